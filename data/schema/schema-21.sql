@@ -0,0 +1,26 @@
+CREATE TABLE IF NOT EXISTS scrobbler_cache (
+  service TEXT NOT NULL,
+  timestamp INTEGER NOT NULL DEFAULT 0,
+  state INTEGER NOT NULL DEFAULT 0,
+  title TEXT,
+  album TEXT,
+  artist TEXT,
+  albumartist TEXT,
+  track INTEGER NOT NULL DEFAULT -1,
+  grouping TEXT,
+  length_nanosec INTEGER NOT NULL DEFAULT 0,
+  musicbrainz_album_artist_id TEXT,
+  musicbrainz_artist_id TEXT,
+  musicbrainz_original_artist_id TEXT,
+  musicbrainz_album_id TEXT,
+  musicbrainz_original_album_id TEXT,
+  musicbrainz_recording_id TEXT,
+  musicbrainz_track_id TEXT,
+  musicbrainz_disc_id TEXT,
+  musicbrainz_release_group_id TEXT,
+  musicbrainz_work_id TEXT
+);
+
+CREATE INDEX IF NOT EXISTS idx_scrobbler_cache_service ON scrobbler_cache (service, state);
+
+UPDATE schema_version SET version=21;
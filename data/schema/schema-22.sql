@@ -0,0 +1,9 @@
+CREATE TABLE IF NOT EXISTS cover_search_misses (
+  artist TEXT NOT NULL,
+  album TEXT NOT NULL,
+  time INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE UNIQUE INDEX IF NOT EXISTS idx_cover_search_misses ON cover_search_misses (artist, album);
+
+UPDATE schema_version SET version=22;
@@ -0,0 +1,12 @@
+CREATE TABLE IF NOT EXISTS lyrics_cache (
+  artist TEXT NOT NULL,
+  title TEXT NOT NULL,
+  album TEXT NOT NULL,
+  provider TEXT,
+  lyrics TEXT,
+  time INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE UNIQUE INDEX IF NOT EXISTS idx_lyrics_cache ON lyrics_cache (artist, title, album);
+
+UPDATE schema_version SET version=23;
@@ -0,0 +1,18 @@
+CREATE VIRTUAL TABLE IF NOT EXISTS %allsongstables_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='%allsongstables', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS %allsongstables_fts_insert AFTER INSERT ON %allsongstables BEGIN
+  INSERT INTO %allsongstables_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS %allsongstables_fts_delete AFTER DELETE ON %allsongstables BEGIN
+  INSERT INTO %allsongstables_fts (%allsongstables_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS %allsongstables_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON %allsongstables BEGIN
+  INSERT INTO %allsongstables_fts (%allsongstables_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO %allsongstables_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+INSERT INTO %allsongstables_fts (%allsongstables_fts) VALUES ('rebuild');
+
+UPDATE schema_version SET version=24;
@@ -0,0 +1,9 @@
+CREATE TABLE IF NOT EXISTS ebur128_analysis_misses (
+  url TEXT NOT NULL,
+  beginning INTEGER NOT NULL DEFAULT 0,
+  mtime INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE UNIQUE INDEX IF NOT EXISTS idx_ebur128_analysis_misses ON ebur128_analysis_misses (url, beginning);
+
+UPDATE schema_version SET version=25;
@@ -4,7 +4,7 @@ CREATE TABLE IF NOT EXISTS schema_version (
 
 DELETE FROM schema_version;
 
-INSERT INTO schema_version (version) VALUES (20);
+INSERT INTO schema_version (version) VALUES (25);
 
 CREATE TABLE IF NOT EXISTS directories (
   path TEXT NOT NULL,
@@ -1026,6 +1026,50 @@ CREATE TABLE IF NOT EXISTS radio_channels (
   thumbnail_url TEXT
 );
 
+CREATE TABLE IF NOT EXISTS scrobbler_cache (
+  service TEXT NOT NULL,
+  timestamp INTEGER NOT NULL DEFAULT 0,
+  state INTEGER NOT NULL DEFAULT 0,
+  title TEXT,
+  album TEXT,
+  artist TEXT,
+  albumartist TEXT,
+  track INTEGER NOT NULL DEFAULT -1,
+  grouping TEXT,
+  length_nanosec INTEGER NOT NULL DEFAULT 0,
+  musicbrainz_album_artist_id TEXT,
+  musicbrainz_artist_id TEXT,
+  musicbrainz_original_artist_id TEXT,
+  musicbrainz_album_id TEXT,
+  musicbrainz_original_album_id TEXT,
+  musicbrainz_recording_id TEXT,
+  musicbrainz_track_id TEXT,
+  musicbrainz_disc_id TEXT,
+  musicbrainz_release_group_id TEXT,
+  musicbrainz_work_id TEXT
+);
+
+CREATE TABLE IF NOT EXISTS cover_search_misses (
+  artist TEXT NOT NULL,
+  album TEXT NOT NULL,
+  time INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS lyrics_cache (
+  artist TEXT NOT NULL,
+  title TEXT NOT NULL,
+  album TEXT NOT NULL,
+  provider TEXT,
+  lyrics TEXT,
+  time INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TABLE IF NOT EXISTS ebur128_analysis_misses (
+  url TEXT NOT NULL,
+  beginning INTEGER NOT NULL DEFAULT 0,
+  mtime INTEGER NOT NULL DEFAULT 0
+);
+
 CREATE INDEX IF NOT EXISTS idx_url ON songs (url);
 
 CREATE INDEX IF NOT EXISTS idx_comp_artist ON songs (compilation_effective, artist);
@@ -1038,4 +1082,177 @@ CREATE INDEX IF NOT EXISTS idx_album ON songs (album);
 
 CREATE INDEX IF NOT EXISTS idx_title ON songs (title);
 
+CREATE INDEX IF NOT EXISTS idx_scrobbler_cache_service ON scrobbler_cache (service, state);
+
+CREATE UNIQUE INDEX IF NOT EXISTS idx_cover_search_misses ON cover_search_misses (artist, album);
+
+CREATE UNIQUE INDEX IF NOT EXISTS idx_lyrics_cache ON lyrics_cache (artist, title, album);
+
+CREATE UNIQUE INDEX IF NOT EXISTS idx_ebur128_analysis_misses ON ebur128_analysis_misses (url, beginning);
+
+CREATE VIRTUAL TABLE IF NOT EXISTS songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS songs_fts_insert AFTER INSERT ON songs BEGIN
+  INSERT INTO songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS songs_fts_delete AFTER DELETE ON songs BEGIN
+  INSERT INTO songs_fts (songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON songs BEGIN
+  INSERT INTO songs_fts (songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS subsonic_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='subsonic_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS subsonic_songs_fts_insert AFTER INSERT ON subsonic_songs BEGIN
+  INSERT INTO subsonic_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS subsonic_songs_fts_delete AFTER DELETE ON subsonic_songs BEGIN
+  INSERT INTO subsonic_songs_fts (subsonic_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS subsonic_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON subsonic_songs BEGIN
+  INSERT INTO subsonic_songs_fts (subsonic_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO subsonic_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS tidal_artists_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='tidal_artists_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS tidal_artists_songs_fts_insert AFTER INSERT ON tidal_artists_songs BEGIN
+  INSERT INTO tidal_artists_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS tidal_artists_songs_fts_delete AFTER DELETE ON tidal_artists_songs BEGIN
+  INSERT INTO tidal_artists_songs_fts (tidal_artists_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS tidal_artists_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON tidal_artists_songs BEGIN
+  INSERT INTO tidal_artists_songs_fts (tidal_artists_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO tidal_artists_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS tidal_albums_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='tidal_albums_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS tidal_albums_songs_fts_insert AFTER INSERT ON tidal_albums_songs BEGIN
+  INSERT INTO tidal_albums_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS tidal_albums_songs_fts_delete AFTER DELETE ON tidal_albums_songs BEGIN
+  INSERT INTO tidal_albums_songs_fts (tidal_albums_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS tidal_albums_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON tidal_albums_songs BEGIN
+  INSERT INTO tidal_albums_songs_fts (tidal_albums_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO tidal_albums_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS tidal_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='tidal_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS tidal_songs_fts_insert AFTER INSERT ON tidal_songs BEGIN
+  INSERT INTO tidal_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS tidal_songs_fts_delete AFTER DELETE ON tidal_songs BEGIN
+  INSERT INTO tidal_songs_fts (tidal_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS tidal_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON tidal_songs BEGIN
+  INSERT INTO tidal_songs_fts (tidal_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO tidal_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS spotify_artists_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='spotify_artists_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS spotify_artists_songs_fts_insert AFTER INSERT ON spotify_artists_songs BEGIN
+  INSERT INTO spotify_artists_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS spotify_artists_songs_fts_delete AFTER DELETE ON spotify_artists_songs BEGIN
+  INSERT INTO spotify_artists_songs_fts (spotify_artists_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS spotify_artists_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON spotify_artists_songs BEGIN
+  INSERT INTO spotify_artists_songs_fts (spotify_artists_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO spotify_artists_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS spotify_albums_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='spotify_albums_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS spotify_albums_songs_fts_insert AFTER INSERT ON spotify_albums_songs BEGIN
+  INSERT INTO spotify_albums_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS spotify_albums_songs_fts_delete AFTER DELETE ON spotify_albums_songs BEGIN
+  INSERT INTO spotify_albums_songs_fts (spotify_albums_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS spotify_albums_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON spotify_albums_songs BEGIN
+  INSERT INTO spotify_albums_songs_fts (spotify_albums_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO spotify_albums_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS spotify_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='spotify_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS spotify_songs_fts_insert AFTER INSERT ON spotify_songs BEGIN
+  INSERT INTO spotify_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS spotify_songs_fts_delete AFTER DELETE ON spotify_songs BEGIN
+  INSERT INTO spotify_songs_fts (spotify_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS spotify_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON spotify_songs BEGIN
+  INSERT INTO spotify_songs_fts (spotify_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO spotify_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS qobuz_artists_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='qobuz_artists_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS qobuz_artists_songs_fts_insert AFTER INSERT ON qobuz_artists_songs BEGIN
+  INSERT INTO qobuz_artists_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS qobuz_artists_songs_fts_delete AFTER DELETE ON qobuz_artists_songs BEGIN
+  INSERT INTO qobuz_artists_songs_fts (qobuz_artists_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS qobuz_artists_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON qobuz_artists_songs BEGIN
+  INSERT INTO qobuz_artists_songs_fts (qobuz_artists_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO qobuz_artists_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS qobuz_albums_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='qobuz_albums_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS qobuz_albums_songs_fts_insert AFTER INSERT ON qobuz_albums_songs BEGIN
+  INSERT INTO qobuz_albums_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS qobuz_albums_songs_fts_delete AFTER DELETE ON qobuz_albums_songs BEGIN
+  INSERT INTO qobuz_albums_songs_fts (qobuz_albums_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS qobuz_albums_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON qobuz_albums_songs BEGIN
+  INSERT INTO qobuz_albums_songs_fts (qobuz_albums_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO qobuz_albums_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE VIRTUAL TABLE IF NOT EXISTS qobuz_songs_fts USING fts5(title, album, artist, albumartist, composer, performer, grouping, genre, comment, content='qobuz_songs', tokenize='trigram');
+
+CREATE TRIGGER IF NOT EXISTS qobuz_songs_fts_insert AFTER INSERT ON qobuz_songs BEGIN
+  INSERT INTO qobuz_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS qobuz_songs_fts_delete AFTER DELETE ON qobuz_songs BEGIN
+  INSERT INTO qobuz_songs_fts (qobuz_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+END;
+
+CREATE TRIGGER IF NOT EXISTS qobuz_songs_fts_update AFTER UPDATE OF title, album, artist, albumartist, composer, performer, grouping, genre, comment ON qobuz_songs BEGIN
+  INSERT INTO qobuz_songs_fts (qobuz_songs_fts, rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES ('delete', old.rowid, old.title, old.album, old.artist, old.albumartist, old.composer, old.performer, old.grouping, old.genre, old.comment);
+  INSERT INTO qobuz_songs_fts (rowid, title, album, artist, albumartist, composer, performer, grouping, genre, comment) VALUES (new.rowid, new.title, new.album, new.artist, new.albumartist, new.composer, new.performer, new.grouping, new.genre, new.comment);
+END;
+
 CREATE VIEW IF NOT EXISTS duplicated_songs as select artist dup_artist, album dup_album, title dup_title from songs as inner_songs where artist != '' and album != '' and title != '' and unavailable = 0 group by artist, album , title having count(*) > 1;
@@ -97,6 +97,9 @@ class AbstractMessageHandler : public _MessageHandlerBase {
   // The MessageReply's Finished() signal will be emitted when a reply arrives with the same ID.  Must be called from my thread.
   void SendRequest(ReplyType *reply);
 
+  // True while a request sent with SendRequest() has not been answered.  Must be called from my thread.
+  bool has_pending_replies() const { return !pending_replies_.isEmpty(); }
+
   // Sets the "id" field of reply to the same as the request, and sends the reply on the socket.  Used on the worker side.
   void SendReply(const MessageType &request, MessageType *reply);
 
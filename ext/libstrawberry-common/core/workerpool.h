@@ -36,6 +36,7 @@
 #include <QFile>
 #include <QList>
 #include <QQueue>
+#include <QHash>
 #include <QString>
 #include <QStringList>
 #include <QAtomicInt>
@@ -83,8 +84,13 @@ class WorkerPool : public _WorkerPoolBase {
   // You must call this before calling Start().
   void SetExecutableName(const QString &executable_name);
 
-  // Sets the number of worker process to use.  Defaults to 1 <= (processors / 2) <= 2.
+  // Sets the number of worker process to use.  Defaults to 1.
   void SetWorkerCount(const int count);
+  int worker_count() const { return worker_count_; }
+
+  // Starts more workers, up to count, once no worker has a request in progress.  Never stops workers.
+  // Can be called from any thread after Start().
+  void RaiseWorkerCount(const int count);
 
   // Sets the prefix to use for the local server (on unix this is a named pipe in /tmp).
   // Defaults to QApplication::applicationName().
@@ -96,8 +102,9 @@ class WorkerPool : public _WorkerPoolBase {
 
   // Fills in the message's "id" field and creates a reply future.
   // The message is queued and the WorkerPool's thread will send it to the next available worker.
+  // Messages with the same affinity key, like the filename, always go to the same worker, so they are processed in the order they were sent.
   // Can be called from any thread.
-  ReplyType *SendMessageWithReply(MessageType *message);
+  ReplyType *SendMessageWithReply(MessageType *message, const QString &affinity_key = QString());
 
  protected:
   // These are all reimplemented slots, they are called on the WorkerPool's thread.
@@ -118,6 +125,12 @@ class WorkerPool : public _WorkerPoolBase {
     HandlerType *handler_;
   };
 
+  struct QueuedMessage {
+    explicit QueuedMessage(ReplyType *_reply = nullptr, const QString &_affinity_key = QString()) : reply(_reply), affinity_key(_affinity_key) {}
+    ReplyType *reply;
+    QString affinity_key;
+  };
+
   // Must only ever be called on my thread.
   void StartOneWorker(Worker *worker);
 
@@ -146,19 +159,26 @@ class WorkerPool : public _WorkerPoolBase {
   // Returns the next handler, or nullptr if there isn't one.  Must be called from my thread.
   HandlerType *NextHandler() const;
 
+  // Returns the handler of the worker for this affinity key, or nullptr if it is not connected.  Must be called from my thread.
+  HandlerType *AffinityHandler(const QString &affinity_key) const;
+
+  // Starts the workers requested by RaiseWorkerCount().  Must be called from my thread.
+  void StartRequestedWorkers();
+
  private:
   QString local_server_name_;
   QString executable_name_;
   QString executable_path_;
 
   int worker_count_;
+  int requested_worker_count_;
   mutable int next_worker_;
   QList<Worker> workers_;
 
   QAtomicInt next_id_;
 
   QMutex message_queue_mutex_;
-  QQueue<ReplyType *> message_queue_;
+  QQueue<QueuedMessage> message_queue_;
 };
 
 
@@ -166,6 +186,7 @@ template<typename HandlerType>
 WorkerPool<HandlerType>::WorkerPool(QObject *parent)
     : _WorkerPoolBase(parent),
       worker_count_(1),
+      requested_worker_count_(1),
       next_worker_(0),
       next_id_(0) {
 
@@ -202,8 +223,8 @@ WorkerPool<HandlerType>::~WorkerPool() {
     }
   }
 
-  for (ReplyType *reply : message_queue_) {
-    reply->Abort();
+  for (const QueuedMessage &queued_message : message_queue_) {
+    queued_message.reply->Abort();
   }
 
 }
@@ -212,6 +233,40 @@ template<typename HandlerType>
 void WorkerPool<HandlerType>::SetWorkerCount(const int count) {
   Q_ASSERT(workers_.isEmpty());
   worker_count_ = count;
+  requested_worker_count_ = count;
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::RaiseWorkerCount(const int count) {
+
+  QMetaObject::invokeMethod(this, [this, count]() {
+    if (count <= requested_worker_count_) return;
+    requested_worker_count_ = count;
+    QMutexLocker l(&message_queue_mutex_);
+    StartRequestedWorkers();
+  });
+
+}
+
+template<typename HandlerType>
+void WorkerPool<HandlerType>::StartRequestedWorkers() {
+
+  Q_ASSERT(QThread::currentThread() == thread());
+
+  if (workers_.isEmpty() || workers_.count() >= requested_worker_count_) return;
+
+  // The worker of an affinity key depends on the number of workers, so only add workers while none of them has a request in progress.
+  for (const Worker &worker : std::as_const(workers_)) {
+    if (worker.handler_ && worker.handler_->has_pending_replies()) return;
+  }
+
+  while (workers_.count() < requested_worker_count_) {
+    Worker worker;
+    StartOneWorker(&worker);
+    workers_ << worker;
+  }
+  worker_count_ = static_cast<int>(workers_.count());
+
 }
 
 template<typename HandlerType>
@@ -408,14 +463,14 @@ WorkerPool<HandlerType>::NewReply(MessageType *message) {
 
 template <typename HandlerType>
 typename WorkerPool<HandlerType>::ReplyType*
-WorkerPool<HandlerType>::SendMessageWithReply(MessageType *message) {
+WorkerPool<HandlerType>::SendMessageWithReply(MessageType *message, const QString &affinity_key) {
 
   ReplyType *reply = NewReply(message);
 
   // Add the pending reply to the queue
   {
     QMutexLocker l(&message_queue_mutex_);
-    message_queue_.enqueue(reply);
+    message_queue_.enqueue(QueuedMessage(reply, affinity_key));
   }
 
   // Wake up the main thread
@@ -430,19 +485,26 @@ void WorkerPool<HandlerType>::SendQueuedMessages() {
 
   QMutexLocker l(&message_queue_mutex_);
 
+  StartRequestedWorkers();
+
+  // Messages for a worker that is not available stay in the queue, in the same order.
+  QQueue<QueuedMessage> waiting_messages;
   while (!message_queue_.isEmpty()) {
-    ReplyType *reply = message_queue_.dequeue();
+    const QueuedMessage queued_message = message_queue_.dequeue();
 
     // Find a worker for this message
-    HandlerType *handler = NextHandler();
+    HandlerType *handler = queued_message.affinity_key.isEmpty() ? NextHandler() : AffinityHandler(queued_message.affinity_key);
     if (!handler) {
-      // No available handlers - put the message on the front of the queue.
-      message_queue_.prepend(reply);
-      qLog(Debug) << "No available handlers to process request";
-      break;
+      waiting_messages.enqueue(queued_message);
+      continue;
     }
 
-    handler->SendRequest(reply);
+    handler->SendRequest(queued_message.reply);
+  }
+
+  if (!waiting_messages.isEmpty()) {
+    qLog(Debug) << "No available handlers to process" << waiting_messages.count() << "requests";
+    message_queue_ = waiting_messages;
   }
 
 }
@@ -463,4 +525,18 @@ HandlerType *WorkerPool<HandlerType>::NextHandler() const {
 
 }
 
+template<typename HandlerType>
+HandlerType *WorkerPool<HandlerType>::AffinityHandler(const QString &affinity_key) const {
+
+  if (workers_.isEmpty()) return nullptr;
+
+  const Worker &worker = workers_[static_cast<qsizetype>(qHash(affinity_key) % static_cast<size_t>(workers_.count()))];
+  if (worker.handler_ && !worker.handler_->is_device_closed()) {
+    return worker.handler_;
+  }
+
+  return nullptr;
+
+}
+
 #endif  // WORKERPOOL_H
@@ -36,6 +36,7 @@
 #include "core/tagreaderclient.h"
 #include "core/thread.h"
 #include "core/song.h"
+#include "core/songprojection.h"
 #include "core/logging.h"
 #include "core/settings.h"
 #include "utilities/threadutils.h"
@@ -125,8 +126,10 @@ void SCollection::Init() {
   QObject::connect(watcher_, &CollectionWatcher::CompilationsNeedUpdating, &*backend_, &CollectionBackend::CompilationsNeedUpdating);
   QObject::connect(watcher_, &CollectionWatcher::UpdateLastSeen, &*backend_, &CollectionBackend::UpdateLastSeen);
 
-  QObject::connect(&*app_->lastfm_import(), &LastFMImport::UpdateLastPlayed, &*backend_, &CollectionBackend::UpdateLastPlayed);
-  QObject::connect(&*app_->lastfm_import(), &LastFMImport::UpdatePlayCount, &*backend_, &CollectionBackend::UpdatePlayCount);
+  QObject::connect(&*app_->lastfm_import(), &LastFMImport::Started, &*backend_, &CollectionBackend::ClearPlayStatisticsIndex);
+  QObject::connect(&*app_->lastfm_import(), &LastFMImport::UpdatePlayStatistics, &*backend_, &CollectionBackend::UpdatePlayStatistics);
+  QObject::connect(&*app_->lastfm_import(), &LastFMImport::Finished, &*backend_, &CollectionBackend::ClearPlayStatisticsIndex);
+  QObject::connect(&*app_->lastfm_import(), &LastFMImport::FinishedWithError, &*backend_, &CollectionBackend::ClearPlayStatisticsIndex);
 
   // This will start the watcher checking for updates
   backend_->LoadDirectoriesAsync();
@@ -201,7 +204,7 @@ void SCollection::SyncPlaycountAndRatingToFiles() {
   const int task_id = app_->task_manager()->StartTask(tr("Saving playcounts and ratings"));
   app_->task_manager()->SetTaskBlocksCollectionScans(task_id);
 
-  const SongList songs = backend_->GetAllSongs();
+  const SongList songs = backend_->GetAllSongs(SongProjection(QStringList() << QStringLiteral("url") << QStringLiteral("playcount") << QStringLiteral("rating")));
   const qint64 nb_songs = songs.size();
   int i = 0;
   for (const Song &song : songs) {
@@ -28,7 +28,6 @@
 #include <QObject>
 #include <QApplication>
 #include <QThread>
-#include <QMutex>
 #include <QSet>
 #include <QMap>
 #include <QVector>
@@ -50,6 +49,7 @@
 #include "core/database.h"
 #include "core/scopedtransaction.h"
 #include "core/song.h"
+#include "core/songprojection.h"
 #include "core/sqlrow.h"
 #include "smartplaylists/smartplaylistsearch.h"
 
@@ -61,15 +61,30 @@
 
 using namespace Qt::StringLiterals;
 
+namespace {
+// Each URL is bound with up to four encodings, this keeps the query well below the SQLite variable limit.
+constexpr int kUrlsPerQuery = 200;
+}
+
 CollectionBackend::CollectionBackend(QObject *parent)
     : CollectionBackendInterface(parent),
       db_(nullptr),
       task_manager_(nullptr),
       source_(Song::Source::Unknown),
-      original_thread_(nullptr) {
+      original_thread_(nullptr),
+      play_statistics_index_loaded_(false),
+      songs_generation_(0),
+      statistics_generation_(0) {
 
   original_thread_ = thread();
 
+  QObject::connect(this, &CollectionBackend::SongsAdded, this, &CollectionBackend::IncrementSongsGeneration, Qt::DirectConnection);
+  QObject::connect(this, &CollectionBackend::SongsDeleted, this, &CollectionBackend::IncrementSongsGeneration, Qt::DirectConnection);
+  QObject::connect(this, &CollectionBackend::SongsChanged, this, &CollectionBackend::IncrementSongsGeneration, Qt::DirectConnection);
+  QObject::connect(this, &CollectionBackend::DatabaseReset, this, &CollectionBackend::IncrementSongsGeneration, Qt::DirectConnection);
+  QObject::connect(this, &CollectionBackend::SongsStatisticsChanged, this, &CollectionBackend::IncrementStatisticsGeneration, Qt::DirectConnection);
+  QObject::connect(this, &CollectionBackend::SongsRatingChanged, this, &CollectionBackend::IncrementStatisticsGeneration, Qt::DirectConnection);
+
 }
 
 CollectionBackend::~CollectionBackend() {
@@ -88,13 +103,15 @@ void CollectionBackend::Init(SharedPtr<Database> db, SharedPtr<TaskManager> task
   songs_table_ = songs_table;
   dirs_table_ = dirs_table;
   subdirs_table_ = subdirs_table;
+  // The songs tables of devices do not have a full-text index.
+  fts_table_ = songs_table.startsWith("device_"_L1) ? QString() : songs_table + "_fts"_L1;
 
 }
 
 void CollectionBackend::Close() {
 
   if (db_) {
-    QMutexLocker l(db_->Mutex());
+    Database::WriteLocker l(db_);
     db_->Close();
   }
 
@@ -132,7 +149,6 @@ void CollectionBackend::GetAllSongsAsync(const int id) {
 
 void CollectionBackend::GetAllSongs(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -191,7 +207,6 @@ void CollectionBackend::LoadDirectories() {
 
   const CollectionDirectoryList dirs = GetAllDirectories();
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   for (const CollectionDirectory &dir : dirs) {
@@ -202,7 +217,7 @@ void CollectionBackend::LoadDirectories() {
 
 void CollectionBackend::ChangeDirPath(const int id, const QString &old_path, const QString &new_path) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
   ScopedTransaction t(&db);
 
@@ -253,7 +268,6 @@ void CollectionBackend::ChangeDirPath(const int id, const QString &old_path, con
 
 CollectionDirectoryList CollectionBackend::GetAllDirectories() {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   CollectionDirectoryList ret;
@@ -278,7 +292,6 @@ CollectionDirectoryList CollectionBackend::GetAllDirectories() {
 
 CollectionSubdirectoryList CollectionBackend::SubdirsInDirectory(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db = db_->Connect();
   return SubdirsInDirectory(id, db);
 
@@ -309,7 +322,6 @@ CollectionSubdirectoryList CollectionBackend::SubdirsInDirectory(const int id, Q
 
 void CollectionBackend::UpdateTotalSongCount() {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -329,7 +341,6 @@ void CollectionBackend::UpdateTotalSongCount() {
 
 void CollectionBackend::UpdateTotalArtistCount() {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -349,7 +360,6 @@ void CollectionBackend::UpdateTotalArtistCount() {
 
 void CollectionBackend::UpdateTotalAlbumCount() {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -373,7 +383,7 @@ void CollectionBackend::AddDirectoryAsync(const QString &path) {
 
 void CollectionBackend::AddDirectory(const QString &path) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   {
@@ -414,7 +424,7 @@ void CollectionBackend::RemoveDirectory(const CollectionDirectory &dir) {
   // Remove songs first
   DeleteSongs(FindSongsInDirectory(dir.id));
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -449,7 +459,6 @@ void CollectionBackend::RemoveDirectory(const CollectionDirectory &dir) {
 
 SongList CollectionBackend::FindSongsInDirectory(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -472,7 +481,6 @@ SongList CollectionBackend::FindSongsInDirectory(const int id) {
 
 SongList CollectionBackend::SongsWithMissingFingerprint(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -495,7 +503,6 @@ SongList CollectionBackend::SongsWithMissingFingerprint(const int id) {
 
 SongList CollectionBackend::SongsWithMissingLoudnessCharacteristics(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -534,7 +541,7 @@ void CollectionBackend::SongPathChanged(const Song &song, const QFileInfo &new_f
 
 void CollectionBackend::AddOrUpdateSubdirs(const CollectionSubdirectoryList &subdirs) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -596,7 +603,6 @@ void CollectionBackend::AddOrUpdateSubdirs(const CollectionSubdirectoryList &sub
 
 SongList CollectionBackend::GetAllSongs() {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -616,13 +622,35 @@ SongList CollectionBackend::GetAllSongs() {
 
 }
 
+SongList CollectionBackend::GetAllSongs(const SongProjection &projection) {
+
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.setForwardOnly(true);
+  q.prepare(QStringLiteral("SELECT %1 FROM %2").arg(projection.column_spec(), songs_table_));
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return SongList();
+  }
+
+  SongList songs;
+  while (q.next()) {
+    Song song(source_);
+    song.InitFromQuery(q, projection, true);
+    songs << song;
+  }
+  return songs;
+
+}
+
 void CollectionBackend::AddOrUpdateSongsAsync(const SongList &songs) {
   QMetaObject::invokeMethod(this, "AddOrUpdateSongs", Qt::QueuedConnection, Q_ARG(SongList, songs));
 }
 
 void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -656,9 +684,9 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
       // Update
       {
         SqlQuery q(db);
-        q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, Song::kUpdateSpec));
+        q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = ?").arg(songs_table_, Song::kUpdateSpec));
         song.BindToQuery(&q);
-        q.BindValue(QStringLiteral(":id"), song.id());
+        q.AddBindValue(song.id());
         if (!q.Exec()) {
           db_->ReportErrors(q);
           return;
@@ -683,9 +711,9 @@ void CollectionBackend::AddOrUpdateSongs(const SongList &songs) {
         // Update
         {
           SqlQuery q(db);
-          q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, Song::kUpdateSpec));
+          q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = ?").arg(songs_table_, Song::kUpdateSpec));
           new_song.BindToQuery(&q);
-          q.BindValue(QStringLiteral(":id"), new_song.id());
+          q.AddBindValue(new_song.id());
           if (!q.Exec()) {
             db_->ReportErrors(q);
             return;
@@ -738,7 +766,7 @@ void CollectionBackend::UpdateSongsBySongIDAsync(const SongMap &new_songs) {
 
 void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   CollectionTask task(task_manager_, tr("Updating %1 database.").arg(Song::TextForSource(source_)));
@@ -768,9 +796,9 @@ void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
         {
           SqlQuery q(db);
-          q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = :id").arg(songs_table_, Song::kUpdateSpec));
+          q.prepare(QStringLiteral("UPDATE %1 SET %2 WHERE ROWID = ?").arg(songs_table_, Song::kUpdateSpec));
           new_song.BindToQuery(&q);
-          q.BindValue(QStringLiteral(":id"), old_song.id());
+          q.AddBindValue(old_song.id());
           if (!q.Exec()) {
             db_->ReportErrors(q);
             return;
@@ -837,7 +865,7 @@ void CollectionBackend::UpdateSongsBySongID(const SongMap &new_songs) {
 
 void CollectionBackend::UpdateMTimesOnly(const SongList &songs) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -857,7 +885,7 @@ void CollectionBackend::UpdateMTimesOnly(const SongList &songs) {
 
 void CollectionBackend::DeleteSongs(const SongList &songs) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -883,7 +911,7 @@ void CollectionBackend::DeleteSongs(const SongList &songs) {
 
 void CollectionBackend::MarkSongsUnavailable(const SongList &songs, const bool unavailable) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery query(db);
@@ -914,7 +942,6 @@ void CollectionBackend::MarkSongsUnavailable(const SongList &songs, const bool u
 
 QStringList CollectionBackend::GetAll(const QString &column, const CollectionFilterOptions &filter_options) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   CollectionQuery query(db, songs_table_, filter_options);
@@ -941,7 +968,6 @@ QStringList CollectionBackend::GetAllArtists(const CollectionFilterOptions &opt)
 
 QStringList CollectionBackend::GetAllArtistsWithAlbums(const CollectionFilterOptions &opt) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   // Albums with 'albumartist' field set:
@@ -990,7 +1016,6 @@ CollectionBackend::AlbumList CollectionBackend::GetAlbumsByArtist(const QString
 SongList CollectionBackend::GetArtistSongs(const QString &effective_albumartist, const CollectionFilterOptions &opt) {
 
   QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
 
   CollectionQuery query(db, songs_table_, opt);
   query.AddCompilationRequirement(false);
@@ -1008,7 +1033,6 @@ SongList CollectionBackend::GetArtistSongs(const QString &effective_albumartist,
 SongList CollectionBackend::GetAlbumSongs(const QString &effective_albumartist, const QString &album, const CollectionFilterOptions &opt) {
 
   QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
 
   CollectionQuery query(db, songs_table_, opt);
   query.AddCompilationRequirement(false);
@@ -1027,7 +1051,6 @@ SongList CollectionBackend::GetAlbumSongs(const QString &effective_albumartist,
 SongList CollectionBackend::GetSongsByAlbum(const QString &album, const CollectionFilterOptions &opt) {
 
   QSqlDatabase db(db_->Connect());
-  QMutexLocker l(db_->Mutex());
 
   CollectionQuery query(db, songs_table_, opt);
   query.AddCompilationRequirement(false);
@@ -1042,6 +1065,23 @@ SongList CollectionBackend::GetSongsByAlbum(const QString &album, const Collecti
 
 }
 
+SongList CollectionBackend::GetSongsByAlbum(const QString &album, const SongProjection &projection, const CollectionFilterOptions &opt) {
+
+  QSqlDatabase db(db_->Connect());
+
+  CollectionQuery query(db, songs_table_, opt);
+  query.AddCompilationRequirement(false);
+  query.AddWhere(QStringLiteral("album"), album);
+
+  SongList songs;
+  if (!ExecCollectionQuery(&query, songs, projection)) {
+    ReportErrors(query);
+  }
+
+  return songs;
+
+}
+
 bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongList &songs) {
 
   query->SetColumnSpec(QStringLiteral("%songs_table.ROWID, ") + Song::kColumnSpec);
@@ -1057,6 +1097,21 @@ bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongList &so
 
 }
 
+bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongList &songs, const SongProjection &projection) {
+
+  query->SetColumnSpec(projection.collection_query_column_spec());
+
+  if (!query->Exec()) return false;
+
+  while (query->Next()) {
+    Song song(source_);
+    song.InitFromQuery(*query, projection, true);
+    songs << song;
+  }
+  return true;
+
+}
+
 bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongMap &songs) {
 
   query->SetColumnSpec(QStringLiteral("%songs_table.ROWID, ") + Song::kColumnSpec);
@@ -1074,7 +1129,6 @@ bool CollectionBackend::ExecCollectionQuery(CollectionQuery *query, SongMap &son
 
 Song CollectionBackend::GetSongById(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
   return GetSongById(id, db);
 
@@ -1082,7 +1136,6 @@ Song CollectionBackend::GetSongById(const int id) {
 
 SongList CollectionBackend::GetSongsById(const QList<int> &ids) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   QStringList str_ids;
@@ -1097,7 +1150,6 @@ SongList CollectionBackend::GetSongsById(const QList<int> &ids) {
 
 SongList CollectionBackend::GetSongsById(const QStringList &ids) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   return GetSongsById(ids, db);
@@ -1106,7 +1158,6 @@ SongList CollectionBackend::GetSongsById(const QStringList &ids) {
 
 SongList CollectionBackend::GetSongsByForeignId(const QStringList &ids, const QString &table, const QString &column) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   QString in = ids.join(u',');
@@ -1161,7 +1212,6 @@ SongList CollectionBackend::GetSongsById(const QStringList &ids, QSqlDatabase &d
 
 Song CollectionBackend::GetSongByUrl(const QUrl &url, const qint64 beginning) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1190,7 +1240,6 @@ Song CollectionBackend::GetSongByUrl(const QUrl &url, const qint64 beginning) {
 
 Song CollectionBackend::GetSongByUrlAndTrack(const QUrl &url, const int track) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1219,7 +1268,6 @@ Song CollectionBackend::GetSongByUrlAndTrack(const QUrl &url, const int track) {
 
 SongList CollectionBackend::GetSongsByUrl(const QUrl &url, const bool unavailable) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1245,10 +1293,64 @@ SongList CollectionBackend::GetSongsByUrl(const QUrl &url, const bool unavailabl
 
 }
 
+SongList CollectionBackend::GetSongsByUrls(const QList<QUrl> &urls) {
+
+  if (urls.isEmpty()) return SongList();
+
+  QSqlDatabase db(db_->Connect());
+
+  SongList songs;
+  for (qint64 chunk_start = 0; chunk_start < urls.count(); chunk_start += kUrlsPerQuery) {
+
+    // The URL might be stored with any of these encodings, same as in GetSongsByUrl().
+    QStringList url_strings;
+    QSet<QString> url_strings_seen;
+    const qint64 chunk_end = qMin(urls.count(), chunk_start + kUrlsPerQuery);
+    for (qint64 i = chunk_start; i < chunk_end; ++i) {
+      const QUrl &url = urls.at(i);
+      const QStringList encodings = QStringList() << url.toString()
+                                                  << url.toString(QUrl::FullyEncoded)
+                                                  << QString::fromUtf8(url.toEncoded(QUrl::FullyDecoded))
+                                                  << QString::fromUtf8(url.toEncoded(QUrl::FullyEncoded));
+      for (const QString &url_string : encodings) {
+        if (!url_strings_seen.contains(url_string)) {
+          url_strings_seen.insert(url_string);
+          url_strings << url_string;
+        }
+      }
+    }
+
+    QStringList placeholders;
+    placeholders.reserve(url_strings.count());
+    for (qint64 i = 0; i < url_strings.count(); ++i) {
+      placeholders << QStringLiteral(":url%1").arg(i);
+    }
+
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE url IN (%3) AND unavailable = 0").arg(Song::kRowIdColumnSpec, songs_table_, placeholders.join(u',')));
+    for (qint64 i = 0; i < url_strings.count(); ++i) {
+      q.BindValue(placeholders.at(i), url_strings.at(i));
+    }
+
+    if (!q.Exec()) {
+      db_->ReportErrors(q);
+      return SongList();
+    }
+
+    while (q.next()) {
+      Song song(source_);
+      song.InitFromQuery(q, true);
+      songs << song;
+    }
+
+  }
+
+  return songs;
+
+}
 
 Song CollectionBackend::GetSongBySongId(const QString &song_id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
   return GetSongBySongId(song_id, db);
 
@@ -1256,7 +1358,6 @@ Song CollectionBackend::GetSongBySongId(const QString &song_id) {
 
 SongList CollectionBackend::GetSongsBySongId(const QStringList &song_ids) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   return GetSongsBySongId(song_ids, db);
@@ -1300,7 +1401,6 @@ SongList CollectionBackend::GetSongsBySongId(const QStringList &song_ids, QSqlDa
 
 SongList CollectionBackend::GetSongsByFingerprint(const QString &fingerprint) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1329,7 +1429,6 @@ CollectionBackend::AlbumList CollectionBackend::GetCompilationAlbums(const Colle
 
 SongList CollectionBackend::GetCompilationSongs(const QString &album, const CollectionFilterOptions &opt) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   CollectionQuery query(db, songs_table_, opt);
@@ -1354,7 +1453,7 @@ SongList CollectionBackend::GetCompilationSongs(const QString &album, const Coll
 
 void CollectionBackend::CompilationsNeedUpdating() {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   // Look for albums that have songs by more than one 'effective album artist' in the same directory
@@ -1463,7 +1562,6 @@ bool CollectionBackend::UpdateCompilations(const QSqlDatabase &db, SongList &cha
 
 CollectionBackend::AlbumList CollectionBackend::GetAlbums(const QString &artist, const bool compilation_required, const CollectionFilterOptions &opt) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   CollectionQuery query(db, songs_table_, opt);
@@ -1551,7 +1649,6 @@ CollectionBackend::AlbumList CollectionBackend::GetAlbums(const QString &artist,
 
 CollectionBackend::Album CollectionBackend::GetAlbumArt(const QString &effective_albumartist, const QString &album) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   Album ret;
@@ -1590,7 +1687,7 @@ void CollectionBackend::UpdateEmbeddedAlbumArtAsync(const QString &effective_alb
 
 void CollectionBackend::UpdateEmbeddedAlbumArt(const QString &effective_albumartist, const QString &album, const bool art_embedded) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1636,7 +1733,7 @@ void CollectionBackend::UpdateManualAlbumArtAsync(const QString &effective_album
 
 void CollectionBackend::UpdateManualAlbumArt(const QString &effective_albumartist, const QString &album, const QUrl &art_manual) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1682,7 +1779,7 @@ void CollectionBackend::UnsetAlbumArtAsync(const QString &effective_albumartist,
 
 void CollectionBackend::UnsetAlbumArt(const QString &effective_albumartist, const QString &album) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1727,7 +1824,7 @@ void CollectionBackend::ClearAlbumArtAsync(const QString &effective_albumartist,
 
 void CollectionBackend::ClearAlbumArt(const QString &effective_albumartist, const QString &album, const bool art_unset) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   {
@@ -1767,7 +1864,7 @@ void CollectionBackend::ClearAlbumArt(const QString &effective_albumartist, cons
 
 void CollectionBackend::ForceCompilation(const QString &album, const QStringList &artists, const bool on) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
   SongList songs;
 
@@ -1818,7 +1915,7 @@ void CollectionBackend::IncrementPlayCount(const int id) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1841,7 +1938,7 @@ void CollectionBackend::IncrementSkipCount(const int id, const float progress) {
 
   if (id == -1) return;
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1887,7 +1984,7 @@ bool CollectionBackend::ResetPlayStatistics(const QStringList &id_str_list) {
 
   if (id_str_list.isEmpty()) return false;
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -1911,7 +2008,7 @@ void CollectionBackend::DeleteAllAsync() {
 void CollectionBackend::DeleteAll() {
 
   {
-    QMutexLocker l(db_->Mutex());
+    Database::WriteLocker l(db_);
     QSqlDatabase db(db_->Connect());
     ScopedTransaction t(&db);
 
@@ -1933,11 +2030,10 @@ void CollectionBackend::DeleteAll() {
 
 SongList CollectionBackend::SmartPlaylistsFindSongs(const SmartPlaylistSearch &search) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   // Build the query
-  QString sql = search.ToSql(songs_table());
+  QString sql = search.ToSql(songs_table(), fts_table_);
 
   // Run the query
   SongList ret;
@@ -1958,95 +2054,200 @@ SongList CollectionBackend::SmartPlaylistsFindSongs(const SmartPlaylistSearch &s
 
 }
 
-SongList CollectionBackend::SmartPlaylistsGetAllSongs() {
+SmartPlaylistCandidateList CollectionBackend::SmartPlaylistsFindCandidates(const SmartPlaylistSearch &search) {
 
-  // Get all the songs!
-  return SmartPlaylistsFindSongs(SmartPlaylistSearch(SmartPlaylistSearch::SearchType::All, SmartPlaylistSearch::TermList(), SmartPlaylistSearch::SortType::FieldAsc, SmartPlaylistSearchTerm::Field::Artist, -1));
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(search.ToCandidatesSql(songs_table(), fts_table_));
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return SmartPlaylistCandidateList();
+  }
+
+  SmartPlaylistCandidateList candidates;
+  while (q.next()) {
+    SmartPlaylistCandidate candidate;
+    candidate.id = q.value(0).toInt();
+    candidate.rating = q.value(1).isNull() ? -1.0F : q.value(1).toFloat();
+    candidate.playcount = q.value(2).toInt();
+    candidate.skipcount = q.value(3).toInt();
+    candidates << candidate;
+  }
+
+  return candidates;
 
 }
 
-SongList CollectionBackend::GetSongsBy(const QString &artist, const QString &album, const QString &title) {
+int CollectionBackend::SmartPlaylistsCountSongs(const SmartPlaylistSearch &search) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
-  SongList songs;
   SqlQuery q(db);
-  if (album.isEmpty()) {
-    q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE artist = :artist COLLATE NOCASE AND title = :title COLLATE NOCASE").arg(Song::kRowIdColumnSpec, songs_table_));
+  q.prepare(search.ToCountSql(songs_table(), fts_table_));
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
+    return 0;
   }
-  else {
-    q.prepare(QStringLiteral("SELECT %1 FROM %2 WHERE artist = :artist COLLATE NOCASE AND album = :album COLLATE NOCASE AND title = :title COLLATE NOCASE").arg(Song::kRowIdColumnSpec, songs_table_));
+  if (!q.next()) return 0;
+
+  return q.value(0).toInt();
+
+}
+
+QList<int> CollectionBackend::SearchSongIds(const QStringList &words, const int limit) {
+
+  if (fts_table_.isEmpty() || words.isEmpty()) return QList<int>();
+
+  // Each word is matched as a phrase, so FTS5 query syntax in the search text is taken literally.
+  QStringList phrases;
+  phrases.reserve(words.count());
+  for (QString word : words) {
+    phrases << u'"' + word.replace(u'"', "\"\""_L1) + u'"';
   }
-  q.BindValue(QStringLiteral(":artist"), artist);
-  if (!album.isEmpty()) q.BindValue(QStringLiteral(":album"), album);
-  q.BindValue(QStringLiteral(":title"), title);
+
+  QSqlDatabase db(db_->Connect());
+
+  SqlQuery q(db);
+  // Ranking the matches is only worth it when the best ones are picked, otherwise they are returned in index order.
+  q.prepare(QStringLiteral("SELECT ROWID FROM %1 WHERE %1 MATCH ?%2").arg(fts_table_, limit > 0 ? QStringLiteral(" ORDER BY rank LIMIT %1").arg(limit) : QString()));
+  q.AddBindValue(phrases.join(u' '));
   if (!q.Exec()) {
     db_->ReportErrors(q);
-    return SongList();
+    return QList<int>();
   }
+
+  QList<int> song_ids;
   while (q.next()) {
-    Song song(source_);
-    song.InitFromQuery(q, true);
-    songs << song;
+    song_ids << q.value(0).toInt();
   }
 
-  return songs;
+  return song_ids;
+
+}
+
+void CollectionBackend::IncrementSongsGeneration() {
+
+  ++songs_generation_;
+
+}
+
+void CollectionBackend::IncrementStatisticsGeneration() {
+
+  ++statistics_generation_;
+
+}
+
+SongList CollectionBackend::SmartPlaylistsGetAllSongs() {
+
+  // Get all the songs!
+  return SmartPlaylistsFindSongs(SmartPlaylistSearch(SmartPlaylistSearch::SearchType::All, SmartPlaylistSearch::TermList(), SmartPlaylistSearch::SortType::FieldAsc, SmartPlaylistSearchTerm::Field::Artist, -1));
+
+}
+
+QString CollectionBackend::PlayStatisticsKey(const QString &artist, const QString &album, const QString &title) {
+
+  return artist.toLower() + QLatin1Char('\n') + album.toLower() + QLatin1Char('\n') + title.toLower();
 
 }
 
-void CollectionBackend::UpdateLastPlayed(const QString &artist, const QString &album, const QString &title, const qint64 lastplayed) {
+void CollectionBackend::LoadPlayStatisticsIndex(QSqlDatabase &db) {
 
-  const SongList songs = GetSongsBy(artist, album, title);
-  if (songs.isEmpty()) {
-    qLog(Debug) << "Could not find a matching song in the database for" << artist << album << title;
+  play_statistics_index_.clear();
+  play_statistics_lastplayed_.clear();
+
+  // Unavailable songs are included like before, so they keep their statistics if the files come back.
+  SqlQuery q(db);
+  q.prepare(QStringLiteral("SELECT ROWID, artist, album, title, lastplayed FROM %1").arg(songs_table_));
+  if (!q.Exec()) {
+    db_->ReportErrors(q);
     return;
   }
 
-  QMutexLocker l(db_->Mutex());
-  QSqlDatabase db(db_->Connect());
-
-  for (const Song &song : songs) {
-    if (song.lastplayed() >= lastplayed) {
-      continue;
-    }
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("UPDATE %1 SET lastplayed = :lastplayed WHERE ROWID = :id").arg(songs_table_));
-    q.BindValue(QStringLiteral(":lastplayed"), lastplayed);
-    q.BindValue(QStringLiteral(":id"), song.id());
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      continue;
+  while (q.next()) {
+    const int id = q.value(0).toInt();
+    const QString artist = q.value(1).toString();
+    const QString album = q.value(2).toString();
+    const QString title = q.value(3).toString();
+    play_statistics_index_[PlayStatisticsKey(artist, album, title)] << id;
+    // Also index without album, play counts are not per album and last played entries can be missing the album.
+    if (!album.isEmpty()) {
+      play_statistics_index_[PlayStatisticsKey(artist, QString(), title)] << id;
     }
+    play_statistics_lastplayed_.insert(id, q.value(4).toLongLong());
   }
 
-  Q_EMIT SongsStatisticsChanged(SongList() << songs);
+  play_statistics_index_loaded_ = true;
 
 }
 
-void CollectionBackend::UpdatePlayCount(const QString &artist, const QString &title, const int playcount, const bool save_tags) {
+void CollectionBackend::ClearPlayStatisticsIndex() {
 
-  const SongList songs = GetSongsBy(artist, QString(), title);
-  if (songs.isEmpty()) {
-    qLog(Debug) << "Could not find a matching song in the database for" << artist << title;
-    return;
-  }
+  play_statistics_index_loaded_ = false;
+  play_statistics_index_.clear();
+  play_statistics_lastplayed_.clear();
 
-  QMutexLocker l(db_->Mutex());
+}
+
+void CollectionBackend::UpdatePlayStatistics(const CollectionPlayStatisticsList &play_statistics) {
+
+  if (play_statistics.isEmpty()) return;
+
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
-  for (const Song &song : songs) {
-    SqlQuery q(db);
-    q.prepare(QStringLiteral("UPDATE %1 SET playcount = :playcount WHERE ROWID = :id").arg(songs_table_));
-    q.BindValue(QStringLiteral(":playcount"), playcount);
-    q.BindValue(QStringLiteral(":id"), song.id());
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      return;
+  if (!play_statistics_index_loaded_) {
+    LoadPlayStatisticsIndex(db);
+  }
+
+  ScopedTransaction transaction(&db);
+
+  SqlQuery q_lastplayed(db);
+  q_lastplayed.prepare(QStringLiteral("UPDATE %1 SET lastplayed = :lastplayed WHERE ROWID = :id").arg(songs_table_));
+  SqlQuery q_playcount(db);
+  q_playcount.prepare(QStringLiteral("UPDATE %1 SET playcount = :playcount WHERE ROWID = :id").arg(songs_table_));
+
+  QSet<int> updated_ids;
+  for (const CollectionPlayStatistics &statistics : play_statistics) {
+    if (statistics.lastplayed > 0) {
+      const QList<int> ids = play_statistics_index_.value(PlayStatisticsKey(statistics.artist, statistics.album, statistics.title));
+      if (ids.isEmpty()) {
+        qLog(Debug) << "Could not find a matching song in the database for" << statistics.artist << statistics.album << statistics.title;
+      }
+      for (const int id : ids) {
+        if (play_statistics_lastplayed_.value(id, -1) >= statistics.lastplayed) continue;
+        q_lastplayed.BindValue(QStringLiteral(":lastplayed"), statistics.lastplayed);
+        q_lastplayed.BindValue(QStringLiteral(":id"), id);
+        if (!q_lastplayed.Exec()) {
+          db_->ReportErrors(q_lastplayed);
+          return;
+        }
+        play_statistics_lastplayed_[id] = statistics.lastplayed;
+        updated_ids << id;
+      }
+    }
+    if (statistics.playcount > 0) {
+      const QList<int> ids = play_statistics_index_.value(PlayStatisticsKey(statistics.artist, QString(), statistics.title));
+      if (ids.isEmpty()) {
+        qLog(Debug) << "Could not find a matching song in the database for" << statistics.artist << statistics.title;
+      }
+      for (const int id : ids) {
+        q_playcount.BindValue(QStringLiteral(":playcount"), statistics.playcount);
+        q_playcount.BindValue(QStringLiteral(":id"), id);
+        if (!q_playcount.Exec()) {
+          db_->ReportErrors(q_playcount);
+          return;
+        }
+        updated_ids << id;
+      }
     }
   }
 
-  Q_EMIT SongsStatisticsChanged(SongList() << songs, save_tags);
+  transaction.Commit();
+
+  if (updated_ids.isEmpty()) return;
+
+  Q_EMIT SongsStatisticsChanged(GetSongsById(updated_ids.values()));
 
 }
 
@@ -2062,7 +2263,7 @@ void CollectionBackend::UpdateSongsRating(const QList<int> &id_list, const float
 
   if (id_list.isEmpty()) return;
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   QStringList id_str_list;
@@ -2096,7 +2297,7 @@ void CollectionBackend::UpdateSongsRatingAsync(const QList<int> &ids, const floa
 void CollectionBackend::UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days) {
 
   {
-    QMutexLocker l(db_->Mutex());
+    Database::WriteLocker l(db_);
     QSqlDatabase db(db_->Connect());
 
     SqlQuery q(db);
@@ -2117,7 +2318,6 @@ void CollectionBackend::ExpireSongs(const int directory_id, const int expire_una
 
   SongList songs;
   {
-    QMutexLocker l(db_->Mutex());
     QSqlDatabase db(db_->Connect());
     SqlQuery q(db);
     q.prepare(QStringLiteral("SELECT %1 FROM %2 LEFT JOIN playlist_items ON %2.ROWID = playlist_items.collection_id WHERE %2.directory_id = :directory_id AND %2.unavailable = 1 AND %2.lastseen > 0 AND %2.lastseen < :time AND playlist_items.collection_id IS NULL").arg(Song::JoinSpec(songs_table_), songs_table_));
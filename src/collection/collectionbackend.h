@@ -26,6 +26,7 @@
 
 #include <optional>
 #include <memory>
+#include <atomic>
 
 #include <QtGlobal>
 #include <QObject>
@@ -34,6 +35,7 @@
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <QHash>
 #include <QSqlDatabase>
 
 #include "core/shared_ptr.h"
@@ -41,11 +43,14 @@
 #include "collectionfilteroptions.h"
 #include "collectionquery.h"
 #include "collectiondirectory.h"
+#include "collectionplaystatistics.h"
+#include "smartplaylists/smartplaylistcandidate.h"
 
 class QThread;
 class TaskManager;
 class Database;
 class SmartPlaylistSearch;
+class SongProjection;
 
 class CollectionBackendInterface : public QObject {
   Q_OBJECT
@@ -123,6 +128,7 @@ class CollectionBackendInterface : public QObject {
   virtual Album GetAlbumArt(const QString &effective_albumartist, const QString &album) = 0;
 
   virtual Song GetSongById(const int id) = 0;
+  virtual SongList GetSongsById(const QList<int> &ids) = 0;
 
   virtual SongList GetSongsByFingerprint(const QString &fingerprint) = 0;
 
@@ -132,6 +138,9 @@ class CollectionBackendInterface : public QObject {
   // Using default beginning value is suitable when searching for single-section songs.
   virtual Song GetSongByUrl(const QUrl &url, const qint64 beginning = 0) = 0;
   virtual Song GetSongByUrlAndTrack(const QUrl &url, const int track) = 0;
+  // Returns all available sections of the songs with the given filenames, using as few queries as possible.
+  // The result is not ordered, use the song URL, beginning and track to match the songs.
+  virtual SongList GetSongsByUrls(const QList<QUrl> &urls) = 0;
 
   virtual void AddDirectoryAsync(const QString &path) = 0;
   virtual void RemoveDirectoryAsync(const CollectionDirectory &dir) = 0;
@@ -161,6 +170,8 @@ class CollectionBackend : public CollectionBackendInterface {
   QString songs_table() const override { return songs_table_; }
   QString dirs_table() const { return dirs_table_; }
   QString subdirs_table() const { return subdirs_table_; }
+  // The full-text index of songs_table, empty if the table does not have one.
+  QString fts_table() const { return fts_table_; }
 
   void GetAllSongsAsync(const int id = 0) override;
 
@@ -179,6 +190,7 @@ class CollectionBackend : public CollectionBackendInterface {
   void ChangeDirPath(const int id, const QString &old_path, const QString &new_path) override;
 
   SongList GetAllSongs() override;
+  SongList GetAllSongs(const SongProjection &projection);
 
   QStringList GetAll(const QString &column, const CollectionFilterOptions &filter_options = CollectionFilterOptions());
   QStringList GetAllArtists(const CollectionFilterOptions &opt = CollectionFilterOptions()) override;
@@ -186,6 +198,7 @@ class CollectionBackend : public CollectionBackendInterface {
   SongList GetArtistSongs(const QString &effective_albumartist, const CollectionFilterOptions &opt = CollectionFilterOptions()) override;
   SongList GetAlbumSongs(const QString &effective_albumartist, const QString &album, const CollectionFilterOptions &opt = CollectionFilterOptions()) override;
   SongList GetSongsByAlbum(const QString &album, const CollectionFilterOptions &opt = CollectionFilterOptions()) override;
+  SongList GetSongsByAlbum(const QString &album, const SongProjection &projection, const CollectionFilterOptions &opt = CollectionFilterOptions());
 
   SongList GetCompilationSongs(const QString &album, const CollectionFilterOptions &opt = CollectionFilterOptions()) override;
 
@@ -201,19 +214,21 @@ class CollectionBackend : public CollectionBackendInterface {
   Album GetAlbumArt(const QString &effective_albumartist, const QString &album) override;
 
   Song GetSongById(const int id) override;
-  SongList GetSongsById(const QList<int> &ids);
+  SongList GetSongsById(const QList<int> &ids) override;
   SongList GetSongsById(const QStringList &ids);
   SongList GetSongsByForeignId(const QStringList &ids, const QString &table, const QString &column);
 
   SongList GetSongsByUrl(const QUrl &url, const bool unavailable = false) override;
   Song GetSongByUrl(const QUrl &url, qint64 beginning = 0) override;
   Song GetSongByUrlAndTrack(const QUrl &url, const int track) override;
+  SongList GetSongsByUrls(const QList<QUrl> &urls) override;
 
   void AddDirectoryAsync(const QString &path) override;
   void RemoveDirectoryAsync(const CollectionDirectory &dir) override;
 
   bool ExecCollectionQuery(CollectionQuery *query, SongList &songs);
   bool ExecCollectionQuery(CollectionQuery *query, SongMap &songs);
+  bool ExecCollectionQuery(CollectionQuery *query, SongList &songs, const SongProjection &projection);
 
   void IncrementPlayCountAsync(const int id);
   void IncrementSkipCountAsync(const int id, const float progress);
@@ -229,6 +244,18 @@ class CollectionBackend : public CollectionBackendInterface {
 
   SongList SmartPlaylistsGetAllSongs();
   SongList SmartPlaylistsFindSongs(const SmartPlaylistSearch &search);
+  SmartPlaylistCandidateList SmartPlaylistsFindCandidates(const SmartPlaylistSearch &search);
+  int SmartPlaylistsCountSongs(const SmartPlaylistSearch &search);
+
+  // IDs of the songs that contain each of the words in one of the indexed text columns.
+  // With a limit only the best matches are returned, best first.
+  // This uses the trigram index, so words shorter than 3 characters never match.
+  QList<int> SearchSongIds(const QStringList &words, const int limit = -1);
+
+  // Changes every time songs are added, changed or removed, so callers can tell when their cached results are stale.
+  quint64 songs_generation() const { return songs_generation_; }
+  // Changes every time play counts, skip counts, last played times or ratings change.
+  quint64 statistics_generation() const { return statistics_generation_; }
 
   void AddOrUpdateSongsAsync(const SongList &songs);
   void UpdateSongsBySongIDAsync(const SongMap &new_songs);
@@ -265,9 +292,8 @@ class CollectionBackend : public CollectionBackendInterface {
   void DeleteAll();
   void SongPathChanged(const Song &song, const QFileInfo &new_file, const std::optional<int> new_collection_directory_id);
 
-  SongList GetSongsBy(const QString &artist, const QString &album, const QString &title);
-  void UpdateLastPlayed(const QString &artist, const QString &album, const QString &title, const qint64 lastplayed);
-  void UpdatePlayCount(const QString &artist, const QString &title, const int playcount, const bool save_tags = false);
+  void UpdatePlayStatistics(const CollectionPlayStatisticsList &play_statistics);
+  void ClearPlayStatisticsIndex();
 
   void UpdateSongRating(const int id, const float rating, const bool save_tags = false);
   void UpdateSongsRating(const QList<int> &id_list, const float rating, const bool save_tags = false);
@@ -275,6 +301,10 @@ class CollectionBackend : public CollectionBackendInterface {
   void UpdateLastSeen(const int directory_id, const int expire_unavailable_songs_days);
   void ExpireSongs(const int directory_id, const int expire_unavailable_songs_days);
 
+ private Q_SLOTS:
+  void IncrementSongsGeneration();
+  void IncrementStatisticsGeneration();
+
  Q_SIGNALS:
   void DirectoryAdded(const CollectionDirectory &dir, const CollectionSubdirectoryList &subdir);
   void DirectoryDeleted(const CollectionDirectory &dir);
@@ -318,6 +348,9 @@ class CollectionBackend : public CollectionBackendInterface {
   Song GetSongBySongId(const QString &song_id, QSqlDatabase &db);
   SongList GetSongsBySongId(const QStringList &song_ids, QSqlDatabase &db);
 
+  void LoadPlayStatisticsIndex(QSqlDatabase &db);
+  static QString PlayStatisticsKey(const QString &artist, const QString &album, const QString &title);
+
  private:
   SharedPtr<Database> db_;
   SharedPtr<TaskManager> task_manager_;
@@ -325,7 +358,16 @@ class CollectionBackend : public CollectionBackendInterface {
   QString songs_table_;
   QString dirs_table_;
   QString subdirs_table_;
+  QString fts_table_;
   QThread *original_thread_;
+
+  // Song IDs by artist, album and title, used while importing play statistics.
+  bool play_statistics_index_loaded_;
+  QHash<QString, QList<int>> play_statistics_index_;
+  QHash<int, qint64> play_statistics_lastplayed_;
+
+  std::atomic<quint64> songs_generation_;
+  std::atomic<quint64> statistics_generation_;
 };
 
 #endif  // COLLECTIONBACKEND_H
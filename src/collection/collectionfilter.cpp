@@ -22,12 +22,22 @@
 #include <algorithm>
 #include <functional>
 
+#include <QtConcurrentRun>
+#include <QThread>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QSet>
 #include <QList>
 #include <QString>
+#include <QStringList>
+#include <QRegularExpression>
 #include <QUrl>
+#include <QCollator>
+#include <QCollatorSortKey>
 
+#include "core/shared_ptr.h"
 #include "core/song.h"
+#include "core/database.h"
 #include "filterparser/filterparser.h"
 #include "filterparser/filtertree.h"
 #include "playlist/songmimedata.h"
@@ -37,7 +47,9 @@
 #include "collectionmodel.h"
 #include "collectionitem.h"
 
-CollectionFilter::CollectionFilter(QObject *parent) : QSortFilterProxyModel(parent), query_hash_(0) {
+using namespace Qt::StringLiterals;
+
+CollectionFilter::CollectionFilter(QObject *parent) : QSortFilterProxyModel(parent), query_hash_(0), fts_search_id_(0), fts_search_pending_(false) {
 
   setSortLocaleAware(true);
   setDynamicSortFilter(true);
@@ -67,17 +79,126 @@ bool CollectionFilter::filterAcceptsRow(const int source_row, const QModelIndex
     query_hash_ = hash;
   }
 
+  // Songs without a title are matched on their filename, which is not in the full-text index.
+  if (fts_song_ids_ && !item->metadata.title().isEmpty() && !fts_song_ids_->contains(item->metadata.id())) {
+    return false;
+  }
+
   return item->metadata.is_valid() && filter_tree_->accept(item->metadata);
 
 }
 
+bool CollectionFilter::lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const {
+
+  // Compare the cached collation keys of the items instead of collating the sort text on every comparison.
+  CollectionModel *model = qobject_cast<CollectionModel*>(sourceModel());
+  if (!model || sortRole() != CollectionModel::Role_SortText || !isSortLocaleAware() || sortCaseSensitivity() != Qt::CaseSensitive) {
+    return QSortFilterProxyModel::lessThan(source_left, source_right);
+  }
+
+  const CollectionItem *left = model->IndexToItem(source_left);
+  const CollectionItem *right = model->IndexToItem(source_right);
+  if (!left || !right) return QSortFilterProxyModel::lessThan(source_left, source_right);
+
+  return SortKey(left).compare(SortKey(right)) < 0;
+
+}
+
+const QCollatorSortKey &CollectionFilter::SortKey(const CollectionItem *item) const {
+
+  if (!item->sort_key) {
+    item->sort_key = collator_.sortKey(item->sort_text);
+  }
+
+  return *item->sort_key;
+
+}
+
 void CollectionFilter::SetFilterString(const QString &filter_string) {
 
   filter_string_ = filter_string;
+  fts_song_ids_.reset();
+  ++fts_search_id_;
+  fts_search_pending_ = false;
+
+  // Look up plain words in the full-text index on a worker thread first, so only the songs found there are matched against the filter tree.
+  CollectionModel *model = qobject_cast<CollectionModel*>(sourceModel());
+  if (model && model->backend() && !model->backend()->fts_table().isEmpty()) {
+    const QStringList words = FullTextSearchWords(filter_string_);
+    if (!words.isEmpty()) {
+      StartFullTextSearch(model->backend(), words);
+      return;
+    }
+  }
+
   setFilterFixedString(filter_string);
 
 }
 
+QStringList CollectionFilter::FullTextSearchWords(const QString &filter_string) {
+
+  static const QRegularExpression regex_plain_words(u"^[\\p{L}\\p{N}\\s]+$"_s);
+  if (!regex_plain_words.match(filter_string).hasMatch()) return QStringList();
+
+  const QStringList words = filter_string.simplified().split(u' ', Qt::SkipEmptyParts);
+  for (const QString &word : words) {
+    // The trigram index can't find shorter words, and "AND" is part of the filter syntax.
+    if (word.length() < 3 || word == "AND"_L1) return QStringList();
+  }
+
+  return words;
+
+}
+
+QSet<int> CollectionFilter::SearchFullText(SharedPtr<CollectionBackend> backend, const QStringList &words) {
+
+  const QList<int> song_ids = backend->SearchSongIds(words);
+
+  if (QThread::currentThread() != backend->thread()) {
+    backend->db()->Close();
+  }
+
+  return QSet<int>(song_ids.begin(), song_ids.end());
+
+}
+
+void CollectionFilter::StartFullTextSearch(SharedPtr<CollectionBackend> backend, const QStringList &words) {
+
+  fts_search_pending_ = true;
+
+  const int search_id = fts_search_id_;
+  QFuture<QSet<int>> future = QtConcurrent::run(&CollectionFilter::SearchFullText, backend, words);
+  QFutureWatcher<QSet<int>> *watcher = new QFutureWatcher<QSet<int>>(this);
+  QObject::connect(watcher, &QFutureWatcher<QSet<int>>::finished, this, [this, watcher, search_id]() {
+    FullTextSearchFinished(search_id, watcher->result());
+    watcher->deleteLater();
+  });
+  watcher->setFuture(future);
+
+}
+
+void CollectionFilter::FullTextSearchFinished(const int search_id, const QSet<int> &song_ids) {
+
+  // The filter string was changed again while searching.
+  if (search_id != fts_search_id_) return;
+
+  fts_search_pending_ = false;
+  fts_song_ids_ = song_ids;
+  setFilterFixedString(filter_string_);
+
+}
+
+void CollectionFilter::AddFullTextSongs(const SongList &songs) {
+
+  // Added and changed songs are not in the result of the last lookup, the filter tree decides if they match.
+  if (!fts_song_ids_) return;
+
+  for (const Song &song : songs) {
+    fts_song_ids_->insert(song.id());
+  }
+
+}
+
 QMimeData *CollectionFilter::mimeData(const QModelIndexList &indexes) const {
 
   if (indexes.isEmpty()) return nullptr;
@@ -87,21 +208,19 @@ QMimeData *CollectionFilter::mimeData(const QModelIndexList &indexes) const {
   data->backend = collection_model->backend();
 
   QSet<int> song_ids;
-  QList<QUrl> urls;
   for (const QModelIndex &idx : indexes) {
     const QModelIndex source_index = mapToSource(idx);
     CollectionItem *item = collection_model->IndexToItem(source_index);
-    GetChildSongs(item, song_ids, urls, data->songs);
+    GetChildSongIds(item, song_ids, data);
   }
 
-  data->setUrls(urls);
-  data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(data->songs);
+  data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(data->name_songs());
 
   return data;
 
 }
 
-void CollectionFilter::GetChildSongs(CollectionItem *item, QSet<int> &song_ids, QList<QUrl> &urls, SongList &songs) const {
+void CollectionFilter::GetChildSongIds(CollectionItem *item, QSet<int> &song_ids, SongMimeData *data) const {
 
   CollectionModel *collection_model = qobject_cast<CollectionModel*>(sourceModel());
 
@@ -110,17 +229,16 @@ void CollectionFilter::GetChildSongs(CollectionItem *item, QSet<int> &song_ids,
       QList<CollectionItem*> children = item->children;
       std::sort(children.begin(), children.end(), std::bind(&CollectionModel::CompareItems, collection_model, std::placeholders::_1, std::placeholders::_2));
       for (CollectionItem *child : children) {
-        GetChildSongs(child, song_ids, urls, songs);
+        GetChildSongIds(child, song_ids, data);
       }
       break;
     }
     case CollectionItem::Type::Song:{
       const QModelIndex idx = collection_model->ItemToIndex(item);
       if (filterAcceptsRow(idx.row(), idx.parent())) {
-        urls << item->metadata.url();
         if (!song_ids.contains(item->metadata.id())) {
           song_ids.insert(item->metadata.id());
-          songs << item->metadata;
+          data->AddSongId(item->metadata);
         }
       }
       break;
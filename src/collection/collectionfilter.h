@@ -22,16 +22,25 @@
 
 #include "config.h"
 
+#include <optional>
+
 #include <QSortFilterProxyModel>
+#include <QCollator>
+#include <QCollatorSortKey>
 #include <QScopedPointer>
 #include <QSet>
 #include <QList>
+#include <QString>
+#include <QStringList>
 #include <QUrl>
 
+#include "core/shared_ptr.h"
 #include "core/song.h"
 #include "filterparser/filtertree.h"
 
+class CollectionBackend;
 class CollectionItem;
+class SongMimeData;
 
 class CollectionFilter : public QSortFilterProxyModel {
   Q_OBJECT
@@ -42,17 +51,36 @@ class CollectionFilter : public QSortFilterProxyModel {
   void SetFilterString(const QString &filter_string);
   QString filter_string() const { return filter_string_; }
 
+  // True while the full-text index is searched, the filter string is applied when the search finishes.
+  bool full_text_search_pending() const { return fts_search_pending_; }
+
+  // The words of a filter string that can be looked up in the full-text index, empty if it uses any filter syntax or short words.
+  static QStringList FullTextSearchWords(const QString &filter_string);
+
+ public Q_SLOTS:
+  void AddFullTextSongs(const SongList &songs);
+
  protected:
   bool filterAcceptsRow(const int source_row, const QModelIndex &source_parent) const override;
+  bool lessThan(const QModelIndex &source_left, const QModelIndex &source_right) const override;
   QMimeData *mimeData(const QModelIndexList &indexes) const override;
 
  private:
-  void GetChildSongs(CollectionItem *item, QSet<int> &song_ids, QList<QUrl> &urls, SongList &songs) const;
+  void GetChildSongIds(CollectionItem *item, QSet<int> &song_ids, SongMimeData *data) const;
+  const QCollatorSortKey &SortKey(const CollectionItem *item) const;
+  static QSet<int> SearchFullText(SharedPtr<CollectionBackend> backend, const QStringList &words);
+  void StartFullTextSearch(SharedPtr<CollectionBackend> backend, const QStringList &words);
+  void FullTextSearchFinished(const int search_id, const QSet<int> &song_ids);
 
  private:
   mutable QScopedPointer<FilterTree> filter_tree_;
   mutable size_t query_hash_;
   QString filter_string_;
+  // Songs matching a plain text filter string according to the full-text index, only these are matched against the filter tree.
+  std::optional<QSet<int>> fts_song_ids_;
+  int fts_search_id_;
+  bool fts_search_pending_;
+  QCollator collator_;
 };
 
 #endif  // COLLECTIONFILTER_H
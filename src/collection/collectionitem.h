@@ -24,6 +24,10 @@
 
 #include "config.h"
 
+#include <optional>
+
+#include <QCollatorSortKey>
+
 #include "core/simpletreeitem.h"
 #include "core/song.h"
 
@@ -54,6 +58,9 @@ class CollectionItem : public SimpleTreeItem<CollectionItem> {
   Song metadata;
   CollectionItem *compilation_artist_node_;
 
+  // Collation key for sort_text, computed the first time the item is sorted.
+  mutable std::optional<QCollatorSortKey> sort_key;
+
  private:
   Q_DISABLE_COPY(CollectionItem)
 };
@@ -29,10 +29,11 @@
 #include <QObject>
 #include <QtGlobal>
 #include <QtConcurrentRun>
+#include <QtConcurrentMap>
 #include <QThread>
-#include <QMutex>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QCollator>
 #include <QDataStream>
 #include <QMimeData>
 #include <QIODevice>
@@ -61,6 +62,7 @@
 #include "core/logging.h"
 #include "core/sqlrow.h"
 #include "core/settings.h"
+#include "core/taskmanager.h"
 #include "collectionfilteroptions.h"
 #include "collectionquery.h"
 #include "collectionbackend.h"
@@ -83,6 +85,19 @@ const int CollectionModel::kPrettyCoverSize = 32;
 namespace {
 constexpr char kPixmapDiskCacheDir[] = "pixmapcache";
 constexpr char kVariousArtists[] = QT_TR_NOOP("Various artists");
+constexpr qint64 kParallelContainerKeysMinSongs = 1000;
+constexpr qint64 kLoadTreeChunkSize = 10000;
+
+// The keys match the ones CollectionFilter would create when sorting, so the first sort after a reload does not have to collate all the items.
+void CreateSortKeys(const QCollator &collator, CollectionItem *item) {
+
+  for (CollectionItem *child : std::as_const(item->children)) {
+    child->sort_key = collator.sortKey(child->sort_text);
+    CreateSortKeys(collator, child);
+  }
+
+}
+
 }  // namespace
 
 QNetworkDiskCache *CollectionModel::sIconCache = nullptr;
@@ -100,7 +115,8 @@ CollectionModel::CollectionModel(SharedPtr<CollectionBackend> backend, Applicati
       total_song_count_(0),
       total_artist_count_(0),
       total_album_count_(0),
-      loading_(false) {
+      loading_(false),
+      load_id_(0) {
 
   setObjectName(backend_->source() == Song::Source::Collection ? QLatin1String(metaObject()->className()) : QStringLiteral("%1%2").arg(Song::DescriptionForSource(backend_->source()), QLatin1String(metaObject()->className())));
 
@@ -132,6 +148,8 @@ CollectionModel::CollectionModel(SharedPtr<CollectionBackend> backend, Applicati
   QObject::connect(&*backend_, &CollectionBackend::TotalArtistCountUpdated, this, &CollectionModel::TotalArtistCountUpdatedSlot);
   QObject::connect(&*backend_, &CollectionBackend::TotalAlbumCountUpdated, this, &CollectionModel::TotalAlbumCountUpdatedSlot);
   QObject::connect(&*backend_, &CollectionBackend::SongsStatisticsChanged, this, &CollectionModel::AddReAddOrUpdate);
+  QObject::connect(&*backend_, &CollectionBackend::SongsAdded, filter_, &CollectionFilter::AddFullTextSongs);
+  QObject::connect(&*backend_, &CollectionBackend::SongsChanged, filter_, &CollectionFilter::AddFullTextSongs);
   QObject::connect(&*backend_, &CollectionBackend::SongsRatingChanged, this, &CollectionModel::AddReAddOrUpdate);
 
   backend_->UpdateTotalSongCountAsync();
@@ -174,11 +192,7 @@ void CollectionModel::Clear() {
     delete root_;
     root_ = nullptr;
   }
-  song_nodes_.clear();
-  container_nodes_[0].clear();
-  container_nodes_[1].clear();
-  container_nodes_[2].clear();
-  divider_nodes_.clear();
+  tree_ = Tree();
   pending_art_.clear();
   pending_cache_keys_.clear();
 
@@ -417,17 +431,15 @@ QMimeData *CollectionModel::mimeData(const QModelIndexList &indexes) const {
   if (indexes.isEmpty()) return nullptr;
 
   SongMimeData *data = new SongMimeData;
-  QList<QUrl> urls;
   QSet<int> song_ids;
 
   data->backend = backend_;
 
   for (const QModelIndex &idx : indexes) {
-    GetChildSongs(IndexToItem(idx), &urls, &data->songs, &song_ids);
+    GetChildSongIds(IndexToItem(idx), &song_ids, data);
   }
 
-  data->setUrls(urls);
-  data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(data->songs);
+  data->name_for_new_playlist_ = PlaylistManager::GetNameForNewPlaylist(data->name_songs());
 
   return data;
 
@@ -516,11 +528,11 @@ void CollectionModel::AddReAddOrUpdateSongsInternal(const SongList &songs) {
   SongList songs_updated;
 
   for (const Song &new_song : songs) {
-    if (!song_nodes_.contains(new_song.id())) {
+    if (!tree_.song_nodes.contains(new_song.id())) {
       songs_added << new_song;
       continue;
     }
-    const Song old_song = song_nodes_.value(new_song.id())->metadata;
+    const Song old_song = tree_.song_nodes.value(new_song.id())->metadata;
     bool container_key_changed = false;
     bool has_unique_album_identifier_1 = false;
     bool has_unique_album_identifier_2 = false;
@@ -534,7 +546,7 @@ void CollectionModel::AddReAddOrUpdateSongsInternal(const SongList &songs) {
           container_key_changed = true;
         }
       }
-      else if (ContainerKey(group_by, new_song, has_unique_album_identifier_1) != ContainerKey(group_by, old_song, has_unique_album_identifier_2)) {
+      else if (ContainerKey(options_active_, group_by, new_song, has_unique_album_identifier_1) != ContainerKey(options_active_, group_by, old_song, has_unique_album_identifier_2)) {
         container_key_changed = true;
       }
     }
@@ -560,43 +572,62 @@ void CollectionModel::AddSongsInternal(const SongList &songs) {
 
   if (loading_) return;
 
+  AddSongs(&tree_, root_, options_active_, songs);
+
+}
+
+void CollectionModel::AddSongs(Tree *tree, CollectionItem *root, const Options &options, const SongList &songs) {
+
+  SongList new_songs;
+  new_songs.reserve(songs.count());
   for (const Song &song : songs) {
 
     // Sanity check to make sure we don't add songs that are outside the user's filter
-    if (!options_active_.filter_options.Matches(song)) continue;
+    if (!options.filter_options.Matches(song)) continue;
+
+    if (tree->song_nodes.contains(song.id())) continue;
 
-    if (song_nodes_.contains(song.id())) continue;
+    new_songs << song;
+
+  }
+
+  // Building the container keys is the expensive part of adding songs, it only depends on the song and the options, so do it in parallel for large batches.
+  QList<QStringList> song_container_keys;
+  if (new_songs.count() >= kParallelContainerKeysMinSongs) {
+    song_container_keys = QtConcurrent::blockingMapped<QList<QStringList>>(new_songs, [&options](const Song &song) { return ContainerKeys(options, song); });
+  }
+  else {
+    song_container_keys.reserve(new_songs.count());
+    for (const Song &song : std::as_const(new_songs)) {
+      song_container_keys << ContainerKeys(options, song);
+    }
+  }
+
+  for (qint64 song_index = 0; song_index < new_songs.count(); ++song_index) {
+
+    const Song &song = new_songs[song_index];
+    const QStringList &container_keys = song_container_keys[song_index];
 
     // Before we can add each song we need to make sure the required container items already exist in the tree.
     // These depend on which "group by" settings the user has on the collection.
     // Eg. if the user grouped by artist and album, we would need to make sure nodes for the song's artist and album were already in the tree.
+    // Containers are looked up by their parent and their own key, so the keys of the parents are not rebuilt for every song.
 
-    CollectionItem *container = root_;
-    QString container_key;
-    bool has_unique_album_identifier = false;
-    for (int i = 0; i < 3; ++i) {
-      const GroupBy group_by = options_active_.group_by[i];
-      if (group_by == GroupBy::None) break;
-      if (options_active_.show_various_artists && IsArtistGroupBy(group_by) && song.is_compilation()) {
-        has_unique_album_identifier = true;
+    CollectionItem *container = root;
+    for (int i = 0; i < container_keys.count(); ++i) {
+      const GroupBy group_by = options.group_by[i];
+      if (IsCompilationArtistGroupBy(options, group_by, song)) {
         if (container->compilation_artist_node_ == nullptr) {
-          CreateCompilationArtistNode(container);
+          CreateCompilationArtistNode(tree, container);
         }
         container = container->compilation_artist_node_;
-        container_key = container->container_key;
       }
       else {
-        if (!container_key.isEmpty()) container_key.append(u'-');
-        container_key.append(ContainerKey(group_by, song, has_unique_album_identifier));
-        if (container_nodes_[i].contains(container_key)) {
-          container = container_nodes_[i][container_key];
-        }
-        else {
-          container = CreateContainerItem(group_by, i, container_key, song, container);
-        }
+        CollectionItem *child = tree->container_nodes.value(ContainerNodeKey(container, container_keys[i]));
+        container = child ? child : CreateContainerItem(tree, options, group_by, i, container_keys[i], song, container);
       }
     }
-    CreateSongItem(song, container);
+    CreateSongItem(tree, options, song, container);
   }
 
 }
@@ -608,15 +639,15 @@ void CollectionModel::UpdateSongsInternal(const SongList &songs) {
   QList<CollectionItem*> album_parents;
 
   for (const Song &new_song : songs) {
-    if (!song_nodes_.contains(new_song.id())) {
+    if (!tree_.song_nodes.contains(new_song.id())) {
       qLog(Error) << "Song does not exist in model" << new_song.id() << new_song.PrettyTitleWithArtist();
       continue;
     }
-    CollectionItem *item = song_nodes_.value(new_song.id());
+    CollectionItem *item = tree_.song_nodes.value(new_song.id());
     const Song &old_song = item->metadata;
     const bool song_title_data_changed = IsSongTitleDataChanged(old_song, new_song);
     const bool art_changed = !old_song.IsArtEqual(new_song);
-    SetSongItemData(item, new_song);
+    SetSongItemData(options_active_, item, new_song);
     if (art_changed) {
       for (CollectionItem *parent = item->parent; parent != root_; parent = parent->parent) {
         if (IsAlbumGroupBy(options_active_.group_by[parent->container_level])) {
@@ -653,14 +684,14 @@ void CollectionModel::RemoveSongsInternal(const SongList &songs) {
   QSet<CollectionItem*> parents;
   for (const Song &song : songs) {
 
-    if (song_nodes_.contains(song.id())) {
-      CollectionItem *node = song_nodes_.value(song.id());
+    if (tree_.song_nodes.contains(song.id())) {
+      CollectionItem *node = tree_.song_nodes.value(song.id());
 
       if (node->parent != root_) parents << node->parent;
 
       beginRemoveRows(ItemToIndex(node->parent), node->row, node->row);
       node->parent->Delete(node->row);
-      song_nodes_.remove(song.id());
+      tree_.song_nodes.remove(song.id());
       endRemoveRows();
 
     }
@@ -688,8 +719,8 @@ void CollectionModel::RemoveSongsInternal(const SongList &songs) {
       if (IsCompilationArtistNode(node)) {
         node->parent->compilation_artist_node_ = nullptr;
       }
-      else if (container_nodes_[node->container_level].contains(node->container_key)) {
-        container_nodes_[node->container_level].remove(node->container_key);
+      else {
+        tree_.container_nodes.remove(ContainerNodeKey(node->parent, ContainerLevelKey(node)));
       }
 
       ClearItemPixmapCache(node);
@@ -703,110 +734,114 @@ void CollectionModel::RemoveSongsInternal(const SongList &songs) {
 
   // Delete empty dividers
   for (const QString &divider_key : std::as_const(divider_keys)) {
-    if (!divider_nodes_.contains(divider_key)) continue;
+    if (!tree_.divider_nodes.contains(divider_key)) continue;
 
     // Look to see if there are any other items still under this divider
-    QList<CollectionItem*> container_nodes = container_nodes_[0].values();
-    if (std::any_of(container_nodes.begin(), container_nodes.end(), [this, divider_key](CollectionItem *node){ return DividerKey(options_active_.group_by[0], node->metadata, node->sort_text) == divider_key; })) {
+    if (std::any_of(root_->children.begin(), root_->children.end(), [this, divider_key](CollectionItem *node){ return node->type == CollectionItem::Type::Container && !IsCompilationArtistNode(node) && DividerKey(options_active_.group_by[0], node->metadata, node->sort_text) == divider_key; })) {
       continue;
     }
 
     // Remove the divider
-    const int row = divider_nodes_.value(divider_key)->row;
+    const int row = tree_.divider_nodes.value(divider_key)->row;
     beginRemoveRows(ItemToIndex(root_), row, row);
     root_->Delete(row);
     endRemoveRows();
-    divider_nodes_.remove(divider_key);
+    tree_.divider_nodes.remove(divider_key);
   }
 
 }
 
-CollectionItem *CollectionModel::CreateContainerItem(const GroupBy group_by, const int container_level, const QString &container_key, const Song &song, CollectionItem *parent) {
+CollectionItem *CollectionModel::CreateContainerItem(Tree *tree, const Options &options, const GroupBy group_by, const int container_level, const QString &container_key, const Song &song, CollectionItem *parent) {
 
   QString divider_key;
-  if (options_active_.show_dividers && container_level == 0) {
-    divider_key = DividerKey(group_by, song, SortText(group_by, container_level, song, options_active_.sort_skips_articles));
+  if (options.show_dividers && container_level == 0) {
+    divider_key = DividerKey(group_by, song, SortText(options, group_by, container_level, song));
     if (!divider_key.isEmpty()) {
-      if (!divider_nodes_.contains(divider_key)) {
-        CreateDividerItem(divider_key, DividerDisplayText(group_by, divider_key), parent);
+      if (!tree->divider_nodes.contains(divider_key)) {
+        CreateDividerItem(tree, divider_key, DividerDisplayText(group_by, divider_key), parent);
       }
     }
   }
 
-  beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
+  const bool notify = tree == &tree_;
+  if (notify) beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
 
   CollectionItem *item = new CollectionItem(CollectionItem::Type::Container, parent);
   item->container_level = container_level;
-  item->container_key = container_key;
+  item->container_key = parent->container_key.isEmpty() ? container_key : parent->container_key + QLatin1Char('-') + container_key;
   item->display_text = DisplayText(group_by, song);
-  item->sort_text = SortText(group_by, container_level, song, options_active_.sort_skips_articles);
+  item->sort_text = SortText(options, group_by, container_level, song);
   if (!divider_key.isEmpty()) {
     item->sort_text.prepend(divider_key + QLatin1Char(' '));
   }
 
-  container_nodes_[container_level].insert(item->container_key, item);
+  tree->container_nodes.insert(ContainerNodeKey(parent, container_key), item);
 
-  endInsertRows();
+  if (notify) endInsertRows();
 
   return item;
 
 }
 
-void CollectionModel::CreateDividerItem(const QString &divider_key, const QString &display_text, CollectionItem *parent) {
+void CollectionModel::CreateDividerItem(Tree *tree, const QString &divider_key, const QString &display_text, CollectionItem *parent) {
 
-  beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
+  const bool notify = tree == &tree_;
+  if (notify) beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
 
-  CollectionItem *divider = new CollectionItem(CollectionItem::Type::Divider, root_);
+  CollectionItem *divider = new CollectionItem(CollectionItem::Type::Divider, parent);
   divider->container_key = divider_key;
   divider->display_text = display_text;
   divider->sort_text = divider_key + "  "_L1;
-  divider_nodes_[divider_key] = divider;
+  tree->divider_nodes[divider_key] = divider;
 
-  endInsertRows();
+  if (notify) endInsertRows();
 
 }
 
-void CollectionModel::CreateSongItem(const Song &song, CollectionItem *parent) {
+void CollectionModel::CreateSongItem(Tree *tree, const Options &options, const Song &song, CollectionItem *parent) {
 
-  beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
+  const bool notify = tree == &tree_;
+  if (notify) beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
 
   CollectionItem *item = new CollectionItem(CollectionItem::Type::Song, parent);
-  SetSongItemData(item, song);
-  song_nodes_.insert(song.id(), item);
+  SetSongItemData(options, item, song);
+  tree->song_nodes.insert(song.id(), item);
 
-  endInsertRows();
+  if (notify) endInsertRows();
 
 }
 
-void CollectionModel::SetSongItemData(CollectionItem *item, const Song &song) {
+void CollectionModel::SetSongItemData(const Options &options, CollectionItem *item, const Song &song) {
 
   item->display_text = song.TitleWithCompilationArtist();
-  if (item->container_level == 1 && !IsAlbumGroupBy(options_active_.group_by[0])) {
+  if (item->container_level == 1 && !IsAlbumGroupBy(options.group_by[0])) {
     item->sort_text = SortText(song.title());
   }
   else {
     item->sort_text = SortTextForSong(song);
   }
+  item->sort_key.reset();
 
   item->metadata = song;
 
 }
 
-CollectionItem *CollectionModel::CreateCompilationArtistNode(CollectionItem *parent) {
+CollectionItem *CollectionModel::CreateCompilationArtistNode(Tree *tree, CollectionItem *parent) {
 
   Q_ASSERT(parent->compilation_artist_node_ == nullptr);
 
-  beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
+  const bool notify = tree == &tree_;
+  if (notify) beginInsertRows(ItemToIndex(parent), static_cast<int>(parent->children.count()), static_cast<int>(parent->children.count()));
 
   parent->compilation_artist_node_ = new CollectionItem(CollectionItem::Type::Container, parent);
   parent->compilation_artist_node_->compilation_artist_node_ = nullptr;
-  if (parent != root_ && !parent->container_key.isEmpty()) parent->compilation_artist_node_->container_key.append(parent->container_key);
+  if (!parent->container_key.isEmpty()) parent->compilation_artist_node_->container_key.append(parent->container_key);
   parent->compilation_artist_node_->container_key.append(QLatin1String(kVariousArtists));
   parent->compilation_artist_node_->display_text = QLatin1String(kVariousArtists);
   parent->compilation_artist_node_->sort_text = " various"_L1;
   parent->compilation_artist_node_->container_level = parent->container_level + 1;
 
-  endInsertRows();
+  if (notify) endInsertRows();
 
   return parent->compilation_artist_node_;
 
@@ -814,8 +849,12 @@ CollectionItem *CollectionModel::CreateCompilationArtistNode(CollectionItem *par
 
 void CollectionModel::LoadSongsFromSqlAsync() {
 
-  QFuture<SongList> future = QtConcurrent::run(&CollectionModel::LoadSongsFromSql, this, options_active_.filter_options);
-  QFutureWatcher<SongList> *watcher = new QFutureWatcher<SongList>();
+  const int load_id = ++load_id_;
+  SharedPtr<TaskManager> task_manager = app_ ? app_->task_manager() : nullptr;
+  const int task_id = task_manager ? task_manager->StartTask(tr("Loading %1").arg(Song::DescriptionForSource(backend_->source()))) : -1;
+
+  QFuture<LoadResult> future = QtConcurrent::run(&CollectionModel::LoadTree, this, load_id, task_id, task_manager, options_active_);
+  QFutureWatcher<LoadResult> *watcher = new QFutureWatcher<LoadResult>();
   QObject::connect(watcher, &QFutureWatcher<void>::finished, this, &CollectionModel::LoadSongsFromSqlAsyncFinished);
   watcher->setFuture(future);
 
@@ -826,7 +865,6 @@ SongList CollectionModel::LoadSongsFromSql(const CollectionFilterOptions &filter
   SongList songs;
 
   {
-    QMutexLocker l(backend_->db()->Mutex());
     QSqlDatabase db(backend_->db()->Connect());
     CollectionQuery q(db, backend_->songs_table(), filter_options);
     q.SetColumnSpec(QStringLiteral("%songs_table.ROWID, ") + Song::kColumnSpec);
@@ -850,15 +888,51 @@ SongList CollectionModel::LoadSongsFromSql(const CollectionFilterOptions &filter
 
 }
 
+CollectionModel::LoadResult CollectionModel::LoadTree(const int load_id, const int task_id, SharedPtr<TaskManager> task_manager, const Options &options) {
+
+  LoadResult result;
+  result.load_id = load_id;
+  result.task_id = task_id;
+  result.root = new CollectionItem(this);
+
+  const SongList songs = LoadSongsFromSql(options.filter_options);
+
+  // The tree is not part of the model yet, so it is built here without any model notifications.
+  for (qint64 i = 0; i < songs.count(); i += kLoadTreeChunkSize) {
+    AddSongs(&result.tree, result.root, options, songs.mid(i, kLoadTreeChunkSize));
+    if (task_manager) {
+      task_manager->SetTaskProgress(task_id, static_cast<quint64>(std::min(i + kLoadTreeChunkSize, static_cast<qint64>(songs.count()))), static_cast<quint64>(songs.count()));
+    }
+  }
+
+  CreateSortKeys(QCollator(), result.root);
+
+  return result;
+
+}
+
 void CollectionModel::LoadSongsFromSqlAsyncFinished() {
 
-  QFutureWatcher<SongList> *watcher = static_cast<QFutureWatcher<SongList>*>(sender());
-  const SongList songs = watcher->result();
+  QFutureWatcher<LoadResult> *watcher = static_cast<QFutureWatcher<LoadResult>*>(sender());
+  LoadResult result = watcher->result();
   watcher->deleteLater();
 
-  BeginReset();
-  ScheduleAddSongs(songs);
-  EndReset();
+  if (app_ && result.task_id != -1) {
+    app_->task_manager()->SetTaskFinished(result.task_id);
+  }
+
+  // Another reload was started while this one was loading.
+  if (result.load_id != load_id_) {
+    delete result.root;
+    return;
+  }
+
+  // Swap in the finished tree with a single reset.
+  beginResetModel();
+  Clear();
+  root_ = result.root;
+  tree_ = std::move(result.tree);
+  endResetModel();
 
   loading_ = false;
 
@@ -1101,15 +1175,15 @@ QString CollectionModel::PrettyFormat(const Song &song) {
 
 }
 
-QString CollectionModel::SortText(const GroupBy group_by, const int container_level, const Song &song, const bool sort_skips_articles) {
+QString CollectionModel::SortText(const Options &options, const GroupBy group_by, const int container_level, const Song &song) {
 
   switch (group_by) {
     case GroupBy::AlbumArtist:
-      return SortTextForArtist(song.effective_albumartist(), sort_skips_articles);
+      return SortTextForArtist(song.effective_albumartist(), options.sort_skips_articles);
     case GroupBy::Artist:
-      return SortTextForArtist(song.artist(), sort_skips_articles);
+      return SortTextForArtist(song.artist(), options.sort_skips_articles);
     case GroupBy::Album:
-      return SortTextForArtist(song.album(), sort_skips_articles);
+      return SortTextForArtist(song.album(), options.sort_skips_articles);
     case GroupBy::AlbumDisc:
       return song.album() + SortTextForNumber(std::max(0, song.disc()));
     case GroupBy::YearAlbum:
@@ -1127,13 +1201,13 @@ QString CollectionModel::SortText(const GroupBy group_by, const int container_le
     case GroupBy::OriginalYear:
       return SortTextForNumber(std::max(0, song.effective_originalyear())) + QLatin1Char(' ');
     case GroupBy::Genre:
-      return SortTextForArtist(song.genre(), sort_skips_articles);
+      return SortTextForArtist(song.genre(), options.sort_skips_articles);
     case GroupBy::Composer:
-      return SortTextForArtist(song.composer(), sort_skips_articles);
+      return SortTextForArtist(song.composer(), options.sort_skips_articles);
     case GroupBy::Performer:
-      return SortTextForArtist(song.performer(), sort_skips_articles);
+      return SortTextForArtist(song.performer(), options.sort_skips_articles);
     case GroupBy::Grouping:
-      return SortTextForArtist(song.grouping(), sort_skips_articles);
+      return SortTextForArtist(song.grouping(), options.sort_skips_articles);
     case GroupBy::FileType:
       return song.TextForFiletype();
     case GroupBy::Format:
@@ -1146,7 +1220,7 @@ QString CollectionModel::SortText(const GroupBy group_by, const int container_le
       return SortTextForNumber(std::max(0, song.bitrate())) + QLatin1Char(' ');
     case GroupBy::None:
     case GroupBy::GroupByCount:{
-      if (container_level == 1 && !IsAlbumGroupBy(options_active_.group_by[0])) {
+      if (container_level == 1 && !IsAlbumGroupBy(options.group_by[0])) {
         return SortText(song.title());
       }
       return SortTextForSong(song);
@@ -1227,7 +1301,7 @@ bool CollectionModel::IsSongTitleDataChanged(const Song &song1, const Song &song
 
 }
 
-QString CollectionModel::ContainerKey(const GroupBy group_by, const Song &song, bool &has_unique_album_identifier) const {
+QString CollectionModel::ContainerKey(const Options &options, const GroupBy group_by, const Song &song, bool &has_unique_album_identifier) {
 
   QString key;
 
@@ -1243,32 +1317,32 @@ QString CollectionModel::ContainerKey(const GroupBy group_by, const Song &song,
     case GroupBy::Album:
       key = TextOrUnknown(song.album());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (options.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::AlbumDisc:
       key = PrettyAlbumDisc(song.album(), song.disc());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (options.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::YearAlbum:
       key = PrettyYearAlbum(song.year(), song.album());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (options.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::YearAlbumDisc:
       key = PrettyYearAlbumDisc(song.year(), song.album(), song.disc());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (options.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::OriginalYearAlbum:
       key = PrettyYearAlbum(song.effective_originalyear(), song.album());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (options.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::OriginalYearAlbumDisc:
       key = PrettyYearAlbumDisc(song.effective_originalyear(), song.album(), song.disc());
       if (!song.album_id().isEmpty()) key.append(QLatin1Char('-') + song.album_id());
-      if (options_active_.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
+      if (options.separate_albums_by_grouping && !song.grouping().isEmpty()) key.append(QLatin1Char('-') + song.grouping());
       break;
     case GroupBy::Disc:
       key = PrettyDisc(song.disc());
@@ -1327,6 +1401,35 @@ QString CollectionModel::ContainerKey(const GroupBy group_by, const Song &song,
 
 }
 
+QStringList CollectionModel::ContainerKeys(const Options &options, const Song &song) {
+
+  QStringList keys;
+  bool has_unique_album_identifier = false;
+  for (int i = 0; i < 3; ++i) {
+    const GroupBy group_by = options.group_by[i];
+    if (group_by == GroupBy::None) break;
+    if (IsCompilationArtistGroupBy(options, group_by, song)) {
+      // Songs are added to the Various Artists node instead.
+      has_unique_album_identifier = true;
+      keys << QString();
+    }
+    else {
+      keys << ContainerKey(options, group_by, song, has_unique_album_identifier);
+    }
+  }
+
+  return keys;
+
+}
+
+QString CollectionModel::ContainerLevelKey(const CollectionItem *item) {
+
+  if (item->parent->container_key.isEmpty()) return item->container_key;
+
+  return item->container_key.mid(item->parent->container_key.length() + 1);
+
+}
+
 QString CollectionModel::DividerKey(const GroupBy group_by, const Song &song, const QString &sort_text) {
 
   // Items which are to be grouped under the same divider must produce the same divider key.
@@ -1431,15 +1534,7 @@ QString CollectionModel::DividerDisplayText(const GroupBy group_by, const QStrin
 
 bool CollectionModel::CompareItems(const CollectionItem *a, const CollectionItem *b) const {
 
-  QVariant left = data(a, CollectionModel::Role_SortText);
-  QVariant right = data(b, CollectionModel::Role_SortText);
-
-  if (left.metaType().id() == QMetaType::Int) {
-    return left.toInt() < right.toInt();
-  }
-  else {
-    return left.toString() < right.toString();
-  }
+  return a->sort_text < b->sort_text;
 
 }
 
@@ -1484,6 +1579,32 @@ void CollectionModel::GetChildSongs(CollectionItem *item, QList<QUrl> *urls, Son
 
 }
 
+void CollectionModel::GetChildSongIds(CollectionItem *item, QSet<int> *song_ids, SongMimeData *data) const {
+
+  switch (item->type) {
+    case CollectionItem::Type::Container: {
+      QList<CollectionItem*> children = item->children;
+      std::sort(children.begin(), children.end(), std::bind(&CollectionModel::CompareItems, this, std::placeholders::_1, std::placeholders::_2));
+
+      for (CollectionItem *child : std::as_const(children)) {
+        GetChildSongIds(child, song_ids, data);
+      }
+      break;
+    }
+
+    case CollectionItem::Type::Song:
+      if (!song_ids->contains(item->metadata.id())) {
+        data->AddSongId(item->metadata);
+        song_ids->insert(item->metadata.id());
+      }
+      break;
+
+    default:
+      break;
+  }
+
+}
+
 SongList CollectionModel::GetChildSongs(const QModelIndexList &indexes) const {
 
   QList<QUrl> dontcare;
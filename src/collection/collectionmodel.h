@@ -34,6 +34,7 @@
 #include <QSet>
 #include <QList>
 #include <QMap>
+#include <QHash>
 #include <QVariant>
 #include <QString>
 #include <QStringList>
@@ -61,6 +62,8 @@ class Application;
 class CollectionBackend;
 class CollectionDirectoryModel;
 class CollectionFilter;
+class TaskManager;
+class SongMimeData;
 
 class CollectionModel : public SimpleTreeModel<CollectionItem> {
   Q_OBJECT
@@ -166,9 +169,8 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   }
   static bool IsAlbumGroupBy(const GroupBy group_by) { return group_by == GroupBy::Album || group_by == GroupBy::YearAlbum || group_by == GroupBy::AlbumDisc || group_by == GroupBy::YearAlbumDisc || group_by == GroupBy::OriginalYearAlbum || group_by == GroupBy::OriginalYearAlbumDisc; }
 
-  QMap<QString, CollectionItem*> container_nodes(const int i) { return container_nodes_[i]; }
-  QList<CollectionItem*> song_nodes() const { return song_nodes_.values(); }
-  int divider_nodes_count() const { return divider_nodes_.count(); }
+  QList<CollectionItem*> song_nodes() const { return tree_.song_nodes.values(); }
+  int divider_nodes_count() const { return tree_.divider_nodes.count(); }
 
   // QAbstractItemModel
   QVariant data(const QModelIndex &idx, const int role = Qt::DisplayRole) const override;
@@ -184,7 +186,7 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   static QString PrettyYearAlbumDisc(const int year, const QString &album, const int disc);
   static QString PrettyDisc(const int disc);
   static QString PrettyFormat(const Song &song);
-  QString SortText(const GroupBy group_by, const int container_level, const Song &song, const bool sort_skips_articles);
+  static QString SortText(const Options &options, const GroupBy group_by, const int container_level, const Song &song);
   static QString SortText(QString text);
   static QString SortTextForNumber(const int number);
   static QString SortTextForArtist(QString artist, const bool skip_articles);
@@ -192,12 +194,15 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   static QString SortTextForYear(const int year);
   static QString SortTextForBitrate(const int bitrate);
   static bool IsSongTitleDataChanged(const Song &song1, const Song &song2);
-  QString ContainerKey(const GroupBy group_by, const Song &song, bool &has_unique_album_identifier) const;
+  static QString ContainerKey(const Options &options, const GroupBy group_by, const Song &song, bool &has_unique_album_identifier);
+  // The container keys for each grouping level of the song, empty for levels where the song goes under Various Artists.
+  static QStringList ContainerKeys(const Options &options, const Song &song);
 
   // Get information about the collection
   void GetChildSongs(CollectionItem *item, QList<QUrl> *urls, SongList *songs, QSet<int> *song_ids) const;
   SongList GetChildSongs(const QModelIndex &idx) const;
   SongList GetChildSongs(const QModelIndexList &indexes) const;
+  void GetChildSongIds(CollectionItem *item, QSet<int> *song_ids, SongMimeData *data) const;
 
   bool CompareItems(const CollectionItem *a, const CollectionItem *b) const;
 
@@ -217,6 +222,27 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   void RemoveSongs(const SongList &songs);
 
  private:
+  // Keyed on the parent and whatever the key is for that level - artist, album, year, etc.
+  using ContainerNodeKey = QPair<CollectionItem*, QString>;
+
+  // Lookups for the items of a tree.
+  // The model's own tree is tree_, reloading builds a detached tree on a worker thread which then replaces it.
+  struct Tree {
+    // Keyed on database ID
+    QMap<int, CollectionItem*> song_nodes;
+    QHash<ContainerNodeKey, CollectionItem*> container_nodes;
+    // Keyed on a letter, a year, a century, etc.
+    QMap<QString, CollectionItem*> divider_nodes;
+  };
+
+  struct LoadResult {
+    LoadResult() : load_id(0), task_id(-1), root(nullptr) {}
+    int load_id;
+    int task_id;
+    CollectionItem *root;
+    Tree tree;
+  };
+
   void Clear();
   void BeginReset();
   void EndReset();
@@ -233,20 +259,25 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   void UpdateSongsInternal(const SongList &songs);
   void RemoveSongsInternal(const SongList &songs);
 
-  void CreateDividerItem(const QString &divider_key, const QString &display_text, CollectionItem *parent);
-  CollectionItem *CreateContainerItem(const GroupBy group_by, const int container_level, const QString &container_key, const Song &song, CollectionItem *parent);
-  void CreateSongItem(const Song &song, CollectionItem *parent);
-  void SetSongItemData(CollectionItem *item, const Song &song);
-  CollectionItem *CreateCompilationArtistNode(CollectionItem *parent);
+  // Items are only inserted with model notifications when building tree_, a detached tree is not visible to views yet.
+  void AddSongs(Tree *tree, CollectionItem *root, const Options &options, const SongList &songs);
+  void CreateDividerItem(Tree *tree, const QString &divider_key, const QString &display_text, CollectionItem *parent);
+  CollectionItem *CreateContainerItem(Tree *tree, const Options &options, const GroupBy group_by, const int container_level, const QString &container_key, const Song &song, CollectionItem *parent);
+  void CreateSongItem(Tree *tree, const Options &options, const Song &song, CollectionItem *parent);
+  static void SetSongItemData(const Options &options, CollectionItem *item, const Song &song);
+  CollectionItem *CreateCompilationArtistNode(Tree *tree, CollectionItem *parent);
 
   void LoadSongsFromSqlAsync();
   SongList LoadSongsFromSql(const CollectionFilterOptions &filter_options = CollectionFilterOptions());
+  LoadResult LoadTree(const int load_id, const int task_id, SharedPtr<TaskManager> task_manager, const Options &options);
 
   static QString DividerKey(const GroupBy group_by, const Song &song, const QString &sort_text);
   static QString DividerDisplayText(const GroupBy group_by, const QString &key);
 
   // Helpers
   static bool IsCompilationArtistNode(const CollectionItem *node) { return node == node->parent->compilation_artist_node_; }
+  static bool IsCompilationArtistGroupBy(const Options &options, const GroupBy group_by, const Song &song) { return options.show_various_artists && IsArtistGroupBy(group_by) && song.is_compilation(); }
+  static QString ContainerLevelKey(const CollectionItem *item);
   QString AlbumIconPixmapCacheKey(const QModelIndex &idx) const;
   static QUrl AlbumIconPixmapDiskCacheKey(const QString &cache_key);
   QVariant AlbumIcon(const QModelIndex &idx);
@@ -293,17 +324,12 @@ class CollectionModel : public SimpleTreeModel<CollectionItem> {
   int total_album_count_;
 
   bool loading_;
+  // Incremented for every reload, so the result of a load that was superseded is discarded.
+  int load_id_;
 
   QQueue<CollectionModelUpdate> updates_;
 
-  // Keyed on database ID
-  QMap<int, CollectionItem*> song_nodes_;
-
-  // Keyed on whatever the key is for that level - artist, album, year, etc.
-  QMap<QString, CollectionItem*> container_nodes_[3];
-
-  // Keyed on a letter, a year, a century, etc.
-  QMap<QString, CollectionItem*> divider_nodes_;
+  Tree tree_;
 
   using ItemAndCacheKey = QPair<CollectionItem*, QString>;
   QMap<quint64, ItemAndCacheKey> pending_art_;
@@ -52,6 +52,7 @@
 #include "core/iconloader.h"
 #include "core/mimedata.h"
 #include "core/musicstorage.h"
+#include "core/songprojection.h"
 #include "core/deletefiles.h"
 #include "core/settings.h"
 #include "utilities/filemanagerutils.h"
@@ -499,7 +500,7 @@ void CollectionView::SetShowInVarious(const bool on) {
   if (on && albums.keys().count() == 1) {
     const QStringList albums_list = albums.keys();
     const QString album = albums_list.first();
-    const SongList all_of_album = app_->collection_backend()->GetSongsByAlbum(album);
+    const SongList all_of_album = app_->collection_backend()->GetSongsByAlbum(album, SongProjection(QStringList() << QStringLiteral("artist")));
     QSet<QString> other_artists;
     for (const Song &s : all_of_album) {
       if (!albums.contains(album, s.artist()) && !other_artists.contains(s.artist())) {
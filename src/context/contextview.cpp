@@ -61,6 +61,9 @@
 #include "collection/collectionquery.h"
 #include "collection/collectionview.h"
 #include "covermanager/albumcoverchoicecontroller.h"
+#include "playlist/playlist.h"
+#include "playlist/playlistitem.h"
+#include "playlist/playlistmanager.h"
 #include "lyrics/lyricsfetcher.h"
 #include "settings/contextsettingspage.h"
 
@@ -71,6 +74,7 @@ using namespace Qt::StringLiterals;
 
 namespace {
 constexpr int kWidgetSpacing = 50;
+constexpr int kPrefetchLyricsSongs = 3;
 }
 
 ContextView::ContextView(QWidget *parent)
@@ -250,7 +254,7 @@ void ContextView::Init(Application *app, CollectionView *collectionview, AlbumCo
   album_cover_choice_controller_ = album_cover_choice_controller;
 
   widget_album_->Init(this, album_cover_choice_controller_);
-  lyrics_fetcher_ = new LyricsFetcher(app_->lyrics_providers(), this);
+  lyrics_fetcher_ = new LyricsFetcher(app_->lyrics_providers(), app_->lyrics_cache(), this);
 
   QObject::connect(collectionview_, &CollectionView::TotalSongCountUpdated_, this, &ContextView::UpdateNoSong);
   QObject::connect(collectionview_, &CollectionView::TotalArtistCountUpdated_, this, &ContextView::UpdateNoSong);
@@ -370,6 +374,7 @@ void ContextView::SongChanged(const Song &song) {
   }
 
   SearchLyrics();
+  PrefetchLyrics();
 
 }
 
@@ -383,6 +388,27 @@ void ContextView::SearchLyrics() {
 
 }
 
+void ContextView::PrefetchLyrics() {
+
+  if (!action_show_lyrics_->isChecked() || !action_search_lyrics_->isChecked()) return;
+
+  Playlist *playlist = app_->playlist_manager()->active();
+  if (!playlist) return;
+
+  SongList songs;
+  const QList<int> rows = playlist->upcoming_rows(kPrefetchLyricsSongs);
+  for (const int row : rows) {
+    if (!playlist->has_item_at(row)) continue;
+    const Song song = playlist->item_at(row)->Metadata();
+    if (song.lyrics().isEmpty() && !song.artist().isEmpty() && !song.title().isEmpty()) {
+      songs << song;
+    }
+  }
+
+  lyrics_fetcher_->Prefetch(songs);
+
+}
+
 void ContextView::FadeStopFinished() {
 
   widget_stacked_->setCurrentWidget(widget_stop_);
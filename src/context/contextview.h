@@ -78,6 +78,7 @@ class ContextView : public QWidget {
   void ResetSong();
   void GetCoverAutomatically();
   void SearchLyrics();
+  void PrefetchLyrics();
   void UpdateFonts();
 
  Q_SIGNALS:
@@ -30,12 +30,15 @@
 
 #include <QObject>
 #include <QThread>
+#include <QList>
 #include <QString>
+#include <QTimer>
 
 #include "core/logging.h"
 
 #include "shared_ptr.h"
 #include "lazy.h"
+#include "startupprofiler.h"
 #include "tagreaderclient.h"
 #include "database.h"
 #include "taskmanager.h"
@@ -70,6 +73,7 @@
 #include "lyrics/elyricsnetlyricsprovider.h"
 #include "lyrics/letraslyricsprovider.h"
 #include "lyrics/lyricfindlyricsprovider.h"
+#include "lyrics/lyricscache.h"
 
 #include "scrobbler/audioscrobbler.h"
 #include "scrobbler/lastfmscrobbler.h"
@@ -130,7 +134,11 @@ class ApplicationImpl {
         task_manager_([]() { return new TaskManager(); }),
         player_([app]() { return new Player(app); }),
         network_([]() { return new NetworkAccessManager(); }),
-        device_finders_([]() { return new DeviceFinders(); }),
+        device_finders_([]() {
+          DeviceFinders *device_finders = new DeviceFinders();
+          device_finders->Init();
+          return device_finders;
+        }),
 #ifndef Q_OS_WIN
         device_manager_([app]() { return new DeviceManager(app); }),
 #endif
@@ -184,6 +192,7 @@ class ApplicationImpl {
           lyrics_providers->ReloadSettings();
           return lyrics_providers;
         }),
+        lyrics_cache_([app]() { return new LyricsCache(app->database()); }, "LyricsCache"),
         streaming_services_([app]() {
           StreamingServices *streaming_services = new StreamingServices();
 #ifdef HAVE_SUBSONIC
@@ -203,9 +212,9 @@ class ApplicationImpl {
         radio_services_([app]() { return new RadioServices(app); }),
         scrobbler_([app]() {
           AudioScrobbler *scrobbler = new AudioScrobbler(app);
-          scrobbler->AddService(make_shared<LastFMScrobbler>(scrobbler->settings(), app->network()));
-          scrobbler->AddService(make_shared<LibreFMScrobbler>(scrobbler->settings(), app->network()));
-          scrobbler->AddService(make_shared<ListenBrainzScrobbler>(scrobbler->settings(), app->network()));
+          scrobbler->AddService(make_shared<LastFMScrobbler>(scrobbler->settings(), app->network(), app->database()));
+          scrobbler->AddService(make_shared<LibreFMScrobbler>(scrobbler->settings(), app->network(), app->database()));
+          scrobbler->AddService(make_shared<ListenBrainzScrobbler>(scrobbler->settings(), app->network(), app->database()));
 #ifdef HAVE_SUBSONIC
           scrobbler->AddService(make_shared<SubsonicScrobbler>(scrobbler->settings(), app));
 #endif
@@ -215,7 +224,8 @@ class ApplicationImpl {
         moodbar_loader_([app]() { return new MoodbarLoader(app); }),
         moodbar_controller_([app]() { return new MoodbarController(app); }),
 #endif
-        lastfm_import_([app]() { return new LastFMImport(app->network()); })
+        lastfm_import_([app]() { return new LastFMImport(app->network()); }),
+        deferred_init_started_(false)
   {}
 
   Lazy<TagReaderClient> tag_reader_client_;
@@ -234,6 +244,7 @@ class ApplicationImpl {
   Lazy<AlbumCoverLoader> album_cover_loader_;
   Lazy<CurrentAlbumCoverLoader> current_albumcover_loader_;
   Lazy<LyricsProviders> lyrics_providers_;
+  Lazy<LyricsCache> lyrics_cache_;
   Lazy<StreamingServices> streaming_services_;
   Lazy<RadioServices> radio_services_;
   Lazy<AudioScrobbler> scrobbler_;
@@ -243,6 +254,9 @@ class ApplicationImpl {
 #endif
   Lazy<LastFMImport> lastfm_import_;
 
+  bool deferred_init_started_;
+  QList<std::function<void()>> deferred_init_;
+
 };
 
 Application::Application(QObject *parent)
@@ -250,7 +264,6 @@ Application::Application(QObject *parent)
 
   setObjectName(QLatin1String(metaObject()->className()));
 
-  device_finders()->Init();
   collection()->Init();
   tag_reader_client();
 
@@ -347,6 +360,41 @@ void Application::ExitReceived() {
 
 }
 
+void Application::StartDeferredInit() {
+
+  if (p_->deferred_init_started_) return;
+  p_->deferred_init_started_ = true;
+
+  StartupProfiler::Mark("Deferred initialization");
+
+  // Components that are not needed to show the main window, most of them are only used once something is playing.
+  p_->deferred_init_ << [this]() { device_finders(); }
+                     << [this]() { album_cover_loader(); }
+                     << [this]() { cover_providers(); }
+                     << [this]() { lyrics_providers(); }
+#ifdef HAVE_MOODBAR
+                     << [this]() { moodbar_loader(); }
+#endif
+                     << [this]() { lyrics_cache(); };
+
+  QTimer::singleShot(0, this, &Application::DeferredInitNext);
+
+}
+
+void Application::DeferredInitNext() {
+
+  if (p_->deferred_init_.isEmpty()) {
+    StartupProfiler::Finish();
+    return;
+  }
+
+  // One component per event loop iteration, so the window keeps responding in between.
+  p_->deferred_init_.takeFirst()();
+
+  QTimer::singleShot(0, this, &Application::DeferredInitNext);
+
+}
+
 void Application::AddError(const QString &message) { Q_EMIT ErrorAdded(message); }
 void Application::ReloadSettings() { Q_EMIT SettingsChanged(); }
 void Application::OpenSettingsDialogAtPage(SettingsDialog::Page page) { Q_EMIT SettingsDialogRequested(page); }
@@ -367,6 +415,7 @@ SharedPtr<AlbumCoverLoader> Application::album_cover_loader() const { return p_-
 SharedPtr<CoverProviders> Application::cover_providers() const { return p_->cover_providers_.ptr(); }
 SharedPtr<CurrentAlbumCoverLoader> Application::current_albumcover_loader() const { return p_->current_albumcover_loader_.ptr(); }
 SharedPtr<LyricsProviders> Application::lyrics_providers() const { return p_->lyrics_providers_.ptr(); }
+SharedPtr<LyricsCache> Application::lyrics_cache() const { return p_->lyrics_cache_.ptr(); }
 SharedPtr<PlaylistBackend> Application::playlist_backend() const { return p_->playlist_backend_.ptr(); }
 SharedPtr<PlaylistManager> Application::playlist_manager() const { return p_->playlist_manager_.ptr(); }
 SharedPtr<StreamingServices> Application::streaming_services() const { return p_->streaming_services_.ptr(); }
@@ -56,6 +56,7 @@ class AlbumCoverLoader;
 class CurrentAlbumCoverLoader;
 class CoverProviders;
 class LyricsProviders;
+class LyricsCache;
 class AudioScrobbler;
 class LastFMImport;
 class StreamingServices;
@@ -94,6 +95,7 @@ class Application : public QObject {
   SharedPtr<CurrentAlbumCoverLoader> current_albumcover_loader() const;
 
   SharedPtr<LyricsProviders> lyrics_providers() const;
+  SharedPtr<LyricsCache> lyrics_cache() const;
 
   SharedPtr<AudioScrobbler> scrobbler() const;
 
@@ -112,8 +114,12 @@ class Application : public QObject {
   QThread *MoveToNewThread(QObject *object);
   static void MoveToThread(QObject *object, QThread *thread);
 
+  // Initializes the components that are not needed to show the main window, called once the main window has been painted.
+  void StartDeferredInit();
+
  private Q_SLOTS:
   void ExitReceived();
+  void DeferredInitNext();
 
  public Q_SLOTS:
   void AddError(const QString &message);
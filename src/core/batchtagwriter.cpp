@@ -0,0 +1,141 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <algorithm>
+
+#include <QObject>
+#include <QThread>
+#include <QList>
+#include <QString>
+
+#include "core/logging.h"
+#include "utilities/timeconstants.h"
+#include "tagreaderclient.h"
+#include "batchtagwriter.h"
+
+namespace {
+constexpr int kRequestsPerWorker = 4;
+constexpr int kMaxWorkers = 4;
+constexpr qint64 kProgressIntervalMsec = 250;
+}  // namespace
+
+BatchTagWriter::BatchTagWriter(QObject *parent)
+    : QObject(parent),
+      max_in_flight_(0),
+      window_(kRequestsPerWorker),
+      next_(0),
+      in_flight_(0),
+      finished_(0),
+      running_(false),
+      cancelled_(false),
+      last_progress_msec_(0) {}
+
+void BatchTagWriter::Start(const QList<Request> &requests) {
+
+  Q_ASSERT(!running_);
+
+  requests_ = requests;
+  next_ = 0;
+  in_flight_ = 0;
+  finished_ = 0;
+  running_ = true;
+  cancelled_ = false;
+  last_progress_msec_ = 0;
+  timer_.start();
+
+  if (requests_.isEmpty()) {
+    running_ = false;
+    Q_EMIT Finished(false);
+    return;
+  }
+
+  if (max_in_flight_ > 0) {
+    window_ = max_in_flight_;
+  }
+  else {
+    // Writes to different files go to different tag reader workers, so start more of them for the batch.
+    const int worker_count = std::max(TagReaderClient::Instance()->worker_count(), std::clamp(QThread::idealThreadCount() / 2, 1, kMaxWorkers));
+    TagReaderClient::Instance()->RaiseWorkerCount(worker_count);
+    window_ = worker_count * kRequestsPerWorker;
+  }
+
+  SendRequests();
+
+}
+
+void BatchTagWriter::Cancel() {
+
+  if (!running_ || cancelled_) return;
+
+  qLog(Debug) << "Cancelling tag writes," << requests_.count() - next_ << "of" << requests_.count() << "files not sent";
+  cancelled_ = true;
+
+  if (in_flight_ == 0) {
+    running_ = false;
+    Q_EMIT Finished(true);
+  }
+
+}
+
+void BatchTagWriter::SendRequests() {
+
+  while (!cancelled_ && in_flight_ < window_ && next_ < requests_.count()) {
+    const int index = next_++;
+    const Request &request = requests_.at(index);
+    TagReaderReply *reply = write_function_ ? write_function_(request) : TagReaderClient::Instance()->WriteFile(request.song.url().toLocalFile(), request.song, request.save_types, request.save_cover_options);
+    QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, index]() { ReplyFinished(reply, index); }, Qt::QueuedConnection);
+    ++in_flight_;
+  }
+
+}
+
+void BatchTagWriter::ReplyFinished(TagReaderReply *reply, const int index) {
+
+  --in_flight_;
+  ++finished_;
+
+  const bool success = reply->message().write_file_response().success();
+  QString error;
+  if (!success && reply->message().write_file_response().has_error()) {
+    error = QString::fromStdString(reply->message().write_file_response().error());
+  }
+  reply->deleteLater();
+
+  Q_EMIT RequestFinished(index, success, error);
+
+  const bool done = in_flight_ == 0 && (cancelled_ || next_ >= requests_.count());
+  const qint64 elapsed_msec = timer_.elapsed();
+  if (done || elapsed_msec - last_progress_msec_ >= kProgressIntervalMsec) {
+    last_progress_msec_ = elapsed_msec;
+    Q_EMIT Progress(finished_, static_cast<int>(requests_.count()), elapsed_msec > 0 ? static_cast<double>(finished_) * kMsecPerSec / static_cast<double>(elapsed_msec) : 0.0);
+  }
+
+  if (done) {
+    qLog(Debug) << "Wrote tags of" << finished_ << "files in" << elapsed_msec << "ms";
+    running_ = false;
+    requests_.clear();
+    Q_EMIT Finished(cancelled_);
+    return;
+  }
+
+  SendRequests();
+
+}
@@ -0,0 +1,92 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BATCHTAGWRITER_H
+#define BATCHTAGWRITER_H
+
+#include "config.h"
+
+#include <functional>
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QElapsedTimer>
+
+#include "song.h"
+#include "tagreaderclient.h"
+
+// Writes the tags of many songs through the tag reader workers, starting more workers for the batch when needed.
+// A few requests per worker are kept in flight, so all workers are busy without queueing every file at once,
+// and the remaining requests can be cancelled.
+
+class BatchTagWriter : public QObject {
+  Q_OBJECT
+
+ public:
+  explicit BatchTagWriter(QObject *parent = nullptr);
+
+  struct Request {
+    explicit Request(const Song &_song = Song(), const TagReaderClient::SaveTypes _save_types = TagReaderClient::SaveType::Tags, const TagReaderClient::SaveCoverOptions &_save_cover_options = TagReaderClient::SaveCoverOptions())
+        : song(_song), save_types(_save_types), save_cover_options(_save_cover_options) {}
+    Song song;
+    TagReaderClient::SaveTypes save_types;
+    TagReaderClient::SaveCoverOptions save_cover_options;
+  };
+
+  // Sends one request and returns its reply, writing the file through the tag reader unless replaced.
+  using WriteFunction = std::function<TagReaderReply*(const Request &request)>;
+  void SetWriteFunction(const WriteFunction &write_function) { write_function_ = write_function; }
+
+  // Limits the number of requests sent at the same time, by default a few per tag reader worker.
+  // When set, the number of tag reader workers is not changed.
+  void SetMaxInFlight(const int max_in_flight) { max_in_flight_ = max_in_flight; }
+
+  void Start(const QList<Request> &requests);
+
+  // Sends no more requests, Finished() is emitted when the requests already sent are done.
+  void Cancel();
+
+  bool is_running() const { return running_; }
+  bool is_cancelled() const { return cancelled_; }
+
+ Q_SIGNALS:
+  void RequestFinished(const int index, const bool success, const QString &error);
+  void Progress(const int finished, const int count, const double files_per_second);
+  void Finished(const bool cancelled);
+
+ private:
+  void SendRequests();
+  void ReplyFinished(TagReaderReply *reply, const int index);
+
+ private:
+  WriteFunction write_function_;
+  QList<Request> requests_;
+  int max_in_flight_;
+  int window_;
+  int next_;
+  int in_flight_;
+  int finished_;
+  bool running_;
+  bool cancelled_;
+  QElapsedTimer timer_;
+  qint64 last_progress_msec_;
+};
+
+#endif  // BATCHTAGWRITER_H
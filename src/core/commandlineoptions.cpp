@@ -83,7 +83,8 @@ constexpr char kHelpText[] =
     "      --quiet                %31\n"
     "      --verbose              %32\n"
     "      --log-levels <levels>  %33\n"
-    "      --version              %34\n";
+    "      --version              %34\n"
+    "      --startup-trace <file> %35\n";
 
 constexpr char kVersionText[] = "Strawberry %1";
 
@@ -169,6 +170,7 @@ bool CommandlineOptions::Parse() {
       {L"verbose", no_argument, nullptr, LongOptions::Verbose},
       {L"log-levels", required_argument, nullptr, LongOptions::LogLevels},
       {L"version", no_argument, nullptr, LongOptions::Version},
+      {L"startup-trace", required_argument, nullptr, LongOptions::StartupTrace},
       {nullptr, 0, nullptr, 0}
 #else
     { "help", no_argument, nullptr, 'h' },
@@ -200,6 +202,7 @@ bool CommandlineOptions::Parse() {
     { "verbose", no_argument, nullptr, LongOptions::Verbose },
     { "log-levels", required_argument, nullptr, LongOptions::LogLevels },
     { "version", no_argument, nullptr, LongOptions::Version },
+    { "startup-trace", required_argument, nullptr, LongOptions::StartupTrace },
     { nullptr, 0, nullptr, 0 }
 #endif
 };
@@ -249,7 +252,8 @@ bool CommandlineOptions::Parse() {
                      QObject::tr("Equivalent to --log-levels *:1"),
                      QObject::tr("Equivalent to --log-levels *:3"),
                      QObject::tr("Comma separated list of class:level, level is 0-3"))
-                .arg(QObject::tr("Print out version information"));
+                .arg(QObject::tr("Print out version information"),
+                     QObject::tr("Write a trace of the startup to <file>, for chrome://tracing"));
 
         std::cout << translated_help_text.toLocal8Bit().constData();
         return false;
@@ -314,6 +318,9 @@ bool CommandlineOptions::Parse() {
       case LongOptions::LogLevels:
         log_levels_ = OptArgToString(optarg);
         break;
+      case LongOptions::StartupTrace:
+        startup_trace_ = OptArgToString(optarg);
+        break;
       case LongOptions::Version:{
         QString version_text = QString::fromUtf8(kVersionText).arg(QLatin1String(STRAWBERRY_VERSION_DISPLAY));
         std::cout << version_text.toLocal8Bit().constData() << std::endl;
@@ -82,6 +82,7 @@ class CommandlineOptions {
   QString log_levels() const { return log_levels_; }
   QString playlist_name() const { return playlist_name_; }
   QString window_size() const { return window_size_; }
+  QString startup_trace() const { return startup_trace_; }
 
   QByteArray Serialize() const;
   void Load(const QByteArray &serialized);
@@ -99,7 +100,8 @@ class CommandlineOptions {
     Version,
     VolumeIncreaseBy,
     VolumeDecreaseBy,
-    RestartOrPrevious
+    RestartOrPrevious,
+    StartupTrace
   };
 
   void RemoveArg(const QString &starts_with, int count);
@@ -136,6 +138,9 @@ class CommandlineOptions {
   QString playlist_name_;
   QString window_size_;
 
+  // Only used by this instance, so not serialised.
+  QString startup_trace_;
+
   QList<QUrl> urls_;
 };
 
@@ -41,8 +41,10 @@
 #include <QSqlError>
 #include <QStandardPaths>
 #include <QScopeGuard>
+#include <QElapsedTimer>
 
 #include "core/logging.h"
+#include "utilities/timeconstants.h"
 #include "taskmanager.h"
 #include "database.h"
 #include "application.h"
@@ -51,12 +53,13 @@
 
 using namespace Qt::StringLiterals;
 
-const int Database::kSchemaVersion = 20;
+const int Database::kSchemaVersion = 25;
 
 namespace {
 constexpr char kDatabaseFilename[] = "strawberry.db";
 constexpr int kMinSupportedSchemaVersion = 10;
 constexpr char kMagicAllSongsTables[] = "%allsongstables";
+constexpr qint64 kSlowLockWaitMsec = 100;
 }  // namespace
 
 int Database::sNextConnectionId = 1;
@@ -67,6 +70,10 @@ Database::Database(Application *app, QObject *parent, const QString &database_na
       app_(app),
       injected_database_name_(database_name),
       query_hash_(0),
+      lock_count_(0),
+      lock_contended_count_(0),
+      lock_wait_nsec_total_(0),
+      lock_wait_nsec_max_(0),
       startup_schema_version_(-1),
       original_thread_(nullptr) {
 
@@ -104,6 +111,10 @@ void Database::ExitAsync() {
 void Database::Exit() {
 
   Q_ASSERT(QThread::currentThread() == thread());
+
+  const LockStatistics statistics = lock_statistics();
+  qLog(Debug) << "Database write lock taken" << statistics.locks << "times," << statistics.contended << "contended, waited" << statistics.wait_nsec_total / kNsecPerMsec << "ms in total and" << statistics.wait_nsec_max / kNsecPerMsec << "ms at most";
+
   Close();
   moveToThread(original_thread_);
   Q_EMIT ExitFinished();
@@ -149,6 +160,19 @@ QSqlDatabase Database::Connect() {
     return db;
   }
 
+  // Let readers on other connections run while a write transaction is open.
+  {
+    SqlQuery q(db);
+    q.prepare(QStringLiteral("PRAGMA journal_mode = WAL"));
+    if (!q.Exec()) {
+      ReportErrors(q);
+    }
+    q.prepare(QStringLiteral("PRAGMA synchronous = NORMAL"));
+    if (!q.Exec()) {
+      ReportErrors(q);
+    }
+  }
+
   if (db.tables().count() == 0) {
     // Set up initial schema
     qLog(Info) << "Creating initial database schema";
@@ -199,6 +223,58 @@ QSqlDatabase Database::Connect() {
 
 }
 
+Database::WriteLocker::WriteLocker(Database *db) : db_(db) {
+
+  db_->LockWrite();
+
+}
+
+Database::WriteLocker::~WriteLocker() {
+
+  db_->UnlockWrite();
+
+}
+
+void Database::LockWrite() {
+
+  ++lock_count_;
+
+  if (mutex_.tryLock()) return;
+
+  QElapsedTimer timer;
+  timer.start();
+  mutex_.lock();
+  const qint64 wait_nsec = timer.nsecsElapsed();
+
+  ++lock_contended_count_;
+  lock_wait_nsec_total_ += wait_nsec;
+  qint64 wait_nsec_max = lock_wait_nsec_max_;
+  while (wait_nsec > wait_nsec_max && !lock_wait_nsec_max_.compare_exchange_weak(wait_nsec_max, wait_nsec)) {}
+
+  if (wait_nsec / kNsecPerMsec >= kSlowLockWaitMsec) {
+    qLog(Debug) << "Waited" << wait_nsec / kNsecPerMsec << "ms for the database write lock";
+  }
+
+}
+
+void Database::UnlockWrite() {
+
+  mutex_.unlock();
+
+}
+
+Database::LockStatistics Database::lock_statistics() const {
+
+  LockStatistics statistics;
+  statistics.locks = lock_count_;
+  statistics.contended = lock_contended_count_;
+  statistics.wait_nsec_total = lock_wait_nsec_total_;
+  statistics.wait_nsec_max = lock_wait_nsec_max_;
+
+  return statistics;
+
+}
+
 void Database::Close() {
 
   QMutexLocker l(&connect_mutex_);
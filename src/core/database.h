@@ -26,6 +26,8 @@
 
 #include <sqlite3.h>
 
+#include <atomic>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QMutex>
@@ -36,6 +38,7 @@
 #include <QStringList>
 #include <QRecursiveMutex>
 
+#include "shared_ptr.h"
 #include "sqlquery.h"
 
 class QThread;
@@ -50,6 +53,27 @@ class Database : public QObject {
 
   static const int kSchemaVersion;
 
+  // The database is in WAL mode, so reads on the calling thread's own connection run in parallel and don't need a lock.
+  // Anything that writes has to hold a WriteLocker, which serializes the writers and keeps track of how long they wait.
+  class WriteLocker {
+   public:
+    explicit WriteLocker(Database *db);
+    explicit WriteLocker(const SharedPtr<Database> &db) : WriteLocker(&*db) {}
+    ~WriteLocker();
+
+   private:
+    Q_DISABLE_COPY(WriteLocker)
+    Database *db_;
+  };
+
+  struct LockStatistics {
+    LockStatistics() : locks(0), contended(0), wait_nsec_total(0), wait_nsec_max(0) {}
+    quint64 locks;
+    quint64 contended;
+    qint64 wait_nsec_total;
+    qint64 wait_nsec_max;
+  };
+
   struct AttachedDatabase {
     AttachedDatabase() {}
     AttachedDatabase(const QString &filename, const QString &schema, bool is_temporary)
@@ -65,7 +89,7 @@ class Database : public QObject {
   void Close();
   void ReportErrors(const SqlQuery &query);
 
-  QRecursiveMutex *Mutex() { return &mutex_; }
+  LockStatistics lock_statistics() const;
 
   void RecreateAttachedDb(const QString &database_name);
   void ExecSchemaCommands(QSqlDatabase &db, const QString &schema, int schema_version, bool in_transaction = false);
@@ -98,6 +122,8 @@ class Database : public QObject {
   void UpdateDatabaseSchema(int version, QSqlDatabase &db);
   void UrlEncodeFilenameColumn(const QString &table, QSqlDatabase &db);
   QStringList SongsTables(QSqlDatabase &db, const int schema_version);
+  void LockWrite();
+  void UnlockWrite();
   bool IntegrityCheck(const QSqlDatabase &db);
   void BackupFile(const QString &filename);
   static bool OpenDatabase(const QString &filename, sqlite3 **connection);
@@ -111,6 +137,11 @@ class Database : public QObject {
   QMutex connect_mutex_;
   QRecursiveMutex mutex_;
 
+  std::atomic<quint64> lock_count_;
+  std::atomic<quint64> lock_contended_count_;
+  std::atomic<qint64> lock_wait_nsec_total_;
+  std::atomic<qint64> lock_wait_nsec_max_;
+
   // This ID makes the QSqlDatabase name unique to the object as well as the thread
   int connection_id_;
 
@@ -21,21 +21,25 @@
 #include <functional>
 #include <type_traits>
 
+#include <QObject>
+
 #include "core/logging.h"
 
 #include "shared_ptr.h"
+#include "startupprofiler.h"
 
 // Helper for lazy initialization of objects.
 // Usage:
 //    Lazy<Foo> my_lazy_object([]() { return new Foo; });
+// The initialization is recorded by the startup profiler, named after the class for QObjects.
 
 template<typename T>
 class Lazy {
  public:
-  explicit Lazy(std::function<T*()> init) : init_(init) {}
+  explicit Lazy(std::function<T*()> init, const char *name = nullptr) : init_(init), name_(name) {}
 
   // Convenience constructor that will lazily default construct the object.
-  Lazy() : init_([]() { return new T; }) {}
+  Lazy() : init_([]() { return new T; }), name_(nullptr) {}
 
   T* get() const {
     CheckInitialized();
@@ -63,12 +67,24 @@ class Lazy {
  private:
   void CheckInitialized() const {
     if (!ptr_) {
+      StartupProfiler::Scope profiler_scope(name());
       ptr_ = SharedPtr<T>(init_(), [](T*obj) { qLog(Debug) << obj << "deleted"; delete obj; });
       qLog(Debug) << &*ptr_ << "created";
     }
   }
 
+  const char *name() const {
+    if (name_) return name_;
+    if constexpr (std::is_base_of_v<QObject, T>) {
+      return T::staticMetaObject.className();
+    }
+    else {
+      return "Lazy";
+    }
+  }
+
   const std::function<T*()> init_;
+  const char *name_;
   mutable SharedPtr<T> ptr_;
 };
 
@@ -86,6 +86,7 @@
 
 #include "shared_ptr.h"
 #include "commandlineoptions.h"
+#include "startupprofiler.h"
 #include "mimedata.h"
 #include "iconloader.h"
 #include "taskmanager.h"
@@ -231,6 +232,8 @@ const char *MainWindow::kAllFilesFilterSpec = QT_TR_NOOP("All Files (*)");
 namespace {
 const int kTrackSliderUpdateTimeMs = 200;
 const int kTrackPositionUpdateTimeMs = 1000;
+// Start the deferred initialization anyway if the main window is not painted, for example when it is behind other windows.
+const int kDeferredInitTimeoutMs = 3000;
 }  // namespace
 
 #ifdef HAVE_QTSPARKLE
@@ -352,6 +355,7 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
       doubleclick_playlist_addmode_(BehaviourSettingsPage::PlaylistAddBehaviour::Play),
       menu_playmode_(BehaviourSettingsPage::PlayBehaviour::Never),
       initialized_(false),
+      painted_(false),
       was_maximized_(true),
       was_minimized_(false),
       hidden_(false),
@@ -436,8 +440,6 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
 #endif
   playlist_list_->SetApplication(app_);
 
-  organize_dialog_->SetDestinationModel(app_->collection()->model()->directory_model());
-
   radio_view_->view()->setModel(app_->radio_services()->sort_model());
 
   // Icons
@@ -1093,6 +1095,13 @@ MainWindow::MainWindow(Application *app, SharedPtr<SystemTrayIcon> tray_icon, OS
   qLog(Debug) << "Started" << QThread::currentThread();
   initialized_ = true;
 
+  if (isVisible()) {
+    QTimer::singleShot(kDeferredInitTimeoutMs, app_, &Application::StartDeferredInit);
+  }
+  else {
+    QTimer::singleShot(0, app_, &Application::StartDeferredInit);
+  }
+
 }
 
 MainWindow::~MainWindow() {
@@ -1625,10 +1634,27 @@ void MainWindow::StopAfterCurrent() {
   Q_EMIT StopAfterToggled(app_->playlist_manager()->active()->stop_after_current());
 }
 
+bool MainWindow::event(QEvent *e) {
+
+  const bool ret = QMainWindow::event(e);
+
+  if (e->type() == QEvent::Paint && !painted_) {
+    painted_ = true;
+    StartupProfiler::Mark("Main window painted");
+    qLog(Info) << "Main window painted after" << StartupProfiler::elapsed() << "ms";
+    QTimer::singleShot(0, app_, &Application::StartDeferredInit);
+  }
+
+  return ret;
+
+}
+
 void MainWindow::showEvent(QShowEvent *e) {
 
   hidden_ = false;
 
+  StartupProfiler::Mark("Main window shown");
+
   QMainWindow::showEvent(e);
 
 }
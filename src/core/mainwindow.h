@@ -116,6 +116,7 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   void CommandlineOptionsReceived(const CommandlineOptions &options);
 
  protected:
+  bool event(QEvent *e) override;
   void showEvent(QShowEvent *e) override;
   void closeEvent(QCloseEvent *e) override;
   void keyPressEvent(QKeyEvent *e) override;
@@ -394,6 +395,7 @@ class MainWindow : public QMainWindow, public PlatformInterface {
   BehaviourSettingsPage::PlayBehaviour menu_playmode_;
 
   bool initialized_;
+  bool painted_;
   bool was_maximized_;
   bool was_minimized_;
   bool hidden_;
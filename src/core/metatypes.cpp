@@ -53,6 +53,7 @@
 #  include "engine/gstenginepipeline.h"
 #endif
 #include "collection/collectiondirectory.h"
+#include "collection/collectionplaystatistics.h"
 #include "playlist/playlistitem.h"
 #include "playlist/playlistsequence.h"
 #include "covermanager/albumcoverloaderresult.h"
@@ -116,6 +117,8 @@ void RegisterMetaTypes() {
   qRegisterMetaType<CollectionDirectoryList>("CollectionDirectoryList");
   qRegisterMetaType<CollectionSubdirectory>("CollectionSubdirectory");
   qRegisterMetaType<CollectionSubdirectoryList>("CollectionSubdirectoryList");
+  qRegisterMetaType<CollectionPlayStatistics>("CollectionPlayStatistics");
+  qRegisterMetaType<CollectionPlayStatisticsList>("CollectionPlayStatisticsList");
   qRegisterMetaType<CollectionModel::Grouping>("CollectionModel::Grouping");
   qRegisterMetaType<PlaylistItemPtr>("PlaylistItemPtr");
   qRegisterMetaType<PlaylistItemPtrList>("PlaylistItemPtrList");
@@ -26,10 +26,12 @@
 #include <algorithm>
 #include <memory>
 #include <chrono>
+#include <utility>
 
 #include <QtGlobal>
 #include <QObject>
 #include <QMap>
+#include <QList>
 #include <QVariant>
 #include <QString>
 #include <QUrl>
@@ -190,6 +192,7 @@ void Player::Init() {
   QObject::connect(&*engine_, &EngineBase::TrackAboutToEnd, this, &Player::TrackAboutToEnd);
   QObject::connect(&*engine_, &EngineBase::TrackEnded, this, &Player::TrackEnded);
   QObject::connect(&*engine_, &EngineBase::MetaData, this, &Player::EngineMetadataReceived);
+  QObject::connect(&*engine_, &EngineBase::FirstBufferReached, this, &Player::EngineFirstBufferReached);
   QObject::connect(&*engine_, &EngineBase::VolumeChanged, this, &Player::SetVolumeFromEngine);
 
   // Equalizer
@@ -720,6 +723,7 @@ void Player::EngineStateChanged(const EngineBase::State state) {
       pause_time_ = QDateTime();
       play_offset_nanosec_ = 0;
       Q_EMIT Playing();
+      WarmUpLikelyTracks();
       break;
     case EngineBase::State::Error:
       Q_EMIT Error();
@@ -797,6 +801,8 @@ void Player::VolumeDown() {
 
 void Player::PlayAt(const int index, const bool pause, const quint64 offset_nanosec, EngineBase::TrackChangeFlags change, const Playlist::AutoScroll autoscroll, const bool reshuffle, const bool force_inform) {
 
+  start_latency_timer_.start();
+
   pause_time_ = pause ? QDateTime::currentDateTime() : QDateTime();
   play_offset_nanosec_ = offset_nanosec;
 
@@ -838,6 +844,35 @@ void Player::PlayAt(const int index, const bool pause, const quint64 offset_nano
 
 }
 
+void Player::EngineFirstBufferReached() {
+
+  if (!start_latency_timer_.isValid()) return;
+
+  qLog(Debug) << "Track started" << start_latency_timer_.elapsed() << "ms after it was requested";
+  start_latency_timer_.invalidate();
+
+}
+
+void Player::WarmUpLikelyTracks() {
+
+  Playlist *active_playlist = app_->playlist_manager()->active();
+  if (!active_playlist || !current_item_) return;
+
+  // The next (or queued) track is warmed up last, so it's the last one to be evicted.
+  QList<int> rows;
+  rows << active_playlist->peek_previous_row() << active_playlist->upcoming_rows(1);
+  for (const int row : std::as_const(rows)) {
+    if (!active_playlist->has_item_at(row)) continue;
+    PlaylistItemPtr item = active_playlist->item_at(row);
+    if (item == current_item_) continue;
+    // URL handlers resolve the stream URL when the track is played.
+    const QUrl url = item->StreamUrl();
+    if (url_handlers_.contains(url.scheme())) continue;
+    engine_->WarmUp(item->Url(), url, item->Metadata().has_cue(), item->effective_beginning_nanosec(), item->effective_end_nanosec());
+  }
+
+}
+
 void Player::CurrentMetadataChanged(const Song &metadata) {
 
   // Those things might have changed (especially when a previously invalid song was reloaded) so we push the latest version into Engine
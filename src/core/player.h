@@ -28,6 +28,7 @@
 #include <QObject>
 #include <QMap>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QString>
 #include <QUrl>
 
@@ -201,6 +202,7 @@ class Player : public PlayerInterface {
  private Q_SLOTS:
   void EngineStateChanged(const EngineBase::State);
   void EngineMetadataReceived(const EngineMetadata &engine_metadata);
+  void EngineFirstBufferReached();
   void TrackAboutToEnd();
   void TrackEnded();
   // Play the next item on the playlist - disregarding radio stations like last.fm that might have more tracks.
@@ -225,6 +227,9 @@ class Player : public PlayerInterface {
 
   void UnPause();
 
+  // Lets the engine prepare the tracks most likely to be played after the current one.
+  void WarmUpLikelyTracks();
+
  private:
   Application *app_;
   SharedPtr<EngineBase> engine_;
@@ -262,6 +267,9 @@ class Player : public PlayerInterface {
   QDateTime pause_time_;
   quint64 play_offset_nanosec_;
 
+  // Measures the time from PlayAt() until the engine reports the first buffer of the track.
+  QElapsedTimer start_latency_timer_;
+
 };
 
 #endif  // PLAYER_H
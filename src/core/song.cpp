@@ -56,6 +56,7 @@
 #include "utilities/timeconstants.h"
 #include "utilities/sqlhelper.h"
 #include "song.h"
+#include "songprojection.h"
 #include "sqlquery.h"
 #include "sqlrow.h"
 #ifdef HAVE_DBUS
@@ -65,91 +66,52 @@
 
 using namespace Qt::StringLiterals;
 
-const QStringList Song::kColumns = QStringList() << u"title"_s
-                                                 << u"album"_s
-                                                 << u"artist"_s
-                                                 << u"albumartist"_s
-                                                 << u"track"_s
-                                                 << u"disc"_s
-                                                 << u"year"_s
-                                                 << u"originalyear"_s
-                                                 << u"genre"_s
-                                                 << u"compilation"_s
-                                                 << u"composer"_s
-                                                 << u"performer"_s
-                                                 << u"grouping"_s
-                                                 << u"comment"_s
-                                                 << u"lyrics"_s
-
-                                                 << u"artist_id"_s
-                                                 << u"album_id"_s
-                                                 << u"song_id"_s
-
-                                                 << u"beginning"_s
-                                                 << u"length"_s
-
-                                                 << u"bitrate"_s
-                                                 << u"samplerate"_s
-                                                 << u"bitdepth"_s
-
-                                                 << u"source"_s
-                                                 << u"directory_id"_s
-                                                 << u"url"_s
-                                                 << u"filetype"_s
-                                                 << u"filesize"_s
-                                                 << u"mtime"_s
-                                                 << u"ctime"_s
-                                                 << u"unavailable"_s
-
-                                                 << u"fingerprint"_s
-
-                                                 << u"playcount"_s
-                                                 << u"skipcount"_s
-                                                 << u"lastplayed"_s
-                                                 << u"lastseen"_s
-
-                                                 << u"compilation_detected"_s
-                                                 << u"compilation_on"_s
-                                                 << u"compilation_off"_s
-                                                 << u"compilation_effective"_s
-
-                                                 << u"art_embedded"_s
-                                                 << u"art_automatic"_s
-                                                 << u"art_manual"_s
-                                                 << u"art_unset"_s
-
-                                                 << u"effective_albumartist"_s
-                                                 << u"effective_originalyear"_s
-
-                                                 << u"cue_path"_s
-
-                                                 << u"rating"_s
-
-                                                 << u"acoustid_id"_s
-                                                 << u"acoustid_fingerprint"_s
-
-                                                 << u"musicbrainz_album_artist_id"_s
-                                                 << u"musicbrainz_artist_id"_s
-                                                 << u"musicbrainz_original_artist_id"_s
-                                                 << u"musicbrainz_album_id"_s
-                                                 << u"musicbrainz_original_album_id"_s
-                                                 << u"musicbrainz_recording_id"_s
-                                                 << u"musicbrainz_track_id"_s
-                                                 << u"musicbrainz_disc_id"_s
-                                                 << u"musicbrainz_release_group_id"_s
-                                                 << u"musicbrainz_work_id"_s
-
-                                                 << u"ebur128_integrated_loudness_lufs"_s
-                                                 << u"ebur128_loudness_range_lu"_s
-
-                                                 ;
+namespace {
+
+constexpr bool ColumnTableInOrder() {
+
+  for (int i = 0; i < Song::kColumnCount; ++i) {
+    if (static_cast<int>(Song::kColumnTable[i].column) != i) return false;
+  }
+
+  return true;
+
+}
+
+static_assert(ColumnTableInOrder(), "Song::kColumnTable must list the columns in the order of Song::Column");
+
+QStringList ColumnNames() {
+
+  QStringList ret;
+  ret.reserve(Song::kColumnCount);
+  for (const Song::ColumnInfo &column : Song::kColumnTable) {
+    ret << QString::fromLatin1(column.name);
+  }
+  return ret;
+
+}
+
+QString UpdateSpec() {
+
+  QStringList ret;
+  ret.reserve(Song::kColumnCount);
+  for (const Song::ColumnInfo &column : Song::kColumnTable) {
+    ret << QString::fromLatin1(column.name) + " = ?"_L1;
+  }
+  return ret.join(", "_L1);
+
+}
+
+}  // namespace
+
+const QStringList Song::kColumns = ColumnNames();
 
 const QStringList Song::kRowIdColumns = QStringList() << u"ROWID"_s << kColumns;
 
 const QString Song::kColumnSpec = kColumns.join(", "_L1);
 const QString Song::kRowIdColumnSpec = kRowIdColumns.join(", "_L1);
-const QString Song::kBindSpec = Utilities::Prepend(u":"_s, kColumns).join(", "_L1);
-const QString Song::kUpdateSpec = Utilities::Updateify(kColumns).join(", "_L1);
+const QString Song::kBindSpec = QStringList(kColumnCount, u"?"_s).join(", "_L1);
+const QString Song::kUpdateSpec = UpdateSpec();
 
 const QStringList Song::kTextSearchColumns = QStringList()      << u"title"_s
                                                                 << u"album"_s
@@ -720,12 +682,6 @@ QString Song::sortable(const QString &v) {
 
 }
 
-int Song::ColumnIndex(const QString &field) {
-
-  return static_cast<int>(kRowIdColumns.indexOf(field));
-
-}
-
 QString Song::JoinSpec(const QString &table) {
   return Utilities::Prepend(table + QLatin1Char('.'), kRowIdColumns).join(", "_L1);
 }
@@ -1435,76 +1391,11 @@ void Song::InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, cons
 
   Q_ASSERT(kRowIdColumns.count() + col <= r.count());
 
-  d->id_ = SqlHelper::ValueToInt(r, ColumnIndex(u"ROWID"_s) + col);
-
-  set_title(SqlHelper::ValueToString(r, ColumnIndex(u"title"_s) + col));
-  set_album(SqlHelper::ValueToString(r, ColumnIndex(u"album"_s) + col));
-  set_artist(SqlHelper::ValueToString(r, ColumnIndex(u"artist"_s) + col));
-  set_albumartist(SqlHelper::ValueToString(r, ColumnIndex(u"albumartist"_s) + col));
-  d->track_ = SqlHelper::ValueToInt(r, ColumnIndex(u"track"_s) + col);
-  d->disc_ = SqlHelper::ValueToInt(r, ColumnIndex(u"disc"_s) + col);
-  d->year_ = SqlHelper::ValueToInt(r, ColumnIndex(u"year"_s) + col);
-  d->originalyear_ = SqlHelper::ValueToInt(r, ColumnIndex(u"originalyear"_s) + col);
-  d->genre_ = SqlHelper::ValueToString(r, ColumnIndex(u"genre"_s) + col);
-  d->compilation_ = r.value(ColumnIndex(u"compilation"_s) + col).toBool();
-  d->composer_ = SqlHelper::ValueToString(r, ColumnIndex(u"composer"_s) + col);
-  d->performer_ = SqlHelper::ValueToString(r, ColumnIndex(u"performer"_s) + col);
-  d->grouping_ = SqlHelper::ValueToString(r, ColumnIndex(u"grouping"_s) + col);
-  d->comment_ = SqlHelper::ValueToString(r, ColumnIndex(u"comment"_s) + col);
-  d->lyrics_ = SqlHelper::ValueToString(r, ColumnIndex(u"lyrics"_s) + col);
-  d->artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"artist_id"_s) + col);
-  d->album_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"album_id"_s) + col);
-  d->song_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"song_id"_s) + col);
-  d->beginning_ = r.value(ColumnIndex(u"beginning"_s) + col).isNull() ? 0 : r.value(ColumnIndex(u"beginning"_s) + col).toLongLong();
-  set_length_nanosec(SqlHelper::ValueToLongLong(r, ColumnIndex(u"length"_s) + col));
-  d->bitrate_ = SqlHelper::ValueToInt(r, ColumnIndex(u"bitrate"_s) + col);
-  d->samplerate_ = SqlHelper::ValueToInt(r, ColumnIndex(u"samplerate"_s) + col);
-  d->bitdepth_ = SqlHelper::ValueToInt(r, ColumnIndex(u"bitdepth"_s) + col);
-  if (!r.value(ColumnIndex(u"ebur128_integrated_loudness_lufs"_s) + col).isNull()) {
-    d->ebur128_integrated_loudness_lufs_ = r.value(ColumnIndex(u"ebur128_integrated_loudness_lufs"_s) + col).toDouble();
-  }
-  if (!r.value(ColumnIndex(u"ebur128_loudness_range_lu"_s) + col).isNull()) {
-    d->ebur128_loudness_range_lu_ = r.value(ColumnIndex(u"ebur128_loudness_range_lu"_s) + col).toDouble();
+  // The ROWID comes first, followed by the columns in the order of kColumnTable.
+  d->id_ = SqlHelper::ValueToInt(r, col);
+  for (int i = 0; i < kColumnCount; ++i) {
+    LoadColumn(kColumnTable[i].column, r, col + 1 + i);
   }
-  d->source_ = static_cast<Source>(r.value(ColumnIndex(u"source"_s) + col).isNull() ? 0 : r.value(ColumnIndex(u"source"_s) + col).toInt());
-  d->directory_id_ = SqlHelper::ValueToInt(r, ColumnIndex(u"directory_id"_s) + col);
-  set_url(QUrl::fromEncoded(SqlHelper::ValueToString(r, ColumnIndex(u"url"_s) + col).toUtf8()));
-  d->basefilename_ = QFileInfo(d->url_.toLocalFile()).fileName();
-  d->filetype_ = FileType(r.value(ColumnIndex(u"filetype"_s) + col).isNull() ? 0 : r.value(ColumnIndex(u"filetype"_s) + col).toInt());
-  d->filesize_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"filesize"_s) + col);
-  d->mtime_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"mtime"_s) + col);
-  d->ctime_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"ctime"_s) + col);
-  d->unavailable_ = r.value(ColumnIndex(u"unavailable"_s) + col).toBool();
-  d->fingerprint_ = SqlHelper::ValueToString(r, ColumnIndex(u"fingerprint"_s) + col);
-  d->playcount_ = SqlHelper::ValueToUInt(r, ColumnIndex(u"playcount"_s) + col);
-  d->skipcount_ = SqlHelper::ValueToUInt(r, ColumnIndex(u"skipcount"_s) + col);
-  d->lastplayed_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"lastplayed"_s) + col);
-  d->lastseen_ = SqlHelper::ValueToLongLong(r, ColumnIndex(u"lastseen"_s) + col);
-  d->compilation_detected_ = SqlHelper::ValueToBool(r, ColumnIndex(u"compilation_detected"_s) + col);
-  d->compilation_on_ = SqlHelper::ValueToBool(r, ColumnIndex(u"compilation_on"_s) + col);
-  d->compilation_off_ = SqlHelper::ValueToBool(r, ColumnIndex(u"compilation_off"_s) + col);
-
-  d->art_embedded_ = SqlHelper::ValueToBool(r, ColumnIndex(u"art_embedded"_s) + col);
-  d->art_automatic_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, ColumnIndex(u"art_automatic"_s) + col).toUtf8());
-  d->art_manual_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, ColumnIndex(u"art_manual"_s) + col).toUtf8());
-  d->art_unset_ = SqlHelper::ValueToBool(r, ColumnIndex(u"art_unset"_s) + col);
-
-  d->cue_path_ = SqlHelper::ValueToString(r, ColumnIndex(u"cue_path"_s) + col);
-  d->rating_ = SqlHelper::ValueToFloat(r, ColumnIndex(u"rating"_s) + col);
-
-  d->acoustid_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"acoustid_id"_s) + col);
-  d->acoustid_fingerprint_ = SqlHelper::ValueToString(r, ColumnIndex(u"acoustid_fingerprint"_s) + col);
-
-  d->musicbrainz_album_artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_album_artist_id"_s) + col);
-  d->musicbrainz_artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_artist_id"_s) + col);
-  d->musicbrainz_original_artist_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_original_artist_id"_s) + col);
-  d->musicbrainz_album_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_album_id"_s) + col);
-  d->musicbrainz_original_album_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_original_album_id"_s) + col);
-  d->musicbrainz_recording_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_recording_id"_s) + col);
-  d->musicbrainz_track_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_track_id"_s) + col);
-  d->musicbrainz_disc_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_disc_id"_s) + col);
-  d->musicbrainz_release_group_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_release_group_id"_s) + col);
-  d->musicbrainz_work_id_ = SqlHelper::ValueToString(r, ColumnIndex(u"musicbrainz_work_id"_s) + col);
 
   d->valid_ = true;
   d->init_from_file_ = reliable_metadata;
@@ -1525,6 +1416,224 @@ void Song::InitFromQuery(const SqlRow &row, const bool reliable_metadata, const
 
 }
 
+void Song::InitFromQuery(const QSqlRecord &r, const SongProjection &projection, const bool reliable_metadata, const int col) {
+
+  d->id_ = SqlHelper::ValueToInt(r, col);
+  projection.Load(this, r, col);
+
+  d->valid_ = true;
+  d->init_from_file_ = reliable_metadata;
+
+  // Looking for a cover in the cache is expensive, only do it for queries that want covers.
+  if (projection.contains(u"art_manual"_s)) {
+    InitArtManual();
+  }
+
+}
+
+void Song::InitFromQuery(const SqlQuery &query, const SongProjection &projection, const bool reliable_metadata, const int col) {
+
+  InitFromQuery(query.record(), projection, reliable_metadata, col);
+
+}
+
+void Song::InitFromQuery(const SqlRow &row, const SongProjection &projection, const bool reliable_metadata, const int col) {
+
+  InitFromQuery(row.record(), projection, reliable_metadata, col);
+
+}
+
+// Decodes the value of a single column at position n of the record, used by InitFromQuery() and SongProjection.
+void Song::LoadColumn(const Column column, const QSqlRecord &r, const int n) {
+
+  switch (column) {
+    case Column::Title:
+      set_title(SqlHelper::ValueToString(r, n));
+      break;
+    case Column::Album:
+      set_album(SqlHelper::ValueToString(r, n));
+      break;
+    case Column::Artist:
+      set_artist(SqlHelper::ValueToString(r, n));
+      break;
+    case Column::AlbumArtist:
+      set_albumartist(SqlHelper::ValueToString(r, n));
+      break;
+    case Column::Track:
+      d->track_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Disc:
+      d->disc_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Year:
+      d->year_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::OriginalYear:
+      d->originalyear_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Genre:
+      d->genre_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Compilation:
+      d->compilation_ = r.value(n).toBool();
+      break;
+    case Column::Composer:
+      d->composer_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Performer:
+      d->performer_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Grouping:
+      d->grouping_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Comment:
+      d->comment_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Lyrics:
+      d->lyrics_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::ArtistId:
+      d->artist_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::AlbumId:
+      d->album_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::SongId:
+      d->song_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Beginning:
+      d->beginning_ = r.value(n).isNull() ? 0 : r.value(n).toLongLong();
+      break;
+    case Column::Length:
+      set_length_nanosec(SqlHelper::ValueToLongLong(r, n));
+      break;
+    case Column::Bitrate:
+      d->bitrate_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Samplerate:
+      d->samplerate_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Bitdepth:
+      d->bitdepth_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Source:
+      d->source_ = static_cast<Source>(r.value(n).isNull() ? 0 : r.value(n).toInt());
+      break;
+    case Column::DirectoryId:
+      d->directory_id_ = SqlHelper::ValueToInt(r, n);
+      break;
+    case Column::Url:
+      set_url(QUrl::fromEncoded(SqlHelper::ValueToString(r, n).toUtf8()));
+      d->basefilename_ = QFileInfo(d->url_.toLocalFile()).fileName();
+      break;
+    case Column::Filetype:
+      d->filetype_ = FileType(r.value(n).isNull() ? 0 : r.value(n).toInt());
+      break;
+    case Column::Filesize:
+      d->filesize_ = SqlHelper::ValueToLongLong(r, n);
+      break;
+    case Column::Mtime:
+      d->mtime_ = SqlHelper::ValueToLongLong(r, n);
+      break;
+    case Column::Ctime:
+      d->ctime_ = SqlHelper::ValueToLongLong(r, n);
+      break;
+    case Column::Unavailable:
+      d->unavailable_ = r.value(n).toBool();
+      break;
+    case Column::Fingerprint:
+      d->fingerprint_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Playcount:
+      d->playcount_ = SqlHelper::ValueToUInt(r, n);
+      break;
+    case Column::Skipcount:
+      d->skipcount_ = SqlHelper::ValueToUInt(r, n);
+      break;
+    case Column::LastPlayed:
+      d->lastplayed_ = SqlHelper::ValueToLongLong(r, n);
+      break;
+    case Column::LastSeen:
+      d->lastseen_ = SqlHelper::ValueToLongLong(r, n);
+      break;
+    case Column::CompilationDetected:
+      d->compilation_detected_ = SqlHelper::ValueToBool(r, n);
+      break;
+    case Column::CompilationOn:
+      d->compilation_on_ = SqlHelper::ValueToBool(r, n);
+      break;
+    case Column::CompilationOff:
+      d->compilation_off_ = SqlHelper::ValueToBool(r, n);
+      break;
+    case Column::ArtEmbedded:
+      d->art_embedded_ = SqlHelper::ValueToBool(r, n);
+      break;
+    case Column::ArtAutomatic:
+      d->art_automatic_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, n).toUtf8());
+      break;
+    case Column::ArtManual:
+      d->art_manual_ = QUrl::fromEncoded(SqlHelper::ValueToString(r, n).toUtf8());
+      break;
+    case Column::ArtUnset:
+      d->art_unset_ = SqlHelper::ValueToBool(r, n);
+      break;
+    case Column::CuePath:
+      d->cue_path_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::Rating:
+      d->rating_ = SqlHelper::ValueToFloat(r, n);
+      break;
+    case Column::AcoustIdId:
+      d->acoustid_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::AcoustIdFingerprint:
+      d->acoustid_fingerprint_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzAlbumArtistId:
+      d->musicbrainz_album_artist_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzArtistId:
+      d->musicbrainz_artist_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzOriginalArtistId:
+      d->musicbrainz_original_artist_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzAlbumId:
+      d->musicbrainz_album_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzOriginalAlbumId:
+      d->musicbrainz_original_album_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzRecordingId:
+      d->musicbrainz_recording_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzTrackId:
+      d->musicbrainz_track_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzDiscId:
+      d->musicbrainz_disc_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzReleaseGroupId:
+      d->musicbrainz_release_group_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::MusicBrainzWorkId:
+      d->musicbrainz_work_id_ = SqlHelper::ValueToString(r, n);
+      break;
+    case Column::EBUR128IntegratedLoudnessLUFS:
+      if (!r.value(n).isNull()) d->ebur128_integrated_loudness_lufs_ = r.value(n).toDouble();
+      break;
+    case Column::EBUR128LoudnessRangeLU:
+      if (!r.value(n).isNull()) d->ebur128_loudness_range_lu_ = r.value(n).toDouble();
+      break;
+    case Column::CompilationEffective:
+    case Column::EffectiveAlbumArtist:
+    case Column::EffectiveOriginalYear:
+      // Computed from the other fields.
+      break;
+  }
+
+}
+
 void Song::InitFromFilePartial(const QString &filename, const QFileInfo &fileinfo) {
 
   set_url(QUrl::fromLocalFile(filename));
@@ -1753,84 +1862,84 @@ void Song::ToMTP(LIBMTP_track_t *track) const {
 
 void Song::BindToQuery(SqlQuery *query) const {
 
-  // Remember to bind these in the same order as kBindSpec
-
-  query->BindStringValue(u":title"_s, d->title_);
-  query->BindStringValue(u":album"_s, d->album_);
-  query->BindStringValue(u":artist"_s, d->artist_);
-  query->BindStringValue(u":albumartist"_s, d->albumartist_);
-  query->BindIntValue(u":track"_s, d->track_);
-  query->BindIntValue(u":disc"_s, d->disc_);
-  query->BindIntValue(u":year"_s, d->year_);
-  query->BindIntValue(u":originalyear"_s, d->originalyear_);
-  query->BindStringValue(u":genre"_s, d->genre_);
-  query->BindBoolValue(u":compilation"_s, d->compilation_);
-  query->BindStringValue(u":composer"_s, d->composer_);
-  query->BindStringValue(u":performer"_s, d->performer_);
-  query->BindStringValue(u":grouping"_s, d->grouping_);
-  query->BindStringValue(u":comment"_s, d->comment_);
-  query->BindStringValue(u":lyrics"_s, d->lyrics_);
-
-  query->BindStringValue(u":artist_id"_s, d->artist_id_);
-  query->BindStringValue(u":album_id"_s, d->album_id_);
-  query->BindStringValue(u":song_id"_s, d->song_id_);
-
-  query->BindValue(u":beginning"_s, d->beginning_);
-  query->BindLongLongValue(u":length"_s, length_nanosec());
-
-  query->BindIntValue(u":bitrate"_s, d->bitrate_);
-  query->BindIntValue(u":samplerate"_s, d->samplerate_);
-  query->BindIntValue(u":bitdepth"_s, d->bitdepth_);
-
-  query->BindValue(u":source"_s, static_cast<int>(d->source_));
-  query->BindNotNullIntValue(u":directory_id"_s, d->directory_id_);
-  query->BindUrlValue(u":url"_s, d->url_);
-  query->BindValue(u":filetype"_s, static_cast<int>(d->filetype_));
+  // Bound by position, remember to bind these in the order of kColumnTable
+
+  query->AddBindStringValue(d->title_);
+  query->AddBindStringValue(d->album_);
+  query->AddBindStringValue(d->artist_);
+  query->AddBindStringValue(d->albumartist_);
+  query->AddBindIntValue(d->track_);
+  query->AddBindIntValue(d->disc_);
+  query->AddBindIntValue(d->year_);
+  query->AddBindIntValue(d->originalyear_);
+  query->AddBindStringValue(d->genre_);
+  query->AddBindBoolValue(d->compilation_);
+  query->AddBindStringValue(d->composer_);
+  query->AddBindStringValue(d->performer_);
+  query->AddBindStringValue(d->grouping_);
+  query->AddBindStringValue(d->comment_);
+  query->AddBindStringValue(d->lyrics_);
+
+  query->AddBindStringValue(d->artist_id_);
+  query->AddBindStringValue(d->album_id_);
+  query->AddBindStringValue(d->song_id_);
+
+  query->AddBindValue(d->beginning_);
+  query->AddBindLongLongValue(length_nanosec());
+
+  query->AddBindIntValue(d->bitrate_);
+  query->AddBindIntValue(d->samplerate_);
+  query->AddBindIntValue(d->bitdepth_);
+
+  query->AddBindValue(static_cast<int>(d->source_));
+  query->AddBindNotNullIntValue(d->directory_id_);
+  query->AddBindUrlValue(d->url_);
+  query->AddBindValue(static_cast<int>(d->filetype_));
   query->BindLongLongValueOrZero(u":filesize"_s, d->filesize_);
   query->BindLongLongValueOrZero(u":mtime"_s, d->mtime_);
   query->BindLongLongValueOrZero(u":ctime"_s, d->ctime_);
-  query->BindBoolValue(u":unavailable"_s, d->unavailable_);
+  query->AddBindBoolValue(d->unavailable_);
 
-  query->BindStringValue(u":fingerprint"_s, d->fingerprint_);
+  query->AddBindStringValue(d->fingerprint_);
 
-  query->BindValue(u":playcount"_s, d->playcount_);
-  query->BindValue(u":skipcount"_s, d->skipcount_);
-  query->BindLongLongValue(u":lastplayed"_s, d->lastplayed_);
-  query->BindLongLongValue(u":lastseen"_s, d->lastseen_);
+  query->AddBindValue(d->playcount_);
+  query->AddBindValue(d->skipcount_);
+  query->AddBindLongLongValue(d->lastplayed_);
+  query->AddBindLongLongValue(d->lastseen_);
 
-  query->BindBoolValue(u":compilation_detected"_s, d->compilation_detected_);
-  query->BindBoolValue(u":compilation_on"_s, d->compilation_on_);
-  query->BindBoolValue(u":compilation_off"_s, d->compilation_off_);
-  query->BindBoolValue(u":compilation_effective"_s, is_compilation());
+  query->AddBindBoolValue(d->compilation_detected_);
+  query->AddBindBoolValue(d->compilation_on_);
+  query->AddBindBoolValue(d->compilation_off_);
+  query->AddBindBoolValue(is_compilation());
 
-  query->BindBoolValue(u":art_embedded"_s, d->art_embedded_);
-  query->BindUrlValue(u":art_automatic"_s, d->art_automatic_);
-  query->BindUrlValue(u":art_manual"_s, d->art_manual_);
-  query->BindBoolValue(u":art_unset"_s, d->art_unset_);
+  query->AddBindBoolValue(d->art_embedded_);
+  query->AddBindUrlValue(d->art_automatic_);
+  query->AddBindUrlValue(d->art_manual_);
+  query->AddBindBoolValue(d->art_unset_);
 
-  query->BindStringValue(u":effective_albumartist"_s, effective_albumartist());
-  query->BindIntValue(u":effective_originalyear"_s, effective_originalyear());
+  query->AddBindStringValue(effective_albumartist());
+  query->AddBindIntValue(effective_originalyear());
 
-  query->BindValue(u":cue_path"_s, d->cue_path_);
+  query->AddBindValue(d->cue_path_);
 
-  query->BindFloatValue(u":rating"_s, d->rating_);
+  query->AddBindFloatValue(d->rating_);
 
-  query->BindStringValue(u":acoustid_id"_s, d->acoustid_id_);
-  query->BindStringValue(u":acoustid_fingerprint"_s, d->acoustid_fingerprint_);
+  query->AddBindStringValue(d->acoustid_id_);
+  query->AddBindStringValue(d->acoustid_fingerprint_);
 
-  query->BindStringValue(u":musicbrainz_album_artist_id"_s, d->musicbrainz_album_artist_id_);
-  query->BindStringValue(u":musicbrainz_artist_id"_s, d->musicbrainz_artist_id_);
-  query->BindStringValue(u":musicbrainz_original_artist_id"_s, d->musicbrainz_original_artist_id_);
-  query->BindStringValue(u":musicbrainz_album_id"_s, d->musicbrainz_album_id_);
-  query->BindStringValue(u":musicbrainz_original_album_id"_s, d->musicbrainz_original_album_id_);
-  query->BindStringValue(u":musicbrainz_recording_id"_s, d->musicbrainz_recording_id_);
-  query->BindStringValue(u":musicbrainz_track_id"_s, d->musicbrainz_track_id_);
-  query->BindStringValue(u":musicbrainz_disc_id"_s, d->musicbrainz_disc_id_);
-  query->BindStringValue(u":musicbrainz_release_group_id"_s, d->musicbrainz_release_group_id_);
-  query->BindStringValue(u":musicbrainz_work_id"_s, d->musicbrainz_work_id_);
+  query->AddBindStringValue(d->musicbrainz_album_artist_id_);
+  query->AddBindStringValue(d->musicbrainz_artist_id_);
+  query->AddBindStringValue(d->musicbrainz_original_artist_id_);
+  query->AddBindStringValue(d->musicbrainz_album_id_);
+  query->AddBindStringValue(d->musicbrainz_original_album_id_);
+  query->AddBindStringValue(d->musicbrainz_recording_id_);
+  query->AddBindStringValue(d->musicbrainz_track_id_);
+  query->AddBindStringValue(d->musicbrainz_disc_id_);
+  query->AddBindStringValue(d->musicbrainz_release_group_id_);
+  query->AddBindStringValue(d->musicbrainz_work_id_);
 
-  query->BindDoubleOrNullValue(u":ebur128_integrated_loudness_lufs"_s, d->ebur128_integrated_loudness_lufs_);
-  query->BindDoubleOrNullValue(u":ebur128_loudness_range_lu"_s, d->ebur128_loudness_range_lu_);
+  query->AddBindDoubleOrNullValue(d->ebur128_integrated_loudness_lufs_);
+  query->AddBindDoubleOrNullValue(d->ebur128_loudness_range_lu_);
 
 }
 
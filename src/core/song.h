@@ -25,6 +25,7 @@
 #include "config.h"
 
 #include <optional>
+#include <iterator>
 
 #include <QtGlobal>
 #include <QSharedData>
@@ -61,6 +62,7 @@ struct LIBMTP_track_struct;
 #endif
 
 class SqlRow;
+class SongProjection;
 
 class Song {
 
@@ -113,6 +115,151 @@ class Song {
     Stream = 91
   };
 
+  // The columns of the songs tables, in table order.
+  // InitFromQuery() decodes and BindToQuery() binds by the position in this table.
+  enum class Column {
+    Title,
+    Album,
+    Artist,
+    AlbumArtist,
+    Track,
+    Disc,
+    Year,
+    OriginalYear,
+    Genre,
+    Compilation,
+    Composer,
+    Performer,
+    Grouping,
+    Comment,
+    Lyrics,
+    ArtistId,
+    AlbumId,
+    SongId,
+    Beginning,
+    Length,
+    Bitrate,
+    Samplerate,
+    Bitdepth,
+    Source,
+    DirectoryId,
+    Url,
+    Filetype,
+    Filesize,
+    Mtime,
+    Ctime,
+    Unavailable,
+    Fingerprint,
+    Playcount,
+    Skipcount,
+    LastPlayed,
+    LastSeen,
+    CompilationDetected,
+    CompilationOn,
+    CompilationOff,
+    CompilationEffective,
+    ArtEmbedded,
+    ArtAutomatic,
+    ArtManual,
+    ArtUnset,
+    EffectiveAlbumArtist,
+    EffectiveOriginalYear,
+    CuePath,
+    Rating,
+    AcoustIdId,
+    AcoustIdFingerprint,
+    MusicBrainzAlbumArtistId,
+    MusicBrainzArtistId,
+    MusicBrainzOriginalArtistId,
+    MusicBrainzAlbumId,
+    MusicBrainzOriginalAlbumId,
+    MusicBrainzRecordingId,
+    MusicBrainzTrackId,
+    MusicBrainzDiscId,
+    MusicBrainzReleaseGroupId,
+    MusicBrainzWorkId,
+    EBUR128IntegratedLoudnessLUFS,
+    EBUR128LoudnessRangeLU
+  };
+
+  enum class ColumnType {
+    Text,
+    Integer,
+    Real
+  };
+
+  struct ColumnInfo {
+    Column column;
+    ColumnType type;
+    const char *name;
+  };
+
+  static constexpr ColumnInfo kColumnTable[] = {
+    { Column::Title, ColumnType::Text, "title" },
+    { Column::Album, ColumnType::Text, "album" },
+    { Column::Artist, ColumnType::Text, "artist" },
+    { Column::AlbumArtist, ColumnType::Text, "albumartist" },
+    { Column::Track, ColumnType::Integer, "track" },
+    { Column::Disc, ColumnType::Integer, "disc" },
+    { Column::Year, ColumnType::Integer, "year" },
+    { Column::OriginalYear, ColumnType::Integer, "originalyear" },
+    { Column::Genre, ColumnType::Text, "genre" },
+    { Column::Compilation, ColumnType::Integer, "compilation" },
+    { Column::Composer, ColumnType::Text, "composer" },
+    { Column::Performer, ColumnType::Text, "performer" },
+    { Column::Grouping, ColumnType::Text, "grouping" },
+    { Column::Comment, ColumnType::Text, "comment" },
+    { Column::Lyrics, ColumnType::Text, "lyrics" },
+    { Column::ArtistId, ColumnType::Text, "artist_id" },
+    { Column::AlbumId, ColumnType::Text, "album_id" },
+    { Column::SongId, ColumnType::Text, "song_id" },
+    { Column::Beginning, ColumnType::Integer, "beginning" },
+    { Column::Length, ColumnType::Integer, "length" },
+    { Column::Bitrate, ColumnType::Integer, "bitrate" },
+    { Column::Samplerate, ColumnType::Integer, "samplerate" },
+    { Column::Bitdepth, ColumnType::Integer, "bitdepth" },
+    { Column::Source, ColumnType::Integer, "source" },
+    { Column::DirectoryId, ColumnType::Integer, "directory_id" },
+    { Column::Url, ColumnType::Text, "url" },
+    { Column::Filetype, ColumnType::Integer, "filetype" },
+    { Column::Filesize, ColumnType::Integer, "filesize" },
+    { Column::Mtime, ColumnType::Integer, "mtime" },
+    { Column::Ctime, ColumnType::Integer, "ctime" },
+    { Column::Unavailable, ColumnType::Integer, "unavailable" },
+    { Column::Fingerprint, ColumnType::Text, "fingerprint" },
+    { Column::Playcount, ColumnType::Integer, "playcount" },
+    { Column::Skipcount, ColumnType::Integer, "skipcount" },
+    { Column::LastPlayed, ColumnType::Integer, "lastplayed" },
+    { Column::LastSeen, ColumnType::Integer, "lastseen" },
+    { Column::CompilationDetected, ColumnType::Integer, "compilation_detected" },
+    { Column::CompilationOn, ColumnType::Integer, "compilation_on" },
+    { Column::CompilationOff, ColumnType::Integer, "compilation_off" },
+    { Column::CompilationEffective, ColumnType::Integer, "compilation_effective" },
+    { Column::ArtEmbedded, ColumnType::Integer, "art_embedded" },
+    { Column::ArtAutomatic, ColumnType::Text, "art_automatic" },
+    { Column::ArtManual, ColumnType::Text, "art_manual" },
+    { Column::ArtUnset, ColumnType::Integer, "art_unset" },
+    { Column::EffectiveAlbumArtist, ColumnType::Text, "effective_albumartist" },
+    { Column::EffectiveOriginalYear, ColumnType::Integer, "effective_originalyear" },
+    { Column::CuePath, ColumnType::Text, "cue_path" },
+    { Column::Rating, ColumnType::Integer, "rating" },
+    { Column::AcoustIdId, ColumnType::Text, "acoustid_id" },
+    { Column::AcoustIdFingerprint, ColumnType::Text, "acoustid_fingerprint" },
+    { Column::MusicBrainzAlbumArtistId, ColumnType::Text, "musicbrainz_album_artist_id" },
+    { Column::MusicBrainzArtistId, ColumnType::Text, "musicbrainz_artist_id" },
+    { Column::MusicBrainzOriginalArtistId, ColumnType::Text, "musicbrainz_original_artist_id" },
+    { Column::MusicBrainzAlbumId, ColumnType::Text, "musicbrainz_album_id" },
+    { Column::MusicBrainzOriginalAlbumId, ColumnType::Text, "musicbrainz_original_album_id" },
+    { Column::MusicBrainzRecordingId, ColumnType::Text, "musicbrainz_recording_id" },
+    { Column::MusicBrainzTrackId, ColumnType::Text, "musicbrainz_track_id" },
+    { Column::MusicBrainzDiscId, ColumnType::Text, "musicbrainz_disc_id" },
+    { Column::MusicBrainzReleaseGroupId, ColumnType::Text, "musicbrainz_release_group_id" },
+    { Column::MusicBrainzWorkId, ColumnType::Text, "musicbrainz_work_id" },
+    { Column::EBUR128IntegratedLoudnessLUFS, ColumnType::Real, "ebur128_integrated_loudness_lufs" },
+    { Column::EBUR128LoudnessRangeLU, ColumnType::Real, "ebur128_loudness_range_lu" },
+  };
+  static constexpr int kColumnCount = static_cast<int>(std::size(kColumnTable));
+
   static const QStringList kColumns;
   static const QStringList kRowIdColumns;
   static const QString kColumnSpec;
@@ -356,7 +503,6 @@ class Song {
   static bool save_embedded_cover_supported(const FileType filetype);
   bool save_embedded_cover_supported() const { return url().isLocalFile() && save_embedded_cover_supported(filetype()) && !has_cue(); };
 
-  static int ColumnIndex(const QString &field);
   static QString JoinSpec(const QString &table);
 
   // Pretty accessors
@@ -426,6 +572,9 @@ class Song {
   void InitFromQuery(const QSqlRecord &r, const bool reliable_metadata, const int col = 0);
   void InitFromQuery(const SqlQuery &query, const bool reliable_metadata, const int col = 0);
   void InitFromQuery(const SqlRow &row, const bool reliable_metadata, const int col = 0);
+  void InitFromQuery(const QSqlRecord &r, const SongProjection &projection, const bool reliable_metadata, const int col = 0);
+  void InitFromQuery(const SqlQuery &query, const SongProjection &projection, const bool reliable_metadata, const int col = 0);
+  void InitFromQuery(const SqlRow &row, const SongProjection &projection, const bool reliable_metadata, const int col = 0);
   void InitFromFilePartial(const QString &filename, const QFileInfo &fileinfo);
   void InitArtManual();
   void InitArtAutomatic();
@@ -466,8 +615,12 @@ class Song {
   static QString TitleRemoveMisc(const QString &title);
 
  private:
+  friend class SongProjection;
+
   struct Private;
 
+  void LoadColumn(const Column column, const QSqlRecord &r, const int n);
+
   static QString sortable(const QString &v);
 
   QSharedDataPointer<Private> d;
@@ -22,6 +22,7 @@
 #include "config.h"
 
 #include <algorithm>
+#include <utility>
 
 #ifdef HAVE_GSTREAMER
 #  include <gst/gst.h>
@@ -36,6 +37,8 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QSet>
+#include <QList>
+#include <QHash>
 #include <QTimer>
 #include <QString>
 #include <QUrl>
@@ -82,7 +85,9 @@ SongLoader::SongLoader(SharedPtr<CollectionBackendInterface> collection_backend,
       fakesink_(nullptr),
       buffer_probe_cb_id_(0),
 #endif
-      success_(false) {
+      success_(false),
+      stream_playlists_(false),
+      abort_(false) {
 
   if (sRawUriSchemes.isEmpty()) {
     sRawUriSchemes << QStringLiteral("udp")
@@ -238,7 +243,6 @@ SongLoader::Result SongLoader::LoadLocal(const QString &filename) {
   // Search in the database.
   QUrl url = QUrl::fromLocalFile(filename);
 
-  QMutexLocker l(collection_backend_->db()->Mutex());
   QSqlDatabase db(collection_backend_->db()->Connect());
 
   CollectionQuery query(db, collection_backend_->songs_table());
@@ -339,32 +343,60 @@ SongLoader::Result SongLoader::LoadLocalAsync(const QString &filename) {
 
 void SongLoader::LoadMetadataBlocking() {
 
-  for (int i = 0; i < songs_.size(); i++) {
-    EffectiveSongLoad(&songs_[i]);
+  for (qint64 i = 0; i < songs_.count() && !abort_; i += ParserBase::kLoadChunkSize) {
+    EffectiveSongsLoad(&songs_, i, qMin(songs_.count(), i + ParserBase::kLoadChunkSize));
   }
 
 }
 
 void SongLoader::EffectiveSongLoad(Song *song) {
 
-  if (!song || !song->url().isLocalFile()) return;
+  if (!song) return;
 
-  if (song->init_from_file() && song->filetype() != Song::FileType::Unknown) {
-    // Maybe we loaded the metadata already, for example from a cuesheet.
-    return;
+  SongList songs = SongList() << *song;
+  EffectiveSongsLoad(&songs, 0, 1);
+  *song = songs.first();
+
+}
+
+void SongLoader::EffectiveSongsLoad(SongList *songs, const qint64 start, const qint64 end) {
+
+  QList<qint64> pending;
+  QList<QUrl> urls;
+  for (qint64 i = start; i < end; ++i) {
+    const Song &song = songs->at(i);
+    if (!song.url().isLocalFile()) continue;
+    if (song.init_from_file() && song.filetype() != Song::FileType::Unknown) {
+      // Maybe we loaded the metadata already, for example from a cuesheet.
+      continue;
+    }
+    pending << i;
+    urls << song.url();
   }
 
-  // First, try to get the song from the collection
-  Song collection_song = collection_backend_->GetSongByUrl(song->url());
-  if (collection_song.is_valid()) {
-    *song = collection_song;
+  if (pending.isEmpty()) return;
+
+  // First, try to get the songs from the collection, all at once
+  QHash<QUrl, Song> collection_songs;
+  const SongList songs_found = collection_backend_->GetSongsByUrls(urls);
+  for (const Song &collection_song : songs_found) {
+    if (collection_song.beginning_nanosec() == 0 && !collection_songs.contains(collection_song.url())) {
+      collection_songs.insert(collection_song.url(), collection_song);
+    }
   }
-  else {
-    // It's a normal media file
-    const QString filename = song->url().toLocalFile();
-    const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(filename, song);
-    if (!result.success()) {
-      qLog(Error) << "Could not read file" << song->url() << result.error;
+
+  for (const qint64 i : std::as_const(pending)) {
+    Song *song = &(*songs)[i];
+    if (collection_songs.contains(song->url())) {
+      *song = collection_songs.value(song->url());
+    }
+    else {
+      // It's a normal media file
+      const QString filename = song->url().toLocalFile();
+      const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(filename, song);
+      if (!result.success()) {
+        qLog(Error) << "Could not read file" << song->url() << result.error;
+      }
     }
   }
 
@@ -374,7 +406,15 @@ void SongLoader::LoadPlaylist(ParserBase *parser, const QString &filename) {
 
   QFile file(filename);
   if (file.open(QIODevice::ReadOnly)) {
-    songs_ = parser->Load(&file, filename, QFileInfo(filename).path());
+    parser->LoadChunked(&file, [this](const SongList &songs) {
+      if (stream_playlists_) {
+        Q_EMIT SongsChunkLoaded(songs);
+      }
+      else {
+        songs_ << songs;
+      }
+      return !abort_;
+    }, filename, QFileInfo(filename).path());
     file.close();
   }
   else {
@@ -402,7 +442,7 @@ void SongLoader::LoadLocalDirectory(const QString &filename) {
 
   QDirIterator it(filename, QDir::Files | QDir::NoDotAndDotDot | QDir::Readable, QDirIterator::Subdirectories);
 
-  while (it.hasNext()) {
+  while (it.hasNext() && !abort_) {
     LoadLocalPartial(it.next());
   }
 
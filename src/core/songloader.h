@@ -26,6 +26,7 @@
 
 #include <memory>
 #include <functional>
+#include <atomic>
 #include <glib.h>
 
 #ifdef HAVE_GSTREAMER
@@ -74,6 +75,12 @@ class SongLoader : public QObject {
   int timeout() const { return timeout_; }
   void set_timeout(int msec) { timeout_ = msec; }
 
+  // When enabled, songs from local playlists are emitted through SongsChunkLoaded() while the playlist is parsed instead of being added to songs().
+  void set_stream_playlists(const bool stream_playlists) { stream_playlists_ = stream_playlists; }
+
+  // Stops a blocking load started in another thread as soon as possible. Thread safe.
+  void Abort() { abort_ = true; }
+
   // If Success is returned the songs are fully loaded. If BlockingLoadRequired is returned LoadFilenamesBlocking() needs to be called next.
   Result Load(const QUrl &url);
   // Loads the files with only filenames. When finished, songs() contains a complete list of all Song objects, but without metadata.
@@ -90,6 +97,7 @@ class SongLoader : public QObject {
   void AudioCDTracksLoadFinished();
   void LoadAudioCDFinished(const bool success);
   void LoadRemoteFinished();
+  void SongsChunkLoaded(const SongList &songs);
 
  private Q_SLOTS:
   void ScheduleTimeout();
@@ -111,6 +119,7 @@ class SongLoader : public QObject {
   Result LoadLocal(const QString &filename);
   SongLoader::Result LoadLocalAsync(const QString &filename);
   void EffectiveSongLoad(Song *song);
+  void EffectiveSongsLoad(SongList *songs, const qint64 start, const qint64 end);
   Result LoadLocalPartial(const QString &filename);
   void LoadLocalDirectory(const QString &filename);
   void LoadPlaylist(ParserBase *parser, const QString &filename);
@@ -166,6 +175,8 @@ class SongLoader : public QObject {
   QStringList errors_;
 
   bool success_;
+  bool stream_playlists_;
+  std::atomic<bool> abort_;
 
 };
 
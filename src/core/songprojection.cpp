@@ -0,0 +1,67 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "config.h"
+
+#include <QString>
+#include <QStringList>
+#include <QSqlRecord>
+
+#include "song.h"
+#include "songprojection.h"
+
+using namespace Qt::StringLiterals;
+
+SongProjection::SongProjection(const QStringList &columns) {
+
+  columns_ << u"ROWID"_s;
+  for (const QString &column : columns) {
+    if (column.compare("ROWID"_L1, Qt::CaseInsensitive) == 0 || columns_.contains(column)) continue;
+    // Song::kColumns follows kColumnTable, so the position of a name is its Song::Column.
+    const qint64 index = Song::kColumns.indexOf(column);
+    Q_ASSERT(index != -1);
+    if (index == -1) continue;
+    columns_ << column;
+    table_columns_ << static_cast<Song::Column>(index);
+  }
+
+}
+
+QString SongProjection::column_spec() const {
+
+  return columns_.join(", "_L1);
+
+}
+
+QString SongProjection::collection_query_column_spec() const {
+
+  return "%songs_table."_L1 + column_spec();
+
+}
+
+void SongProjection::Load(Song *song, const QSqlRecord &r, const int col) const {
+
+  Q_ASSERT(columns_.count() + col <= r.count());
+
+  for (int i = 0; i < table_columns_.count(); ++i) {
+    song->LoadColumn(table_columns_[i], r, col + 1 + i);
+  }
+
+}
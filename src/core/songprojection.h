@@ -0,0 +1,63 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SONGPROJECTION_H
+#define SONGPROJECTION_H
+
+#include "config.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "song.h"
+
+class QSqlRecord;
+class SqlQuery;
+class SqlRow;
+
+// The columns to select from a songs table when only a few fields of each song are needed, for example:
+//   SongProjection projection(QStringList() << u"url"_s << u"playcount"_s);
+//   q.prepare(QStringLiteral("SELECT %1 FROM %2").arg(projection.column_spec(), songs_table));
+//   song.InitFromQuery(q, projection, true);
+// ROWID is always the first column. Fields that are not selected keep their default values,
+// so the songs should not be written back to the database or added to playlists.
+
+class SongProjection {
+ public:
+  explicit SongProjection(const QStringList &columns);
+
+  const QStringList &columns() const { return columns_; }
+  bool contains(const QString &column) const { return columns_.contains(column); }
+
+  // Comma separated columns, for SELECT statements.
+  QString column_spec() const;
+  // Same, with the ROWID qualified with the songs table placeholder used by CollectionQuery.
+  QString collection_query_column_spec() const;
+
+  // Decodes the selected columns after the ROWID, which is at column col of the record.
+  void Load(Song *song, const QSqlRecord &r, const int col = 0) const;
+
+ private:
+  QStringList columns_;
+  QList<Song::Column> table_columns_;
+};
+
+#endif  // SONGPROJECTION_H
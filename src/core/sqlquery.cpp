@@ -20,6 +20,7 @@
 #include "config.h"
 
 #include <QMap>
+#include <QList>
 #include <QVariant>
 #include <QString>
 #include <QUrl>
@@ -28,6 +29,46 @@
 
 using namespace Qt::StringLiterals;
 
+namespace {
+
+QVariant StringValue(const QString &value) {
+  return value.isNull() ? ""_L1 : value;
+}
+
+QVariant UrlValue(const QUrl &value) {
+  return value.isValid() ? value.toString(QUrl::FullyEncoded) : ""_L1;
+}
+
+QVariant IntValue(const int value) {
+  return value <= 0 ? -1 : value;
+}
+
+QVariant LongLongValue(const qint64 value) {
+  return value <= 0 ? -1 : value;
+}
+
+QVariant LongLongValueOrZero(const qint64 value) {
+  return value <= 0 ? 0 : value;
+}
+
+QVariant FloatValue(const float value) {
+  return value <= 0 ? -1 : value;
+}
+
+QVariant DoubleOrNullValue(const std::optional<double> value) {
+  return value.has_value() ? *value : QVariant();
+}
+
+QVariant BoolValue(const bool value) {
+  return value ? 1 : 0;
+}
+
+QVariant NotNullIntValue(const int value) {
+  return value == -1 ? QVariant() : value;
+}
+
+}  // namespace
+
 void SqlQuery::BindValue(const QString &placeholder, const QVariant &value) {
 
   bound_values_.insert(placeholder, value);
@@ -38,55 +79,115 @@ void SqlQuery::BindValue(const QString &placeholder, const QVariant &value) {
 
 void SqlQuery::BindStringValue(const QString &placeholder, const QString &value) {
 
-  BindValue(placeholder, value.isNull() ? ""_L1 : value);
+  BindValue(placeholder, StringValue(value));
 
 }
 
 void SqlQuery::BindUrlValue(const QString &placeholder, const QUrl &value) {
 
-  BindValue(placeholder, value.isValid() ? value.toString(QUrl::FullyEncoded) : ""_L1);
+  BindValue(placeholder, UrlValue(value));
 
 }
 
 void SqlQuery::BindIntValue(const QString &placeholder, const int value) {
 
-  BindValue(placeholder, value <= 0 ? -1 : value);
+  BindValue(placeholder, IntValue(value));
 
 }
 
 void SqlQuery::BindLongLongValue(const QString &placeholder, const qint64 value) {
 
-  BindValue(placeholder, value <= 0 ? -1 : value);
+  BindValue(placeholder, LongLongValue(value));
 
 }
 
 void SqlQuery::BindLongLongValueOrZero(const QString &placeholder, const qint64 value) {
 
-  BindValue(placeholder, value <= 0 ? 0 : value);
+  BindValue(placeholder, LongLongValueOrZero(value));
 
 }
 
 void SqlQuery::BindFloatValue(const QString &placeholder, const float value) {
 
-  BindValue(placeholder, value <= 0 ? -1 : value);
+  BindValue(placeholder, FloatValue(value));
 
 }
 
 void SqlQuery::BindDoubleOrNullValue(const QString &placeholder, const std::optional<double> value) {
 
-  BindValue(placeholder, value.has_value() ? *value : QVariant());
+  BindValue(placeholder, DoubleOrNullValue(value));
 
 }
 
 void SqlQuery::BindBoolValue(const QString &placeholder, const bool value) {
 
-  BindValue(placeholder, value ? 1 : 0);
+  BindValue(placeholder, BoolValue(value));
 
 }
 
 void SqlQuery::BindNotNullIntValue(const QString &placeholder, const int value) {
 
-  BindValue(placeholder, value == -1 ? QVariant() : value);
+  BindValue(placeholder, NotNullIntValue(value));
+
+}
+
+void SqlQuery::AddBindValue(const QVariant &value) {
+
+  addBindValue(value);
+
+}
+
+void SqlQuery::AddBindStringValue(const QString &value) {
+
+  addBindValue(StringValue(value));
+
+}
+
+void SqlQuery::AddBindUrlValue(const QUrl &value) {
+
+  addBindValue(UrlValue(value));
+
+}
+
+void SqlQuery::AddBindIntValue(const int value) {
+
+  addBindValue(IntValue(value));
+
+}
+
+void SqlQuery::AddBindLongLongValue(const qint64 value) {
+
+  addBindValue(LongLongValue(value));
+
+}
+
+void SqlQuery::AddBindLongLongValueOrZero(const qint64 value) {
+
+  addBindValue(LongLongValueOrZero(value));
+
+}
+
+void SqlQuery::AddBindFloatValue(const float value) {
+
+  addBindValue(FloatValue(value));
+
+}
+
+void SqlQuery::AddBindDoubleOrNullValue(const std::optional<double> value) {
+
+  addBindValue(DoubleOrNullValue(value));
+
+}
+
+void SqlQuery::AddBindBoolValue(const bool value) {
+
+  addBindValue(BoolValue(value));
+
+}
+
+void SqlQuery::AddBindNotNullIntValue(const int value) {
+
+  addBindValue(NotNullIntValue(value));
 
 }
 
@@ -94,12 +195,26 @@ bool SqlQuery::Exec() {
 
   bool success = exec();
   last_query_ = executedQuery();
+  const bool positional = bound_values_.isEmpty();
 
   for (QMap<QString, QVariant>::const_iterator it = bound_values_.constBegin(); it != bound_values_.constEnd(); ++it) {
     last_query_.replace(it.key(), it.value().toString());
   }
   bound_values_.clear();
 
+  // Positional values are only filled in for failed queries, they are bound for every row of bulk inserts.
+  if (!success && positional) {
+    const QVariantList values = boundValues();
+    qsizetype pos = 0;
+    for (const QVariant &value : values) {
+      pos = last_query_.indexOf(u'?', pos);
+      if (pos == -1) break;
+      const QString text = value.toString();
+      last_query_.replace(pos, 1, text);
+      pos += text.length();
+    }
+  }
+
   return success;
 
 }
@@ -49,6 +49,18 @@ class SqlQuery : public QSqlQuery {
   void BindBoolValue(const QString &placeholder, const bool value);
   void BindNotNullIntValue(const QString &placeholder, const int value);
 
+  // Positional binding for queries using ? placeholders, values are bound in the order they are added.
+  void AddBindValue(const QVariant &value);
+  void AddBindStringValue(const QString &value);
+  void AddBindUrlValue(const QUrl &value);
+  void AddBindIntValue(const int value);
+  void AddBindLongLongValue(const qint64 value);
+  void AddBindLongLongValueOrZero(const qint64 value);
+  void AddBindFloatValue(const float value);
+  void AddBindDoubleOrNullValue(const std::optional<double> value);
+  void AddBindBoolValue(const bool value);
+  void AddBindNotNullIntValue(const int value);
+
   bool Exec();
   QString LastQuery() const;
 
@@ -0,0 +1,232 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <atomic>
+#include <utility>
+
+#include <QtGlobal>
+#include <QCoreApplication>
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include "core/logging.h"
+#include "startupprofiler.h"
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+struct StartupEvent {
+  const char *name;
+  const char *parent;
+  char phase;
+  qint64 start;
+  qint64 duration;
+  Qt::HANDLE thread_id;
+  QString thread_name;
+};
+
+struct StartupTrace {
+  QMutex mutex;
+  QString filename;
+  QList<StartupEvent> events;
+};
+
+Q_GLOBAL_STATIC(StartupTrace, sStartupTrace)
+
+QElapsedTimer sStartupTimer;
+std::atomic<bool> sStartupProfilerEnabled(false);
+
+// The scopes that are open on each thread, innermost last.
+thread_local QList<const char*> sOpenScopes;
+
+}  // namespace
+
+void StartupProfiler::Start() {
+
+  if (!sStartupTimer.isValid()) sStartupTimer.start();
+
+}
+
+void StartupProfiler::Enable(const QString &filename) {
+
+  Start();
+
+  QMutexLocker l(&sStartupTrace->mutex);
+  sStartupTrace->filename = filename;
+  sStartupProfilerEnabled = true;
+
+}
+
+bool StartupProfiler::enabled() {
+
+  return sStartupProfilerEnabled;
+
+}
+
+qint64 StartupProfiler::Now() {
+
+  return sStartupTimer.isValid() ? sStartupTimer.nsecsElapsed() / 1000 : 0;
+
+}
+
+qint64 StartupProfiler::elapsed() {
+
+  return Now() / 1000;
+
+}
+
+void StartupProfiler::AddEvent(const char *name, const char *parent, const char phase, const qint64 start, const qint64 duration) {
+
+  if (!enabled()) return;
+
+  StartupEvent event;
+  event.name = name;
+  event.parent = parent;
+  event.phase = phase;
+  event.start = start;
+  event.duration = duration;
+  event.thread_id = QThread::currentThreadId();
+  event.thread_name = QThread::currentThread()->objectName();
+
+  QMutexLocker l(&sStartupTrace->mutex);
+  sStartupTrace->events << event;
+
+}
+
+void StartupProfiler::Mark(const char *name) {
+
+  if (!enabled()) return;
+
+  AddEvent(name, sOpenScopes.isEmpty() ? nullptr : sOpenScopes.last(), 'i', Now(), 0);
+
+}
+
+void StartupProfiler::Finish() {
+
+  if (!sStartupProfilerEnabled.exchange(false)) return;
+
+  QMutexLocker l(&sStartupTrace->mutex);
+
+  const qint64 pid = QCoreApplication::applicationPid();
+
+  // Thread handles don't fit in a JSON number, number the threads in the order they show up instead.
+  QMap<Qt::HANDLE, int> thread_ids;
+  QMap<int, QString> thread_names;
+
+  QJsonArray trace_events;
+  for (const StartupEvent &event : std::as_const(sStartupTrace->events)) {
+    if (!thread_ids.contains(event.thread_id)) {
+      thread_ids.insert(event.thread_id, static_cast<int>(thread_ids.count()) + 1);
+    }
+    const int thread_id = thread_ids.value(event.thread_id);
+    if (!event.thread_name.isEmpty()) {
+      thread_names.insert(thread_id, event.thread_name);
+    }
+
+    QJsonObject trace_event;
+    trace_event["name"_L1] = QString::fromLatin1(event.name);
+    trace_event["cat"_L1] = u"startup"_s;
+    trace_event["ph"_L1] = QString(QLatin1Char(event.phase));
+    trace_event["ts"_L1] = event.start;
+    if (event.phase == 'X') {
+      trace_event["dur"_L1] = event.duration;
+    }
+    else {
+      trace_event["s"_L1] = u"t"_s;
+    }
+    trace_event["pid"_L1] = pid;
+    trace_event["tid"_L1] = thread_id;
+    if (event.parent) {
+      QJsonObject args;
+      args["parent"_L1] = QString::fromLatin1(event.parent);
+      trace_event["args"_L1] = args;
+    }
+    trace_events << trace_event;
+  }
+
+  for (QMap<int, QString>::const_iterator it = thread_names.constBegin(); it != thread_names.constEnd(); ++it) {
+    QJsonObject args;
+    args["name"_L1] = it.value();
+    QJsonObject trace_event;
+    trace_event["name"_L1] = u"thread_name"_s;
+    trace_event["ph"_L1] = u"M"_s;
+    trace_event["pid"_L1] = pid;
+    trace_event["tid"_L1] = it.key();
+    trace_event["args"_L1] = args;
+    trace_events << trace_event;
+  }
+
+  QJsonObject trace;
+  trace["traceEvents"_L1] = trace_events;
+  trace["displayTimeUnit"_L1] = u"ms"_s;
+
+  const qint64 event_count = sStartupTrace->events.count();
+  sStartupTrace->events.clear();
+
+  QFile file(sStartupTrace->filename);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qLog(Error) << "Could not open startup trace file" << sStartupTrace->filename << "for writing:" << file.errorString();
+    return;
+  }
+  file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+  file.close();
+
+  qLog(Info) << "Startup trace with" << event_count << "events written to" << sStartupTrace->filename;
+
+}
+
+StartupProfiler::Scope::Scope(const char *name) : name_(name), parent_(nullptr), start_(0), active_(StartupProfiler::enabled()) {
+
+  if (!active_) return;
+
+  parent_ = sOpenScopes.isEmpty() ? nullptr : sOpenScopes.last();
+  sOpenScopes << name_;
+  start_ = StartupProfiler::Now();
+
+}
+
+StartupProfiler::Scope::~Scope() {
+
+  Finish();
+
+}
+
+void StartupProfiler::Scope::Finish() {
+
+  if (!active_) return;
+  active_ = false;
+
+  StartupProfiler::AddEvent(name_, parent_, 'X', start_, StartupProfiler::Now() - start_);
+
+  const qsizetype i = sOpenScopes.lastIndexOf(name_);
+  if (i != -1) sOpenScopes.removeAt(i);
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QString>
+
+// Records how long startup takes, as a Chrome trace that can be opened in chrome://tracing or Perfetto.
+// Scopes that start while another scope is open on the same thread are recorded as dependencies of that scope,
+// so the trace shows which component pulled in which.
+// Nothing is recorded unless Enable() was called, and recording stops when the trace is written by Finish().
+
+class StartupProfiler {
+
+ public:
+  // Starts the clock, this should be called first thing in main().
+  static void Start();
+
+  static void Enable(const QString &filename);
+  static bool enabled();
+
+  // Milliseconds since Start().
+  static qint64 elapsed();
+
+  static void Mark(const char *name);
+  static void Finish();
+
+  class Scope {
+   public:
+    explicit Scope(const char *name);
+    ~Scope();
+
+    // Ends the scope before it goes out of scope.
+    void Finish();
+
+   private:
+    Q_DISABLE_COPY(Scope)
+
+    const char *name_;
+    const char *parent_;
+    qint64 start_;
+    bool active_;
+  };
+
+ private:
+  static qint64 Now();
+  static void AddEvent(const char *name, const char *parent, const char phase, const qint64 start, const qint64 duration);
+};
+
+#endif  // STARTUPPROFILER_H
@@ -58,6 +58,8 @@ TagReaderClient::TagReaderClient(QObject *parent) : QObject(parent), worker_pool
 
 void TagReaderClient::Start() { worker_pool_->Start(); }
 
+void TagReaderClient::RaiseWorkerCount(const int count) { worker_pool_->RaiseWorkerCount(count); }
+
 void TagReaderClient::ExitAsync() {
   QMetaObject::invokeMethod(this, &TagReaderClient::Exit, Qt::QueuedConnection);
 }
@@ -78,7 +80,7 @@ TagReaderReply *TagReaderClient::IsMediaFile(const QString &filename) {
 
   spb::tagreader::Message message;
   message.mutable_is_media_file_request()->set_filename(filename.toStdString());
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, filename);
 
 }
 
@@ -86,7 +88,7 @@ TagReaderReply *TagReaderClient::ReadFile(const QString &filename) {
 
   spb::tagreader::Message message;
   message.mutable_read_file_request()->set_filename(filename.toStdString());
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, filename);
 
 }
 
@@ -114,7 +116,7 @@ TagReaderReply *TagReaderClient::WriteFile(const QString &filename, const Song &
 
   metadata.ToProtobuf(request->mutable_metadata());
 
-  ReplyType *reply = worker_pool_->SendMessageWithReply(&message);
+  ReplyType *reply = worker_pool_->SendMessageWithReply(&message, filename);
 
   return reply;
 
@@ -127,7 +129,7 @@ TagReaderReply *TagReaderClient::LoadEmbeddedArt(const QString &filename) {
 
   request->set_filename(filename.toStdString());
 
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, filename);
 
 }
 
@@ -148,7 +150,7 @@ TagReaderReply *TagReaderClient::SaveEmbeddedArt(const QString &filename, const
     request->set_cover_mime_type(save_cover_options.mime_type.toStdString());
   }
 
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, filename);
 
 }
 
@@ -160,7 +162,7 @@ TagReaderReply *TagReaderClient::SaveSongPlaycount(const QString &filename, cons
   request->set_filename(filename.toStdString());
   request->set_playcount(playcount);
 
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, filename);
 
 }
 
@@ -181,7 +183,7 @@ TagReaderReply *TagReaderClient::SaveSongRating(const QString &filename, const f
   request->set_filename(filename.toStdString());
   request->set_rating(rating);
 
-  return worker_pool_->SendMessageWithReply(&message);
+  return worker_pool_->SendMessageWithReply(&message, filename);
 
 }
 
@@ -51,6 +51,11 @@ class TagReaderClient : public QObject {
   void Start();
   void ExitAsync();
 
+  // Requests for different files are spread over the workers, so this many can be processed at the same time.
+  // Requests for the same file always go to the same worker, in order.
+  int worker_count() const { return worker_pool_->worker_count(); }
+  void RaiseWorkerCount(const int count);
+
   enum class SaveType {
     NoType = 0,
     Tags = 1,
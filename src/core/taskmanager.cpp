@@ -45,6 +45,8 @@ int TaskManager::StartTask(const QString &name) {
   t.progress = 0;
   t.progress_max = 0;
   t.blocks_collection_scans = false;
+  t.cancellable = false;
+  t.cancelled = false;
 
   {
     QMutexLocker l(&mutex_);
@@ -84,6 +86,40 @@ void TaskManager::SetTaskBlocksCollectionScans(const int id) {
 
 }
 
+void TaskManager::SetTaskCancellable(const int id) {
+
+  {
+    QMutexLocker l(&mutex_);
+    if (!tasks_.contains(id)) return;
+
+    tasks_[id].cancellable = true;
+  }
+
+  Q_EMIT TasksChanged();
+
+}
+
+void TaskManager::CancelTask(const int id) {
+
+  {
+    QMutexLocker l(&mutex_);
+    if (!tasks_.contains(id) || !tasks_.value(id).cancellable || tasks_.value(id).cancelled) return;
+
+    tasks_[id].cancelled = true;
+  }
+
+  Q_EMIT TaskCancelled(id);
+  Q_EMIT TasksChanged();
+
+}
+
+bool TaskManager::IsTaskCancelled(const int id) {
+
+  QMutexLocker l(&mutex_);
+  return tasks_.contains(id) && tasks_.value(id).cancelled;
+
+}
+
 void TaskManager::SetTaskProgress(const int id, const quint64 progress, const quint64 max) {
 
   {
@@ -38,12 +38,14 @@ class TaskManager : public QObject {
   explicit TaskManager(QObject *parent = nullptr);
 
   struct Task {
-    Task() : id(0), progress(0), progress_max(0), blocks_collection_scans(false) {}
+    Task() : id(0), progress(0), progress_max(0), blocks_collection_scans(false), cancellable(false), cancelled(false) {}
     int id;
     QString name;
     quint64 progress;
     quint64 progress_max;
     bool blocks_collection_scans;
+    bool cancellable;
+    bool cancelled;
   };
 
   class ScopedTask {
@@ -64,6 +66,9 @@ class TaskManager : public QObject {
 
   int StartTask(const QString &name);
   void SetTaskBlocksCollectionScans(const int id);
+  void SetTaskCancellable(const int id);
+  void CancelTask(const int id);
+  bool IsTaskCancelled(const int id);
   void SetTaskProgress(const int id, const quint64 progress, const quint64 max = 0);
   void IncreaseTaskProgress(const int id, const quint64 progress, const quint64 max = 0);
   void SetTaskFinished(const int id);
@@ -71,6 +76,7 @@ class TaskManager : public QObject {
 
  Q_SIGNALS:
   void TasksChanged();
+  void TaskCancelled(const int id);
 
   void PauseCollectionWatchers();
   void ResumeCollectionWatchers();
@@ -20,17 +20,26 @@
 
 #include "config.h"
 
+#include <algorithm>
+
 #include <QObject>
+#include <QThread>
 #include <QThreadPool>
+#include <QList>
+#include <QHash>
+#include <QString>
 
+#include "core/shared_ptr.h"
 #include "core/song.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverexport.h"
 #include "albumcoverexporter.h"
 #include "coverexportrunnable.h"
 
+using std::make_shared;
+
 namespace {
-constexpr int kMaxConcurrentRequests = 3;
+constexpr int kMinConcurrentRequests = 3;
 }
 
 AlbumCoverExporter::AlbumCoverExporter(QObject *parent)
@@ -39,7 +48,7 @@ AlbumCoverExporter::AlbumCoverExporter(QObject *parent)
       exported_(0),
       skipped_(0),
       all_(0) {
-  thread_pool_->setMaxThreadCount(kMaxConcurrentRequests);
+  thread_pool_->setMaxThreadCount(std::max(kMinConcurrentRequests, QThread::idealThreadCount()));
 }
 
 void AlbumCoverExporter::SetDialogResult(const AlbumCoverExport::DialogResult &dialog_result) {
@@ -52,17 +61,40 @@ void AlbumCoverExporter::SetCoverTypes(const AlbumCoverLoaderOptions::Types &cov
 
 void AlbumCoverExporter::AddExportRequest(const Song &song) {
 
-  requests_.append(new CoverExportRunnable(dialog_result_, cover_types_, song));
-  all_ = static_cast<int>(requests_.count());
+  songs_ << song;
+  all_ = static_cast<int>(songs_.count());
 
 }
 
-void AlbumCoverExporter::Cancel() { requests_.clear(); }
+void AlbumCoverExporter::Cancel() {
+
+  songs_.clear();
+  qDeleteAll(requests_);
+  requests_.clear();
+
+}
 
 void AlbumCoverExporter::StartExporting() {
 
   exported_ = 0;
   skipped_ = 0;
+  timer_.start();
+
+  // Albums sharing the same source image are exported by one runnable, so the image is only read and encoded once.
+  QList<QString> keys;
+  QHash<QString, SongList> songs_by_key;
+  for (const Song &song : std::as_const(songs_)) {
+    const QString key = CoverExportRunnable::SourceKey(dialog_result_, cover_types_, song);
+    if (!songs_by_key.contains(key)) keys << key;
+    songs_by_key[key] << song;
+  }
+  songs_.clear();
+
+  SharedPtr<CoverExportWrittenFiles> written_files = make_shared<CoverExportWrittenFiles>();
+  for (const QString &key : std::as_const(keys)) {
+    requests_.enqueue(new CoverExportRunnable(dialog_result_, cover_types_, songs_by_key.value(key), written_files));
+  }
+
   AddJobsToPool();
 
 }
@@ -95,3 +127,12 @@ void AlbumCoverExporter::CoverSkipped() {
   AddJobsToPool();
 
 }
+
+double AlbumCoverExporter::covers_per_second() const {
+
+  const qint64 elapsed = timer_.isValid() ? timer_.elapsed() : 0;
+  if (elapsed <= 0) return 0.0;
+
+  return static_cast<double>(exported_ + skipped_) * 1000.0 / static_cast<double>(elapsed);
+
+}
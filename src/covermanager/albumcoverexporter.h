@@ -26,12 +26,13 @@
 #include <QObject>
 #include <QQueue>
 #include <QString>
+#include <QElapsedTimer>
 
+#include "core/song.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverexport.h"
 
 class QThreadPool;
-class Song;
 class CoverExportRunnable;
 
 class AlbumCoverExporter : public QObject {
@@ -46,7 +47,8 @@ class AlbumCoverExporter : public QObject {
   void StartExporting();
   void Cancel();
 
-  int request_count() { return static_cast<int>(requests_.size()); }
+  int request_count() { return static_cast<int>(songs_.size()); }
+  double covers_per_second() const;
 
  Q_SIGNALS:
   void AlbumCoversExportUpdate(const int exported, const int skipped, const int all);
@@ -61,12 +63,14 @@ class AlbumCoverExporter : public QObject {
   AlbumCoverLoaderOptions::Types cover_types_;
   AlbumCoverExport::DialogResult dialog_result_;
 
+  SongList songs_;
   QQueue<CoverExportRunnable*> requests_;
   QThreadPool *thread_pool_;
 
   int exported_;
   int skipped_;
   int all_;
+  QElapsedTimer timer_;
 };
 
 #endif  // ALBUMCOVEREXPORTER_H
@@ -27,17 +27,23 @@
 #include <QObject>
 #include <QTimer>
 #include <QString>
+#include <QList>
+#include <QHash>
 
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
 #include "core/song.h"
 #include "albumcoverfetcher.h"
 #include "albumcoverfetchersearch.h"
+#include "coverprovider.h"
+#include "coverproviderratelimiter.h"
 
 using namespace std::chrono_literals;
 
 namespace {
 constexpr int kMaxConcurrentRequests = 5;
+constexpr int kBatchRequestsPerMinute = 30;
+constexpr int kBatchRequestsBurst = 5;
 }
 
 AlbumCoverFetcher::AlbumCoverFetcher(SharedPtr<CoverProviders> cover_providers, SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -123,9 +129,22 @@ void AlbumCoverFetcher::StartRequests() {
     return;
   }
 
-  while (!queued_requests_.isEmpty() && active_requests_.size() < kMaxConcurrentRequests) {
+  // Batch requests wait until every provider they use has a token left, the other requests are started right away.
+  bool batch_ready = true;
+  QQueue<CoverSearchRequest>::iterator it = queued_requests_.begin();
+  while (it != queued_requests_.end() && active_requests_.size() < kMaxConcurrentRequests) {
 
-    CoverSearchRequest request = queued_requests_.dequeue();
+    if (it->batch) {
+      if (batch_ready) batch_ready = CanStartBatchRequest(*it);
+      if (!batch_ready) {
+        ++it;
+        continue;
+      }
+      BatchRequestStarted(*it);
+    }
+
+    CoverSearchRequest request = *it;
+    it = queued_requests_.erase(it);
 
     // Search objects are this fetcher's children so worst case scenario - they get deleted with it
     AlbumCoverFetcherSearch *search = new AlbumCoverFetcherSearch(request, network_, this);
@@ -139,6 +158,33 @@ void AlbumCoverFetcher::StartRequests() {
 
 }
 
+bool AlbumCoverFetcher::CanStartBatchRequest(const CoverSearchRequest &request) {
+
+  const QList<CoverProvider*> providers = AlbumCoverFetcherSearch::ProvidersForRequest(cover_providers_, request);
+  for (CoverProvider *provider : providers) {
+    QHash<QString, CoverProviderRateLimiter>::iterator it = rate_limiters_.find(provider->name());
+    if (it != rate_limiters_.end() && !it->CanStart()) {
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+void AlbumCoverFetcher::BatchRequestStarted(const CoverSearchRequest &request) {
+
+  const QList<CoverProvider*> providers = AlbumCoverFetcherSearch::ProvidersForRequest(cover_providers_, request);
+  for (CoverProvider *provider : providers) {
+    QHash<QString, CoverProviderRateLimiter>::iterator it = rate_limiters_.find(provider->name());
+    if (it == rate_limiters_.end()) {
+      it = rate_limiters_.insert(provider->name(), CoverProviderRateLimiter(kBatchRequestsPerMinute, kBatchRequestsBurst));
+    }
+    it->Started();
+  }
+
+}
+
 void AlbumCoverFetcher::SingleSearchFinished(const quint64 request_id, const CoverProviderSearchResults &results) {
 
   if (!active_requests_.contains(request_id)) return;
@@ -40,6 +40,7 @@
 
 #include "coversearchstatistics.h"
 #include "albumcoverimageresult.h"
+#include "coverproviderratelimiter.h"
 
 class QTimer;
 class NetworkAccessManager;
@@ -128,6 +129,8 @@ class AlbumCoverFetcher : public QObject {
 
  private:
   void AddRequest(const CoverSearchRequest &req);
+  bool CanStartBatchRequest(const CoverSearchRequest &request);
+  void BatchRequestStarted(const CoverSearchRequest &request);
 
   SharedPtr<CoverProviders> cover_providers_;
   SharedPtr<NetworkAccessManager> network_;
@@ -135,6 +138,7 @@ class AlbumCoverFetcher : public QObject {
 
   QQueue<CoverSearchRequest> queued_requests_;
   QHash<quint64, AlbumCoverFetcherSearch*> active_requests_;
+  QHash<QString, CoverProviderRateLimiter> rate_limiters_;
 
   QTimer *request_starter_;
 };
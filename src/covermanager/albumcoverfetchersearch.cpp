@@ -55,6 +55,9 @@ constexpr int kSearchTimeoutMs = 20000;
 constexpr int kImageLoadTimeoutMs = 6000;
 constexpr int kTargetSize = 500;
 constexpr float kGoodScore = 4.0;
+constexpr int kImagesPerRound = 3;
+// When the best result scores this much higher than the next one, only its image is downloaded.
+constexpr float kClearScoreMargin = 1.0;
 }  // namespace
 
 AlbumCoverFetcherSearch::AlbumCoverFetcherSearch(const CoverSearchRequest &request, SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -62,7 +65,9 @@ AlbumCoverFetcherSearch::AlbumCoverFetcherSearch(const CoverSearchRequest &reque
       request_(request),
       image_load_timeout_(new NetworkTimeouts(kImageLoadTimeoutMs, this)),
       network_(network),
-      cancel_requested_(false) {
+      cancel_requested_(false),
+      images_requested_(false),
+      search_incomplete_(false) {
 
   // We will terminate the search after kSearchTimeoutMs milliseconds if we are not able to find all of the results before that point in time
   QTimer::singleShot(kSearchTimeoutMs, this, &AlbumCoverFetcherSearch::TerminateSearch);
@@ -76,6 +81,9 @@ AlbumCoverFetcherSearch::~AlbumCoverFetcherSearch() {
 
 void AlbumCoverFetcherSearch::TerminateSearch() {
 
+  // Providers that did not answer in time might still have a cover.
+  if (!pending_requests_.isEmpty()) search_incomplete_ = true;
+
   const QList<int> ids = pending_requests_.keys();
   for (const int id : ids) {
     pending_requests_.take(id)->CancelSearch(id);
@@ -93,9 +101,34 @@ void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
     return;
   }
 
+  const QList<CoverProvider*> providers = ProvidersForRequest(cover_providers, request_);
+  for (CoverProvider *provider : providers) {
+
+    QObject::connect(provider, &CoverProvider::SearchResults, this, QOverload<const int, const CoverProviderSearchResults&>::of(&AlbumCoverFetcherSearch::ProviderSearchResults));
+    QObject::connect(provider, &CoverProvider::SearchFinished, this, &AlbumCoverFetcherSearch::ProviderSearchFinished);
+    const int id = cover_providers->NextId();
+    const bool success = provider->StartSearch(request_.artist, request_.album, request_.title, id);
+
+    if (success) {
+      pending_requests_[id] = provider;
+      provider_error_counts_.insert(provider, provider->error_count());
+      statistics_.network_requests_made_++;
+    }
+  }
+
+  // End this search before it even began if there are no providers...
+  if (pending_requests_.isEmpty()) {
+    TerminateSearch();
+  }
+
+}
+
+QList<CoverProvider*> AlbumCoverFetcherSearch::ProvidersForRequest(SharedPtr<CoverProviders> cover_providers, const CoverSearchRequest &request) {
+
   QList<CoverProvider*> cover_providers_sorted = cover_providers->List();
   std::stable_sort(cover_providers_sorted.begin(), cover_providers_sorted.end(), ProviderCompareOrder);
 
+  QList<CoverProvider*> providers;
   for (CoverProvider *provider : std::as_const(cover_providers_sorted)) {
 
     if (!provider->is_enabled()) continue;
@@ -106,30 +139,20 @@ void AlbumCoverFetcherSearch::Start(SharedPtr<CoverProviders> cover_providers) {
     }
 
     // Skip provider if it does not have batch set and we are doing a batch - "Fetch Missing Covers".
-    if (!provider->batch() && request_.batch) {
+    if (!provider->batch() && request.batch) {
       continue;
     }
 
     // If artist and album is missing, check if we can still use this provider by searching using title.
-    if (!provider->allow_missing_album() && request_.album.isEmpty() && !request_.title.isEmpty()) {
+    if (!provider->allow_missing_album() && request.album.isEmpty() && !request.title.isEmpty()) {
       continue;
     }
 
-    QObject::connect(provider, &CoverProvider::SearchResults, this, QOverload<const int, const CoverProviderSearchResults&>::of(&AlbumCoverFetcherSearch::ProviderSearchResults));
-    QObject::connect(provider, &CoverProvider::SearchFinished, this, &AlbumCoverFetcherSearch::ProviderSearchFinished);
-    const int id = cover_providers->NextId();
-    const bool success = provider->StartSearch(request_.artist, request_.album, request_.title, id);
+    providers << provider;
 
-    if (success) {
-      pending_requests_[id] = provider;
-      statistics_.network_requests_made_++;
-    }
   }
 
-  // End this search before it even began if there are no providers...
-  if (pending_requests_.isEmpty()) {
-    TerminateSearch();
-  }
+  return providers;
 
 }
 
@@ -262,7 +285,9 @@ void AlbumCoverFetcherSearch::AllProvidersFinished() {
   // No results?
   if (results_.isEmpty()) {
     statistics_.missing_images_++;
-    Q_EMIT AlbumCoverFetched(request_.id, AlbumCoverImageResult());
+    AlbumCoverImageResult result;
+    result.not_found = !search_incomplete_ && !provider_error_counts_.isEmpty() && !ProvidersFailed();
+    Q_EMIT AlbumCoverFetched(request_.id, result);
     return;
   }
 
@@ -276,8 +301,26 @@ void AlbumCoverFetcherSearch::AllProvidersFinished() {
 
 }
 
+bool AlbumCoverFetcherSearch::ProvidersFailed() const {
+
+  // Errors are not reported per search, so an error during any search counts against this one as well.
+  for (QMap<CoverProvider*, int>::const_iterator it = provider_error_counts_.constBegin(); it != provider_error_counts_.constEnd(); ++it) {
+    if (it.key()->error_count() != it.value()) return true;
+  }
+
+  return false;
+
+}
+
 void AlbumCoverFetcherSearch::FetchMoreImages() {
 
+  // On the first round, skip downloading the other candidates if the best one is clearly ahead of them.
+  int max_images = kImagesPerRound;
+  if (!images_requested_ && (results_.count() == 1 || (results_.count() > 1 && results_[0].score() - results_[1].score() >= kClearScoreMargin))) {
+    max_images = 1;
+  }
+  images_requested_ = true;
+
   int i = 0;
   while (!results_.isEmpty()) {
     ++i;
@@ -294,7 +337,7 @@ void AlbumCoverFetcherSearch::FetchMoreImages() {
 
     ++statistics_.network_requests_made_;
 
-    if (i >= 3) break;
+    if (i >= max_images) break;
 
   }
 
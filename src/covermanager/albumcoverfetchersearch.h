@@ -27,6 +27,7 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QPair>
+#include <QList>
 #include <QMap>
 #include <QMultiMap>
 #include <QHash>
@@ -58,6 +59,9 @@ class AlbumCoverFetcherSearch : public QObject {
 
   void Start(SharedPtr<CoverProviders> cover_providers);
 
+  // The enabled providers that can be used for the request, in the configured order.
+  static QList<CoverProvider*> ProvidersForRequest(SharedPtr<CoverProviders> cover_providers, const CoverSearchRequest &request);
+
   // Cancels all pending requests.  No Finished signals will be emitted, and it is the caller's responsibility to delete the AlbumCoverFetcherSearch.
   void Cancel();
 
@@ -81,6 +85,7 @@ class AlbumCoverFetcherSearch : public QObject {
  private:
   void ProviderSearchResults(CoverProvider *provider, const CoverProviderSearchResults &results);
   void AllProvidersFinished();
+  bool ProvidersFailed() const;
 
   void FetchMoreImages();
   static float ScoreImage(const QSize size);
@@ -99,6 +104,8 @@ class AlbumCoverFetcherSearch : public QObject {
   CoverProviderSearchResults results_;
 
   QMap<int, CoverProvider*> pending_requests_;
+  // Error count of each provider when the search was started.
+  QMap<CoverProvider*, int> provider_error_counts_;
   QHash<QNetworkReply*, CoverProviderSearchResult> pending_image_loads_;
   NetworkTimeouts *image_load_timeout_;
 
@@ -113,6 +120,8 @@ class AlbumCoverFetcherSearch : public QObject {
   SharedPtr<NetworkAccessManager> network_;
 
   bool cancel_requested_;
+  bool images_requested_;
+  bool search_incomplete_;
 
 };
 
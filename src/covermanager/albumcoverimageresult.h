@@ -32,14 +32,18 @@ class AlbumCoverImageResult {
     : cover_url(_cover_url),
       mime_type(_mime_type),
       image_data(_image_data),
-      image(_image) {}
-  explicit AlbumCoverImageResult(const QImage &_image) : image(_image) {}
+      image(_image),
+      not_found(false) {}
+  explicit AlbumCoverImageResult(const QImage &_image) : image(_image), not_found(false) {}
 
   QUrl cover_url;
   QString mime_type;
   QByteArray image_data;
   QImage image;
 
+  // Set by a cover search when every provider completed without errors and none of them had a candidate.
+  bool not_found;
+
   bool is_valid() const { return !image_data.isNull() || !image.isNull(); }
   bool is_jpeg() const { return mime_type == QStringLiteral("image/jpeg") && !image_data.isEmpty(); }
 };
@@ -31,9 +31,13 @@
 #include <QScreen>
 #include <QItemSelectionModel>
 #include <QListWidgetItem>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 #include <QFileInfo>
 #include <QFile>
 #include <QSet>
+#include <QHash>
 #include <QVariant>
 #include <QString>
 #include <QStringList>
@@ -41,6 +45,7 @@
 #include <QImage>
 #include <QImageWriter>
 #include <QPixmap>
+#include <QIcon>
 #include <QPainter>
 #include <QTimer>
 #include <QMenu>
@@ -64,10 +69,9 @@
 #include "core/scoped_ptr.h"
 #include "core/shared_ptr.h"
 #include "core/application.h"
+#include "core/logging.h"
 #include "core/iconloader.h"
 #include "core/tagreaderclient.h"
-#include "core/database.h"
-#include "core/sqlrow.h"
 #include "core/settings.h"
 #include "utilities/strutils.h"
 #include "utilities/fileutils.h"
@@ -77,10 +81,10 @@
 #include "widgets/forcescrollperpixel.h"
 #include "widgets/searchfield.h"
 #include "collection/collectionbackend.h"
-#include "collection/collectionquery.h"
 #include "playlist/songmimedata.h"
 #include "coverproviders.h"
 #include "albumcovermanager.h"
+#include "albumcovermanagermodel.h"
 #include "albumcoversearcher.h"
 #include "albumcoverchoicecontroller.h"
 #include "albumcoverexport.h"
@@ -90,6 +94,7 @@
 #include "albumcoverloaderresult.h"
 #include "coversearchstatistics.h"
 #include "coversearchstatisticsdialog.h"
+#include "coversearchmisscache.h"
 #include "albumcoverimageresult.h"
 
 #include "ui_albumcovermanager.h"
@@ -100,6 +105,7 @@ using namespace Qt::StringLiterals;
 namespace {
 constexpr char kSettingsGroup[] = "CoverManager";
 constexpr int kThumbnailSize = 120;
+constexpr int kAlbumsPerPage = 500;
 }
 
 AlbumCoverManager::AlbumCoverManager(Application *app, SharedPtr<CollectionBackend> collection_backend, QMainWindow *mainwindow, QWidget *parent)
@@ -109,11 +115,16 @@ AlbumCoverManager::AlbumCoverManager(Application *app, SharedPtr<CollectionBacke
       app_(app),
       collection_backend_(collection_backend),
       album_cover_choice_controller_(new AlbumCoverChoiceController(this)),
-      timer_album_cover_load_(new QTimer(this)),
+      albums_model_(nullptr),
+      timer_album_pages_(new QTimer(this)),
       filter_all_(nullptr),
       filter_with_covers_(nullptr),
       filter_without_covers_(nullptr),
+      albums_load_id_(0),
+      albums_pending_pos_(0),
+      albums_pending_show_album_artist_(false),
       cover_fetcher_(new AlbumCoverFetcher(app_->cover_providers(), app_->network(), this)),
+      cover_search_misses_(new CoverSearchMissCache(app_->database())),
       cover_searcher_(nullptr),
       cover_export_(nullptr),
       cover_exporter_(new AlbumCoverExporter(this)),
@@ -128,11 +139,16 @@ AlbumCoverManager::AlbumCoverManager(Application *app, SharedPtr<CollectionBacke
       all_artists_(nullptr) {
 
   ui_->setupUi(this);
-  ui_->albums->set_cover_manager(this);
 
-  timer_album_cover_load_->setSingleShot(false);
-  timer_album_cover_load_->setInterval(10ms);
-  QObject::connect(timer_album_cover_load_, &QTimer::timeout, this, &AlbumCoverManager::LoadAlbumCovers);
+  albums_model_ = new AlbumCoverManagerModel(collection_backend_, icon_nocover_item_, this);
+  ui_->albums->setModel(albums_model_);
+  QObject::connect(albums_model_, &AlbumCoverManagerModel::CountsChanged, this, &AlbumCoverManager::UpdateCounts);
+  QObject::connect(ui_->albums, &AlbumCoverManagerList::VisibleRowsChanged, this, &AlbumCoverManager::LoadVisibleAlbumCovers);
+
+  // Add the albums a page at a time, so the view stays responsive while a large collection is added.
+  timer_album_pages_->setSingleShot(false);
+  timer_album_pages_->setInterval(0ms);
+  QObject::connect(timer_album_pages_, &QTimer::timeout, this, &AlbumCoverManager::AddAlbumsPage);
 
   // Icons
   ui_->action_fetch->setIcon(IconLoader::Load(QStringLiteral("download")));
@@ -222,7 +238,7 @@ void AlbumCoverManager::Init() {
   QObject::connect(ui_->export_covers, &QPushButton::clicked, this, &AlbumCoverManager::ExportCovers);
   QObject::connect(cover_fetcher_, &AlbumCoverFetcher::AlbumCoverFetched, this, &AlbumCoverManager::AlbumCoverFetched);
   QObject::connect(ui_->action_fetch, &QAction::triggered, this, &AlbumCoverManager::FetchSingleCover);
-  QObject::connect(ui_->albums, &QListWidget::doubleClicked, this, &AlbumCoverManager::AlbumDoubleClicked);
+  QObject::connect(ui_->albums, &QListView::doubleClicked, this, &AlbumCoverManager::AlbumDoubleClicked);
   QObject::connect(ui_->action_add_to_playlist, &QAction::triggered, this, &AlbumCoverManager::AddSelectedToPlaylist);
   QObject::connect(ui_->action_load, &QAction::triggered, this, &AlbumCoverManager::LoadSelectedToPlaylist);
 
@@ -280,7 +296,10 @@ void AlbumCoverManager::closeEvent(QCloseEvent *e) {
   CancelRequests();
 
   ui_->artists->clear();
-  ui_->albums->clear();
+  ++albums_load_id_;
+  timer_album_pages_->stop();
+  albums_pending_.clear();
+  albums_model_->Clear();
 
   QMainWindow::closeEvent(e);
 
@@ -321,8 +340,8 @@ void AlbumCoverManager::SaveSettings() {
 void AlbumCoverManager::CancelRequests() {
 
   app_->album_cover_loader()->CancelTasks(QSet<quint64>(cover_loading_tasks_.keyBegin(), cover_loading_tasks_.keyEnd()));
-  cover_loading_pending_.clear();
   cover_loading_tasks_.clear();
+  cover_loading_albums_.clear();
   cover_save_tasks_.clear();
 
   cover_exporter_->Cancel();
@@ -350,7 +369,7 @@ void AlbumCoverManager::Reset() {
 
   ui_->artists->clear();
   all_artists_ = new QListWidgetItem(all_artists_icon_, tr("All artists"), ui_->artists, All_Artists);
-  new AlbumItem(artist_icon_, tr("Various artists"), ui_->artists, Various_Artists);
+  new QListWidgetItem(artist_icon_, tr("Various artists"), ui_->artists, Various_Artists);
 
   QStringList artists = collection_backend_->GetAllArtistsWithAlbums();
   std::stable_sort(artists.begin(), artists.end(), CompareNocase);
@@ -376,98 +395,119 @@ void AlbumCoverManager::ArtistChanged(QListWidgetItem *current) {
 
   if (!current) return;
 
-  ui_->albums->clear();
-  context_menu_items_.clear();
   CancelRequests();
+  context_menu_albums_.clear();
+  timer_album_pages_->stop();
+  albums_pending_.clear();
+  albums_pending_pos_ = 0;
+  albums_model_->Clear();
+
+  // Load the albums in the background, the previous load is ignored if the artist changes before it finishes.
+  const quint64 load_id = ++albums_load_id_;
+  const bool show_album_artist = current->type() != Specific_Artist;
+  QFuture<CollectionBackend::AlbumList> future = QtConcurrent::run(&AlbumCoverManager::LoadAlbums, collection_backend_, current->type(), current->text());
+  QFutureWatcher<CollectionBackend::AlbumList> *watcher = new QFutureWatcher<CollectionBackend::AlbumList>(this);
+  QObject::connect(watcher, &QFutureWatcher<CollectionBackend::AlbumList>::finished, this, [this, watcher, load_id, show_album_artist]() {
+    const CollectionBackend::AlbumList albums = watcher->result();
+    watcher->deleteLater();
+    if (load_id != albums_load_id_) return;
+    albums_pending_ = albums;
+    albums_pending_pos_ = 0;
+    albums_pending_show_album_artist_ = show_album_artist;
+    AddAlbumsPage();
+  });
+  watcher->setFuture(future);
+
+}
+
+CollectionBackend::AlbumList AlbumCoverManager::LoadAlbums(SharedPtr<CollectionBackend> collection_backend, const int artist_type, const QString &artist) {
 
   // Get the list of albums.  How we do it depends on what thing we have selected in the artist list.
   CollectionBackend::AlbumList albums;
-  switch (current->type()) {
-    case Various_Artists: albums = collection_backend_->GetCompilationAlbums(); break;
-    case Specific_Artist: albums = collection_backend_->GetAlbumsByArtist(current->text()); break;
+  switch (artist_type) {
+    case Various_Artists: albums = collection_backend->GetCompilationAlbums(); break;
+    case Specific_Artist: albums = collection_backend->GetAlbumsByArtist(artist); break;
     case All_Artists:
-    default:              albums = collection_backend_->GetAllAlbums(); break;
+    default:              albums = collection_backend->GetAllAlbums(); break;
   }
 
+  // Don't show songs without an album, obviously
+  albums.erase(std::remove_if(albums.begin(), albums.end(), [](const CollectionBackend::Album &album_info) { return album_info.album.isEmpty(); }), albums.end());
+
   // Sort by album name.  The list is already sorted by sqlite but it was done case sensitively.
   std::stable_sort(albums.begin(), albums.end(), CompareAlbumNameNocase);
 
-  for (const CollectionBackend::Album &album_info : std::as_const(albums)) {
-
-    // Don't show songs without an album, obviously
-    if (album_info.album.isEmpty()) continue;
+  return albums;
 
-    QString display_text;
-
-    if (current->type() == Specific_Artist) {
-      display_text = album_info.album;
-    }
-    else {
-      display_text = album_info.album_artist + " - "_L1 + album_info.album;
-    }
-
-    AlbumItem *album_item = new AlbumItem(icon_nocover_item_, display_text, ui_->albums);
-    album_item->setData(Role_AlbumArtist, album_info.album_artist);
-    album_item->setData(Role_Album, album_info.album);
-    album_item->setData(Role_Filetype, QVariant::fromValue(album_info.filetype));
-    album_item->setData(Role_CuePath, album_info.cue_path);
-    album_item->setData(Qt::TextAlignmentRole, QVariant(Qt::AlignTop | Qt::AlignHCenter));
-    album_item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled);
-    album_item->urls = album_info.urls;
-
-    if (album_info.album_artist.isEmpty()) {
-      album_item->setToolTip(album_info.album);
-    }
-    else {
-      album_item->setToolTip(album_info.album_artist + " - "_L1 + album_info.album);
-    }
+}
 
-    album_item->setData(Role_ArtEmbedded, album_info.art_embedded);
-    album_item->setData(Role_ArtAutomatic, album_info.art_automatic);
-    album_item->setData(Role_ArtManual, album_info.art_manual);
-    album_item->setData(Role_ArtUnset, album_info.art_unset);
-
-    if (album_info.art_embedded || !album_info.art_automatic.isEmpty() || !album_info.art_manual.isEmpty()) {
-      QueueAlbumCoverLoad(album_item);
-    }
+void AlbumCoverManager::AddAlbumsPage() {
 
+  if (albums_pending_pos_ >= albums_pending_.count()) {
+    timer_album_pages_->stop();
+    albums_pending_.clear();
+    albums_pending_pos_ = 0;
+    return;
   }
 
-  UpdateFilter();
+  albums_model_->AddAlbums(albums_pending_.mid(albums_pending_pos_, kAlbumsPerPage), albums_pending_show_album_artist_);
+  albums_pending_pos_ += kAlbumsPerPage;
 
-}
-
-void AlbumCoverManager::QueueAlbumCoverLoad(AlbumItem *album_item) {
-
-  cover_loading_pending_.enqueue(album_item);
-
-  if (!timer_album_cover_load_->isActive()) {
-    timer_album_cover_load_->start();
+  if (!timer_album_pages_->isActive()) {
+    timer_album_pages_->start();
   }
 
 }
 
-void AlbumCoverManager::LoadAlbumCovers() {
+void AlbumCoverManager::LoadVisibleAlbumCovers(const int first_row, const int last_row) {
 
-  if (cover_loading_pending_.isEmpty()) {
-    if (timer_album_cover_load_->isActive()) {
-      timer_album_cover_load_->stop();
+  // Cancel the covers that were scrolled away before they were loaded.
+  QSet<quint64> cancelled_ids;
+  for (QHash<int, quint64>::iterator it = cover_loading_albums_.begin(); it != cover_loading_albums_.end();) {
+    const QModelIndex idx = albums_model_->index_for_album(it.key());
+    if (idx.isValid() && idx.row() >= first_row && idx.row() <= last_row) {
+      ++it;
+      continue;
     }
-    return;
+    cancelled_ids << it.value();
+    cover_loading_tasks_.remove(it.value());
+    it = cover_loading_albums_.erase(it);
+  }
+  if (!cancelled_ids.isEmpty()) {
+    app_->album_cover_loader()->CancelTasks(cancelled_ids);
   }
 
-  LoadAlbumCoverAsync(cover_loading_pending_.dequeue());
+  for (int row = first_row; row <= last_row; ++row) {
+    const int album_index = albums_model_->album_index(row);
+    if (album_index == -1 || albums_model_->AlbumCoverLoaded(album_index) || cover_loading_albums_.contains(album_index) || !albums_model_->AlbumHasArt(album_index)) continue;
+    LoadAlbumCoverAsync(album_index);
+  }
 
 }
 
-void AlbumCoverManager::LoadAlbumCoverAsync(AlbumItem *album_item) {
+void AlbumCoverManager::LoadAlbumCoverAsync(const int album_index) {
+
+  CancelAlbumCoverLoad(album_index);
+
+  const CollectionBackend::Album &album_info = albums_model_->album(album_index);
 
   AlbumCoverLoaderOptions cover_options(AlbumCoverLoaderOptions::Option::ScaledImage | AlbumCoverLoaderOptions::Option::PadScaledImage);
   cover_options.types = cover_types_;
   cover_options.desired_scaled_size = QSize(kThumbnailSize, kThumbnailSize);
   cover_options.device_pixel_ratio = devicePixelRatioF();
-  quint64 cover_load_id = app_->album_cover_loader()->LoadImageAsync(cover_options, album_item->data(Role_ArtEmbedded).toBool(), album_item->data(Role_ArtAutomatic).toUrl(), album_item->data(Role_ArtManual).toUrl(), album_item->data(Role_ArtUnset).toBool(), album_item->urls.constFirst());
-  cover_loading_tasks_.insert(cover_load_id, album_item);
+  quint64 cover_load_id = app_->album_cover_loader()->LoadImageAsync(cover_options, album_info.art_embedded, album_info.art_automatic, album_info.art_manual, album_info.art_unset, album_info.urls.constFirst());
+  cover_loading_tasks_.insert(cover_load_id, album_index);
+  cover_loading_albums_.insert(album_index, cover_load_id);
+
+}
+
+void AlbumCoverManager::CancelAlbumCoverLoad(const int album_index) {
+
+  if (!cover_loading_albums_.contains(album_index)) return;
+
+  const quint64 id = cover_loading_albums_.take(album_index);
+  cover_loading_tasks_.remove(id);
+  app_->album_cover_loader()->CancelTask(id);
 
 }
 
@@ -475,17 +515,16 @@ void AlbumCoverManager::AlbumCoverLoaded(const quint64 id, const AlbumCoverLoade
 
   if (!cover_loading_tasks_.contains(id)) return;
 
-  AlbumItem *album_item = cover_loading_tasks_.take(id);
+  const int album_index = cover_loading_tasks_.take(id);
+  cover_loading_albums_.remove(album_index);
 
   if (!result.success || result.image_scaled.isNull() || result.type == AlbumCoverLoaderResult::Type::Unset) {
-    album_item->setIcon(icon_nocover_item_);
+    albums_model_->SetAlbumCover(album_index, QIcon());
   }
   else {
-    album_item->setIcon(QPixmap::fromImage(result.image_scaled));
+    albums_model_->SetAlbumCover(album_index, QIcon(QPixmap::fromImage(result.image_scaled)));
   }
 
-  UpdateFilter();
-
 }
 
 void AlbumCoverManager::UpdateFilter() {
@@ -494,74 +533,52 @@ void AlbumCoverManager::UpdateFilter() {
   const bool hide_with_covers = filter_without_covers_->isChecked();
   const bool hide_without_covers = filter_with_covers_->isChecked();
 
-  HideCovers hide_covers = HideCovers::None;
+  AlbumCoverManagerModel::HideCovers hide_covers = AlbumCoverManagerModel::HideCovers::None;
   if (hide_with_covers) {
-    hide_covers = HideCovers::WithCovers;
+    hide_covers = AlbumCoverManagerModel::HideCovers::WithCovers;
   }
   else if (hide_without_covers) {
-    hide_covers = HideCovers::WithoutCovers;
+    hide_covers = AlbumCoverManagerModel::HideCovers::WithoutCovers;
   }
 
-  qint32 total_count = 0;
-  qint32 without_cover = 0;
+  albums_model_->SetFilter(filter, hide_covers);
 
-  for (int i = 0; i < ui_->albums->count(); ++i) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(ui_->albums->item(i));
-    bool should_hide = ShouldHide(*album_item, filter, hide_covers);
-    album_item->setHidden(should_hide);
+}
 
-    if (!should_hide) {
-      ++total_count;
-      if (!ItemHasCover(*album_item)) {
-        ++without_cover;
-      }
-    }
-  }
+void AlbumCoverManager::UpdateCounts() {
 
-  ui_->total_albums->setText(QString::number(total_count));
-  ui_->without_cover->setText(QString::number(without_cover));
+  ui_->total_albums->setText(QString::number(albums_model_->total_count()));
+  ui_->without_cover->setText(QString::number(albums_model_->without_cover_count()));
 
 }
 
-bool AlbumCoverManager::ShouldHide(const AlbumItem &album_item, const QString &filter, const HideCovers hide_covers) const {
+void AlbumCoverManager::FetchAlbumCovers() {
 
-  bool has_cover = ItemHasCover(album_item);
-  if (hide_covers == HideCovers::WithCovers && has_cover) {
-    return true;
-  }
-  else if (hide_covers == HideCovers::WithoutCovers && !has_cover) {
-    return true;
+  if (!cover_search_misses_->is_loaded()) {
+    cover_search_misses_->Load();
   }
 
-  if (filter.isEmpty()) {
-    return false;
-  }
+  int skipped = 0;
+  for (int row = 0; row < albums_model_->rowCount(); ++row) {
+    const int album_index = albums_model_->album_index(row);
+    if (albums_model_->AlbumHasCover(album_index)) continue;
 
-  const QStringList query = filter.split(u' ');
-  for (const QString &s : query) {
-    bool in_text = album_item.text().contains(s, Qt::CaseInsensitive);
-    bool in_albumartist = album_item.data(Role_AlbumArtist).toString().contains(s, Qt::CaseInsensitive);
-    if (!in_text && !in_albumartist) {
-      return true;
+    // Albums recently searched without finding anything are skipped, searching for a single cover still works for them.
+    const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+    if (cover_search_misses_->Contains(album_info.album_artist, album_info.album)) {
+      ++skipped;
+      continue;
     }
-  }
-
-  return false;
 
-}
-
-void AlbumCoverManager::FetchAlbumCovers() {
-
-  for (int i = 0; i < ui_->albums->count(); ++i) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(ui_->albums->item(i));
-    if (album_item->isHidden()) continue;
-    if (ItemHasCover(*album_item)) continue;
-
-    quint64 id = cover_fetcher_->FetchAlbumCover(album_item->data(Role_AlbumArtist).toString(), album_item->data(Role_Album).toString(), QString(), true);
-    cover_fetching_tasks_[id] = album_item;
+    quint64 id = cover_fetcher_->FetchAlbumCover(album_info.album_artist, album_info.album, QString(), true);
+    cover_fetching_tasks_[id] = album_index;
     jobs_++;
   }
 
+  if (skipped > 0) {
+    qLog(Debug) << "Skipping" << skipped << "albums where no cover was found recently";
+  }
+
   if (!cover_fetching_tasks_.isEmpty()) ui_->button_fetch->setEnabled(false);
 
   progress_bar_->setMaximum(jobs_);
@@ -576,9 +593,14 @@ void AlbumCoverManager::AlbumCoverFetched(const quint64 id, const AlbumCoverImag
 
   if (!cover_fetching_tasks_.contains(id)) return;
 
-  AlbumItem *album_item = cover_fetching_tasks_.take(id);
-  if (!result.image.isNull()) {
-    SaveAndSetCover(album_item, result);
+  const int album_index = cover_fetching_tasks_.take(id);
+  const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+  if (result.not_found) {
+    cover_search_misses_->Add(album_info.album_artist, album_info.album);
+  }
+  else if (!result.image.isNull()) {
+    cover_search_misses_->Remove(album_info.album_artist, album_info.album);
+    SaveAndSetCover(album_index, result);
   }
 
   if (cover_fetching_tasks_.isEmpty()) {
@@ -621,28 +643,28 @@ void AlbumCoverManager::UpdateStatusText() {
 bool AlbumCoverManager::eventFilter(QObject *obj, QEvent *e) {
 
   if (obj == ui_->albums && e->type() == QEvent::ContextMenu) {
-    context_menu_items_ = ui_->albums->selectedItems();
-    if (context_menu_items_.isEmpty()) return QMainWindow::eventFilter(obj, e);
+    context_menu_albums_ = albums_model_->album_indexes(ui_->albums->selectionModel()->selectedIndexes());
+    if (context_menu_albums_.isEmpty()) return QMainWindow::eventFilter(obj, e);
 
     bool some_with_covers = false;
     bool some_unset = false;
     bool some_clear = false;
 
-    for (QListWidgetItem *list_widget_item : std::as_const(context_menu_items_)) {
-      AlbumItem *album_item = static_cast<AlbumItem*>(list_widget_item);
-      if (ItemHasCover(*album_item)) some_with_covers = true;
-      if (album_item->data(Role_ArtUnset).toBool()) {
+    for (const int album_index : std::as_const(context_menu_albums_)) {
+      const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+      if (albums_model_->AlbumHasCover(album_index)) some_with_covers = true;
+      if (album_info.art_unset) {
         some_unset = true;
       }
-      else if (!album_item->data(Role_ArtEmbedded).toBool() && album_item->data(Role_ArtAutomatic).toUrl().isEmpty() && album_item->data(Role_ArtManual).toUrl().isEmpty()) {
+      else if (!album_info.art_embedded && album_info.art_automatic.isEmpty() && album_info.art_manual.isEmpty()) {
         some_clear = true;
       }
     }
 
-    album_cover_choice_controller_->show_cover_action()->setEnabled(some_with_covers && context_menu_items_.size() == 1);
+    album_cover_choice_controller_->show_cover_action()->setEnabled(some_with_covers && context_menu_albums_.size() == 1);
     album_cover_choice_controller_->cover_to_file_action()->setEnabled(some_with_covers);
-    album_cover_choice_controller_->cover_from_file_action()->setEnabled(context_menu_items_.size() == 1);
-    album_cover_choice_controller_->cover_from_url_action()->setEnabled(context_menu_items_.size() == 1);
+    album_cover_choice_controller_->cover_from_file_action()->setEnabled(context_menu_albums_.size() == 1);
+    album_cover_choice_controller_->cover_from_url_action()->setEnabled(context_menu_albums_.size() == 1);
     album_cover_choice_controller_->search_for_cover_action()->setEnabled(app_->cover_providers()->HasAnyProviders());
     album_cover_choice_controller_->unset_cover_action()->setEnabled(some_with_covers || some_clear);
     album_cover_choice_controller_->clear_cover_action()->setEnabled(some_with_covers || some_unset);
@@ -658,45 +680,11 @@ bool AlbumCoverManager::eventFilter(QObject *obj, QEvent *e) {
 }
 
 Song AlbumCoverManager::GetSingleSelectionAsSong() {
-  return context_menu_items_.size() != 1 ? Song() : AlbumItemAsSong(context_menu_items_.value(0));
+  return context_menu_albums_.size() != 1 ? Song() : albums_model_->AlbumAsSong(context_menu_albums_.value(0));
 }
 
 Song AlbumCoverManager::GetFirstSelectedAsSong() {
-  return context_menu_items_.isEmpty() ? Song() : AlbumItemAsSong(context_menu_items_.value(0));
-}
-
-Song AlbumCoverManager::AlbumItemAsSong(AlbumItem *album_item) {
-
-  Song result(Song::Source::Collection);
-
-  QString title = album_item->data(Role_Album).toString();
-  QString artist_name = album_item->data(Role_AlbumArtist).toString();
-  if (!artist_name.isEmpty()) {
-    result.set_title(artist_name + " - "_L1 + title);
-  }
-  else {
-    result.set_title(title);
-  }
-
-  result.set_artist(album_item->data(Role_AlbumArtist).toString());
-  result.set_albumartist(album_item->data(Role_AlbumArtist).toString());
-  result.set_album(album_item->data(Role_Album).toString());
-
-  result.set_filetype(static_cast<Song::FileType>(album_item->data(Role_Filetype).toInt()));
-  result.set_url(album_item->urls.constFirst());
-  result.set_cue_path(album_item->data(Role_CuePath).toString());
-
-  result.set_art_embedded(album_item->data(Role_ArtEmbedded).toBool());
-  result.set_art_automatic(album_item->data(Role_ArtAutomatic).toUrl());
-  result.set_art_manual(album_item->data(Role_ArtManual).toUrl());
-  result.set_art_unset(album_item->data(Role_ArtUnset).toBool());
-
-  // force validity
-  result.set_valid(true);
-  result.set_id(0);
-
-  return result;
-
+  return context_menu_albums_.isEmpty() ? Song() : albums_model_->AlbumAsSong(context_menu_albums_.value(0));
 }
 
 void AlbumCoverManager::ShowCover() {
@@ -710,10 +698,10 @@ void AlbumCoverManager::ShowCover() {
 
 void AlbumCoverManager::FetchSingleCover() {
 
-  for (QListWidgetItem *list_widget_item : std::as_const(context_menu_items_)) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(list_widget_item);
-    quint64 id = cover_fetcher_->FetchAlbumCover(album_item->data(Role_AlbumArtist).toString(), album_item->data(Role_Album).toString(), QString(), false);
-    cover_fetching_tasks_[id] = album_item;
+  for (const int album_index : std::as_const(context_menu_albums_)) {
+    const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+    quint64 id = cover_fetcher_->FetchAlbumCover(album_info.album_artist, album_info.album, QString(), false);
+    cover_fetching_tasks_[id] = album_index;
     jobs_++;
   }
 
@@ -724,11 +712,11 @@ void AlbumCoverManager::FetchSingleCover() {
 
 }
 
-void AlbumCoverManager::UpdateCoverInList(AlbumItem *album_item, const QUrl &cover_url) {
+void AlbumCoverManager::UpdateCoverInList(const int album_index, const QUrl &cover_url) {
 
-  album_item->setData(Role_ArtManual, cover_url);
-  album_item->setData(Role_ArtUnset, false);
-  LoadAlbumCoverAsync(album_item);
+  const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+  albums_model_->SetAlbumArt(album_index, album_info.art_embedded, album_info.art_automatic, cover_url, false);
+  LoadAlbumCoverAsync(album_index);
 
 }
 
@@ -829,29 +817,25 @@ void AlbumCoverManager::SaveImageToAlbums(Song *song, const AlbumCoverImageResul
   }
 
   // Force the found cover on all of the selected items
-  QList<QUrl> urls;
-  QList<AlbumItem*> album_items;
-  for (QListWidgetItem *list_widget_item : std::as_const(context_menu_items_)) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(list_widget_item);
+  for (const int album_index : std::as_const(context_menu_albums_)) {
     switch (album_cover_choice_controller_->get_save_album_cover_type()) {
       case CoverOptions::CoverType::Cache:
       case CoverOptions::CoverType::Album:{
-        Song current_song = AlbumItemAsSong(album_item);
+        Song current_song = albums_model_->AlbumAsSong(album_index);
         album_cover_choice_controller_->SaveArtManualToSong(&current_song, cover_url);
-        UpdateCoverInList(album_item, cover_url);
+        UpdateCoverInList(album_index, cover_url);
         break;
       }
       case CoverOptions::CoverType::Embedded:{
-        for (const QUrl &url : std::as_const(album_item->urls)) {
+        const QList<QUrl> urls = albums_model_->album(album_index).urls;
+        for (const QUrl &url : urls) {
           const bool art_embedded = !result.image_data.isEmpty();
           TagReaderReply *reply = app_->tag_reader_client()->SaveEmbeddedArt(url.toLocalFile(), TagReaderClient::SaveCoverOptions(result.image_data, result.mime_type));
-          QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, album_item, url, art_embedded]() {
-            SaveEmbeddedCoverFinished(reply, album_item, url, art_embedded);
+          QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, album_index, url, art_embedded]() {
+            SaveEmbeddedCoverFinished(reply, album_index, url, art_embedded);
           });
-          cover_save_tasks_.insert(album_item, url);
+          cover_save_tasks_.insert(album_index, url);
         }
-        urls << album_item->urls;
-        album_items << album_item;
         break;
       }
     }
@@ -861,18 +845,15 @@ void AlbumCoverManager::SaveImageToAlbums(Song *song, const AlbumCoverImageResul
 
 void AlbumCoverManager::UnsetCover() {
 
-  if (context_menu_items_.isEmpty()) return;
+  if (context_menu_albums_.isEmpty()) return;
 
   // Force the 'none' cover on all of the selected items
-  for (QListWidgetItem *list_widget_item : std::as_const(context_menu_items_)) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(list_widget_item);
-    album_item->setIcon(icon_nocover_item_);
-    album_item->setData(Role_ArtEmbedded, false);
-    album_item->setData(Role_ArtManual, QUrl());
-    album_item->setData(Role_ArtAutomatic, QUrl());
-    album_item->setData(Role_ArtUnset, true);
-
-    Song current_song = AlbumItemAsSong(album_item);
+  for (const int album_index : std::as_const(context_menu_albums_)) {
+    CancelAlbumCoverLoad(album_index);
+    albums_model_->SetAlbumArt(album_index, false, QUrl(), QUrl(), true);
+    albums_model_->SetAlbumCover(album_index, QIcon());
+
+    Song current_song = albums_model_->AlbumAsSong(album_index);
     album_cover_choice_controller_->UnsetAlbumCoverForSong(&current_song);
   }
 
@@ -880,18 +861,15 @@ void AlbumCoverManager::UnsetCover() {
 
 void AlbumCoverManager::ClearCover() {
 
-  if (context_menu_items_.isEmpty()) return;
+  if (context_menu_albums_.isEmpty()) return;
 
   // Force the 'none' cover on all of the selected items
-  for (QListWidgetItem *list_widget_item : std::as_const(context_menu_items_)) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(list_widget_item);
-    album_item->setIcon(icon_nocover_item_);
-    album_item->setData(Role_ArtEmbedded, false);
-    album_item->setData(Role_ArtAutomatic, QUrl());
-    album_item->setData(Role_ArtManual, QUrl());
-    album_item->setData(Role_ArtUnset, false);
-
-    Song current_song = AlbumItemAsSong(album_item);
+  for (const int album_index : std::as_const(context_menu_albums_)) {
+    CancelAlbumCoverLoad(album_index);
+    albums_model_->SetAlbumArt(album_index, false, QUrl(), QUrl(), false);
+    albums_model_->SetAlbumCover(album_index, QIcon());
+
+    Song current_song = albums_model_->AlbumAsSong(album_index);
     album_cover_choice_controller_->ClearAlbumCoverForSong(&current_song);
   }
 
@@ -899,45 +877,19 @@ void AlbumCoverManager::ClearCover() {
 
 void AlbumCoverManager::DeleteCover() {
 
-  for (QListWidgetItem *list_widget_item : std::as_const(context_menu_items_)) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(list_widget_item);
-    Song song = AlbumItemAsSong(album_item);
+  for (const int album_index : std::as_const(context_menu_albums_)) {
+    Song song = albums_model_->AlbumAsSong(album_index);
     album_cover_choice_controller_->DeleteCover(&song);
-    album_item->setIcon(icon_nocover_item_);
-    album_item->setData(Role_ArtEmbedded, false);
-    album_item->setData(Role_ArtManual, QUrl());
-    album_item->setData(Role_ArtAutomatic, QUrl());
+    CancelAlbumCoverLoad(album_index);
+    albums_model_->SetAlbumArt(album_index, false, QUrl(), QUrl(), albums_model_->album(album_index).art_unset);
+    albums_model_->SetAlbumCover(album_index, QIcon());
   }
 
 }
 
 SongList AlbumCoverManager::GetSongsInAlbum(const QModelIndex &idx) const {
 
-  SongList ret;
-
-  QMutexLocker l(collection_backend_->db()->Mutex());
-  QSqlDatabase db(collection_backend_->db()->Connect());
-
-  CollectionQuery q(db, collection_backend_->songs_table());
-  q.SetColumnSpec(Song::kRowIdColumnSpec);
-  q.AddWhere(QStringLiteral("album"), idx.data(Role_Album).toString());
-  q.SetOrderBy(QStringLiteral("disc, track, title"));
-
-  QString albumartist = idx.data(Role_AlbumArtist).toString();
-  if (!albumartist.isEmpty()) {
-    q.AddWhere(QStringLiteral("effective_albumartist"), albumartist);
-  }
-
-  q.AddCompilationRequirement(albumartist.isEmpty());
-
-  if (!q.Exec()) return ret;
-
-  while (q.Next()) {
-    Song song;
-    song.InitFromQuery(q, true);
-    ret << song;
-  }
-  return ret;
+  return albums_model_->GetSongsInAlbum(albums_model_->album_index(idx));
 
 }
 
@@ -965,9 +917,9 @@ SongMimeData *AlbumCoverManager::GetMimeDataForAlbums(const QModelIndexList &ind
 
 void AlbumCoverManager::AlbumDoubleClicked(const QModelIndex &idx) {
 
-  AlbumItem *album_item = static_cast<AlbumItem*>(idx.internalPointer());
-  if (!album_item) return;
-  album_cover_choice_controller_->ShowCover(AlbumItemAsSong(album_item));
+  const int album_index = albums_model_->album_index(idx);
+  if (album_index == -1) return;
+  album_cover_choice_controller_->ShowCover(albums_model_->AlbumAsSong(album_index));
 
 }
 
@@ -985,25 +937,26 @@ void AlbumCoverManager::LoadSelectedToPlaylist() {
 
 }
 
-void AlbumCoverManager::SaveAndSetCover(AlbumItem *album_item, const AlbumCoverImageResult &result) {
+void AlbumCoverManager::SaveAndSetCover(const int album_index, const AlbumCoverImageResult &result) {
 
-  const QList<QUrl> &urls = album_item->urls;
-  const Song::FileType filetype = static_cast<Song::FileType>(album_item->data(Role_Filetype).toInt());
-  const bool has_cue = !album_item->data(Role_CuePath).toString().isEmpty();
+  const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+  const QList<QUrl> urls = album_info.urls;
+  const Song::FileType filetype = album_info.filetype;
+  const bool has_cue = !album_info.cue_path.isEmpty();
 
   if (album_cover_choice_controller_->get_save_album_cover_type() == CoverOptions::CoverType::Embedded && Song::save_embedded_cover_supported(filetype) && !has_cue) {
     for (const QUrl &url : urls) {
       const bool art_embedded = !result.image_data.isEmpty();
       TagReaderReply *reply = app_->tag_reader_client()->SaveEmbeddedArt(url.toLocalFile(), TagReaderClient::SaveCoverOptions(result.cover_url.isValid() ? result.cover_url.toLocalFile() : QString(), result.image_data, result.mime_type));
-      QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, album_item, url, art_embedded]() {
-        SaveEmbeddedCoverFinished(reply, album_item, url, art_embedded);
+      QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, album_index, url, art_embedded]() {
+        SaveEmbeddedCoverFinished(reply, album_index, url, art_embedded);
       });
-      cover_save_tasks_.insert(album_item, url);
+      cover_save_tasks_.insert(album_index, url);
     }
   }
   else {
-    const QString albumartist = album_item->data(Role_AlbumArtist).toString();
-    const QString album = album_item->data(Role_Album).toString();
+    const QString albumartist = album_info.album_artist;
+    const QString album = album_info.album;
     QUrl cover_url;
     if (!result.cover_url.isEmpty() && result.cover_url.isValid() && result.cover_url.isLocalFile()) {
       cover_url = result.cover_url;
@@ -1018,7 +971,7 @@ void AlbumCoverManager::SaveAndSetCover(AlbumItem *album_item, const AlbumCoverI
     collection_backend_->UpdateManualAlbumArtAsync(albumartist, album, cover_url);
 
     // Update the icon in our list
-    UpdateCoverInList(album_item, cover_url);
+    UpdateCoverInList(album_index, cover_url);
   }
 
 }
@@ -1036,15 +989,15 @@ void AlbumCoverManager::ExportCovers() {
   cover_exporter_->SetDialogResult(result);
   cover_exporter_->SetCoverTypes(cover_types_);
 
-  for (int i = 0; i < ui_->albums->count(); ++i) {
-    AlbumItem *album_item = static_cast<AlbumItem*>(ui_->albums->item(i));
+  for (int row = 0; row < albums_model_->rowCount(); ++row) {
+    const int album_index = albums_model_->album_index(row);
 
-    // skip hidden and coverless albums
-    if (album_item->isHidden() || !ItemHasCover(*album_item)) {
+    // skip coverless albums, hidden albums are not rows in the model
+    if (!albums_model_->AlbumHasCover(album_index)) {
       continue;
     }
 
-    cover_exporter_->AddExportRequest(AlbumItemAsSong(album_item));
+    cover_exporter_->AddExportRequest(albums_model_->AlbumAsSong(album_index));
   }
 
   if (cover_exporter_->request_count() > 0) {
@@ -1070,7 +1023,7 @@ void AlbumCoverManager::UpdateExportStatus(const int exported, const int skipped
   QString message = tr("Exported %1 covers out of %2 (%3 skipped)")
                         .arg(exported)
                         .arg(max)
-                        .arg(skipped);
+                        .arg(skipped) + ", "_L1 + tr("%1 covers/s").arg(cover_exporter_->covers_per_second(), 0, 'f', 1);
   statusBar()->showMessage(message);
 
   // End of the current process
@@ -1089,30 +1042,29 @@ void AlbumCoverManager::UpdateExportStatus(const int exported, const int skipped
 
 }
 
-bool AlbumCoverManager::ItemHasCover(const AlbumItem &album_item) const {
-  return album_item.icon().cacheKey() != icon_nocover_item_.cacheKey();
-}
-
-void AlbumCoverManager::SaveEmbeddedCoverFinished(TagReaderReply *reply, AlbumItem *album_item, const QUrl &url, const bool art_embedded) {
+void AlbumCoverManager::SaveEmbeddedCoverFinished(TagReaderReply *reply, const int album_index, const QUrl &url, const bool art_embedded) {
 
-  if (cover_save_tasks_.contains(album_item, url)) {
-    cover_save_tasks_.remove(album_item, url);
+  // The album list was reloaded while saving.
+  if (!cover_save_tasks_.contains(album_index, url)) {
+    return;
   }
 
+  cover_save_tasks_.remove(album_index, url);
+
   if (!reply->is_successful()) {
     Q_EMIT Error(tr("Could not save cover to file %1.").arg(url.toLocalFile()));
     return;
   }
 
-  if (cover_save_tasks_.contains(album_item)) {
+  if (cover_save_tasks_.contains(album_index)) {
     return;
   }
 
-  album_item->setData(Role_ArtEmbedded, true);
-  album_item->setData(Role_ArtUnset, false);
-  Song song = AlbumItemAsSong(album_item);
+  const CollectionBackend::Album &album_info = albums_model_->album(album_index);
+  albums_model_->SetAlbumArt(album_index, true, album_info.art_automatic, album_info.art_manual, false);
+  Song song = albums_model_->AlbumAsSong(album_index);
   album_cover_choice_controller_->SaveArtEmbeddedToSong(&song, art_embedded);
-  LoadAlbumCoverAsync(album_item);
+  LoadAlbumCoverAsync(album_index);
 
 }
 
@@ -32,14 +32,16 @@
 #include <QListWidgetItem>
 #include <QMap>
 #include <QMultiMap>
-#include <QQueue>
+#include <QHash>
 #include <QString>
 #include <QImage>
 #include <QIcon>
 
+#include "core/scoped_ptr.h"
 #include "core/shared_ptr.h"
 #include "core/song.h"
 #include "core/tagreaderclient.h"
+#include "collection/collectionbackend.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverloaderresult.h"
 #include "albumcoverchoicecontroller.h"
@@ -56,24 +58,16 @@ class QCloseEvent;
 class QShowEvent;
 
 class Application;
-class CollectionBackend;
 class SongMimeData;
 class AlbumCoverExport;
 class AlbumCoverExporter;
 class AlbumCoverFetcher;
 class AlbumCoverSearcher;
+class AlbumCoverManagerModel;
+class CoverSearchMissCache;
 
 class Ui_CoverManager;
 
-class AlbumItem : public QListWidgetItem {
- public:
-  AlbumItem(const QIcon &icon, const QString &text, QListWidget *parent = nullptr, int type = Type) : QListWidgetItem(icon, text, parent, type) {};
-  QList<QUrl> urls;
-
- private:
-  Q_DISABLE_COPY(AlbumItem)
-};
-
 class AlbumCoverManager : public QMainWindow {
   Q_OBJECT
 
@@ -105,25 +99,6 @@ class AlbumCoverManager : public QMainWindow {
     Specific_Artist
   };
 
-  enum Role {
-    Role_AlbumArtist = Qt::UserRole + 1,
-    Role_Album,
-    Role_ArtEmbedded,
-    Role_ArtAutomatic,
-    Role_ArtManual,
-    Role_ArtUnset,
-    Role_Filetype,
-    Role_CuePath,
-    Role_ImageData,
-    Role_Image
-  };
-
-  enum class HideCovers {
-    None,
-    WithCovers,
-    WithoutCovers
-  };
-
   void LoadGeometry();
   void SaveSettings();
 
@@ -134,32 +109,30 @@ class AlbumCoverManager : public QMainWindow {
   // Returns the first of the selected elements in form of a Song ready to be used by AlbumCoverChoiceController or invalid song if there's nothing selected.
   Song GetFirstSelectedAsSong();
 
-  Song AlbumItemAsSong(QListWidgetItem *list_widget_item) { return AlbumItemAsSong(static_cast<AlbumItem*>(list_widget_item)); }
-  static Song AlbumItemAsSong(AlbumItem *album_item);
+  static CollectionBackend::AlbumList LoadAlbums(SharedPtr<CollectionBackend> collection_backend, const int artist_type, const QString &artist);
 
-  void QueueAlbumCoverLoad(AlbumItem *album_item);
-  void LoadAlbumCoverAsync(AlbumItem *album_item);
+  void LoadAlbumCoverAsync(const int album_index);
+  void CancelAlbumCoverLoad(const int album_index);
 
   void UpdateStatusText();
-  bool ShouldHide(const AlbumItem &album_item, const QString &filter, const HideCovers hide_covers) const;
-  void SaveAndSetCover(AlbumItem *album_item, const AlbumCoverImageResult &result);
+  void SaveAndSetCover(const int album_index, const AlbumCoverImageResult &result);
 
   void SaveImageToAlbums(Song *song, const AlbumCoverImageResult &result);
 
   SongList GetSongsInAlbums(const QModelIndexList &indexes) const;
   SongMimeData *GetMimeDataForAlbums(const QModelIndexList &indexes) const;
 
-  bool ItemHasCover(const AlbumItem &album_item) const;
-
  Q_SIGNALS:
   void Error(const QString &error);
   void AddToPlaylist(QMimeData *data);
 
  private Q_SLOTS:
   void ArtistChanged(QListWidgetItem *current);
-  void LoadAlbumCovers();
+  void AddAlbumsPage();
+  void LoadVisibleAlbumCovers(const int first_row, const int last_row);
   void AlbumCoverLoaded(const quint64 id, const AlbumCoverLoaderResult &result);
   void UpdateFilter();
+  void UpdateCounts();
   void FetchAlbumCovers();
   void ExportCovers();
   void AlbumCoverFetched(const quint64 id, const AlbumCoverImageResult &result, const CoverSearchStatistics &statistics);
@@ -182,10 +155,10 @@ class AlbumCoverManager : public QMainWindow {
   void AddSelectedToPlaylist();
   void LoadSelectedToPlaylist();
 
-  void UpdateCoverInList(AlbumItem *album_item, const QUrl &cover);
+  void UpdateCoverInList(const int album_index, const QUrl &cover);
   void UpdateExportStatus(const int exported, const int skipped, const int max);
 
-  void SaveEmbeddedCoverFinished(TagReaderReply *reply, AlbumItem *album_item, const QUrl &url, const bool art_embedded);
+  void SaveEmbeddedCoverFinished(TagReaderReply *reply, const int album_index, const QUrl &url, const bool art_embedded);
 
  private:
   Ui_CoverManager *ui_;
@@ -193,18 +166,27 @@ class AlbumCoverManager : public QMainWindow {
   Application *app_;
   SharedPtr<CollectionBackend> collection_backend_;
   AlbumCoverChoiceController *album_cover_choice_controller_;
-  QTimer *timer_album_cover_load_;
+  AlbumCoverManagerModel *albums_model_;
+  QTimer *timer_album_pages_;
 
   QAction *filter_all_;
   QAction *filter_with_covers_;
   QAction *filter_without_covers_;
 
-  QQueue<AlbumItem*> cover_loading_pending_;
-  QMap<quint64, AlbumItem*> cover_loading_tasks_;
+  // Albums loaded from the collection that are not in the model yet, they are added a page at a time.
+  quint64 albums_load_id_;
+  CollectionBackend::AlbumList albums_pending_;
+  qint64 albums_pending_pos_;
+  bool albums_pending_show_album_artist_;
+
+  // Cover loads by task ID and by album index.
+  QMap<quint64, int> cover_loading_tasks_;
+  QHash<int, quint64> cover_loading_albums_;
 
   AlbumCoverFetcher *cover_fetcher_;
-  QMap<quint64, AlbumItem*> cover_fetching_tasks_;
+  QMap<quint64, int> cover_fetching_tasks_;
   CoverSearchStatistics fetch_statistics_;
+  ScopedPtr<CoverSearchMissCache> cover_search_misses_;
 
   AlbumCoverSearcher *cover_searcher_;
   AlbumCoverExport *cover_export_;
@@ -216,13 +198,13 @@ class AlbumCoverManager : public QMainWindow {
   const QIcon icon_nocover_item_;
 
   QMenu *context_menu_;
-  QList<QListWidgetItem*> context_menu_items_;
+  QList<int> context_menu_albums_;
 
   QProgressBar *progress_bar_;
   QPushButton *abort_progress_;
   int jobs_;
 
-  QMultiMap<AlbumItem*, QUrl> cover_save_tasks_;
+  QMultiMap<int, QUrl> cover_save_tasks_;
 
   QListWidgetItem *all_artists_;
 
@@ -21,53 +21,111 @@
 
 #include "config.h"
 
-#include <utility>
+#include <chrono>
 
 #include <QWidget>
-#include <QStringList>
-#include <QUrl>
-#include <QList>
 #include <QListView>
-#include <QListWidget>
-#include <QListWidgetItem>
-#include <QMimeData>
+#include <QAbstractItemModel>
+#include <QTimer>
+#include <QRect>
 #include <QDropEvent>
+#include <QResizeEvent>
 
-#include "core/scoped_ptr.h"
-#include "core/song.h"
-#include "collection/collectionbackend.h"
-#include "playlist/songmimedata.h"
-#include "albumcovermanager.h"
 #include "albumcovermanagerlist.h"
 
-AlbumCoverManagerList::AlbumCoverManagerList(QWidget *parent) : QListWidget(parent), manager_(nullptr) {}
+using namespace std::literals::chrono_literals;
 
-QMimeData *AlbumCoverManagerList::mimeData(const QList<QListWidgetItem*> &items) const {
+AlbumCoverManagerList::AlbumCoverManagerList(QWidget *parent)
+    : QListView(parent),
+      timer_visible_rows_(new QTimer(this)) {
 
-  // Get songs
-  SongList songs;
-  for (QListWidgetItem *item : items) {
-    songs << manager_->GetSongsInAlbum(indexFromItem(item));
+  timer_visible_rows_->setSingleShot(true);
+  timer_visible_rows_->setInterval(50ms);
+  QObject::connect(timer_visible_rows_, &QTimer::timeout, this, &AlbumCoverManagerList::UpdateVisibleRows);
+
+}
+
+void AlbumCoverManagerList::setModel(QAbstractItemModel *model) {
+
+  if (QAbstractItemModel *old_model = QListView::model()) {
+    QObject::disconnect(old_model, nullptr, this, nullptr);
+  }
+
+  QListView::setModel(model);
+
+  if (model) {
+    QObject::connect(model, &QAbstractItemModel::rowsInserted, this, &AlbumCoverManagerList::QueueUpdateVisibleRows);
+    QObject::connect(model, &QAbstractItemModel::modelReset, this, &AlbumCoverManagerList::QueueUpdateVisibleRows);
   }
 
-  if (songs.isEmpty()) return nullptr;
+}
+
+void AlbumCoverManagerList::scrollContentsBy(const int dx, const int dy) {
+
+  QListView::scrollContentsBy(dx, dy);
+  QueueUpdateVisibleRows();
+
+}
+
+void AlbumCoverManagerList::resizeEvent(QResizeEvent *e) {
+
+  QListView::resizeEvent(e);
+  QueueUpdateVisibleRows();
 
-  // Get URLs from the songs
-  QList<QUrl> urls;
-  urls.reserve(songs.count());
-  for (const Song &song : std::as_const(songs)) {
-    urls << song.url();
+}
+
+void AlbumCoverManagerList::QueueUpdateVisibleRows() {
+
+  timer_visible_rows_->start();
+
+}
+
+int AlbumCoverManagerList::FirstRowBelow(const int y) const {
+
+  // Rows are laid out left to right, top to bottom, so the bottom edge only grows with the row number.
+  // Rows that are not laid out yet have an empty rectangle and are treated as being below everything.
+  int first = 0;
+  int last = model()->rowCount();
+  while (first < last) {
+    const int middle = first + (last - first) / 2;
+    const QRect rect = visualRect(model()->index(middle, 0));
+    if (rect.isValid() && rect.bottom() < y) {
+      first = middle + 1;
+    }
+    else {
+      last = middle;
+    }
   }
 
-  // Get the QAbstractItemModel data so the picture works
-  ScopedPtr<QMimeData> orig_data(QListWidget::mimeData(items));
+  return first;
 
-  SongMimeData *mime_data = new SongMimeData;
-  mime_data->backend = manager_->collection_backend();
-  mime_data->songs = songs;
-  mime_data->setUrls(urls);
-  mime_data->setData(orig_data->formats()[0], orig_data->data(orig_data->formats()[0]));
+}
+
+void AlbumCoverManagerList::UpdateVisibleRows() {
+
+  if (!isVisible() || !model() || model()->rowCount() == 0) return;
+
+  // Include one screen above and below, so covers are already there when scrolling a bit.
+  const int margin = viewport()->height();
+  const int top = -margin;
+  const int bottom = viewport()->height() + margin;
 
-  return mime_data;
+  const int row_count = model()->rowCount();
+  const int first_row = FirstRowBelow(top);
+  int last_row = first_row - 1;
+  for (int row = first_row; row < row_count; ++row) {
+    const QRect rect = visualRect(model()->index(row, 0));
+    if (!rect.isValid()) {
+      // Not laid out yet, check again once the layout has caught up.
+      QueueUpdateVisibleRows();
+      break;
+    }
+    if (rect.top() > bottom) break;
+    last_row = row;
+  }
+
+  if (last_row >= first_row) {
+    Q_EMIT VisibleRowsChanged(first_row, last_row);
+  }
 
 }
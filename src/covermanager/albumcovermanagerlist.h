@@ -25,31 +25,42 @@
 #include "config.h"
 
 #include <QObject>
-#include <QString>
-#include <QList>
-#include <QListWidget>
+#include <QListView>
 
 class QWidget;
-class QMimeData;
-class QListWidgetItem;
+class QTimer;
+class QAbstractItemModel;
 class QDropEvent;
-class AlbumCoverManager;
+class QResizeEvent;
 
-class AlbumCoverManagerList : public QListWidget {
+// Album view of the cover manager.
+// Tells the cover manager which rows are on screen, or close to it, so covers are only loaded for those.
+
+class AlbumCoverManagerList : public QListView {
   Q_OBJECT
 
  public:
   explicit AlbumCoverManagerList(QWidget *parent = nullptr);
 
-  void set_cover_manager(AlbumCoverManager *manager) { manager_ = manager; }
+  void setModel(QAbstractItemModel *model) override;
 
- protected:
-  QMimeData *mimeData(const QList<QListWidgetItem*> &items) const override;
+ Q_SIGNALS:
+  void VisibleRowsChanged(const int first_row, const int last_row);
 
+ protected:
   void dropEvent(QDropEvent*) override {}
+  void scrollContentsBy(const int dx, const int dy) override;
+  void resizeEvent(QResizeEvent *e) override;
+
+ private Q_SLOTS:
+  void QueueUpdateVisibleRows();
+  void UpdateVisibleRows();
+
+ private:
+  int FirstRowBelow(const int y) const;
 
  private:
-  AlbumCoverManager *manager_;
+  QTimer *timer_visible_rows_;
 };
 
 #endif  // ALBUMCOVERMANAGERLIST_H
@@ -0,0 +1,416 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <utility>
+
+#include <QObject>
+#include <QAbstractListModel>
+#include <QList>
+#include <QVariant>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QIcon>
+#include <QMimeData>
+#include <QSqlDatabase>
+
+#include "core/scoped_ptr.h"
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "core/database.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionquery.h"
+#include "playlist/songmimedata.h"
+#include "albumcovermanagermodel.h"
+
+using namespace Qt::StringLiterals;
+
+AlbumCoverManagerModel::AlbumCoverManagerModel(SharedPtr<CollectionBackend> collection_backend, const QIcon &icon_nocover, QObject *parent)
+    : QAbstractListModel(parent),
+      collection_backend_(collection_backend),
+      icon_nocover_(icon_nocover),
+      hide_covers_(HideCovers::None),
+      without_cover_count_(0) {}
+
+int AlbumCoverManagerModel::rowCount(const QModelIndex &parent) const {
+
+  if (parent.isValid()) return 0;
+
+  return static_cast<int>(rows_.count());
+
+}
+
+QVariant AlbumCoverManagerModel::data(const QModelIndex &idx, const int role) const {
+
+  const int i = album_index(idx);
+  if (i == -1) return QVariant();
+
+  const Album &album = albums_[i];
+
+  switch (role) {
+    case Qt::DisplayRole:
+      return album.display_text;
+    case Qt::ToolTipRole:
+      return album.tooltip;
+    case Qt::DecorationRole:
+      return album.cover_loaded ? album.icon : icon_nocover_;
+    case Qt::TextAlignmentRole:
+      return QVariant(Qt::AlignTop | Qt::AlignHCenter);
+    case Role_AlbumArtist:
+      return album.album.album_artist;
+    case Role_Album:
+      return album.album.album;
+    case Role_ArtEmbedded:
+      return album.album.art_embedded;
+    case Role_ArtAutomatic:
+      return album.album.art_automatic;
+    case Role_ArtManual:
+      return album.album.art_manual;
+    case Role_ArtUnset:
+      return album.album.art_unset;
+    case Role_Filetype:
+      return QVariant::fromValue(album.album.filetype);
+    case Role_CuePath:
+      return album.album.cue_path;
+    case Role_AlbumIndex:
+      return i;
+    default:
+      return QVariant();
+  }
+
+}
+
+Qt::ItemFlags AlbumCoverManagerModel::flags(const QModelIndex &idx) const {
+
+  if (!idx.isValid()) return Qt::NoItemFlags;
+
+  return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled;
+
+}
+
+Qt::DropActions AlbumCoverManagerModel::supportedDragActions() const {
+
+  return Qt::CopyAction;
+
+}
+
+QMimeData *AlbumCoverManagerModel::mimeData(const QModelIndexList &indexes) const {
+
+  SongList songs;
+  const QList<int> album_indexes = AlbumCoverManagerModel::album_indexes(indexes);
+  for (const int i : album_indexes) {
+    songs << GetSongsInAlbum(i);
+  }
+
+  if (songs.isEmpty()) return nullptr;
+
+  QList<QUrl> urls;
+  urls.reserve(songs.count());
+  for (const Song &song : std::as_const(songs)) {
+    urls << song.url();
+  }
+
+  // Get the QAbstractItemModel data so the picture works
+  ScopedPtr<QMimeData> orig_data(QAbstractListModel::mimeData(indexes));
+
+  SongMimeData *mime_data = new SongMimeData;
+  mime_data->backend = collection_backend_;
+  mime_data->songs = songs;
+  mime_data->setUrls(urls);
+  if (orig_data && !orig_data->formats().isEmpty()) {
+    mime_data->setData(orig_data->formats()[0], orig_data->data(orig_data->formats()[0]));
+  }
+
+  return mime_data;
+
+}
+
+void AlbumCoverManagerModel::Clear() {
+
+  beginResetModel();
+  albums_.clear();
+  rows_.clear();
+  album_rows_.clear();
+  without_cover_count_ = 0;
+  endResetModel();
+
+  Q_EMIT CountsChanged();
+
+}
+
+void AlbumCoverManagerModel::AddAlbums(const CollectionBackend::AlbumList &albums, const bool show_album_artist) {
+
+  if (albums.isEmpty()) return;
+
+  QList<int> new_rows;
+  for (const CollectionBackend::Album &album_info : albums) {
+
+    Album album;
+    album.album = album_info;
+    if (show_album_artist) {
+      album.display_text = album_info.album_artist + " - "_L1 + album_info.album;
+    }
+    else {
+      album.display_text = album_info.album;
+    }
+    if (album_info.album_artist.isEmpty()) {
+      album.tooltip = album_info.album;
+    }
+    else {
+      album.tooltip = album_info.album_artist + " - "_L1 + album_info.album;
+    }
+
+    const int i = static_cast<int>(albums_.count());
+    albums_ << album;
+    if (ShouldHide(album)) {
+      album_rows_ << -1;
+    }
+    else {
+      album_rows_ << static_cast<int>(rows_.count() + new_rows.count());
+      new_rows << i;
+      if (!HasCover(album)) ++without_cover_count_;
+    }
+
+  }
+
+  if (!new_rows.isEmpty()) {
+    beginInsertRows(QModelIndex(), static_cast<int>(rows_.count()), static_cast<int>(rows_.count() + new_rows.count() - 1));
+    rows_ << new_rows;
+    endInsertRows();
+  }
+
+  Q_EMIT CountsChanged();
+
+}
+
+void AlbumCoverManagerModel::SetFilter(const QString &filter, const HideCovers hide_covers) {
+
+  beginResetModel();
+
+  filter_ = filter.isEmpty() ? QStringList() : filter.split(u' ');
+  hide_covers_ = hide_covers;
+
+  rows_.clear();
+  without_cover_count_ = 0;
+  for (int i = 0; i < albums_.count(); ++i) {
+    const Album &album = albums_[i];
+    if (ShouldHide(album)) {
+      album_rows_[i] = -1;
+      continue;
+    }
+    album_rows_[i] = static_cast<int>(rows_.count());
+    rows_ << i;
+    if (!HasCover(album)) ++without_cover_count_;
+  }
+
+  endResetModel();
+
+  Q_EMIT CountsChanged();
+
+}
+
+bool AlbumCoverManagerModel::ShouldHide(const Album &album) const {
+
+  const bool has_cover = HasCover(album);
+  if (hide_covers_ == HideCovers::WithCovers && has_cover) {
+    return true;
+  }
+  else if (hide_covers_ == HideCovers::WithoutCovers && !has_cover) {
+    return true;
+  }
+
+  for (const QString &s : filter_) {
+    const bool in_text = album.display_text.contains(s, Qt::CaseInsensitive);
+    const bool in_albumartist = album.album.album_artist.contains(s, Qt::CaseInsensitive);
+    if (!in_text && !in_albumartist) {
+      return true;
+    }
+  }
+
+  return false;
+
+}
+
+bool AlbumCoverManagerModel::HasCover(const Album &album) const {
+
+  // Until the cover is loaded, trust the database.
+  if (album.cover_loaded) {
+    return album.icon.cacheKey() != icon_nocover_.cacheKey();
+  }
+
+  return !album.album.art_unset && (album.album.art_embedded || !album.album.art_automatic.isEmpty() || !album.album.art_manual.isEmpty());
+
+}
+
+int AlbumCoverManagerModel::album_index(const QModelIndex &idx) const {
+
+  if (!idx.isValid() || idx.model() != this) return -1;
+
+  return album_index(idx.row());
+
+}
+
+int AlbumCoverManagerModel::album_index(const int row) const {
+
+  if (row < 0 || row >= rows_.count()) return -1;
+
+  return rows_[row];
+
+}
+
+QModelIndex AlbumCoverManagerModel::index_for_album(const int album_index) const {
+
+  if (album_index < 0 || album_index >= album_rows_.count() || album_rows_[album_index] == -1) return QModelIndex();
+
+  return index(album_rows_[album_index]);
+
+}
+
+QList<int> AlbumCoverManagerModel::album_indexes(const QModelIndexList &indexes) const {
+
+  QList<int> ret;
+  ret.reserve(indexes.count());
+  for (const QModelIndex &idx : indexes) {
+    const int i = album_index(idx);
+    if (i != -1) ret << i;
+  }
+
+  return ret;
+
+}
+
+bool AlbumCoverManagerModel::AlbumHasArt(const int album_index) const {
+
+  const CollectionBackend::Album &album_info = albums_[album_index].album;
+  return album_info.art_embedded || !album_info.art_automatic.isEmpty() || !album_info.art_manual.isEmpty();
+
+}
+
+bool AlbumCoverManagerModel::AlbumHasCover(const int album_index) const {
+
+  return HasCover(albums_[album_index]);
+
+}
+
+void AlbumCoverManagerModel::SetAlbumArt(const int album_index, const bool art_embedded, const QUrl &art_automatic, const QUrl &art_manual, const bool art_unset) {
+
+  Album &album = albums_[album_index];
+  const bool had_cover = HasCover(album);
+  album.album.art_embedded = art_embedded;
+  album.album.art_automatic = art_automatic;
+  album.album.art_manual = art_manual;
+  album.album.art_unset = art_unset;
+
+  AlbumChanged(album_index, had_cover);
+
+}
+
+void AlbumCoverManagerModel::SetAlbumCover(const int album_index, const QIcon &icon) {
+
+  Album &album = albums_[album_index];
+  const bool had_cover = HasCover(album);
+  album.icon = icon.isNull() ? icon_nocover_ : icon;
+  album.cover_loaded = true;
+
+  AlbumChanged(album_index, had_cover);
+
+}
+
+void AlbumCoverManagerModel::AlbumChanged(const int album_index, const bool had_cover) {
+
+  const QModelIndex idx = index_for_album(album_index);
+  if (!idx.isValid()) return;
+
+  if (had_cover != HasCover(albums_[album_index])) {
+    without_cover_count_ += had_cover ? 1 : -1;
+    Q_EMIT CountsChanged();
+  }
+
+  Q_EMIT dataChanged(idx, idx);
+
+}
+
+Song AlbumCoverManagerModel::AlbumAsSong(const int album_index) const {
+
+  const CollectionBackend::Album &album_info = albums_[album_index].album;
+
+  Song result(Song::Source::Collection);
+
+  if (!album_info.album_artist.isEmpty()) {
+    result.set_title(album_info.album_artist + " - "_L1 + album_info.album);
+  }
+  else {
+    result.set_title(album_info.album);
+  }
+
+  result.set_artist(album_info.album_artist);
+  result.set_albumartist(album_info.album_artist);
+  result.set_album(album_info.album);
+
+  result.set_filetype(album_info.filetype);
+  result.set_url(album_info.urls.constFirst());
+  result.set_cue_path(album_info.cue_path);
+
+  result.set_art_embedded(album_info.art_embedded);
+  result.set_art_automatic(album_info.art_automatic);
+  result.set_art_manual(album_info.art_manual);
+  result.set_art_unset(album_info.art_unset);
+
+  // force validity
+  result.set_valid(true);
+  result.set_id(0);
+
+  return result;
+
+}
+
+SongList AlbumCoverManagerModel::GetSongsInAlbum(const int album_index) const {
+
+  SongList ret;
+
+  if (album_index < 0 || album_index >= albums_.count()) return ret;
+
+  const CollectionBackend::Album &album_info = albums_[album_index].album;
+
+  QSqlDatabase db(collection_backend_->db()->Connect());
+
+  CollectionQuery q(db, collection_backend_->songs_table());
+  q.SetColumnSpec(Song::kRowIdColumnSpec);
+  q.AddWhere(QStringLiteral("album"), album_info.album);
+  q.SetOrderBy(QStringLiteral("disc, track, title"));
+
+  if (!album_info.album_artist.isEmpty()) {
+    q.AddWhere(QStringLiteral("effective_albumartist"), album_info.album_artist);
+  }
+
+  q.AddCompilationRequirement(album_info.album_artist.isEmpty());
+
+  if (!q.Exec()) return ret;
+
+  while (q.Next()) {
+    Song song;
+    song.InitFromQuery(q, true);
+    ret << song;
+  }
+
+  return ret;
+
+}
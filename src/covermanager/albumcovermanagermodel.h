@@ -0,0 +1,130 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ALBUMCOVERMANAGERMODEL_H
+#define ALBUMCOVERMANAGERMODEL_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QObject>
+#include <QAbstractListModel>
+#include <QList>
+#include <QVariant>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QIcon>
+
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "collection/collectionbackend.h"
+
+class QMimeData;
+
+// The albums shown by the cover manager.
+// Every album loaded for the current artist is kept, but only the ones matching the filter are exposed as rows.
+// Albums are addressed by their position in the loaded list, which stays the same when the filter changes.
+// Covers are only set for the albums the view asks for, the others show the "no cover" icon.
+
+class AlbumCoverManagerModel : public QAbstractListModel {
+  Q_OBJECT
+
+ public:
+  explicit AlbumCoverManagerModel(SharedPtr<CollectionBackend> collection_backend, const QIcon &icon_nocover, QObject *parent = nullptr);
+
+  enum Role {
+    Role_AlbumArtist = Qt::UserRole + 1,
+    Role_Album,
+    Role_ArtEmbedded,
+    Role_ArtAutomatic,
+    Role_ArtManual,
+    Role_ArtUnset,
+    Role_Filetype,
+    Role_CuePath,
+    Role_AlbumIndex
+  };
+
+  enum class HideCovers {
+    None,
+    WithCovers,
+    WithoutCovers
+  };
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &idx, const int role = Qt::DisplayRole) const override;
+  Qt::ItemFlags flags(const QModelIndex &idx) const override;
+  QMimeData *mimeData(const QModelIndexList &indexes) const override;
+  Qt::DropActions supportedDragActions() const override;
+
+  void Clear();
+  void AddAlbums(const CollectionBackend::AlbumList &albums, const bool show_album_artist);
+  void SetFilter(const QString &filter, const HideCovers hide_covers);
+
+  qint64 album_count() const { return albums_.count(); }
+  const CollectionBackend::Album &album(const int album_index) const { return albums_[album_index].album; }
+  int album_index(const QModelIndex &idx) const;
+  int album_index(const int row) const;
+  QModelIndex index_for_album(const int album_index) const;
+  QList<int> album_indexes(const QModelIndexList &indexes) const;
+
+  bool AlbumHasArt(const int album_index) const;
+  bool AlbumHasCover(const int album_index) const;
+  bool AlbumCoverLoaded(const int album_index) const { return albums_[album_index].cover_loaded; }
+
+  void SetAlbumArt(const int album_index, const bool art_embedded, const QUrl &art_automatic, const QUrl &art_manual, const bool art_unset);
+  void SetAlbumCover(const int album_index, const QIcon &icon);
+
+  Song AlbumAsSong(const int album_index) const;
+  SongList GetSongsInAlbum(const int album_index) const;
+
+  int total_count() const { return static_cast<int>(rows_.count()); }
+  int without_cover_count() const { return without_cover_count_; }
+
+ Q_SIGNALS:
+  void CountsChanged();
+
+ private:
+  struct Album {
+    Album() : cover_loaded(false) {}
+    CollectionBackend::Album album;
+    QString display_text;
+    QString tooltip;
+    QIcon icon;
+    bool cover_loaded;
+  };
+
+  bool ShouldHide(const Album &album) const;
+  bool HasCover(const Album &album) const;
+  void AlbumChanged(const int album_index, const bool had_cover);
+
+ private:
+  SharedPtr<CollectionBackend> collection_backend_;
+  const QIcon icon_nocover_;
+
+  QList<Album> albums_;
+  QList<int> rows_;
+  QList<int> album_rows_;
+
+  QStringList filter_;
+  HideCovers hide_covers_;
+  int without_cover_count_;
+};
+
+#endif  // ALBUMCOVERMANAGERMODEL_H
@@ -23,220 +23,293 @@
 
 #include <utility>
 
+#include <QMutex>
+#include <QMutexLocker>
+#include <QIODevice>
 #include <QFile>
+#include <QBuffer>
+#include <QByteArray>
 #include <QSize>
 #include <QString>
+#include <QStringList>
 #include <QImage>
+#include <QImageReader>
+#include <QCryptographicHash>
 
+#include "core/shared_ptr.h"
 #include "core/song.h"
 #include "core/tagreaderclient.h"
+#include "utilities/fileutils.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverexport.h"
 #include "coverexportrunnable.h"
 
 using namespace Qt::StringLiterals;
 
-CoverExportRunnable::CoverExportRunnable(const AlbumCoverExport::DialogResult &dialog_result, const AlbumCoverLoaderOptions::Types &cover_types, const Song &song, QObject *parent)
-    : QObject(parent),
-      dialog_result_(dialog_result),
-      cover_types_(cover_types),
-      song_(song) {}
+QString CoverExportWrittenFiles::File(const QByteArray &hash) {
 
-void CoverExportRunnable::run() {
+  QMutexLocker l(&mutex_);
+  return files_.value(hash);
 
-  if (song_.art_unset() || (!song_.art_embedded() && !song_.art_automatic_is_valid() && !song_.art_manual_is_valid())) {
-    EmitCoverSkipped();
-  }
-  else {
-    if (dialog_result_.RequiresCoverProcessing()) {
-      ProcessAndExportCover();
-    }
-    else {
-      ExportCover();
-    }
-  }
+}
+
+void CoverExportWrittenFiles::AddFile(const QByteArray &hash, const QString &filename) {
+
+  QMutexLocker l(&mutex_);
+  if (!files_.contains(hash)) files_.insert(hash, filename);
 
 }
 
-// Exports a single album cover using a "save QImage to file" approach.
-// For performance reasons this method will be invoked only if loading and in memory processing of images is necessary for current settings which means that:
-// - either the force size flag is being used
-// - or the "overwrite smaller" mode is used
-// In all other cases, the faster ExportCover() method will be used.
-void CoverExportRunnable::ProcessAndExportCover() {
+CoverExportRunnable::CoverExportRunnable(const AlbumCoverExport::DialogResult &dialog_result, const AlbumCoverLoaderOptions::Types &cover_types, const SongList &songs, SharedPtr<CoverExportWrittenFiles> written_files, QObject *parent)
+    : QObject(parent),
+      dialog_result_(dialog_result),
+      cover_types_(cover_types),
+      songs_(songs),
+      written_files_(written_files) {}
 
-  QImage image;
-  QString extension;
+QString CoverExportRunnable::SourceKey(const AlbumCoverExport::DialogResult &dialog_result, const AlbumCoverLoaderOptions::Types &cover_types, const Song &song) {
 
-  for (const AlbumCoverLoaderOptions::Type cover_type : std::as_const(cover_types_)) {
+  if (song.art_unset() || (!song.art_embedded() && !song.art_automatic_is_valid() && !song.art_manual_is_valid())) {
+    return QString();
+  }
+
+  QStringList sources;
+  for (const AlbumCoverLoaderOptions::Type cover_type : cover_types) {
     switch (cover_type) {
       case AlbumCoverLoaderOptions::Type::Unset:
-        if (song_.art_unset()) {
-          EmitCoverSkipped();
-          return;
-        }
         break;
       case AlbumCoverLoaderOptions::Type::Embedded:
-        if (song_.art_embedded() && dialog_result_.export_embedded_) {
-          const TagReaderClient::Result result = TagReaderClient::Instance()->LoadEmbeddedArtAsImageBlocking(song_.url().toLocalFile(), image);
-          if (result.success() && !image.isNull()) {
-            extension = "jpg"_L1;
-          }
+        if (song.art_embedded() && dialog_result.export_embedded_) {
+          sources << "embedded:"_L1 + song.url().toLocalFile();
         }
         break;
       case AlbumCoverLoaderOptions::Type::Manual:
-        if (dialog_result_.export_downloaded_ && song_.art_manual_is_valid()) {
-          const QString cover_path = song_.art_manual().toLocalFile();
-          if (image.load(cover_path)) {
-            extension = cover_path.section(u'.', -1);
-          }
+        if (dialog_result.export_downloaded_ && song.art_manual_is_valid()) {
+          sources << "file:"_L1 + song.art_manual().toLocalFile();
         }
         break;
       case AlbumCoverLoaderOptions::Type::Automatic:
-        if (dialog_result_.export_downloaded_ && song_.art_automatic_is_valid()) {
-          const QString cover_path = song_.art_automatic().toLocalFile();
-          if (image.load(cover_path)) {
-            extension = cover_path.section(u'.', -1);
-          }
+        if (dialog_result.export_downloaded_ && song.art_automatic_is_valid()) {
+          sources << "file:"_L1 + song.art_automatic().toLocalFile();
         }
         break;
     }
-    if (!image.isNull() && !extension.isEmpty()) break;
-  }
-
-  if (image.isNull() || extension.isEmpty()) {
-    EmitCoverSkipped();
-    return;
   }
 
-  // Rescale if necessary
-  if (dialog_result_.IsSizeForced()) {
-    image = image.scaled(QSize(dialog_result_.width_, dialog_result_.height_), Qt::IgnoreAspectRatio);
-  }
+  // Processed covers of songs with embedded art are always saved as JPEG.
+  if (song.art_embedded()) sources << u"jpg"_s;
 
-  QString cover_dir = song_.url().toLocalFile().section(u'/', 0, -2);
-  QString new_file = cover_dir + QLatin1Char('/') + dialog_result_.filename_ + QLatin1Char('.') + (song_.art_embedded() ? "jpg"_L1 : extension);
+  return sources.join(u'\n');
 
-  // If the file exists, do not override!
-  if (dialog_result_.overwrite_ == AlbumCoverExport::OverwriteMode::None && QFile::exists(new_file)) {
-    EmitCoverSkipped();
-    return;
-  }
+}
 
-  // We're handling overwrite as remove + copy so we need to delete the old file first
-  if (QFile::exists(new_file) && dialog_result_.overwrite_ != AlbumCoverExport::OverwriteMode::None) {
+void CoverExportRunnable::run() {
 
-    // if the mode is "overwrite smaller" then skip the cover if a bigger one is already available in the folder
-    if (dialog_result_.overwrite_ == AlbumCoverExport::OverwriteMode::Smaller) {
-      QImage image_existing;
-      image_existing.load(new_file);
+  if (songs_.isEmpty()) return;
 
-      if (image_existing.isNull() || image_existing.size().height() >= image.size().height() || image_existing.size().width() >= image.size().width()) {
-        EmitCoverSkipped();
-        return;
-      }
-    }
+  const Song &song = songs_.constFirst();
 
-    if (!QFile::remove(new_file)) {
-      EmitCoverSkipped();
-      return;
-    }
+  Cover cover;
+  if (song.art_unset() || (!song.art_embedded() && !song.art_automatic_is_valid() && !song.art_manual_is_valid()) || !LoadCover(cover)) {
+    EmitCoversSkipped(songs_.count());
+    return;
   }
 
-  if (image.save(new_file)) {
-    EmitCoverExported();
-  }
-  else {
-    EmitCoverSkipped();
-  }
+  ExportCovers(cover);
 
 }
 
-// Exports a single album cover using a "copy file" approach.
-void CoverExportRunnable::ExportCover() {
+// Finds the first available cover, only the image header of files is read here.
+bool CoverExportRunnable::LoadCover(Cover &cover) const {
 
-  QImage image;
-  QString extension;
-  QString cover_path;
-  bool embedded_cover = false;
+  const Song &song = songs_.constFirst();
 
   for (const AlbumCoverLoaderOptions::Type cover_type : std::as_const(cover_types_)) {
     switch (cover_type) {
       case AlbumCoverLoaderOptions::Type::Unset:
-        if (song_.art_unset()) {
-          EmitCoverSkipped();
-          return;
+        if (song.art_unset()) {
+          return false;
         }
         break;
       case AlbumCoverLoaderOptions::Type::Embedded:
-        if (song_.art_embedded() && dialog_result_.export_embedded_) {
-          const TagReaderClient::Result result = TagReaderClient::Instance()->LoadEmbeddedArtAsImageBlocking(song_.url().toLocalFile(), image);
-          if (result.success() && !image.isNull()) {
-            embedded_cover = true;
-            extension = "jpg"_L1;
+        if (song.art_embedded() && dialog_result_.export_embedded_) {
+          QByteArray data;
+          const TagReaderClient::Result result = TagReaderClient::Instance()->LoadEmbeddedArtBlocking(song.url().toLocalFile(), data);
+          QBuffer buffer(&data);
+          if (result.success() && !data.isEmpty() && QImageReader(&buffer).canRead()) {
+            cover.embedded = true;
+            cover.embedded_data = data;
+            cover.extension = "jpg"_L1;
+            return true;
           }
         }
         break;
       case AlbumCoverLoaderOptions::Type::Manual:
-        if (dialog_result_.export_downloaded_ && song_.art_manual_is_valid()) {
-          cover_path = song_.art_manual().toLocalFile();
-          if (image.load(cover_path)) {
-            extension = cover_path.section(u'.', -1);
+        if (dialog_result_.export_downloaded_ && song.art_manual_is_valid()) {
+          const QString cover_path = song.art_manual().toLocalFile();
+          if (QImageReader(cover_path).canRead()) {
+            cover.path = cover_path;
+            cover.extension = cover_path.section(u'.', -1);
+            return true;
           }
         }
         break;
       case AlbumCoverLoaderOptions::Type::Automatic:
-        if (dialog_result_.export_downloaded_ && song_.art_automatic_is_valid()) {
-          cover_path = song_.art_automatic().toLocalFile();
-          if (image.load(cover_path)) {
-            extension = cover_path.section(u'.', -1);
+        if (dialog_result_.export_downloaded_ && song.art_automatic_is_valid()) {
+          const QString cover_path = song.art_automatic().toLocalFile();
+          if (QImageReader(cover_path).canRead()) {
+            cover.path = cover_path;
+            cover.extension = cover_path.section(u'.', -1);
+            return true;
           }
         }
         break;
     }
-    if (!image.isNull() && !extension.isEmpty() && (embedded_cover || !cover_path.isEmpty())) break;
   }
 
-  if (image.isNull() || extension.isEmpty()) {
-    EmitCoverSkipped();
+  return false;
+
+}
+
+// Image files are copied as they are, unless they need to be resized or compared to existing covers ("overwrite smaller").
+// Otherwise the image is decoded and encoded once. Either way, the first file written is then linked or copied to the other albums.
+void CoverExportRunnable::ExportCovers(const Cover &cover) {
+
+  const bool process = dialog_result_.RequiresCoverProcessing();
+  if (!cover.embedded && !process) {
+    WriteCovers(cover.extension, QByteArray(), cover.path, QSize());
     return;
   }
 
-  QString cover_dir = song_.url().toLocalFile().section(u'/', 0, -2);
-  QString new_file = cover_dir + QLatin1Char('/') + dialog_result_.filename_ + QLatin1Char('.') + extension;
+  const QString extension = process && songs_.constFirst().art_embedded() ? "jpg"_L1 : cover.extension;
 
-  // If the file exists, do not override!
-  if (dialog_result_.overwrite_ == AlbumCoverExport::OverwriteMode::None && QFile::exists(new_file)) {
-    EmitCoverSkipped();
+  // Different albums often have the same embedded cover, reuse the file written for the first one.
+  QByteArray hash;
+  if (cover.embedded) {
+    hash = QCryptographicHash::hash(cover.embedded_data, QCryptographicHash::Sha1);
+    const QString written_file = written_files_->File(hash);
+    if (!written_file.isEmpty() && QFile::exists(written_file)) {
+      WriteCovers(extension, QByteArray(), written_file, QImageReader(written_file).size());
+      return;
+    }
+  }
+
+  QImage image;
+  if (cover.embedded) {
+    image.loadFromData(cover.embedded_data);
+  }
+  else {
+    image.load(cover.path);
+  }
+  if (image.isNull()) {
+    EmitCoversSkipped(songs_.count());
     return;
   }
 
-  // We're handling overwrite as remove + copy so we need to delete the old file first
-  if (dialog_result_.overwrite_ != AlbumCoverExport::OverwriteMode::None && QFile::exists(new_file)) {
-    if (!QFile::remove(new_file)) {
+  // Rescale if necessary
+  if (dialog_result_.IsSizeForced()) {
+    image = image.scaled(QSize(dialog_result_.width_, dialog_result_.height_), Qt::IgnoreAspectRatio);
+  }
+
+  QByteArray data;
+  QBuffer buffer(&data);
+  if (!buffer.open(QIODevice::WriteOnly) || !image.save(&buffer, extension.toLatin1().constData())) {
+    EmitCoversSkipped(songs_.count());
+    return;
+  }
+  buffer.close();
+
+  const QString new_file = WriteCovers(extension, data, QString(), image.size());
+  if (!hash.isEmpty() && !new_file.isEmpty()) {
+    written_files_->AddFile(hash, new_file);
+  }
+
+}
+
+// Writes the cover to the directory of each song, either the encoded data or a copy of source_file.
+// The other songs get a link to the first file written, or a copy of it. Returns the first file written.
+QString CoverExportRunnable::WriteCovers(const QString &extension, const QByteArray &data, QString source_file, const QSize &size) {
+
+  QString first_new_file;
+
+  for (const Song &song : std::as_const(songs_)) {
+
+    const QString cover_dir = song.url().toLocalFile().section(u'/', 0, -2);
+    const QString new_file = cover_dir + QLatin1Char('/') + dialog_result_.filename_ + QLatin1Char('.') + extension;
+
+    // Another album in the same directory, or the cover is already there.
+    if (new_file == first_new_file || new_file == source_file) {
+      EmitCoverExported();
+      continue;
+    }
+
+    if (!PrepareNewFile(new_file, size)) {
       EmitCoverSkipped();
-      return;
+      continue;
     }
-  }
 
-  if (embedded_cover) {
-    if (!image.save(new_file)) {
+    bool success = false;
+    if (source_file.isEmpty()) {
+      QFile file(new_file);
+      success = file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+      file.close();
+    }
+    else if (first_new_file.isEmpty()) {
+      // Never link to the source, it can be Strawberry's own cover file which is rewritten in place when the cover changes.
+      success = QFile::copy(source_file, new_file);
+    }
+    else {
+      success = Utilities::LinkOrCopy(first_new_file, new_file);
+    }
+
+    if (!success) {
       EmitCoverSkipped();
-      return;
+      continue;
+    }
+
+    if (first_new_file.isEmpty()) {
+      first_new_file = new_file;
+      if (source_file.isEmpty()) source_file = new_file;
     }
+
+    EmitCoverExported();
+
   }
-  else {
-    // Automatic or manual cover, available in an image file
-    if (!QFile::copy(cover_path, new_file)) {
-      EmitCoverSkipped();
-      return;
+
+  return first_new_file;
+
+}
+
+bool CoverExportRunnable::PrepareNewFile(const QString &new_file, const QSize &size) const {
+
+  if (!QFile::exists(new_file)) return true;
+
+  // If the file exists, do not override!
+  if (dialog_result_.overwrite_ == AlbumCoverExport::OverwriteMode::None) return false;
+
+  // If the mode is "overwrite smaller" then skip the cover if a bigger one is already available in the folder
+  if (dialog_result_.overwrite_ == AlbumCoverExport::OverwriteMode::Smaller) {
+    QImageReader reader(new_file);
+    QSize existing_size = reader.size();
+    if (!existing_size.isValid()) existing_size = reader.read().size();
+    if (!existing_size.isValid() || existing_size.height() >= size.height() || existing_size.width() >= size.width()) {
+      return false;
     }
   }
 
-  EmitCoverExported();
+  // We're handling overwrite as remove + copy so we need to delete the old file first
+  return QFile::remove(new_file);
 
 }
 
 void CoverExportRunnable::EmitCoverExported() { Q_EMIT CoverExported(); }
 
 void CoverExportRunnable::EmitCoverSkipped() { Q_EMIT CoverSkipped(); }
+
+void CoverExportRunnable::EmitCoversSkipped(const qint64 count) {
+
+  for (qint64 i = 0; i < count; ++i) {
+    Q_EMIT CoverSkipped();
+  }
+
+}
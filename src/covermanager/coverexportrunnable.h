@@ -26,34 +26,68 @@
 
 #include <QObject>
 #include <QRunnable>
+#include <QMutex>
+#include <QHash>
+#include <QByteArray>
 #include <QString>
+#include <QSize>
 
+#include "core/shared_ptr.h"
 #include "core/song.h"
 #include "albumcoverloaderoptions.h"
 #include "albumcoverexport.h"
 
+// Files written for embedded covers during one export, by the hash of the embedded image.
+// Albums with the same embedded cover get a link or copy of the first file instead of encoding it again.
+class CoverExportWrittenFiles {
+ public:
+  QString File(const QByteArray &hash);
+  void AddFile(const QByteArray &hash, const QString &filename);
+
+ private:
+  QMutex mutex_;
+  QHash<QByteArray, QString> files_;
+};
+
+// Exports the cover of a group of albums sharing the same source image, see SourceKey().
+// The image is only read and encoded once for the whole group.
 class CoverExportRunnable : public QObject, public QRunnable {
   Q_OBJECT
 
  public:
-  explicit CoverExportRunnable(const AlbumCoverExport::DialogResult &dialog_result, const AlbumCoverLoaderOptions::Types &cover_types, const Song &song, QObject *parent = nullptr);
+  explicit CoverExportRunnable(const AlbumCoverExport::DialogResult &dialog_result, const AlbumCoverLoaderOptions::Types &cover_types, const SongList &songs, SharedPtr<CoverExportWrittenFiles> written_files, QObject *parent = nullptr);
 
   void run() override;
 
+  // Songs with the same key have the same candidate covers and export the same image.
+  static QString SourceKey(const AlbumCoverExport::DialogResult &dialog_result, const AlbumCoverLoaderOptions::Types &cover_types, const Song &song);
+
  Q_SIGNALS:
   void CoverExported();
   void CoverSkipped();
 
  private:
+  struct Cover {
+    Cover() : embedded(false) {}
+    bool embedded;
+    QByteArray embedded_data;
+    QString path;
+    QString extension;
+  };
+
   void EmitCoverExported();
   void EmitCoverSkipped();
+  void EmitCoversSkipped(const qint64 count);
 
-  void ProcessAndExportCover();
-  void ExportCover();
+  bool LoadCover(Cover &cover) const;
+  void ExportCovers(const Cover &cover);
+  QString WriteCovers(const QString &extension, const QByteArray &data, QString source_file, const QSize &size);
+  bool PrepareNewFile(const QString &new_file, const QSize &size) const;
 
   AlbumCoverExport::DialogResult dialog_result_;
   AlbumCoverLoaderOptions::Types cover_types_;
-  Song song_;
+  SongList songs_;
+  SharedPtr<CoverExportWrittenFiles> written_files_;
 };
 
 #endif  // COVEREXPORTRUNNABLE_H
@@ -52,6 +52,9 @@ class CoverProvider : public QObject {
   bool batch() const { return batch_; }
   bool allow_missing_album() const { return allow_missing_album_; }
 
+  // Number of errors reported so far, so a search can tell a failed request from one without results.
+  int error_count() const { return error_count_; }
+
   void set_enabled(const bool enabled) { enabled_ = enabled; }
   void set_order(const int order) { order_ = order; }
 
@@ -88,6 +91,7 @@ class CoverProvider : public QObject {
   float quality_;
   bool batch_;
   bool allow_missing_album_;
+  int error_count_;
 };
 
 #endif  // COVERPROVIDER_H
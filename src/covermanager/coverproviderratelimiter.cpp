@@ -0,0 +1,77 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtGlobal>
+#include <QDateTime>
+
+#include "coverproviderratelimiter.h"
+
+namespace {
+qint64 CurrentMSecs(const qint64 now) {
+  return now > 0 ? now : QDateTime::currentMSecsSinceEpoch();
+}
+}  // namespace
+
+CoverProviderRateLimiter::CoverProviderRateLimiter(const int requests_per_minute, const int burst)
+    : tokens_per_msec_(static_cast<double>(std::max(1, requests_per_minute)) / 60000.0),
+      max_tokens_(static_cast<double>(std::max(1, burst))),
+      tokens_(max_tokens_),
+      last_refill_(0) {}
+
+void CoverProviderRateLimiter::Refill(const qint64 now) {
+
+  if (last_refill_ > 0 && now > last_refill_) {
+    tokens_ = std::min(max_tokens_, tokens_ + static_cast<double>(now - last_refill_) * tokens_per_msec_);
+  }
+  if (now > last_refill_) {
+    last_refill_ = now;
+  }
+
+}
+
+bool CoverProviderRateLimiter::CanStart(const qint64 now) {
+
+  Refill(CurrentMSecs(now));
+
+  return tokens_ >= 1.0;
+
+}
+
+void CoverProviderRateLimiter::Started(const qint64 now) {
+
+  Refill(CurrentMSecs(now));
+
+  tokens_ = std::max(0.0, tokens_ - 1.0);
+
+}
+
+qint64 CoverProviderRateLimiter::msec_until_ready(const qint64 now) {
+
+  Refill(CurrentMSecs(now));
+
+  if (tokens_ >= 1.0) return 0;
+
+  return static_cast<qint64>(std::ceil((1.0 - tokens_) / tokens_per_msec_));
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COVERPROVIDERRATELIMITER_H
+#define COVERPROVIDERRATELIMITER_H
+
+#include "config.h"
+
+#include <QtGlobal>
+
+// Token bucket limiting how fast batch searches are sent to one cover provider.
+// The bucket holds up to burst tokens and refills at requests_per_minute, each search takes one token.
+
+class CoverProviderRateLimiter {
+
+ public:
+  explicit CoverProviderRateLimiter(const int requests_per_minute, const int burst);
+
+  bool CanStart(const qint64 now = 0);
+  void Started(const qint64 now = 0);
+  qint64 msec_until_ready(const qint64 now = 0);
+
+ private:
+  void Refill(const qint64 now);
+
+ private:
+  double tokens_per_msec_;
+  double max_tokens_;
+  double tokens_;
+  qint64 last_refill_;
+};
+
+#endif  // COVERPROVIDERRATELIMITER_H
@@ -0,0 +1,121 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QHash>
+#include <QString>
+#include <QDateTime>
+#include <QSqlDatabase>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "coversearchmisscache.h"
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr qint64 kMissExpirySecs = 30LL * 24LL * 60LL * 60LL;
+}
+
+CoverSearchMissCache::CoverSearchMissCache(SharedPtr<Database> database) : database_(database), loaded_(false) {}
+
+QString CoverSearchMissCache::Key(const QString &artist, const QString &album) {
+
+  return artist.toLower() + QLatin1Char('\t') + album.toLower();
+
+}
+
+void CoverSearchMissCache::Load() {
+
+  misses_.clear();
+
+  const qint64 expired = QDateTime::currentSecsSinceEpoch() - kMissExpirySecs;
+
+  {
+    Database::WriteLocker l(database_);
+    QSqlDatabase db(database_->Connect());
+    SqlQuery q(db);
+    q.prepare(u"DELETE FROM cover_search_misses WHERE time < :time"_s);
+    q.BindLongLongValue(u":time"_s, expired);
+    if (!q.Exec()) {
+      database_->ReportErrors(q);
+    }
+  }
+
+  QSqlDatabase db(database_->Connect());
+  SqlQuery q(db);
+  q.prepare(u"SELECT artist, album, time FROM cover_search_misses"_s);
+  if (!q.Exec()) {
+    database_->ReportErrors(q);
+    return;
+  }
+
+  while (q.next()) {
+    misses_.insert(Key(q.value(0).toString(), q.value(1).toString()), q.value(2).toLongLong());
+  }
+
+  loaded_ = true;
+
+}
+
+bool CoverSearchMissCache::Contains(const QString &artist, const QString &album, const qint64 now) const {
+
+  const QHash<QString, qint64>::const_iterator it = misses_.constFind(Key(artist, album));
+  if (it == misses_.constEnd()) return false;
+
+  return (now > 0 ? now : QDateTime::currentSecsSinceEpoch()) - it.value() < kMissExpirySecs;
+
+}
+
+void CoverSearchMissCache::Add(const QString &artist, const QString &album, const qint64 now) {
+
+  const qint64 time = now > 0 ? now : QDateTime::currentSecsSinceEpoch();
+  misses_.insert(Key(artist, album), time);
+
+  Database::WriteLocker l(database_);
+  QSqlDatabase db(database_->Connect());
+  SqlQuery q(db);
+  q.prepare(u"INSERT OR REPLACE INTO cover_search_misses (artist, album, time) VALUES (:artist, :album, :time)"_s);
+  q.BindStringValue(u":artist"_s, artist.toLower());
+  q.BindStringValue(u":album"_s, album.toLower());
+  q.BindLongLongValue(u":time"_s, time);
+  if (!q.Exec()) {
+    database_->ReportErrors(q);
+  }
+
+}
+
+void CoverSearchMissCache::Remove(const QString &artist, const QString &album) {
+
+  if (misses_.remove(Key(artist, album)) == 0) return;
+
+  Database::WriteLocker l(database_);
+  QSqlDatabase db(database_->Connect());
+  SqlQuery q(db);
+  q.prepare(u"DELETE FROM cover_search_misses WHERE artist = :artist AND album = :album"_s);
+  q.BindStringValue(u":artist"_s, artist.toLower());
+  q.BindStringValue(u":album"_s, album.toLower());
+  if (!q.Exec()) {
+    database_->ReportErrors(q);
+  }
+
+}
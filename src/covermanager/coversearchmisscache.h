@@ -0,0 +1,57 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COVERSEARCHMISSCACHE_H
+#define COVERSEARCHMISSCACHE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QHash>
+#include <QString>
+
+#include "core/shared_ptr.h"
+
+class Database;
+
+// Remembers the albums a cover search found nothing for, so fetching missing covers does not search for them again every time.
+// The misses are stored in the cover_search_misses table and expire after a while, since providers add new covers.
+
+class CoverSearchMissCache {
+
+ public:
+  explicit CoverSearchMissCache(SharedPtr<Database> database);
+
+  void Load();
+  bool is_loaded() const { return loaded_; }
+
+  bool Contains(const QString &artist, const QString &album, const qint64 now = 0) const;
+  void Add(const QString &artist, const QString &album, const qint64 now = 0);
+  void Remove(const QString &artist, const QString &album);
+
+ private:
+  static QString Key(const QString &artist, const QString &album);
+
+ private:
+  SharedPtr<Database> database_;
+  bool loaded_;
+  QHash<QString, qint64> misses_;
+};
+
+#endif  // COVERSEARCHMISSCACHE_H
@@ -311,6 +311,7 @@ void DeezerCoverProvider::HandleSearchReply(QNetworkReply *reply, const int id)
 }
 
 void DeezerCoverProvider::Error(const QString &error, const QVariant &debug) {
+  ++error_count_;
   qLog(Error) << "Deezer:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 }
@@ -469,6 +469,7 @@ void DiscogsCoverProvider::EndSearch(SharedPtr<DiscogsCoverSearchContext> search
 
 void DiscogsCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Discogs:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
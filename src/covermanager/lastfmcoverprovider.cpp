@@ -335,6 +335,7 @@ QByteArray LastFmCoverProvider::GetReplyData(QNetworkReply *reply) {
 
 void LastFmCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Last.fm:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
@@ -272,6 +272,7 @@ QByteArray MusicbrainzCoverProvider::GetReplyData(QNetworkReply *reply) {
 
 void MusicbrainzCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Musicbrainz:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
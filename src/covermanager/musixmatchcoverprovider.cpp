@@ -232,6 +232,7 @@ void MusixmatchCoverProvider::HandleSearchReply(QNetworkReply *reply, const int
 
 void MusixmatchCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Musixmatch:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
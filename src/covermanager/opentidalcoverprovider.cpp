@@ -465,6 +465,7 @@ void OpenTidalCoverProvider::FinishAllSearches() {
 
 void OpenTidalCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Tidal:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
@@ -281,6 +281,7 @@ void QobuzCoverProvider::HandleSearchReply(QNetworkReply *reply, const int id) {
 
 void QobuzCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Qobuz:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
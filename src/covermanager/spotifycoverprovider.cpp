@@ -260,6 +260,7 @@ void SpotifyCoverProvider::HandleSearchReply(QNetworkReply *reply, const int id,
 
 void SpotifyCoverProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "Spotify:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
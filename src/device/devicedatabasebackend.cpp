@@ -25,7 +25,6 @@
 
 #include <QObject>
 #include <QThread>
-#include <QMutex>
 #include <QIODevice>
 #include <QFile>
 #include <QByteArray>
@@ -60,7 +59,7 @@ void DeviceDatabaseBackend::Init(SharedPtr<Database> db) { db_ = db; }
 void DeviceDatabaseBackend::Close() {
 
   if (db_) {
-    QMutexLocker l(db_->Mutex());
+    Database::WriteLocker l(db_);
     db_->Close();
   }
 
@@ -85,7 +84,6 @@ DeviceDatabaseBackend::DeviceList DeviceDatabaseBackend::GetAllDevices() {
   DeviceList old_devices;
 
   {
-    QMutexLocker l(db_->Mutex());
     QSqlDatabase db(db_->Connect());
     SqlQuery q(db);
     q.prepare(QStringLiteral("SELECT ROWID, unique_id, friendly_name, size, icon, schema_version, transcode_mode, transcode_format FROM devices"));
@@ -125,7 +123,7 @@ DeviceDatabaseBackend::DeviceList DeviceDatabaseBackend::GetAllDevices() {
 
 int DeviceDatabaseBackend::AddDevice(const Device &device) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction t(&db);
@@ -164,7 +162,7 @@ int DeviceDatabaseBackend::AddDevice(const Device &device) {
 
 void DeviceDatabaseBackend::RemoveDevice(const int id) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction t(&db);
@@ -223,7 +221,7 @@ void DeviceDatabaseBackend::RemoveDevice(const int id) {
 
 void DeviceDatabaseBackend::SetDeviceOptions(const int id, const QString &friendly_name, const QString &icon_name, const MusicStorage::TranscodeMode mode, const Song::FileType format) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
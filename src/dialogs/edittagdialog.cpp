@@ -74,6 +74,7 @@
 #include "core/iconloader.h"
 #include "core/logging.h"
 #include "core/tagreaderclient.h"
+#include "core/batchtagwriter.h"
 #include "core/settings.h"
 #include "utilities/strutils.h"
 #include "utilities/timeutils.h"
@@ -119,7 +120,7 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
       tag_fetcher_(new TagFetcher(app->network(), this)),
       results_dialog_(new TrackSelectionDialog(this)),
 #endif
-      lyrics_fetcher_(new LyricsFetcher(app->lyrics_providers(), this)),
+      lyrics_fetcher_(new LyricsFetcher(app->lyrics_providers(), nullptr, this)),
       cover_menu_(new QMenu(this)),
       image_no_cover_thumbnail_(ImageUtils::GenerateNoCoverImage(QSize(128, 128), devicePixelRatioF())),
       loading_(false),
@@ -127,7 +128,7 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
       summary_cover_art_id_(-1),
       tags_cover_art_id_(-1),
       cover_art_is_set_(false),
-      save_tag_pending_(0),
+      tag_writer_(new BatchTagWriter(this)),
       lyrics_id_(-1) {
 
   QObject::connect(&*app_->album_cover_loader(), &AlbumCoverLoader::AlbumCoverLoaded, this, &EditTagDialog::AlbumCoverLoaded);
@@ -139,13 +140,18 @@ EditTagDialog::EditTagDialog(Application *app, QWidget *parent)
   QObject::connect(results_dialog_, &TrackSelectionDialog::finished, tag_fetcher_, &TagFetcher::Cancel);
 #endif
   QObject::connect(lyrics_fetcher_, &LyricsFetcher::LyricsFetched, this, &EditTagDialog::UpdateLyrics);
+  QObject::connect(tag_writer_, &BatchTagWriter::RequestFinished, this, &EditTagDialog::SongSaveTagsComplete);
+  QObject::connect(tag_writer_, &BatchTagWriter::Progress, this, &EditTagDialog::SaveProgress);
+  QObject::connect(tag_writer_, &BatchTagWriter::Finished, this, &EditTagDialog::SaveDataFinished);
 
   album_cover_choice_controller_->Init(app_);
 
   ui_->setupUi(this);
   ui_->splitter->setSizes(QList<int>() << 200 << width() - 200);
   ui_->loading_label->hide();
+  ui_->cancel_save->hide();
   ui_->label_lyrics->hide();
+  QObject::connect(ui_->cancel_save, &QPushButton::clicked, this, &EditTagDialog::CancelSave);
 
   ui_->fetch_tag->setIcon(QPixmap::fromImage(QImage(QStringLiteral(":/pictures/musicbrainz.png"))));
 #ifdef HAVE_MUSICBRAINZ
@@ -321,6 +327,18 @@ void EditTagDialog::accept() {
 
 }
 
+void EditTagDialog::reject() {
+
+  // Closing the dialog while saving cancels the writes that are not sent yet instead.
+  if (tag_writer_->is_running()) {
+    CancelSave();
+    return;
+  }
+
+  QDialog::reject();
+
+}
+
 bool EditTagDialog::eventFilter(QObject *o, QEvent *e) {
 
   if (o == ui_->tags_art) {
@@ -1180,6 +1198,8 @@ void EditTagDialog::ButtonClicked(QAbstractButton *button) {
 void EditTagDialog::SaveData() {
 
   QMap<QString, QUrl> cover_urls;
+  QList<BatchTagWriter::Request> requests;
+  pending_saves_.clear();
 
   for (int i = 0; i < data_.count(); ++i) {
     Data &ref = data_[i];
@@ -1275,7 +1295,6 @@ void EditTagDialog::SaveData() {
       if (ref.current_.year() <= 0) { ref.current_.set_year(-1); }
       if (ref.current_.originalyear() <= 0) { ref.current_.set_originalyear(-1); }
       if (ref.current_.lastplayed() <= 0) { ref.current_.set_lastplayed(-1); }
-      ++save_tag_pending_;
       TagReaderClient::SaveCoverOptions savecover_options;
       if (save_embedded_cover && ref.cover_action_ == UpdateCoverAction::New) {
         if (!ref.cover_result_.image.isNull()) {
@@ -1299,8 +1318,8 @@ void EditTagDialog::SaveData() {
       if (save_embedded_cover) {
         save_types |= TagReaderClient::SaveType::Cover;
       }
-      TagReaderReply *reply = TagReaderClient::Instance()->WriteFile(ref.current_.url().toLocalFile(), ref.current_, save_types, savecover_options);
-      QObject::connect(reply, &TagReaderReply::Finished, this, [this, reply, ref]() { SongSaveTagsComplete(reply, ref.current_.url().toLocalFile(), ref.current_, ref.cover_action_); }, Qt::QueuedConnection);
+      requests << BatchTagWriter::Request(ref.current_, save_types, savecover_options);
+      pending_saves_ << PendingSave(ref.current_, ref.cover_action_);
     }
     // If the cover was changed, but no tags written, make sure to update the collection.
     else if (ref.cover_action_ != UpdateCoverAction::None && !ref.current_.effective_albumartist().isEmpty() && !ref.current_.album().isEmpty()) {
@@ -1314,23 +1333,54 @@ void EditTagDialog::SaveData() {
 
   }
 
-  if (save_tag_pending_ <= 0) SaveDataFinished();
+  if (requests.isEmpty()) {
+    SaveDataFinished();
+    return;
+  }
+
+  ui_->cancel_save->setEnabled(true);
+  ui_->cancel_save->show();
+  tag_writer_->Start(requests);
 
 }
 
-void EditTagDialog::SaveDataFinished() {
+void EditTagDialog::SaveDataFinished(const bool cancelled) {
 
+  // The songs that were written are updated in the collection in a single transaction, also when saving was cancelled.
   if (!collection_songs_.isEmpty()) {
     app_->collection_backend()->AddOrUpdateSongsAsync(collection_songs_.values());
     collection_songs_.clear();
   }
 
+  pending_saves_.clear();
+  ui_->cancel_save->hide();
+
   if (!SetLoading(QString())) return;
 
+  if (cancelled) return;
+
   QDialog::accept();
 
 }
 
+void EditTagDialog::SaveProgress(const int finished, const int count, const double files_per_second) {
+
+  if (tag_writer_->is_cancelled()) return;
+
+  ui_->loading_label->set_text(tr("Saving tracks %1 of %2 (%3 files/s)").arg(finished).arg(count).arg(files_per_second, 0, 'f', 1));
+
+}
+
+void EditTagDialog::CancelSave() {
+
+  if (!tag_writer_->is_running() || tag_writer_->is_cancelled()) return;
+
+  ui_->cancel_save->setEnabled(false);
+  ui_->loading_label->set_text(tr("Cancelling") + QStringLiteral("..."));
+  tag_writer_->Cancel();
+
+}
+
 void EditTagDialog::ResetPlayStatistics() {
 
   const QModelIndexList idx_list = ui_->song_list->selectionModel()->selectedIndexes();
@@ -1451,15 +1501,13 @@ void EditTagDialog::UpdateLyrics(const quint64 id, const QString &provider, cons
 
 }
 
-void EditTagDialog::SongSaveTagsComplete(TagReaderReply *reply, const QString &filename, Song song, const UpdateCoverAction cover_action) {
+void EditTagDialog::SongSaveTagsComplete(const int index, const bool success, const QString &error) {
 
-  --save_tag_pending_;
-  const bool success = reply->message().write_file_response().success();
-  QString error;
-  if (!success && reply->message().write_file_response().has_error()) {
-    error = QString::fromStdString(reply->message().write_file_response().error());
-  }
-  reply->deleteLater();
+  if (index < 0 || index >= pending_saves_.count()) return;
+
+  Song song = pending_saves_.at(index).song;
+  const UpdateCoverAction cover_action = pending_saves_.at(index).cover_action;
+  const QString filename = song.url().toLocalFile();
 
   if (success) {
     if (song.is_collection_song()) {
@@ -1499,6 +1547,4 @@ void EditTagDialog::SongSaveTagsComplete(TagReaderReply *reply, const QString &f
     }
   }
 
-  if (save_tag_pending_ <= 0) SaveDataFinished();
-
 }
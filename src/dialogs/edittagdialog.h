@@ -53,6 +53,7 @@ class QHideEvent;
 
 class Application;
 class AlbumCoverChoiceController;
+class BatchTagWriter;
 class Ui_EditTagDialog;
 #ifdef HAVE_MUSICBRAINZ
 class TrackSelectionDialog;
@@ -72,6 +73,7 @@ class EditTagDialog : public QDialog {
   PlaylistItemPtrList playlist_items() const { return playlist_items_; }
 
   void accept() override;
+  void reject() override;
 
  Q_SIGNALS:
   void Error(const QString &message);
@@ -103,10 +105,17 @@ class EditTagDialog : public QDialog {
     UpdateCoverAction cover_action_;
     AlbumCoverImageResult cover_result_;
   };
+  struct PendingSave {
+    explicit PendingSave(const Song &_song = Song(), const UpdateCoverAction _cover_action = UpdateCoverAction::None) : song(_song), cover_action(_cover_action) {}
+    Song song;
+    UpdateCoverAction cover_action;
+  };
 
  private Q_SLOTS:
   void SetSongsFinished();
-  void SaveDataFinished();
+  void SaveDataFinished(const bool cancelled = false);
+  void SaveProgress(const int finished, const int count, const double files_per_second);
+  void CancelSave();
 
   void SelectionChanged();
   void FieldValueEdited();
@@ -133,7 +142,7 @@ class EditTagDialog : public QDialog {
   void PreviousSong();
   void NextSong();
 
-  void SongSaveTagsComplete(TagReaderReply *reply, const QString &filename, Song song, const UpdateCoverAction cover_action);
+  void SongSaveTagsComplete(const int index, const bool success, const QString &error);
 
  private:
   struct FieldData {
@@ -204,7 +213,8 @@ class EditTagDialog : public QDialog {
   QPushButton *previous_button_;
   QPushButton *next_button_;
 
-  int save_tag_pending_;
+  BatchTagWriter *tag_writer_;
+  QList<PendingSave> pending_saves_;
 
   QMap<int, Song> collection_songs_;
 
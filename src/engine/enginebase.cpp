@@ -64,6 +64,8 @@ EngineBase::EngineBase(QObject *parent)
       buffer_duration_nanosec_(BackendSettingsPage::kDefaultBufferDuration * kNsecPerMsec),
       buffer_low_watermark_(BackendSettingsPage::kDefaultBufferLowWatermark),
       buffer_high_watermark_(BackendSettingsPage::kDefaultBufferHighWatermark),
+      network_cache_enabled_(false),
+      network_cache_size_(static_cast<qint64>(BackendSettingsPage::kDefaultNetworkCacheSize) * 1024 * 1024),
       fadeout_enabled_(true),
       crossfade_enabled_(true),
       autocrossfade_enabled_(false),
@@ -184,6 +186,8 @@ void EngineBase::ReloadSettings() {
   buffer_duration_nanosec_ = s.value("bufferduration", BackendSettingsPage::kDefaultBufferDuration).toLongLong() * kNsecPerMsec;
   buffer_low_watermark_ = s.value("bufferlowwatermark", BackendSettingsPage::kDefaultBufferLowWatermark).toDouble();
   buffer_high_watermark_ = s.value("bufferhighwatermark", BackendSettingsPage::kDefaultBufferHighWatermark).toDouble();
+  network_cache_enabled_ = s.value("network_cache", false).toBool();
+  network_cache_size_ = s.value("network_cache_size", BackendSettingsPage::kDefaultNetworkCacheSize).toLongLong() * 1024 * 1024;
 
   rg_enabled_ = s.value("rgenabled", false).toBool();
   rg_mode_ = s.value("rgmode", 0).toInt();
@@ -104,6 +104,8 @@ class EngineBase : public QObject {
   virtual bool Init() = 0;
   virtual State state() const = 0;
   virtual void StartPreloading(const QUrl&, const QUrl&, const bool, const qint64, const qint64) {}
+  // Prepares a track that is likely to be played next (manually or automatically), so it starts without the usual setup delay.
+  virtual void WarmUp(const QUrl&, const QUrl&, const bool, const qint64, const qint64) {}
   virtual bool Load(const QUrl &media_url, const QUrl &stream_url, const TrackChangeFlags change, const bool force_stop_at_end, const quint64 beginning_nanosec, const qint64 end_nanosec, const std::optional<double> ebur128_integrated_loudness_lufs);
   virtual bool Play(const bool pause, const quint64 offset_nanosec) = 0;
   virtual void Stop(const bool stop_after = false) = 0;
@@ -184,6 +186,9 @@ class EngineBase : public QObject {
   // Always use the state from event, because it's not guaranteed that immediate subsequent call to state() won't return a stale value.
   void StateChanged(const EngineBase::State state);
 
+  // Emitted when the first buffer of a newly loaded track reached the audio sink.
+  void FirstBufferReached();
+
   void VolumeChanged(const uint volume);
 
   void Finished();
@@ -220,6 +225,8 @@ class EngineBase : public QObject {
   quint64 buffer_duration_nanosec_;
   double buffer_low_watermark_;
   double buffer_high_watermark_;
+  bool network_cache_enabled_;
+  qint64 network_cache_size_;
 
   // Fadeout
   bool fadeout_enabled_;
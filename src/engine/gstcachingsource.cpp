@@ -0,0 +1,291 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+#include <QtGlobal>
+#include <QtConcurrentRun>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QStorageInfo>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+#include "core/logging.h"
+#include "gstcachingsource.h"
+
+const char *GstCachingSource::kUri = "appsrc://";
+
+namespace {
+constexpr qint64 kChunkSize = 512 * 1024;
+constexpr const char *kNetworkFileSystems[] = { "cifs", "smb3", "smbfs", "nfs", "nfs4", "fuse.sshfs", "fuse.rclone", "9p", "afpfs", "davfs", "webdav" };
+}  // namespace
+
+GstCachingSource::GstCachingSource(const QString &filename, const qint64 max_cache_size)
+    : filename_(filename),
+      max_chunks_(std::max(2LL, max_cache_size / kChunkSize)),
+      size_(0),
+      position_(0),
+      error_(false),
+      stop_(false) {
+
+  thread_pool_.setMaxThreadCount(1);
+
+}
+
+GstCachingSource::~GstCachingSource() {
+
+  {
+    QMutexLocker l(&mutex_);
+    stop_ = true;
+    position_changed_.wakeAll();
+    chunk_read_.wakeAll();
+  }
+
+  thread_pool_.waitForDone();
+
+  const Statistics stats = statistics();
+  qLog(Debug) << "Network cache for" << filename_ << "held" << stats.cached << "of" << stats.size << "bytes," << stats.seeks << "seeks," << stats.stalls << "stalls totalling" << stats.stall_time_msec << "ms";
+
+}
+
+bool GstCachingSource::IsNetworkFile(const QUrl &url) {
+
+  if (!url.isLocalFile()) return false;
+
+  // UNC path, see GstEngine::FixupUrl()
+  if (!url.host().isEmpty()) return true;
+
+  const QByteArray type = QStorageInfo(QFileInfo(url.toLocalFile()).absolutePath()).fileSystemType();
+  return std::any_of(std::begin(kNetworkFileSystems), std::end(kNetworkFileSystems), [&type](const char *network_type) { return type == network_type; });
+
+}
+
+void GstCachingSource::Attach(SharedPtr<GstCachingSource> source, GstElement *appsrc) {
+
+  const qint64 size = QFileInfo(source->filename_).size();
+  {
+    QMutexLocker l(&source->mutex_);
+    source->size_ = size;
+  }
+
+  g_object_set(G_OBJECT(appsrc), "format", GST_FORMAT_BYTES, nullptr);
+  gst_app_src_set_stream_type(GST_APP_SRC(appsrc), GST_APP_STREAM_TYPE_RANDOM_ACCESS);
+  gst_app_src_set_size(GST_APP_SRC(appsrc), size);
+
+  GstAppSrcCallbacks callbacks;
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.need_data = &NeedDataCallback;
+  callbacks.seek_data = &SeekDataCallback;
+  gst_app_src_set_callbacks(GST_APP_SRC(appsrc), &callbacks, new SharedPtr<GstCachingSource>(source), &DestroyNotify);
+
+  (void)QtConcurrent::run(&source->thread_pool_, &GstCachingSource::ReadLoop, &*source);
+
+}
+
+GstCachingSource::Statistics GstCachingSource::statistics() const {
+
+  QMutexLocker l(&mutex_);
+
+  Statistics stats = statistics_;
+  stats.size = size_;
+  for (const QByteArray &chunk : chunks_) {
+    stats.cached += chunk.size();
+  }
+
+  return stats;
+
+}
+
+void GstCachingSource::NeedDataCallback(GstAppSrc *appsrc, guint length, gpointer self) {
+
+  GstCachingSource *instance = reinterpret_cast<SharedPtr<GstCachingSource>*>(self)->get();
+  instance->PushData(appsrc, length);
+
+}
+
+gboolean GstCachingSource::SeekDataCallback(GstAppSrc *appsrc, guint64 offset, gpointer self) {
+
+  Q_UNUSED(appsrc)
+
+  GstCachingSource *instance = reinterpret_cast<SharedPtr<GstCachingSource>*>(self)->get();
+
+  QMutexLocker l(&instance->mutex_);
+  instance->position_ = static_cast<qint64>(offset);
+  ++instance->statistics_.seeks;
+  instance->position_changed_.wakeAll();
+
+  return TRUE;
+
+}
+
+void GstCachingSource::DestroyNotify(gpointer data) {
+
+  delete reinterpret_cast<SharedPtr<GstCachingSource>*>(data);
+
+}
+
+void GstCachingSource::ReadLoop() {
+
+  QFile file(filename_);
+  const bool open = file.open(QIODevice::ReadOnly);
+
+  QMutexLocker l(&mutex_);
+
+  if (!open) {
+    qLog(Error) << "Could not open" << filename_ << file.errorString();
+    error_ = true;
+    chunk_read_.wakeAll();
+    return;
+  }
+
+  while (!stop_) {
+
+    const qint64 chunk = NextChunkToRead();
+    if (chunk == -1) {
+      position_changed_.wait(&mutex_);
+      continue;
+    }
+
+    l.unlock();
+    QByteArray data;
+    if (file.seek(chunk * kChunkSize)) {
+      data = file.read(kChunkSize);
+    }
+    l.relock();
+
+    if (data.isEmpty()) {
+      qLog(Error) << "Could not read" << filename_ << file.errorString();
+      error_ = true;
+      chunk_read_.wakeAll();
+      break;
+    }
+
+    if (chunks_.count() >= max_chunks_) {
+      EvictChunk();
+    }
+    chunks_.insert(chunk, data);
+    chunk_read_.wakeAll();
+
+  }
+
+}
+
+qint64 GstCachingSource::NextChunkToRead() const {
+
+  if (size_ <= 0) return -1;
+
+  const qint64 last_chunk = (size_ - 1) / kChunkSize;
+  const qint64 position_chunk = std::min(position_ / kChunkSize, last_chunk);
+
+  // Read ahead of the decoder first.
+  for (qint64 chunk = position_chunk; chunk <= std::min(last_chunk, position_chunk + max_chunks_ - 1); ++chunk) {
+    if (!chunks_.contains(chunk)) return chunk;
+  }
+
+  // Files that fit are read completely, so seeking back is served from memory too.
+  if (last_chunk < max_chunks_) {
+    for (qint64 chunk = 0; chunk < position_chunk; ++chunk) {
+      if (!chunks_.contains(chunk)) return chunk;
+    }
+  }
+
+  return -1;
+
+}
+
+void GstCachingSource::EvictChunk() {
+
+  // Drop what the decoder has passed first, then what is furthest ahead.
+  if (chunks_.firstKey() < position_ / kChunkSize) {
+    chunks_.erase(chunks_.begin());
+  }
+  else {
+    chunks_.erase(std::prev(chunks_.end()));
+  }
+
+}
+
+void GstCachingSource::PushData(GstAppSrc *appsrc, const guint length) {
+
+  QMutexLocker l(&mutex_);
+
+  if (position_ >= size_) {
+    l.unlock();
+    gst_app_src_end_of_stream(appsrc);
+    return;
+  }
+
+  const qint64 position = position_;
+  const qint64 chunk = position / kChunkSize;
+  if (!chunks_.contains(chunk) && !error_ && !stop_) {
+    // Waiting for the very first chunk is the normal open latency, not a stall.
+    const bool stall = !chunks_.isEmpty();
+    QElapsedTimer timer;
+    timer.start();
+    position_changed_.wakeAll();
+    while (!chunks_.contains(chunk) && !error_ && !stop_) {
+      chunk_read_.wait(&mutex_);
+    }
+    if (stall) {
+      ++statistics_.stalls;
+      statistics_.stall_time_msec += timer.elapsed();
+      qLog(Debug) << "Network cache for" << filename_ << "stalled for" << timer.elapsed() << "ms at" << position << "of" << size_ << "bytes," << chunks_.count() << "of" << max_chunks_ << "chunks cached";
+    }
+  }
+
+  // Seeked while waiting, appsrc asks again for the new position.
+  if (position_ != position) return;
+
+  if (!chunks_.contains(chunk)) {
+    const bool error = error_;
+    l.unlock();
+    if (error) {
+      GST_ELEMENT_ERROR(appsrc, RESOURCE, READ, ("Could not read \"%s\".", filename_.toUtf8().constData()), (nullptr));
+    }
+    return;
+  }
+
+  const QByteArray data = chunks_.value(chunk);
+  const qint64 offset = position - (chunk * kChunkSize);
+  qint64 bytes = data.size() - offset;
+  if (length > 0 && length != static_cast<guint>(-1)) {
+    bytes = std::min(bytes, static_cast<qint64>(length));
+  }
+  position_ = position + bytes;
+  position_changed_.wakeAll();
+  l.unlock();
+
+  GstBuffer *buffer = gst_buffer_new_allocate(nullptr, static_cast<gsize>(bytes), nullptr);
+  gst_buffer_fill(buffer, 0, data.constData() + offset, static_cast<gsize>(bytes));
+  GST_BUFFER_OFFSET(buffer) = static_cast<guint64>(position);
+  gst_app_src_push_buffer(appsrc, buffer);
+
+}
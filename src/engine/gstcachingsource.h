@@ -0,0 +1,94 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GSTCACHINGSOURCE_H
+#define GSTCACHINGSOURCE_H
+
+#include "config.h"
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QMap>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+#include "core/shared_ptr.h"
+
+// Feeds the appsrc that playbin creates for an appsrc:// URI from a file on a network share.
+// An I/O thread reads the file ahead of the decoder in large chunks into a bounded in-memory cache,
+// files that fit are read completely, so latency spikes on the share don't reach the decoder and seeks are served from memory.
+
+class GstCachingSource {
+
+ public:
+  explicit GstCachingSource(const QString &filename, const qint64 max_cache_size);
+  ~GstCachingSource();
+
+  static const char *kUri;
+
+  // True for local paths that are on a network filesystem (SMB, NFS, SSHFS...) or a Windows UNC path.
+  static bool IsNetworkFile(const QUrl &url);
+
+  // Configures the appsrc and starts reading, the appsrc keeps a reference to the source.
+  static void Attach(SharedPtr<GstCachingSource> source, GstElement *appsrc);
+
+  struct Statistics {
+    Statistics() : size(0), cached(0), stalls(0), stall_time_msec(0), seeks(0) {}
+    qint64 size;
+    qint64 cached;
+    int stalls;
+    qint64 stall_time_msec;
+    int seeks;
+  };
+  Statistics statistics() const;
+
+ private:
+  static void NeedDataCallback(GstAppSrc *appsrc, guint length, gpointer self);
+  static gboolean SeekDataCallback(GstAppSrc *appsrc, guint64 offset, gpointer self);
+  static void DestroyNotify(gpointer data);
+
+  void ReadLoop();
+  qint64 NextChunkToRead() const;
+  void EvictChunk();
+  void PushData(GstAppSrc *appsrc, const guint length);
+
+ private:
+  const QString filename_;
+  const qint64 max_chunks_;
+  QThreadPool thread_pool_;
+
+  mutable QMutex mutex_;
+  QWaitCondition chunk_read_;
+  QWaitCondition position_changed_;
+  QMap<qint64, QByteArray> chunks_;
+  qint64 size_;
+  qint64 position_;
+  bool error_;
+  bool stop_;
+  Statistics statistics_;
+};
+
+#endif  // GSTCACHINGSOURCE_H
@@ -83,6 +83,7 @@ constexpr int kDiscoveryTimeoutS = 10;
 constexpr qint64 kTimerIntervalNanosec = 1000 * kNsecPerMsec;  // 1s
 constexpr qint64 kPreloadGapNanosec = 8000 * kNsecPerMsec;     // 8s
 constexpr qint64 kSeekDelayNanosec = 100 * kNsecPerMsec;       // 100msec
+constexpr int kWarmPipelinesMax = 2;
 }  // namespace
 
 GstEngine::GstEngine(SharedPtr<TaskManager> task_manager, QObject *parent)
@@ -108,7 +109,8 @@ GstEngine::GstEngine(SharedPtr<TaskManager> task_manager, QObject *parent)
       discovery_discovered_cb_id_(-1),
       delayed_state_(State::Empty),
       delayed_state_pause_(false),
-      delayed_state_offset_nanosec_(0) {
+      delayed_state_offset_nanosec_(0),
+      first_buffer_pending_(false) {
 
   seek_timer_->setSingleShot(true);
   seek_timer_->setInterval(kSeekDelayNanosec / kNsecPerMsec);
@@ -121,6 +123,7 @@ GstEngine::GstEngine(SharedPtr<TaskManager> task_manager, QObject *parent)
 GstEngine::~GstEngine() {
 
   EnsureInitialized();
+  warm_pipelines_.clear();
   current_pipeline_.reset();
 
   if (latest_buffer_) {
@@ -189,6 +192,57 @@ void GstEngine::StartPreloading(const QUrl &media_url, const QUrl &stream_url, c
 
 }
 
+void GstEngine::WarmUp(const QUrl &media_url, const QUrl &stream_url, const bool force_stop_at_end, const qint64 beginning_nanosec, const qint64 end_nanosec) {
+
+  Q_UNUSED(beginning_nanosec)
+
+  EnsureInitialized();
+
+  if (!WarmUpSupported(stream_url)) return;
+
+  const qint64 end_offset_nanosec = force_stop_at_end ? end_nanosec : 0;
+
+  // A track that started gaplessly in the current pipeline leaves its warm pipeline unused.
+  for (qsizetype i = warm_pipelines_.count() - 1; i >= 0; --i) {
+    if (current_pipeline_ && warm_pipelines_[i]->stream_url() == current_pipeline_->stream_url()) {
+      FinishPipeline(warm_pipelines_.takeAt(i));
+    }
+  }
+
+  if (current_pipeline_ && current_pipeline_->stream_url() == stream_url) return;
+  if (std::any_of(warm_pipelines_.begin(), warm_pipelines_.end(), [stream_url, end_offset_nanosec](GstEnginePipelinePtr pipeline) { return pipeline->stream_url() == stream_url && pipeline->end_offset_nanosec() == end_offset_nanosec; })) {
+    return;
+  }
+
+  GstEnginePipelinePtr pipeline = CreatePipeline();
+  QString error;
+  if (!pipeline->InitFromUrl(media_url, stream_url, FixupUrl(stream_url), end_offset_nanosec, ebur128_loudness_normalizing_gain_db_, error)) {
+    qLog(Debug) << "Could not warm up pipeline for" << stream_url << error;
+    return;
+  }
+
+  // Errors are reported when the track is actually played, so just drop the pipeline.
+  const int pipeline_id = pipeline->id();
+  QObject::connect(&*pipeline, &GstEnginePipeline::Error, this, [this, pipeline_id]() {
+    for (qsizetype i = 0; i < warm_pipelines_.count(); ++i) {
+      if (warm_pipelines_[i]->id() == pipeline_id) {
+        FinishPipeline(warm_pipelines_.takeAt(i));
+        break;
+      }
+    }
+  });
+
+  qLog(Debug) << "Warming up pipeline" << pipeline_id << "for" << stream_url;
+
+  warm_pipelines_ << pipeline;
+  while (warm_pipelines_.count() > kWarmPipelinesMax) {
+    FinishPipeline(warm_pipelines_.takeFirst());
+  }
+
+  pipeline->SetStateAsync(GST_STATE_PAUSED);
+
+}
+
 bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const EngineBase::TrackChangeFlags change, const bool force_stop_at_end, const quint64 beginning_nanosec, const qint64 end_nanosec, const std::optional<double> ebur128_integrated_loudness_lufs) {
 
   EnsureInitialized();
@@ -209,11 +263,20 @@ bool GstEngine::Load(const QUrl &media_url, const QUrl &stream_url, const Engine
     return true;
   }
 
-  GstEnginePipelinePtr pipeline = CreatePipeline(media_url, stream_url, gst_url, force_stop_at_end ? end_nanosec : 0, ebur128_loudness_normalizing_gain_db_);
-  if (!pipeline) return false;
+  GstEnginePipelinePtr pipeline = TakeWarmPipeline(stream_url, force_stop_at_end ? end_nanosec : 0);
+  if (pipeline) {
+    qLog(Debug) << "Using warm pipeline" << pipeline->id() << "for" << stream_url;
+    pipeline->SetEBUR128LoudnessNormalizingGain_dB(ebur128_loudness_normalizing_gain_db_);
+    AttachPipeline(pipeline);
+  }
+  else {
+    pipeline = CreatePipeline(media_url, stream_url, gst_url, force_stop_at_end ? end_nanosec : 0, ebur128_loudness_normalizing_gain_db_);
+    if (!pipeline) return false;
+  }
 
   GstEnginePipelinePtr old_pipeline = current_pipeline_;
   current_pipeline_ = pipeline;
+  first_buffer_pending_ = true;
 
   if (old_pipeline) {
     if (crossfade && !old_pipeline->exclusive_mode() && !AnyExclusivePipelineActive() && !fadeout_pipelines_.contains(old_pipeline->id())) {
@@ -322,6 +385,8 @@ void GstEngine::Stop(const bool stop_after) {
     }
   }
 
+  ClearWarmPipelines();
+
   BufferingFinished();
 
   Q_EMIT StateChanged(State::Empty);
@@ -511,6 +576,9 @@ void GstEngine::ReloadSettings() {
 
   if (output_.isEmpty()) output_ = QLatin1String(kAutoSink);
 
+  // The warm pipelines were set up with the old settings.
+  ClearWarmPipelines();
+
 }
 
 void GstEngine::ConsumeBuffer(GstBuffer *buffer, const int pipeline_id, const QString &format) {
@@ -667,6 +735,11 @@ void GstEngine::AddBufferToScope(GstBuffer *buf, const int pipeline_id, const QS
   latest_buffer_ = buf;
   have_new_buffer_ = true;
 
+  if (first_buffer_pending_) {
+    first_buffer_pending_ = false;
+    Q_EMIT FirstBufferReached();
+  }
+
 }
 
 void GstEngine::FadeoutFinished(const int pipeline_id) {
@@ -899,6 +972,7 @@ GstEnginePipelinePtr GstEngine::CreatePipeline() {
   pipeline->set_buffer_duration_nanosec(buffer_duration_nanosec_);
   pipeline->set_buffer_low_watermark(buffer_low_watermark_);
   pipeline->set_buffer_high_watermark(buffer_high_watermark_);
+  pipeline->set_network_cache(network_cache_enabled_, network_cache_size_);
   pipeline->set_proxy_settings(proxy_address_, proxy_authentication_, proxy_user_, proxy_pass_);
   pipeline->set_channels(channels_enabled_, channels_);
   pipeline->set_bs2b_enabled(bs2b_enabled_);
@@ -909,6 +983,14 @@ GstEnginePipelinePtr GstEngine::CreatePipeline() {
   pipeline->set_spotify_login(spotify_username_, spotify_password_);
 #endif
 
+  return pipeline;
+
+}
+
+void GstEngine::AttachPipeline(GstEnginePipelinePtr pipeline) {
+
+  QObject::disconnect(&*pipeline, nullptr, this, nullptr);
+
   pipeline->AddBufferConsumer(this);
   for (GstBufferConsumer *consumer : std::as_const(buffer_consumers_)) {
     pipeline->AddBufferConsumer(consumer);
@@ -923,8 +1005,6 @@ GstEnginePipelinePtr GstEngine::CreatePipeline() {
   QObject::connect(&*pipeline, &GstEnginePipeline::VolumeChanged, this, &EngineBase::UpdateVolume);
   QObject::connect(&*pipeline, &GstEnginePipeline::AboutToFinish, this, &EngineBase::EmitAboutToFinish);
 
-  return pipeline;
-
 }
 
 GstEnginePipelinePtr GstEngine::CreatePipeline(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, const double ebur128_loudness_normalizing_gain_db) {
@@ -937,11 +1017,52 @@ GstEnginePipelinePtr GstEngine::CreatePipeline(const QUrl &media_url, const QUrl
     Q_EMIT StateChanged(State::Error);
     Q_EMIT FatalError();
   }
+  else {
+    AttachPipeline(ret);
+  }
 
   return ret;
 
 }
 
+bool GstEngine::WarmUpSupported(const QUrl &stream_url) const {
+
+  // A prerolled pipeline keeps its audio sink open next to the playing one, which exclusive and direct hardware outputs don't allow.
+  if (exclusive_mode_ || (output_ == QLatin1String(kALSASink) && device_.toString().contains("hw:"_L1))) {
+    return false;
+  }
+
+  // Streams would miss their metadata and buffering messages, and servers tend to drop idle connections.
+  const QString scheme = stream_url.scheme();
+  return stream_url.isLocalFile() || scheme == "smb"_L1 || scheme == "sftp"_L1 || scheme == "nfs"_L1;
+
+}
+
+GstEnginePipelinePtr GstEngine::TakeWarmPipeline(const QUrl &stream_url, const qint64 end_nanosec) {
+
+  for (qsizetype i = 0; i < warm_pipelines_.count(); ++i) {
+    if (warm_pipelines_[i]->stream_url() != stream_url || warm_pipelines_[i]->end_offset_nanosec() != end_nanosec) continue;
+    GstEnginePipelinePtr pipeline = warm_pipelines_.takeAt(i);
+    // A pipeline that is still prerolling could miss the pending state, so start over with a new one.
+    if (pipeline->is_active() && !pipeline->is_buffering()) {
+      return pipeline;
+    }
+    FinishPipeline(pipeline);
+    break;
+  }
+
+  return GstEnginePipelinePtr();
+
+}
+
+void GstEngine::ClearWarmPipelines() {
+
+  while (!warm_pipelines_.isEmpty()) {
+    FinishPipeline(warm_pipelines_.takeFirst());
+  }
+
+}
+
 void GstEngine::FinishPipeline(GstEnginePipelinePtr pipeline) {
 
   const int pipeline_id = pipeline->id();
@@ -63,6 +63,7 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   bool Init() override;
   State state() const override;
   void StartPreloading(const QUrl &media_url, const QUrl &stream_url, const bool force_stop_at_end, const qint64 beginning_nanosec, const qint64 end_nanosec) override;
+  void WarmUp(const QUrl &media_url, const QUrl &stream_url, const bool force_stop_at_end, const qint64 beginning_nanosec, const qint64 end_nanosec) override;
   bool Load(const QUrl &media_url, const QUrl &stream_url, const EngineBase::TrackChangeFlags change, const bool force_stop_at_end, const quint64 beginning_nanosec, const qint64 end_nanosec, const std::optional<double> ebur128_integrated_loudness_lufs) override;
   bool Play(const bool pause, const quint64 offset_nanosec) override;
   void Stop(const bool stop_after = false) override;
@@ -139,6 +140,11 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
 
   GstEnginePipelinePtr CreatePipeline();
   GstEnginePipelinePtr CreatePipeline(const QUrl &media_url, const QUrl &stream_url, const QByteArray &gst_url, const qint64 end_nanosec, const double ebur128_loudness_normalizing_gain_db);
+  void AttachPipeline(GstEnginePipelinePtr pipeline);
+
+  bool WarmUpSupported(const QUrl &stream_url) const;
+  GstEnginePipelinePtr TakeWarmPipeline(const QUrl &stream_url, const qint64 end_nanosec);
+  void ClearWarmPipelines();
 
   void FinishPipeline(GstEnginePipelinePtr pipeline);
 
@@ -163,6 +169,11 @@ class GstEngine : public EngineBase, public GstBufferConsumer {
   GstEnginePipelinePtr fadeout_pause_pipeline_;
   QMap<int, GstEnginePipelinePtr> old_pipelines_;
 
+  // Prerolled pipelines for tracks that are likely to be played next, oldest first.
+  // They hold the first seconds of decoded audio in their queue, so playback can start as soon as one is attached.
+  QList<GstEnginePipelinePtr> warm_pipelines_;
+  bool first_buffer_pending_;
+
   QList<GstBufferConsumer*> buffer_consumers_;
 
   GstBuffer *latest_buffer_;
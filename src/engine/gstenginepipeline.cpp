@@ -26,11 +26,13 @@
 #include <cstdint>
 #include <cstring>
 #include <cmath>
+#include <memory>
 
 #include <glib.h>
 #include <glib-object.h>
 #include <gst/gst.h>
 #include <gst/audio/audio.h>
+#include <gst/app/gstappsrc.h>
 
 #ifdef Q_OS_UNIX
 #  include <pthread.h>
@@ -66,8 +68,10 @@
 #include "gstengine.h"
 #include "gstenginepipeline.h"
 #include "gstbufferconsumer.h"
+#include "gstcachingsource.h"
 
 using namespace Qt::StringLiterals;
+using std::make_shared;
 
 namespace {
 
@@ -97,6 +101,8 @@ GstEnginePipeline::GstEnginePipeline(QObject *parent)
       buffer_duration_nanosec_(BackendSettingsPage::kDefaultBufferDuration * kNsecPerMsec),
       buffer_low_watermark_(BackendSettingsPage::kDefaultBufferLowWatermark),
       buffer_high_watermark_(BackendSettingsPage::kDefaultBufferHighWatermark),
+      network_cache_enabled_(false),
+      network_cache_size_(0),
       proxy_authentication_(false),
       channels_enabled_(false),
       channels_(0),
@@ -255,6 +261,11 @@ void GstEnginePipeline::set_channels(const bool enabled, const int channels) {
   channels_ = channels;
 }
 
+void GstEnginePipeline::set_network_cache(const bool enabled, const qint64 size) {
+  network_cache_enabled_ = enabled;
+  network_cache_size_ = size;
+}
+
 void GstEnginePipeline::set_bs2b_enabled(const bool enabled) {
   bs2b_enabled_ = enabled;
 }
@@ -462,7 +473,7 @@ bool GstEnginePipeline::InitFromUrl(const QUrl &media_url, const QUrl &stream_ur
 
   {
     QMutexLocker l(&mutex_url_);
-    g_object_set(G_OBJECT(pipeline_), "uri", gst_url.constData(), nullptr);
+    g_object_set(G_OBJECT(pipeline_), "uri", PlaybinUri(stream_url, gst_url).constData(), nullptr);
   }
 
   pipeline_connected_ = true;
@@ -1013,6 +1024,19 @@ void GstEnginePipeline::SourceSetupCallback(GstElement *playbin, GstElement *sou
     }
   }
 
+  if (GST_IS_APP_SRC(source)) {
+    SharedPtr<GstCachingSource> caching_source;
+    {
+      QMutexLocker l(&instance->mutex_caching_source_);
+      caching_source = instance->pending_caching_source_;
+      instance->pending_caching_source_.reset();
+    }
+    if (caching_source) {
+      qLog(Debug) << "Setting up network cache";
+      GstCachingSource::Attach(caching_source, source);
+    }
+  }
+
   if (g_object_class_find_property(G_OBJECT_GET_CLASS(source), "user-agent")) {
     qLog(Debug) << "Setting user-agent";
     QString user_agent = QStringLiteral("%1 %2").arg(QCoreApplication::applicationName(), QCoreApplication::applicationVersion());
@@ -1669,7 +1693,7 @@ void GstEnginePipeline::StateChangedMessageReceived(GstMessage *msg) {
       next_uri_set_ = false;
       {
         QMutexLocker l(&mutex_url_);
-        g_object_set(G_OBJECT(pipeline_), "uri", gst_url_.constData(), nullptr);
+        g_object_set(G_OBJECT(pipeline_), "uri", PlaybinUri(stream_url_, gst_url_).constData(), nullptr);
       }
       if (pending_seek_nanosec_ == -1) {
         qLog(Debug) << "Reverting next uri and going to playing state.";
@@ -1819,6 +1843,14 @@ void GstEnginePipeline::SetStateAsyncFinished(const GstState state, const GstSta
 
 QFuture<GstStateChangeReturn> GstEnginePipeline::Play(const bool pause, const quint64 offset_nanosec) {
 
+  // A pipeline that was prerolled in advance is already paused, there will be no state change message to pick up a pending seek or state.
+  if (pipeline_active_.value() && !buffering_.value()) {
+    if (offset_nanosec != 0) {
+      Seek(static_cast<qint64>(offset_nanosec));
+    }
+    return SetStateAsync(pause ? GST_STATE_PAUSED : GST_STATE_PLAYING);
+  }
+
   if (offset_nanosec != 0) {
     pending_seek_nanosec_ = static_cast<qint64>(offset_nanosec);
   }
@@ -2095,13 +2127,26 @@ void GstEnginePipeline::SetNextUrl() {
     {
       QMutexLocker l(&mutex_next_url_);
       qLog(Debug) << "Setting next URL to" << next_gst_url_;
-      g_object_set(G_OBJECT(pipeline_), "uri", next_gst_url_.constData(), nullptr);
+      g_object_set(G_OBJECT(pipeline_), "uri", PlaybinUri(next_stream_url_, next_gst_url_).constData(), nullptr);
     }
     about_to_finish_ = false;
   }
 
 }
 
+QByteArray GstEnginePipeline::PlaybinUri(const QUrl &stream_url, const QByteArray &gst_url) {
+
+  if (!network_cache_enabled_ || !GstCachingSource::IsNetworkFile(stream_url)) {
+    return gst_url;
+  }
+
+  QMutexLocker l(&mutex_caching_source_);
+  pending_caching_source_ = make_shared<GstCachingSource>(stream_url.toLocalFile(), network_cache_size_);
+
+  return QByteArray(GstCachingSource::kUri);
+
+}
+
 void GstEnginePipeline::SetSourceDevice(const QString &device) {
 
   QMutexLocker l(&mutex_source_device_);
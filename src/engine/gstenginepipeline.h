@@ -50,6 +50,7 @@
 class QTimer;
 class QTimerEvent;
 class GstBufferConsumer;
+class GstCachingSource;
 struct GstPlayBin;
 
 class GstEnginePipeline : public QObject {
@@ -73,6 +74,7 @@ class GstEnginePipeline : public QObject {
   void set_buffer_duration_nanosec(const quint64 duration_nanosec);
   void set_buffer_low_watermark(const double value);
   void set_buffer_high_watermark(const double value);
+  void set_network_cache(const bool enabled, const qint64 size);
   void set_proxy_settings(const QString &address, const bool authentication, const QString &user, const QString &pass);
   void set_channels(const bool enabled, const int channels);
   void set_bs2b_enabled(const bool enabled);
@@ -135,6 +137,10 @@ class GstEnginePipeline : public QObject {
   // Don't allow the user to change the playback state (playing/paused) while the pipeline is buffering.
   bool is_buffering() const { return buffering_.value(); }
 
+  // True once the pipeline reached the paused or playing state.
+  bool is_active() const { return pipeline_active_.value(); }
+  qint64 end_offset_nanosec() const { return end_offset_nanosec_.value(); }
+
   bool exclusive_mode() const { return exclusive_mode_; }
 
   QByteArray redirect_url() const { return redirect_url_; }
@@ -196,6 +202,9 @@ class GstEnginePipeline : public QObject {
   void Disconnect();
   void ResumeFaderAsync();
 
+  // Returns the URI to give playbin, which is appsrc:// when the file is read through a caching source.
+  QByteArray PlaybinUri(const QUrl &stream_url, const QByteArray &gst_url);
+
  private Q_SLOTS:
   void SetStateAsyncFinished(const GstState state, const GstStateChangeReturn state_change_return);
   void SetFaderVolume(const qreal volume);
@@ -222,6 +231,12 @@ class GstEnginePipeline : public QObject {
   double buffer_low_watermark_;
   double buffer_high_watermark_;
 
+  // Files on network shares are read ahead into memory, the source is handed to the appsrc in SourceSetupCallback.
+  bool network_cache_enabled_;
+  qint64 network_cache_size_;
+  SharedPtr<GstCachingSource> pending_caching_source_;
+  QMutex mutex_caching_source_;
+
   // Proxy
   QString proxy_address_;
   bool proxy_authentication_;
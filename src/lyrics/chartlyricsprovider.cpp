@@ -142,6 +142,7 @@ void ChartLyricsProvider::HandleSearchReply(QNetworkReply *reply, const int id,
 
 void ChartLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "ChartLyrics:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
@@ -535,6 +535,7 @@ void GeniusLyricsProvider::AuthError(const QString &error, const QVariant &debug
 
 void GeniusLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "GeniusLyrics:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
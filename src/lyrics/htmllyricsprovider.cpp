@@ -203,6 +203,7 @@ QString HtmlLyricsProvider::ParseLyricsFromHTML(const QString &content, const QR
 
 void HtmlLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << name_ << error;
   if (debug.isValid()) qLog(Debug) << name_ << debug;
 
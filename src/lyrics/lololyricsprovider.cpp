@@ -148,6 +148,7 @@ void LoloLyricsProvider::HandleSearchReply(QNetworkReply *reply, const int id, c
 
 void LoloLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "LoloLyrics:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
@@ -201,6 +201,7 @@ void LyricFindLyricsProvider::HandleSearchReply(QNetworkReply *reply, const int
 
 void LyricFindLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "LyricFind:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
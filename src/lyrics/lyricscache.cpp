@@ -0,0 +1,131 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QString>
+#include <QDateTime>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+#include <QSqlDatabase>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "lyricscache.h"
+#include "lyricssearchrequest.h"
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr qint64 kFoundExpirySecs = 180LL * 24LL * 60LL * 60LL;
+constexpr qint64 kNotFoundExpirySecs = 3LL * 24LL * 60LL * 60LL;
+}  // namespace
+
+LyricsCache::LyricsCache(SharedPtr<Database> database) : database_(database) {
+
+  // One thread, kept alive, so the writes are applied in the order they were queued and reuse the same database connection.
+  thread_pool_.setMaxThreadCount(1);
+  thread_pool_.setExpiryTimeout(-1);
+
+}
+
+LyricsCache::~LyricsCache() {
+
+  // Close the connection of the store thread from that thread, after the pending writes.
+  SharedPtr<Database> database = database_;
+  (void)QtConcurrent::run(&thread_pool_, [database]() { database->Close(); });
+  thread_pool_.waitForDone();
+
+}
+
+QString LyricsCache::RequestArtist(const LyricsSearchRequest &request) {
+
+  return (request.albumartist.isEmpty() ? request.artist : request.albumartist).toLower();
+
+}
+
+QString LyricsCache::Key(const LyricsSearchRequest &request) {
+
+  return RequestArtist(request) + QLatin1Char('\t') + request.title.toLower() + QLatin1Char('\t') + request.album.toLower();
+
+}
+
+bool LyricsCache::Lookup(const LyricsSearchRequest &request, Entry *entry, const qint64 now) const {
+
+  QSqlDatabase db(database_->Connect());
+  SqlQuery q(db);
+  q.prepare(u"SELECT provider, lyrics, time FROM lyrics_cache WHERE artist = :artist AND title = :title AND album = :album"_s);
+  q.BindStringValue(u":artist"_s, RequestArtist(request));
+  q.BindStringValue(u":title"_s, request.title.toLower());
+  q.BindStringValue(u":album"_s, request.album.toLower());
+  if (!q.Exec()) {
+    database_->ReportErrors(q);
+    return false;
+  }
+  if (!q.next()) return false;
+
+  Entry result;
+  result.provider = q.value(0).toString();
+  result.lyrics = q.value(1).toString();
+  result.time = q.value(2).toLongLong();
+
+  const qint64 age = (now > 0 ? now : QDateTime::currentSecsSinceEpoch()) - result.time;
+  if (age >= (result.lyrics.isEmpty() ? kNotFoundExpirySecs : kFoundExpirySecs)) {
+    return false;
+  }
+
+  if (entry) *entry = result;
+
+  return true;
+
+}
+
+void LyricsCache::Store(const LyricsSearchRequest &request, const QString &provider, const QString &lyrics, const qint64 now) {
+
+  const QString artist = RequestArtist(request);
+  const QString title = request.title.toLower();
+  const QString album = request.album.toLower();
+  const qint64 time = now > 0 ? now : QDateTime::currentSecsSinceEpoch();
+  SharedPtr<Database> database = database_;
+
+  (void)QtConcurrent::run(&thread_pool_, [database, artist, title, album, provider, lyrics, time]() {
+    Database::WriteLocker l(database);
+    QSqlDatabase db(database->Connect());
+    SqlQuery q(db);
+    q.prepare(u"INSERT OR REPLACE INTO lyrics_cache (artist, title, album, provider, lyrics, time) VALUES (:artist, :title, :album, :provider, :lyrics, :time)"_s);
+    q.BindStringValue(u":artist"_s, artist);
+    q.BindStringValue(u":title"_s, title);
+    q.BindStringValue(u":album"_s, album);
+    q.BindStringValue(u":provider"_s, provider);
+    q.BindStringValue(u":lyrics"_s, lyrics);
+    q.BindLongLongValue(u":time"_s, time);
+    if (!q.Exec()) {
+      database->ReportErrors(q);
+    }
+  });
+
+}
+
+void LyricsCache::Flush() {
+
+  thread_pool_.waitForDone();
+
+}
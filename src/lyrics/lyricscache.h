@@ -0,0 +1,68 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef LYRICSCACHE_H
+#define LYRICSCACHE_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QString>
+#include <QThreadPool>
+
+#include "core/shared_ptr.h"
+#include "lyricssearchrequest.h"
+
+class Database;
+
+// Lyrics found (or not found) for a song, stored in the lyrics_cache table keyed by artist, title and album.
+// Lookups are single indexed reads on the calling thread, writes are queued to a worker thread.
+// Found lyrics are kept much longer than misses, since providers keep adding lyrics.
+
+class LyricsCache {
+
+ public:
+  explicit LyricsCache(SharedPtr<Database> database);
+  ~LyricsCache();
+
+  struct Entry {
+    Entry() : time(0) {}
+    QString provider;
+    QString lyrics;
+    qint64 time;
+  };
+
+  // Returns true if there is an entry that has not expired yet, an entry with empty lyrics means none were found.
+  bool Lookup(const LyricsSearchRequest &request, Entry *entry, const qint64 now = 0) const;
+  void Store(const LyricsSearchRequest &request, const QString &provider, const QString &lyrics, const qint64 now = 0);
+
+  // Waits for the queued writes.
+  void Flush();
+
+  static QString Key(const LyricsSearchRequest &request);
+
+ private:
+  static QString RequestArtist(const LyricsSearchRequest &request);
+
+ private:
+  SharedPtr<Database> database_;
+  QThreadPool thread_pool_;
+};
+
+#endif  // LYRICSCACHE_H
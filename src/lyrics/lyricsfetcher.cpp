@@ -20,14 +20,18 @@
 #include "config.h"
 
 #include <chrono>
+#include <utility>
 
 #include <QtGlobal>
+#include <QMetaObject>
 #include <QTimer>
+#include <QSet>
 #include <QString>
 
 #include "core/shared_ptr.h"
 #include "core/song.h"
 #include "lyricsfetcher.h"
+#include "lyricscache.h"
 #include "lyricsfetchersearch.h"
 #include "lyricssearchrequest.h"
 #include "lyricssearchresult.h"
@@ -38,9 +42,10 @@ namespace {
 constexpr int kMaxConcurrentRequests = 5;
 }
 
-LyricsFetcher::LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, QObject *parent)
+LyricsFetcher::LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, SharedPtr<LyricsCache> lyrics_cache, QObject *parent)
     : QObject(parent),
       lyrics_providers_(lyrics_providers),
+      lyrics_cache_(lyrics_cache),
       next_id_(0),
       request_starter_(new QTimer(this)) {
 
@@ -49,7 +54,7 @@ LyricsFetcher::LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, QObjec
 
 }
 
-quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QString &artist, const QString &album, const QString &title) {
+LyricsSearchRequest LyricsFetcher::SearchRequest(const QString &effective_albumartist, const QString &artist, const QString &album, const QString &title) {
 
   LyricsSearchRequest search_request;
   search_request.albumartist = effective_albumartist;
@@ -57,6 +62,43 @@ quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QStrin
   search_request.album = Song::AlbumRemoveDiscMisc(album);
   search_request.title = Song::TitleRemoveMisc(title);
 
+  return search_request;
+
+}
+
+quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QString &artist, const QString &album, const QString &title) {
+
+  const LyricsSearchRequest search_request = SearchRequest(effective_albumartist, artist, album, title);
+
+  if (lyrics_cache_) {
+    LyricsCache::Entry entry;
+    if (lyrics_cache_->Lookup(search_request, &entry)) {
+      const quint64 id = ++next_id_;
+      // Queued, so the caller knows the ID before the lyrics arrive.
+      QMetaObject::invokeMethod(this, [this, id, entry]() { Q_EMIT LyricsFetched(id, entry.provider, entry.lyrics); }, Qt::QueuedConnection);
+      return id;
+    }
+
+    // Take over a prefetch that is already searching for this song.
+    const QString key = LyricsCache::Key(search_request);
+    for (QHash<quint64, LyricsFetcherSearch*>::iterator it = active_prefetches_.begin(); it != active_prefetches_.end(); ++it) {
+      if (LyricsCache::Key(it.value()->request()) == key) {
+        const quint64 id = it.key();
+        active_requests_.insert(id, it.value());
+        active_prefetches_.erase(it);
+        return id;
+      }
+    }
+    for (QQueue<Request>::iterator it = prefetch_requests_.begin(); it != prefetch_requests_.end();) {
+      if (LyricsCache::Key(it->search_request) == key) {
+        it = prefetch_requests_.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
   Request request;
   request.id = ++next_id_;
   request.search_request = search_request;
@@ -66,6 +108,40 @@ quint64 LyricsFetcher::Search(const QString &effective_albumartist, const QStrin
 
 }
 
+void LyricsFetcher::Prefetch(const SongList &songs) {
+
+  if (!lyrics_cache_) return;
+
+  prefetch_requests_.clear();
+
+  QSet<QString> keys;
+  for (LyricsFetcherSearch *search : std::as_const(active_requests_)) {
+    keys << LyricsCache::Key(search->request());
+  }
+  for (LyricsFetcherSearch *search : std::as_const(active_prefetches_)) {
+    keys << LyricsCache::Key(search->request());
+  }
+  for (const Request &request : std::as_const(queued_requests_)) {
+    keys << LyricsCache::Key(request.search_request);
+  }
+
+  for (const Song &song : songs) {
+    const LyricsSearchRequest search_request = SearchRequest(song.effective_albumartist(), song.artist(), song.album(), song.title());
+    const QString key = LyricsCache::Key(search_request);
+    if (keys.contains(key)) continue;
+    keys << key;
+    LyricsCache::Entry entry;
+    if (lyrics_cache_->Lookup(search_request, &entry)) continue;
+    Request request;
+    request.id = ++next_id_;
+    request.search_request = search_request;
+    prefetch_requests_.enqueue(request);
+  }
+
+  if (!prefetch_requests_.isEmpty() && !request_starter_->isActive()) request_starter_->start();
+
+}
+
 void LyricsFetcher::AddRequest(const Request &request) {
 
   queued_requests_.enqueue(request);
@@ -79,40 +155,55 @@ void LyricsFetcher::AddRequest(const Request &request) {
 void LyricsFetcher::Clear() {
 
   queued_requests_.clear();
+  prefetch_requests_.clear();
 
-  const QList<LyricsFetcherSearch*> searches = active_requests_.values();
+  const QList<LyricsFetcherSearch*> searches = active_requests_.values() + active_prefetches_.values();
   for (LyricsFetcherSearch *search : searches) {
     search->Cancel();
     search->deleteLater();
   }
   active_requests_.clear();
+  active_prefetches_.clear();
 
 }
 
 void LyricsFetcher::StartRequests() {
 
-  if (queued_requests_.isEmpty()) {
+  if (queued_requests_.isEmpty() && prefetch_requests_.isEmpty()) {
     request_starter_->stop();
     return;
   }
 
   while (!queued_requests_.isEmpty() && active_requests_.size() < kMaxConcurrentRequests) {
+    StartSearch(queued_requests_.dequeue(), &active_requests_);
+  }
 
-    Request request = queued_requests_.dequeue();
+  // Prefetch one song at a time, and only while nothing else is searching, so it never competes with the song being played.
+  if (queued_requests_.isEmpty() && active_requests_.isEmpty() && active_prefetches_.isEmpty() && !prefetch_requests_.isEmpty()) {
+    StartSearch(prefetch_requests_.dequeue(), &active_prefetches_);
+  }
 
-    LyricsFetcherSearch *search = new LyricsFetcherSearch(request.id, request.search_request, this);
-    active_requests_.insert(request.id, search);
+}
 
-    QObject::connect(search, &LyricsFetcherSearch::SearchFinished, this, &LyricsFetcher::SingleSearchFinished);
-    QObject::connect(search, &LyricsFetcherSearch::LyricsFetched, this, &LyricsFetcher::SingleLyricsFetched);
+void LyricsFetcher::StartSearch(const Request &request, QHash<quint64, LyricsFetcherSearch*> *searches) {
 
-    search->Start(lyrics_providers_);
-  }
+  LyricsFetcherSearch *search = new LyricsFetcherSearch(request.id, request.search_request, this);
+  searches->insert(request.id, search);
+
+  QObject::connect(search, &LyricsFetcherSearch::SearchFinished, this, &LyricsFetcher::SingleSearchFinished);
+  QObject::connect(search, &LyricsFetcherSearch::LyricsFetched, this, &LyricsFetcher::SingleLyricsFetched);
+
+  search->Start(lyrics_providers_);
 
 }
 
 void LyricsFetcher::SingleSearchFinished(const quint64 request_id, const LyricsSearchResults &results) {
 
+  if (active_prefetches_.contains(request_id)) {
+    active_prefetches_.take(request_id)->deleteLater();
+    return;
+  }
+
   if (!active_requests_.contains(request_id)) return;
 
   LyricsFetcherSearch *search = active_requests_.take(request_id);
@@ -123,10 +214,23 @@ void LyricsFetcher::SingleSearchFinished(const quint64 request_id, const LyricsS
 
 void LyricsFetcher::SingleLyricsFetched(const quint64 request_id, const QString &provider, const QString &lyrics) {
 
+  if (active_prefetches_.contains(request_id)) {
+    LyricsFetcherSearch *search = active_prefetches_.take(request_id);
+    search->deleteLater();
+    if (!lyrics.isEmpty() || search->not_found()) {
+      lyrics_cache_->Store(search->request(), provider, lyrics);
+    }
+    return;
+  }
+
   if (!active_requests_.contains(request_id)) return;
 
   LyricsFetcherSearch *search = active_requests_.take(request_id);
   search->deleteLater();
+  // Only remember a miss when every provider answered, not when the search timed out or failed.
+  if (lyrics_cache_ && (!lyrics.isEmpty() || search->not_found())) {
+    lyrics_cache_->Store(search->request(), provider, lyrics);
+  }
   Q_EMIT LyricsFetched(request_id, provider, lyrics);
 
 }
@@ -33,18 +33,20 @@
 #include <QUrl>
 
 #include "core/shared_ptr.h"
+#include "core/song.h"
 #include "lyricssearchrequest.h"
 #include "lyricssearchresult.h"
 
 class QTimer;
 class LyricsProviders;
 class LyricsFetcherSearch;
+class LyricsCache;
 
 class LyricsFetcher : public QObject {
   Q_OBJECT
 
  public:
-  explicit LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, QObject *parent = nullptr);
+  explicit LyricsFetcher(SharedPtr<LyricsProviders> lyrics_providers, SharedPtr<LyricsCache> lyrics_cache, QObject *parent = nullptr);
   ~LyricsFetcher() override {}
 
   struct Request {
@@ -56,8 +58,14 @@ class LyricsFetcher : public QObject {
   quint64 Search(const QString &effective_albumartist, const QString &artist, const QString &album, const QString &title);
   void Clear();
 
+  // Searches for the lyrics of the given songs in the background, one at a time when no other search is running, and stores them in the cache.
+  // Replaces the songs from the previous call that were not searched yet.
+  void Prefetch(const SongList &songs);
+
  private:
+  static LyricsSearchRequest SearchRequest(const QString &effective_albumartist, const QString &artist, const QString &album, const QString &title);
   void AddRequest(const Request &request);
+  void StartSearch(const Request &request, QHash<quint64, LyricsFetcherSearch*> *searches);
 
  Q_SIGNALS:
   void LyricsFetched(const quint64 request_id, const QString &provider, const QString &lyrics);
@@ -70,10 +78,13 @@ class LyricsFetcher : public QObject {
 
  private:
   SharedPtr<LyricsProviders> lyrics_providers_;
+  SharedPtr<LyricsCache> lyrics_cache_;
   quint64 next_id_;
 
   QQueue<Request> queued_requests_;
+  QQueue<Request> prefetch_requests_;
   QHash<quint64, LyricsFetcherSearch*> active_requests_;
+  QHash<quint64, LyricsFetcherSearch*> active_prefetches_;
 
   QTimer *request_starter_;
 };
@@ -45,7 +45,9 @@ LyricsFetcherSearch::LyricsFetcherSearch(const quint64 id, const LyricsSearchReq
     : QObject(parent),
       id_(id),
       request_(request),
-      cancel_requested_(false) {
+      cancel_requested_(false),
+      search_incomplete_(false),
+      not_found_(false) {
 
   QTimer::singleShot(kSearchTimeoutMs, this, &LyricsFetcherSearch::TerminateSearch);
 
@@ -53,6 +55,9 @@ LyricsFetcherSearch::LyricsFetcherSearch(const quint64 id, const LyricsSearchReq
 
 void LyricsFetcherSearch::TerminateSearch() {
 
+  // Providers that did not answer in time might still have lyrics.
+  if (!pending_requests_.isEmpty()) search_incomplete_ = true;
+
   const QList<int> keys = pending_requests_.keys();
   for (const int id : keys) {
     pending_requests_.take(id)->CancelSearchAsync(id);
@@ -79,6 +84,7 @@ void LyricsFetcherSearch::Start(SharedPtr<LyricsProviders> lyrics_providers) {
     const bool success = provider->StartSearchAsync(id, request_);
     if (success) {
       pending_requests_.insert(id, provider);
+      provider_error_counts_.insert(provider, provider->error_count());
     }
   }
 
@@ -139,6 +145,7 @@ void LyricsFetcherSearch::AllProvidersFinished() {
     Q_EMIT LyricsFetched(id_, results_.constLast().provider, results_.constLast().lyrics);
   }
   else {
+    not_found_ = !search_incomplete_ && !provider_error_counts_.isEmpty() && !ProvidersFailed();
     Q_EMIT LyricsFetched(id_, QString(), QString());
   }
 
@@ -146,6 +153,17 @@ void LyricsFetcherSearch::AllProvidersFinished() {
 
 }
 
+bool LyricsFetcherSearch::ProvidersFailed() const {
+
+  // Errors are not reported per search, so an error during any search counts against this one as well.
+  for (QMap<LyricsProvider*, int>::const_iterator it = provider_error_counts_.constBegin(); it != provider_error_counts_.constEnd(); ++it) {
+    if (it.key()->error_count() != it.value()) return true;
+  }
+
+  return false;
+
+}
+
 void LyricsFetcherSearch::Cancel() {
 
   cancel_requested_ = true;
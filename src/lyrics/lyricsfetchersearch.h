@@ -43,6 +43,11 @@ class LyricsFetcherSearch : public QObject {
   void Start(SharedPtr<LyricsProviders> lyrics_providers);
   void Cancel();
 
+  LyricsSearchRequest request() const { return request_; }
+
+  // True when every provider completed without errors and none of them had lyrics.
+  bool not_found() const { return not_found_; }
+
  Q_SIGNALS:
   void SearchFinished(const quint64 id, const LyricsSearchResults &results);
   void LyricsFetched(const quint64 id, const QString &provider, const QString &lyrics);
@@ -53,6 +58,7 @@ class LyricsFetcherSearch : public QObject {
 
  private:
   void AllProvidersFinished();
+  bool ProvidersFailed() const;
   static bool ProviderCompareOrder(LyricsProvider *a, LyricsProvider *b);
   static bool LyricsSearchResultCompareScore(const LyricsSearchResult &a, const LyricsSearchResult &b);
 
@@ -61,7 +67,11 @@ class LyricsFetcherSearch : public QObject {
   LyricsSearchRequest request_;
   LyricsSearchResults results_;
   QMap<int, LyricsProvider*> pending_requests_;
+  // Error count of each provider when the search was started.
+  QMap<LyricsProvider*, int> provider_error_counts_;
   bool cancel_requested_;
+  bool search_incomplete_;
+  bool not_found_;
 };
 
 #endif  // LYRICSFETCHERSEARCH_H
@@ -44,6 +44,9 @@ class LyricsProvider : public QObject {
   bool is_enabled() const { return enabled_; }
   int order() const { return order_; }
 
+  // Number of errors reported so far, so a search can tell a failed request from one without lyrics.
+  int error_count() const { return error_count_; }
+
   void set_enabled(const bool enabled) { enabled_ = enabled; }
   void set_order(const int order) { order_ = order; }
 
@@ -71,6 +74,7 @@ class LyricsProvider : public QObject {
   bool enabled_;
   int order_;
   const bool authentication_required_;
+  int error_count_;
 };
 
 #endif  // LYRICSPROVIDER_H
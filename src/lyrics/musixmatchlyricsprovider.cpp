@@ -445,6 +445,7 @@ void MusixmatchLyricsProvider::EndSearch(LyricsSearchContextPtr search, const QU
 
 void MusixmatchLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "MusixmatchLyrics:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
@@ -111,6 +111,7 @@ void OVHLyricsProvider::HandleSearchReply(QNetworkReply *reply, const int id, co
 
 void OVHLyricsProvider::Error(const QString &error, const QVariant &debug) {
 
+  ++error_count_;
   qLog(Error) << "OVHLyrics:" << error;
   if (debug.isValid()) qLog(Debug) << debug;
 
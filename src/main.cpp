@@ -91,6 +91,7 @@
 #include "core/iconloader.h"
 #include "core/mainwindow.h"
 #include "core/commandlineoptions.h"
+#include "core/startupprofiler.h"
 #include "core/application.h"
 #include "core/networkproxyfactory.h"
 #ifdef Q_OS_MACOS
@@ -117,6 +118,8 @@ using std::make_shared;
 
 int main(int argc, char *argv[]) {
 
+  StartupProfiler::Start();
+
 #ifdef Q_OS_MACOS
   // Do Mac specific startup to get media keys working.
   // This must go before QApplication initialization.
@@ -153,6 +156,9 @@ int main(int argc, char *argv[]) {
     // Parse commandline options - need to do this before starting the full QApplication, so it works without an X server
     if (!options.Parse()) return 1;
     logging::SetLevels(options.log_levels());
+    if (!options.startup_trace().isEmpty() && single_app.isPrimaryInstance()) {
+      StartupProfiler::Enable(options.startup_trace());
+    }
     if (!single_app.isPrimaryInstance()) {
       if (options.is_empty()) {
         qLog(Info) << "Strawberry is already running - activating existing window (1)";
@@ -185,7 +191,9 @@ int main(int argc, char *argv[]) {
   QGuiApplication::setDesktopFileName(QStringLiteral("org.strawberrymusicplayer.strawberry"));
   QGuiApplication::setQuitOnLastWindowClosed(false);
 
+  StartupProfiler::Scope profiler_scope_qapplication("QApplication");
   QApplication a(argc, argv);
+  profiler_scope_qapplication.Finish();
   KDSingleApplication single_app(QCoreApplication::applicationName(), KDSingleApplication::Option::IncludeUsernameInSocketName);
   if (!single_app.isPrimaryInstance()) {
     if (options.is_empty()) {
@@ -277,7 +285,9 @@ int main(int argc, char *argv[]) {
 
 #endif
 
+  StartupProfiler::Scope profiler_scope_application("Application");
   Application app;
+  profiler_scope_application.Finish();
 
   // Network proxy
   QNetworkProxyFactory::setApplicationProxyFactory(NetworkProxyFactory::Instance());
@@ -298,7 +308,9 @@ int main(int argc, char *argv[]) {
 #endif
 
   // Window
+  StartupProfiler::Scope profiler_scope_mainwindow("MainWindow");
   MainWindow w(&app, tray_icon, &osd, options);
+  profiler_scope_mainwindow.Finish();
 
 #ifdef Q_OS_MACOS
   mac::EnableFullScreen(w);
@@ -29,6 +29,8 @@
 #include <unordered_map>
 #include <random>
 #include <chrono>
+#include <iterator>
+#include <vector>
 
 #include <QObject>
 #include <QCoreApplication>
@@ -48,6 +50,8 @@
 #include <QString>
 #include <QStringList>
 #include <QUrl>
+#include <QCollator>
+#include <QCollatorSortKey>
 #include <QFont>
 #include <QBrush>
 #include <QUndoStack>
@@ -65,6 +69,7 @@
 #include "core/tagreaderclient.h"
 #include "core/song.h"
 #include "core/settings.h"
+#include "core/taskmanager.h"
 #include "utilities/timeconstants.h"
 #include "collection/collection.h"
 #include "collection/collectionbackend.h"
@@ -656,6 +661,42 @@ int Playlist::previous_row(const bool ignore_repeat_track) {
 
 }
 
+QList<int> Playlist::upcoming_rows(const int count) const {
+
+  QList<int> rows;
+
+  for (int i = 0; i < queue_->rowCount() && rows.count() < count; ++i) {
+    const int row = queue_->mapToSource(queue_->index(i, 0)).row();
+    if (row != -1) rows << row;
+  }
+
+  int virtual_index = current_virtual_index_;
+  while (rows.count() < count) {
+    const int next_virtual_index = NextVirtualIndex(virtual_index, true);
+    if (next_virtual_index <= virtual_index || next_virtual_index >= virtual_items_.count()) break;
+    virtual_index = next_virtual_index;
+    const int row = virtual_items_.value(virtual_index);
+    if (!rows.contains(row)) rows << row;
+  }
+
+  return rows;
+
+}
+
+int Playlist::peek_previous_row() const {
+
+  for (qsizetype i = played_indexes_.count() - 1; i >= 0; --i) {
+    const QPersistentModelIndex &idx = played_indexes_[i];
+    if (idx.isValid() && idx != current_item_index_) return idx.row();
+  }
+
+  const int prev_virtual_index = PreviousVirtualIndex(current_virtual_index_, true);
+  if (prev_virtual_index < 0) return -1;
+
+  return virtual_items_.value(prev_virtual_index);
+
+}
+
 void Playlist::set_current_row(const int i, const AutoScroll autoscroll, const bool is_stopping, const bool force_inform) {
 
   QPersistentModelIndex old_current_item_index = current_item_index_;
@@ -807,7 +848,11 @@ bool Playlist::dropMimeData(const QMimeData *data, Qt::DropAction action, const
   if (const SongMimeData *song_data = qobject_cast<const SongMimeData*>(data)) {
     // Dragged from a collection
     // We want to check if these songs are from the actual local file backend, if they are we treat them differently.
-    if (song_data->backend && song_data->backend->songs_table() == QLatin1String(SCollection::kSongsTable)) {
+    const bool collection_items = song_data->backend && song_data->backend->songs_table() == QLatin1String(SCollection::kSongsTable);
+    if (!song_data->song_ids.isEmpty()) {
+      InsertSongIds(song_data->backend, song_data->song_ids, collection_items, row, play_now, enqueue_now, enqueue_next_now);
+    }
+    else if (collection_items) {
       InsertSongItems<CollectionPlaylistItem>(song_data->songs, row, play_now, enqueue_now, enqueue_next_now);
     }
     else {
@@ -889,6 +934,44 @@ bool Playlist::dropMimeData(const QMimeData *data, Qt::DropAction action, const
 
 }
 
+void Playlist::InsertSongIds(SharedPtr<CollectionBackendInterface> backend, const QList<int> &song_ids, const bool collection_items, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next) {
+
+  const int task_id = task_manager_->StartTask(tr("Loading songs"));
+
+  QFuture<PlaylistItemPtrList> future = QtConcurrent::run(&Playlist::LoadSongIdItems, backend, song_ids, collection_items);
+  QFutureWatcher<PlaylistItemPtrList> *watcher = new QFutureWatcher<PlaylistItemPtrList>(this);
+  // The watcher is deleted with the playlist if it goes away while the songs are loading, so finish the task from there.
+  SharedPtr<TaskManager> task_manager = task_manager_;
+  QObject::connect(watcher, &QObject::destroyed, task_manager.get(), [task_manager, task_id]() { task_manager->SetTaskFinished(task_id); });
+  QObject::connect(watcher, &QFutureWatcher<PlaylistItemPtrList>::finished, this, [this, watcher, pos, play_now, enqueue, enqueue_next]() {
+    const PlaylistItemPtrList items = watcher->result();
+    watcher->deleteLater();
+    // Rows might have been removed while the songs were loading.
+    InsertItems(items, pos > items_.count() ? -1 : pos, play_now, enqueue, enqueue_next);
+  });
+  watcher->setFuture(future);
+
+}
+
+PlaylistItemPtrList Playlist::LoadSongIdItems(SharedPtr<CollectionBackendInterface> backend, const QList<int> &song_ids, const bool collection_items) {
+
+  const SongList songs = SongMimeData::LoadSongs(backend, song_ids);
+
+  PlaylistItemPtrList items;
+  items.reserve(songs.count());
+  for (const Song &song : songs) {
+    if (collection_items) {
+      items << make_shared<CollectionPlaylistItem>(song);
+    }
+    else {
+      items << make_shared<SongPlaylistItem>(song);
+    }
+  }
+
+  return items;
+
+}
+
 void Playlist::InsertUrls(const QList<QUrl> &urls, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next) {
 
   SongLoaderInserter *inserter = new SongLoaderInserter(task_manager_, collection_backend_, backend_->app()->player());
@@ -1103,10 +1186,17 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
   const int start = pos == -1 ? static_cast<int>(items_.count()) : pos;
   const int end = start + static_cast<int>(items.count()) - 1;
 
+  const PlaylistItemPtr current = current_item();
+
   beginInsertRows(QModelIndex(), start, end);
+
+  // Make room for all the items at once, inserting them one by one moves the rows after them for every item.
+  items_.insert(start, items.count(), PlaylistItemPtr());
+  std::copy(items.begin(), items.end(), items_.begin() + start);
+  virtual_items_.reserve(items_.count());
+
   for (int i = start; i <= end; ++i) {
-    PlaylistItemPtr item = items[i - start];
-    items_.insert(i, item);
+    const PlaylistItemPtr &item = items_[i];
     virtual_items_ << static_cast<int>(virtual_items_.count());
 
     if (item->source() == Song::Source::Collection) {
@@ -1116,7 +1206,7 @@ void Playlist::InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const in
       }
     }
 
-    if (item == current_item()) {
+    if (current && item == current) {
       // It's one we removed before that got re-added through an undo
       current_item_index_ = index(i, 0);
       last_played_item_index_ = current_item_index_;
@@ -1311,23 +1401,18 @@ bool Playlist::CompareItems(const Column column, const Qt::SortOrder order, Play
   PlaylistItemPtr a = order == Qt::AscendingOrder ? _a : _b;
   PlaylistItemPtr b = order == Qt::AscendingOrder ? _b : _a;
 
+  if (IsCollatedColumn(column)) {
+    return QString::localeAwareCompare(CollationText(column, a), CollationText(column, b)) < 0;
+  }
+
 #define cmp(field) return a->Metadata().field() < b->Metadata().field()
-#define strcmp(field) return QString::localeAwareCompare(a->Metadata().field().toLower(), b->Metadata().field().toLower()) < 0;
 
   switch (column) {
-    case Column::Title:        strcmp(title_sortable);
-    case Column::Artist:       strcmp(artist_sortable);
-    case Column::Album:        strcmp(album_sortable);
     case Column::Length:       cmp(length_nanosec);
     case Column::Track:        cmp(track);
     case Column::Disc:         cmp(disc);
     case Column::Year:         cmp(year);
     case Column::OriginalYear: cmp(effective_originalyear);
-    case Column::Genre:        strcmp(genre);
-    case Column::AlbumArtist:  strcmp(playlist_albumartist_sortable);
-    case Column::Composer:     strcmp(composer);
-    case Column::Performer:    strcmp(performer);
-    case Column::Grouping:     strcmp(grouping);
 
     case Column::PlayCount:    cmp(playcount);
     case Column::SkipCount:    cmp(skipcount);
@@ -1336,15 +1421,12 @@ bool Playlist::CompareItems(const Column column, const Qt::SortOrder order, Play
     case Column::Bitrate:      cmp(bitrate);
     case Column::Samplerate:   cmp(samplerate);
     case Column::Bitdepth:     cmp(bitdepth);
-    case Column::Filename:
-      return QString::localeAwareCompare(a->Url().path(), b->Url().path()) < 0;
     case Column::BaseFilename: cmp(basefilename);
     case Column::Filesize:     cmp(filesize);
     case Column::Filetype:     cmp(filetype);
     case Column::DateModified: cmp(mtime);
     case Column::DateCreated:  cmp(ctime);
 
-    case Column::Comment:      strcmp(comment);
     case Column::Source:       cmp(source);
 
     case Column::Rating:       cmp(rating);
@@ -1354,18 +1436,100 @@ bool Playlist::CompareItems(const Column column, const Qt::SortOrder order, Play
     case Column::EBUR128IntegratedLoudness: cmp(ebur128_integrated_loudness_lufs);
     case Column::EBUR128LoudnessRange: cmp(ebur128_loudness_range_lu);
 
+    case Column::Title:
+    case Column::Artist:
+    case Column::Album:
+    case Column::Genre:
+    case Column::AlbumArtist:
+    case Column::Composer:
+    case Column::Performer:
+    case Column::Grouping:
+    case Column::Filename:
+    case Column::Comment:
     case Column::Mood:
     case Column::ColumnCount:
       break;
   }
 
 #undef cmp
-#undef strcmp
 
   return false;
 
 }
 
+bool Playlist::IsCollatedColumn(const Column column) {
+
+  switch (column) {
+    case Column::Title:
+    case Column::Artist:
+    case Column::Album:
+    case Column::Genre:
+    case Column::AlbumArtist:
+    case Column::Composer:
+    case Column::Performer:
+    case Column::Grouping:
+    case Column::Filename:
+    case Column::Comment:
+      return true;
+    default:
+      return false;
+  }
+
+}
+
+QString Playlist::CollationText(const Column column, PlaylistItemPtr item) {
+
+  const Song metadata = item->Metadata();
+
+  switch (column) {
+    case Column::Title:        return metadata.title_sortable().toLower();
+    case Column::Artist:       return metadata.artist_sortable().toLower();
+    case Column::Album:        return metadata.album_sortable().toLower();
+    case Column::Genre:        return metadata.genre().toLower();
+    case Column::AlbumArtist:  return metadata.playlist_albumartist_sortable().toLower();
+    case Column::Composer:     return metadata.composer().toLower();
+    case Column::Performer:    return metadata.performer().toLower();
+    case Column::Grouping:     return metadata.grouping().toLower();
+    case Column::Filename:     return item->Url().path();
+    case Column::Comment:      return metadata.comment().toLower();
+    default:
+      break;
+  }
+
+  return QString();
+
+}
+
+void Playlist::SortItems(const Column column, const Qt::SortOrder order, PlaylistItemPtrList::iterator begin, PlaylistItemPtrList::iterator end) {
+
+  if (!IsCollatedColumn(column)) {
+    std::stable_sort(begin, end, std::bind(&Playlist::CompareItems, column, order, std::placeholders::_1, std::placeholders::_2));
+    return;
+  }
+
+  // Collation keys are computed once per item, comparing them is a plain binary compare.
+  struct SortEntry {
+    QCollatorSortKey key;
+    PlaylistItemPtr item;
+  };
+
+  const QCollator collator;
+  std::vector<SortEntry> entries;
+  entries.reserve(static_cast<size_t>(std::distance(begin, end)));
+  for (PlaylistItemPtrList::iterator it = begin; it != end; ++it) {
+    entries.push_back(SortEntry{ collator.sortKey(CollationText(column, *it)), *it });
+  }
+
+  std::stable_sort(entries.begin(), entries.end(), [order](const SortEntry &a, const SortEntry &b) {
+    return order == Qt::AscendingOrder ? a.key.compare(b.key) < 0 : b.key.compare(a.key) < 0;
+  });
+
+  for (const SortEntry &entry : entries) {
+    *begin++ = entry.item;
+  }
+
+}
+
 QString Playlist::column_name(const Column column) {
 
   switch (column) {
@@ -1450,12 +1614,12 @@ void Playlist::sort(const int column_number, const Qt::SortOrder order) {
 
   if (column == Column::Album) {
     // When sorting by album, also take into account discs and tracks.
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Track, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Disc, order, std::placeholders::_1, std::placeholders::_2));
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, Column::Album, order, std::placeholders::_1, std::placeholders::_2));
+    SortItems(Column::Track, order, begin, new_items.end());
+    SortItems(Column::Disc, order, begin, new_items.end());
+    SortItems(Column::Album, order, begin, new_items.end());
   }
   else {
-    std::stable_sort(begin, new_items.end(), std::bind(&Playlist::CompareItems, column, order, std::placeholders::_1, std::placeholders::_2));
+    SortItems(column, order, begin, new_items.end());
   }
 
   undo_stack_->push(new PlaylistUndoCommands::SortItems(this, column, order, new_items));
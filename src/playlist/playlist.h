@@ -55,6 +55,7 @@ class QUndoStack;
 class QTimer;
 
 class CollectionBackend;
+class CollectionBackendInterface;
 class PlaylistBackend;
 class PlaylistFilter;
 class Queue;
@@ -149,6 +150,7 @@ class Playlist : public QAbstractListModel {
   static const int kUndoItemLimit;
 
   static bool CompareItems(const Column column, const Qt::SortOrder order, PlaylistItemPtr a, PlaylistItemPtr b);
+  static void SortItems(const Column column, const Qt::SortOrder order, PlaylistItemPtrList::iterator begin, PlaylistItemPtrList::iterator end);
 
   static QString column_name(const Column column);
   static QString abbreviated_column_name(const Column column);
@@ -176,6 +178,10 @@ class Playlist : public QAbstractListModel {
   void reset_played_indexes() { played_indexes_.clear(); }
   int next_row(const bool ignore_repeat_track = false);
   int previous_row(const bool ignore_repeat_track = false);
+  // The rows likely to be played after the current one, queued rows first. Does not wrap around or reshuffle.
+  QList<int> upcoming_rows(const int count) const;
+  // The row previous_row() would most likely return, without consuming the played history. Does not wrap around.
+  int peek_previous_row() const;
 
   QModelIndex current_index() const;
 
@@ -329,6 +335,14 @@ class Playlist : public QAbstractListModel {
   template<typename T>
   void InsertSongItems(const SongList &songs, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next = false);
 
+  // Loads the songs dragged from a collection in a worker thread, then inserts them.
+  void InsertSongIds(SharedPtr<CollectionBackendInterface> backend, const QList<int> &song_ids, const bool collection_items, const int pos, const bool play_now, const bool enqueue, const bool enqueue_next);
+  static PlaylistItemPtrList LoadSongIdItems(SharedPtr<CollectionBackendInterface> backend, const QList<int> &song_ids, const bool collection_items);
+
+  // Text columns are sorted locale aware on the lower case text.
+  static bool IsCollatedColumn(const Column column);
+  static QString CollationText(const Column column, PlaylistItemPtr item);
+
   // Modify the playlist without changing the undo stack.  These are used by our friends in PlaylistUndoCommands
   void InsertItemsWithoutUndo(const PlaylistItemPtrList &items, const int pos, const bool enqueue = false, const bool enqueue_next = false);
   PlaylistItemPtrList RemoveItemsWithoutUndo(const int row, const int count);
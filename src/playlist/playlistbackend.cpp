@@ -72,10 +72,22 @@ PlaylistBackend::PlaylistBackend(Application *app, QObject *parent)
 
 }
 
+PlaylistBackend::PlaylistBackend(SharedPtr<Database> db, QObject *parent)
+    : QObject(parent),
+      app_(nullptr),
+      db_(db),
+      original_thread_(nullptr) {
+
+  setObjectName(QLatin1String(metaObject()->className()));
+
+  original_thread_ = thread();
+
+}
+
 void PlaylistBackend::Close() {
 
   if (db_) {
-    QMutexLocker l(db_->Mutex());
+    Database::WriteLocker l(db_);
     db_->Close();
   }
 
@@ -108,7 +120,6 @@ PlaylistBackend::PlaylistList PlaylistBackend::GetAllFavoritePlaylists() {
 
 PlaylistBackend::PlaylistList PlaylistBackend::GetPlaylists(const GetPlaylistsFlags flags) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   PlaylistList ret;
@@ -152,7 +163,6 @@ PlaylistBackend::PlaylistList PlaylistBackend::GetPlaylists(const GetPlaylistsFl
 
 PlaylistBackend::Playlist PlaylistBackend::GetPlaylist(const int id) {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -187,7 +197,6 @@ PlaylistItemPtrList PlaylistBackend::GetPlaylistItems(const int playlist) {
 
   {
 
-    QMutexLocker l(db_->Mutex());
     QSqlDatabase db(db_->Connect());
 
     QString query = QStringLiteral("SELECT %1, %2, p.type FROM playlist_items AS p LEFT JOIN songs ON p.collection_id = songs.ROWID WHERE p.playlist = :playlist").arg(Song::JoinSpec(QStringLiteral("songs")), Song::JoinSpec(QStringLiteral("p")));
@@ -223,7 +232,6 @@ SongList PlaylistBackend::GetPlaylistSongs(const int playlist) {
   SongList songs;
 
   {
-    QMutexLocker l(db_->Mutex());
     QSqlDatabase db(db_->Connect());
 
     QString query = QStringLiteral("SELECT %1, %2, p.type FROM playlist_items AS p LEFT JOIN songs ON p.collection_id = songs.ROWID WHERE p.playlist = :playlist").arg(Song::JoinSpec(QStringLiteral("songs")), Song::JoinSpec(QStringLiteral("p")));
@@ -282,7 +290,7 @@ PlaylistItemPtr PlaylistBackend::RestoreCueData(PlaylistItemPtr item, SharedPtr<
   // We need collection to run a CueParser; also, this method applies only to file-type PlaylistItems
   if (item->source() != Song::Source::LocalFile) return item;
 
-  CueParser cue_parser(app_->collection_backend());
+  CueParser cue_parser(app_ ? app_->collection_backend() : nullptr);
 
   Song song = item->Metadata();
   // We're only interested in .cue songs here
@@ -334,7 +342,7 @@ void PlaylistBackend::SavePlaylistAsync(int playlist, const PlaylistItemPtrList
 
 void PlaylistBackend::SavePlaylist(int playlist, const PlaylistItemPtrList &items, int last_played, PlaylistGeneratorPtr dynamic) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   qLog(Debug) << "Saving playlist" << playlist;
@@ -352,16 +360,18 @@ void PlaylistBackend::SavePlaylist(int playlist, const PlaylistItemPtrList &item
     }
   }
 
-  // Save the new ones
-  for (PlaylistItemPtr item : items) {  // clazy:exclude=range-loop-reference
+  // Save the new ones, the statement is prepared once and the values are bound by position for each item
+  {
     SqlQuery q(db);
-    q.prepare(QStringLiteral("INSERT INTO playlist_items (playlist, type, collection_id, ") + Song::kColumnSpec + QStringLiteral(") VALUES (:playlist, :type, :collection_id, ") + Song::kBindSpec + QStringLiteral(")"));
-    q.BindValue(QStringLiteral(":playlist"), playlist);
-    item->BindToQuery(&q);
-
-    if (!q.Exec()) {
-      db_->ReportErrors(q);
-      return;
+    q.prepare(QStringLiteral("INSERT INTO playlist_items (playlist, type, collection_id, ") + Song::kColumnSpec + QStringLiteral(") VALUES (?, ?, ?, ") + Song::kBindSpec + QStringLiteral(")"));
+    for (PlaylistItemPtr item : items) {  // clazy:exclude=range-loop-reference
+      q.AddBindValue(playlist);
+      item->BindToQuery(&q);
+
+      if (!q.Exec()) {
+        db_->ReportErrors(q);
+        return;
+      }
     }
   }
 
@@ -393,7 +403,7 @@ void PlaylistBackend::SavePlaylist(int playlist, const PlaylistItemPtrList &item
 
 int PlaylistBackend::CreatePlaylist(const QString &name, const QString &special_type) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -411,7 +421,7 @@ int PlaylistBackend::CreatePlaylist(const QString &name, const QString &special_
 
 void PlaylistBackend::RemovePlaylist(int id) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   ScopedTransaction transaction(&db);
@@ -442,7 +452,7 @@ void PlaylistBackend::RemovePlaylist(int id) {
 
 void PlaylistBackend::RenamePlaylist(const int id, const QString &new_name) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
   SqlQuery q(db);
   q.prepare(QStringLiteral("UPDATE playlists SET name=:name WHERE ROWID=:id"));
@@ -457,7 +467,7 @@ void PlaylistBackend::RenamePlaylist(const int id, const QString &new_name) {
 
 void PlaylistBackend::FavoritePlaylist(const int id, const bool is_favorite) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
   SqlQuery q(db);
   q.prepare(QStringLiteral("UPDATE playlists SET is_favorite=:is_favorite WHERE ROWID=:id"));
@@ -472,7 +482,7 @@ void PlaylistBackend::FavoritePlaylist(const int id, const bool is_favorite) {
 
 void PlaylistBackend::SetPlaylistOrder(const QList<int> &ids) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
   ScopedTransaction transaction(&db);
 
@@ -499,7 +509,7 @@ void PlaylistBackend::SetPlaylistOrder(const QList<int> &ids) {
 
 void PlaylistBackend::SetPlaylistUiPath(const int id, const QString &path) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
   SqlQuery q(db);
   q.prepare(QStringLiteral("UPDATE playlists SET ui_path=:path WHERE ROWID=:id"));
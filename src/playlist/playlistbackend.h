@@ -48,6 +48,8 @@ class PlaylistBackend : public QObject {
 
  public:
   Q_INVOKABLE explicit PlaylistBackend(Application *app, QObject *parent = nullptr);
+  // Without an application, CUE sheets of restored items are not matched against the collection.
+  explicit PlaylistBackend(SharedPtr<Database> db, QObject *parent = nullptr);
 
   struct Playlist {
     Playlist() : id(-1), favorite(false), last_played(0) {}
@@ -93,8 +93,8 @@ PlaylistItem::~PlaylistItem() = default;
 
 void PlaylistItem::BindToQuery(SqlQuery *query) const {
 
-  query->BindValue(QStringLiteral(":type"), static_cast<int>(source_));
-  query->BindValue(QStringLiteral(":collection_id"), DatabaseValue(Column_CollectionId));
+  query->AddBindValue(static_cast<int>(source_));
+  query->AddBindValue(DatabaseValue(Column_CollectionId));
 
   DatabaseSongMetadata().BindToQuery(query);
 
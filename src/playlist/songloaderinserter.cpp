@@ -44,7 +44,13 @@ SongLoaderInserter::SongLoaderInserter(SharedPtr<TaskManager> task_manager, Shar
       enqueue_(false),
       enqueue_next_(false),
       collection_backend_(collection_backend),
-      player_(player) {}
+      player_(player),
+      task_id_(-1),
+      cancelled_(false) {
+
+  QObject::connect(&*task_manager_, &TaskManager::TaskCancelled, this, &SongLoaderInserter::TaskCancelled);
+
+}
 
 SongLoaderInserter::~SongLoaderInserter() { qDeleteAll(pending_); }
 
@@ -57,7 +63,7 @@ void SongLoaderInserter::Load(Playlist *destination, int row, bool play_now, boo
   enqueue_next_ = enqueue_next;
 
   QObject::connect(destination, &Playlist::destroyed, this, &SongLoaderInserter::DestinationDestroyed);
-  QObject::connect(this, &SongLoaderInserter::PreloadFinished, this, &SongLoaderInserter::InsertSongs);
+  QObject::connect(this, &SongLoaderInserter::SongsLoaded, this, &SongLoaderInserter::InsertSongs);
   QObject::connect(this, &SongLoaderInserter::EffectiveLoadFinished, destination, &Playlist::UpdateItems);
 
   for (const QUrl &url : urls) {
@@ -66,12 +72,25 @@ void SongLoaderInserter::Load(Playlist *destination, int row, bool play_now, boo
     SongLoader::Result ret = loader->Load(url);
 
     if (ret == SongLoader::Result::BlockingLoadRequired) {
+      // Insert playlists progressively while they are parsed.
+      // Chunks can't be queued next in order, so these are inserted in one go.
+      if (!enqueue_next_) {
+        loader->set_stream_playlists(true);
+        QObject::connect(loader, &SongLoader::SongsChunkLoaded, this, &SongLoaderInserter::InsertSongs);
+      }
       pending_.append(loader);
+      songs_after_pending_.append(SongList());
       continue;
     }
 
     if (ret == SongLoader::Result::Success) {
-      songs_ << loader->songs();
+      // Keep the drop order, songs after a URL that is still loading are inserted after its songs.
+      if (pending_.isEmpty()) {
+        songs_ << loader->songs();
+      }
+      else {
+        songs_after_pending_.last() << loader->songs();
+      }
     }
     else {
       const QStringList errors = loader->errors();
@@ -82,11 +101,15 @@ void SongLoaderInserter::Load(Playlist *destination, int row, bool play_now, boo
     delete loader;
   }
 
+  // Insert what was found in the collection before the first pending URL right away.
+  InsertSongs(songs_);
+  songs_.clear();
+
   if (pending_.isEmpty()) {
-    InsertSongs();
     deleteLater();
   }
   else {
+    StartTask(tr("Loading tracks"));
     (void)QtConcurrent::run(&SongLoaderInserter::AsyncLoad, this);
   }
 }
@@ -135,7 +158,7 @@ void SongLoaderInserter::AudioCDTracksLoadFinished(SongLoader *loader) {
     }
   }
   else {
-    InsertSongs();
+    InsertSongs(songs_);
   }
 
 }
@@ -156,23 +179,49 @@ void SongLoaderInserter::AudioCDTagsLoaded(const bool success) {
 
 }
 
-void SongLoaderInserter::InsertSongs() {
+void SongLoaderInserter::InsertSongs(const SongList &songs) {
+
+  if (!destination_ || songs.isEmpty()) return;
 
   // Insert songs (that haven't been completely loaded) to allow user to see and play them while not loaded completely
-  if (destination_) {
-    destination_->InsertSongsOrCollectionItems(songs_, row_, play_now_, enqueue_, enqueue_next_);
+  const int row = row_ == -1 ? -1 : qMin(row_, destination_->rowCount());
+  destination_->InsertSongsOrCollectionItems(songs, row, play_now_, enqueue_, enqueue_next_);
+
+  // Songs loaded later are inserted after these, and should not start playback again.
+  if (row != -1) row_ = row + static_cast<int>(songs.count());
+  play_now_ = false;
+
+}
+
+int SongLoaderInserter::StartTask(const QString &name) {
+
+  const int task_id = task_manager_->StartTask(name);
+  task_manager_->SetTaskCancellable(task_id);
+  task_id_ = task_id;
+
+  return task_id;
+
+}
+
+void SongLoaderInserter::TaskCancelled(const int task_id) {
+
+  if (task_id != task_id_ || cancelled_) return;
+
+  cancelled_ = true;
+  for (SongLoader *loader : std::as_const(pending_)) {
+    loader->Abort();
   }
 
 }
 
 void SongLoaderInserter::AsyncLoad() {
 
-  // First, quick load raw songs.
+  // First, quick load raw songs. Playlists emit their songs in chunks while they are parsed.
   int async_progress = 0;
-  int async_load_id = task_manager_->StartTask(tr("Loading tracks"));
+  int async_load_id = task_id_;
   task_manager_->SetTaskProgress(async_load_id, async_progress, pending_.count());
-  bool first_loaded = false;
-  for (int i = 0; i < pending_.count(); ++i) {
+  int first_loaded = -1;
+  for (int i = 0; i < pending_.count() && !cancelled_; ++i) {
     SongLoader *loader = pending_.value(i);
     SongLoader::Result res = loader->LoadFilenamesBlocking();
     task_manager_->SetTaskProgress(async_load_id, ++async_progress);
@@ -182,35 +231,55 @@ void SongLoaderInserter::AsyncLoad() {
       for (const QString &error : errors) {
         Q_EMIT Error(error);
       }
-      continue;
     }
+    else {
+      if (first_loaded == -1 && !loader->songs().isEmpty()) {
+        // Load everything from the first song.
+        // It'll start playing as soon as it's inserted, so it needs to have the duration set to show properly in the UI.
+        loader->LoadMetadataBlocking();
+        first_loaded = i;
+      }
 
-    if (!first_loaded) {
-      // Load everything from the first song.
-      // It'll start playing as soon as we emit PreloadFinished, so it needs to have the duration set to show properly in the UI.
-      loader->LoadMetadataBlocking();
-      first_loaded = true;
+      Q_EMIT SongsLoaded(loader->songs());
     }
 
-    songs_ << loader->songs();
+    // Then the songs that were ready already, but were dropped after this URL.
+    if (!songs_after_pending_.value(i).isEmpty()) {
+      Q_EMIT SongsLoaded(songs_after_pending_.value(i));
+    }
 
   }
   task_manager_->SetTaskFinished(async_load_id);
   Q_EMIT PreloadFinished();
 
+  if (cancelled_) {
+    deleteLater();
+    return;
+  }
+
   // Songs are inserted in playlist, now load them completely.
-  async_progress = 0;
-  async_load_id = task_manager_->StartTask(tr("Loading tracks info"));
-  task_manager_->SetTaskProgress(async_load_id, async_progress, songs_.count());
+  // Songs from streamed playlists were fully loaded by the parser already.
+  qint64 song_count = 0;
+  for (SongLoader *loader : std::as_const(pending_)) {
+    song_count += loader->songs().count();
+  }
+  if (song_count == 0) {
+    deleteLater();
+    return;
+  }
+
+  async_load_id = StartTask(tr("Loading tracks info"));
+  task_manager_->SetTaskProgress(async_load_id, 0, static_cast<quint64>(song_count));
   SongList songs;
-  for (int i = 0; i < pending_.count(); ++i) {
+  for (int i = 0; i < pending_.count() && !cancelled_; ++i) {
     SongLoader *loader = pending_.value(i);
-    if (i != 0) {
+    if (loader->songs().isEmpty()) continue;
+    if (i != first_loaded) {
       // We already did this earlier for the first song.
       loader->LoadMetadataBlocking();
     }
     songs << loader->songs();
-    task_manager_->SetTaskProgress(async_load_id, songs.count());
+    task_manager_->SetTaskProgress(async_load_id, static_cast<quint64>(songs.count()));
   }
   task_manager_->SetTaskFinished(async_load_id);
 
@@ -24,6 +24,8 @@
 
 #include "config.h"
 
+#include <atomic>
+
 #include <QObject>
 #include <QList>
 #include <QString>
@@ -51,16 +53,19 @@ class SongLoaderInserter : public QObject {
  Q_SIGNALS:
   void Error(const QString &message);
   void PreloadFinished();
+  void SongsLoaded(const SongList &songs);
   void EffectiveLoadFinished(const SongList &songs);
 
  private Q_SLOTS:
   void DestinationDestroyed();
   void AudioCDTracksLoadFinished(SongLoader *loader);
   void AudioCDTagsLoaded(const bool success);
-  void InsertSongs();
+  void InsertSongs(const SongList &songs);
+  void TaskCancelled(const int task_id);
 
  private:
   void AsyncLoad();
+  int StartTask(const QString &name);
 
  private:
   SharedPtr<TaskManager> task_manager_;
@@ -74,8 +79,13 @@ class SongLoaderInserter : public QObject {
   SongList songs_;
 
   QList<SongLoader*> pending_;
+  // Songs that were ready right away, but come after the pending loader at the same index.
+  QList<SongList> songs_after_pending_;
   SharedPtr<CollectionBackendInterface> collection_backend_;
   const SharedPtr<Player> player_;
+
+  std::atomic<int> task_id_;
+  std::atomic<bool> cancelled_;
 };
 
 #endif  // SONGLOADERINSERTER_H
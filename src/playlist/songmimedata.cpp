@@ -19,8 +19,104 @@
  *
  */
 
+#include "config.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <QList>
+#include <QHash>
+#include <QMetaType>
+#include <QVariant>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "collection/collectionbackend.h"
 #include "songmimedata.h"
 
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr qint64 kLoadSongsChunkSize = 1000;
+}
+
 SongMimeData::SongMimeData(QObject *parent) : backend(nullptr) {
   Q_UNUSED(parent);
 }
+
+void SongMimeData::AddSongId(const Song &song) {
+
+  song_ids << song.id();
+
+  // Once there are two artists, the name is "Various artists" whatever the other songs are.
+  if (name_artists_.count() > 1) return;
+
+  if (!name_artists_.contains(song.artist()) || !name_albums_.contains(song.album())) {
+    name_artists_ << song.artist();
+    name_albums_ << song.album();
+    name_songs_ << song;
+  }
+
+}
+
+SongList SongMimeData::LoadSongs(SharedPtr<CollectionBackendInterface> backend, const QList<int> &song_ids) {
+
+  if (!backend || song_ids.isEmpty()) return SongList();
+
+  // Keep the ID lists short, the SQL statement length is limited.
+  QHash<int, Song> songs_by_id;
+  songs_by_id.reserve(song_ids.count());
+  for (qint64 i = 0; i < song_ids.count(); i += kLoadSongsChunkSize) {
+    const SongList songs = backend->GetSongsById(song_ids.mid(i, std::min(song_ids.count() - i, kLoadSongsChunkSize)));
+    for (const Song &song : songs) {
+      songs_by_id.insert(song.id(), song);
+    }
+  }
+
+  SongList songs;
+  songs.reserve(songs_by_id.count());
+  for (const int song_id : song_ids) {
+    if (songs_by_id.contains(song_id)) {
+      songs << songs_by_id.value(song_id);
+    }
+  }
+
+  return songs;
+
+}
+
+QStringList SongMimeData::formats() const {
+
+  QStringList ret = MimeData::formats();
+  if (!song_ids.isEmpty() && !ret.contains("text/uri-list"_L1)) {
+    ret << u"text/uri-list"_s;
+  }
+
+  return ret;
+
+}
+
+QVariant SongMimeData::retrieveData(const QString &mimetype, QMetaType preferred_type) const {
+
+  if (mimetype == "text/uri-list"_L1 && !song_ids.isEmpty() && !MimeData::formats().contains(mimetype)) {
+    if (urls_.isEmpty()) {
+      const SongList songs = LoadSongs(backend, song_ids);
+      urls_.reserve(songs.count());
+      for (const Song &song : songs) {
+        urls_ << song.url();
+      }
+    }
+    QVariantList ret;
+    ret.reserve(urls_.count());
+    for (const QUrl &url : std::as_const(urls_)) {
+      ret << url;
+    }
+    return ret;
+  }
+
+  return MimeData::retrieveData(mimetype, preferred_type);
+
+}
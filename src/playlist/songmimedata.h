@@ -24,6 +24,14 @@
 
 #include "config.h"
 
+#include <QList>
+#include <QSet>
+#include <QMetaType>
+#include <QVariant>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
 #include "core/shared_ptr.h"
 #include "core/mimedata.h"
 #include "core/song.h"
@@ -38,6 +46,28 @@ class SongMimeData : public MimeData {
 
   SharedPtr<CollectionBackendInterface> backend;
   SongList songs;
+
+  // Drags from the collection only carry the song IDs, the songs are loaded from the backend when dropped.
+  QList<int> song_ids;
+
+  // Adds a song by ID, only keeping the few songs that decide the name for a new playlist.
+  void AddSongId(const Song &song);
+  const SongList &name_songs() const { return name_songs_; }
+
+  // Loads the songs in the order of the IDs, this can be called from any thread.
+  static SongList LoadSongs(SharedPtr<CollectionBackendInterface> backend, const QList<int> &song_ids);
+
+  // The URL list is only loaded when another application asks for it.
+  QStringList formats() const override;
+
+ protected:
+  QVariant retrieveData(const QString &mimetype, QMetaType preferred_type) const override;
+
+ private:
+  SongList name_songs_;
+  QSet<QString> name_artists_;
+  QSet<QString> name_albums_;
+  mutable QList<QUrl> urls_;
 };
 
 #endif  // SONGMIMEDATA_H
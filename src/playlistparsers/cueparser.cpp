@@ -68,7 +68,11 @@ CueParser::CueParser(SharedPtr<CollectionBackendInterface> collection_backend, Q
 
 SongList CueParser::Load(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
 
-  SongList ret;
+  return LoadAll(device, playlist_path, dir, collection_lookup);
+
+}
+
+void CueParser::LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
 
   QTextStream text_stream(device);
 
@@ -159,7 +163,7 @@ SongList CueParser::Load(QIODevice *device, const QString &playlist_path, const
 
     if (line.isNull()) {
       qLog(Warning) << "The .cue file from" << dir_path << "defines no tracks!";
-      return ret;
+      return;
     }
 
     // If this is a data file, all of its tracks will be ignored
@@ -253,40 +257,59 @@ SongList CueParser::Load(QIODevice *device, const QString &playlist_path, const
 
   QDateTime cue_mtime = QFileInfo(playlist_path).lastModified();
 
-  // Finalize parsing songs
-  for (int i = 0; i < entries.length(); i++) {
-    CueEntry entry = entries.at(i);
+  // Finalize parsing songs, the collection lookups are done per chunk
+  for (qint64 chunk_start = 0; chunk_start < entries.count(); chunk_start += kLoadChunkSize) {
+    const qint64 chunk_end = qMin(entries.count(), chunk_start + kLoadChunkSize);
+
+    SongList songs;
+    songs.reserve(chunk_end - chunk_start);
+    for (qint64 i = chunk_start; i < chunk_end; ++i) {
+      const CueEntry &entry = entries.at(i);
+      Song song(Song::Source::LocalFile);
+      PrepareSong(entry.file, IndexToMarker(entry.index), 0, dir, &song);
+      songs << song;
+    }
+    ResolveSongs(&songs, collection_lookup);
 
-    Song song = LoadSong(entry.file, IndexToMarker(entry.index), 0, dir, collection_lookup);
+    SongList ret;
+    ret.reserve(songs.count());
+    for (qint64 i = chunk_start; i < chunk_end; ++i) {
+      const CueEntry &entry = entries.at(i);
 
-    // Cue song has mtime equal to qMax(media_file_mtime, cue_sheet_mtime)
-    if (cue_mtime.isValid()) {
-      song.set_mtime(qMax(cue_mtime.toSecsSinceEpoch(), song.mtime()));
-    }
-    song.set_cue_path(playlist_path);
+      Song song = songs.at(i - chunk_start);
 
-    // Overwrite the stuff, we may have read from the file or collection, using the current .cue metadata
+      // Cue song has mtime equal to qMax(media_file_mtime, cue_sheet_mtime)
+      if (cue_mtime.isValid()) {
+        song.set_mtime(qMax(cue_mtime.toSecsSinceEpoch(), song.mtime()));
+      }
+      song.set_cue_path(playlist_path);
 
-    song.set_track(i + 1);
+      // Overwrite the stuff, we may have read from the file or collection, using the current .cue metadata
 
-    // The last TRACK for every FILE gets it's 'end' marker from the media file's length
-    if (i + 1 < entries.size() && entries.at(i).file == entries.at(i + 1).file) {
-      // Incorrect indices?
-      if (!UpdateSong(entry, entries.at(i + 1).index, &song)) {
-        continue;
+      song.set_track(static_cast<int>(i + 1));
+
+      // The last TRACK for every FILE gets it's 'end' marker from the media file's length
+      if (i + 1 < entries.size() && entries.at(i).file == entries.at(i + 1).file) {
+        // Incorrect indices?
+        if (!UpdateSong(entry, entries.at(i + 1).index, &song)) {
+          continue;
+        }
       }
-    }
-    else {
-      // Incorrect index?
-      if (!UpdateLastSong(entry, &song)) {
-        continue;
+      else {
+        // Incorrect index?
+        if (!UpdateLastSong(entry, &song)) {
+          continue;
+        }
       }
+
+      ret << song;
     }
 
-    ret << song;
+    if (!ret.isEmpty() && !callback(ret)) {
+      return;
+    }
   }
 
-  return ret;
 }
 
 // This and the kFileLineRegExp do most of the "dirty" work, namely: splitting the raw .cue
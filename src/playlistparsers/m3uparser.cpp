@@ -21,10 +21,10 @@
 #include <QObject>
 #include <QIODevice>
 #include <QDir>
-#include <QBuffer>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
+#include <QList>
 #include <QSettings>
 
 #include "core/shared_ptr.h"
@@ -44,59 +44,84 @@ M3UParser::M3UParser(SharedPtr<CollectionBackendInterface> collection_backend, Q
 
 SongList M3UParser::Load(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
 
+  return LoadAll(device, playlist_path, dir, collection_lookup);
+
+}
+
+void M3UParser::LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
   Q_UNUSED(playlist_path);
 
   M3UType type = M3UType::STANDARD;
   Metadata current_metadata;
-
-  QString data = QString::fromUtf8(device->readAll());
-  data.replace(u'\r', u'\n');
-  data.replace("\n\n"_L1, "\n"_L1);
-  QByteArray bytes = data.toUtf8();
-  QBuffer buffer(&bytes);
-  if (!buffer.open(QIODevice::ReadOnly)) return SongList();
-
-  QString line = QString::fromUtf8(buffer.readLine()).trimmed();
-  if (line.startsWith("#EXTM3U"_L1)) {
-    // This is in extended M3U format.
-    type = M3UType::EXTENDED;
-    line = QString::fromUtf8(buffer.readLine()).trimmed();
-  }
-
-  SongList ret;
-  Q_FOREVER {
-    if (line.startsWith(u'#')) {
-      // Extended info or comment.
-      if (type == M3UType::EXTENDED && line.startsWith("#EXT"_L1)) {
-        if (!ParseMetadata(line, &current_metadata)) {
-          qLog(Warning) << "Failed to parse metadata: " << line;
+  bool first_line = true;
+
+  SongList songs;
+  QList<Metadata> metadata;
+  while (!device->atEnd()) {
+    // Some playlists only use \r as line separator.
+    const QStringList lines = QString::fromUtf8(device->readLine()).split(u'\r');
+    for (const QString &raw_line : lines) {
+      const QString line = raw_line.trimmed();
+      if (first_line) {
+        first_line = false;
+        if (line.startsWith("#EXTM3U"_L1)) {
+          // This is in extended M3U format.
+          type = M3UType::EXTENDED;
+          continue;
         }
       }
-    }
-    else if (!line.isEmpty()) {
-      Song song = LoadSong(line, 0, 0, dir, collection_lookup);
-      if (!current_metadata.title.isEmpty()) {
-        song.set_title(current_metadata.title);
-      }
-      if (!current_metadata.artist.isEmpty()) {
-        song.set_artist(current_metadata.artist);
+      if (line.startsWith(u'#')) {
+        // Extended info or comment.
+        if (type == M3UType::EXTENDED && line.startsWith("#EXT"_L1)) {
+          if (!ParseMetadata(line, &current_metadata)) {
+            qLog(Warning) << "Failed to parse metadata: " << line;
+          }
+        }
       }
-      if (current_metadata.length > 0) {
-        song.set_length_nanosec(current_metadata.length);
+      else if (!line.isEmpty()) {
+        Song song(Song::Source::LocalFile);
+        PrepareSong(line, 0, 0, dir, &song);
+        songs << song;
+        metadata << current_metadata;
+        current_metadata = Metadata();
+        if (songs.count() >= kLoadChunkSize && !FlushChunk(&songs, &metadata, callback, collection_lookup)) {
+          return;
+        }
       }
-      ret << song;
+    }
+  }
+
+  FlushChunk(&songs, &metadata, callback, collection_lookup);
+
+}
 
-      current_metadata = Metadata();
+bool M3UParser::FlushChunk(SongList *songs, QList<Metadata> *metadata, const SongChunkCallback &callback, const bool collection_lookup) const {
+
+  if (songs->isEmpty()) return true;
+
+  ResolveSongs(songs, collection_lookup);
+
+  for (qint64 i = 0; i < songs->count(); ++i) {
+    Song &song = (*songs)[i];
+    const Metadata &song_metadata = metadata->at(i);
+    if (!song_metadata.title.isEmpty()) {
+      song.set_title(song_metadata.title);
     }
-    if (buffer.atEnd()) {
-      break;
+    if (!song_metadata.artist.isEmpty()) {
+      song.set_artist(song_metadata.artist);
+    }
+    if (song_metadata.length > 0) {
+      song.set_length_nanosec(song_metadata.length);
     }
-    line = QString::fromUtf8(buffer.readLine()).trimmed();
   }
 
-  buffer.close();
+  const bool proceed = callback(*songs);
+
+  songs->clear();
+  metadata->clear();
 
-  return ret;
+  return proceed;
 
 }
 
@@ -25,6 +25,7 @@
 
 #include <QtGlobal>
 #include <QObject>
+#include <QList>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
@@ -53,6 +54,7 @@ class M3UParser : public ParserBase {
   bool TryMagic(const QByteArray &data) const override;
 
   SongList Load(QIODevice *device, const QString &playlist_path = ""_L1, const QDir &dir = QDir(), const bool collection_lookup = true) const override;
+  void LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path = ""_L1, const QDir &dir = QDir(), const bool collection_lookup = true) const override;
   void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const override;
 
  private:
@@ -70,6 +72,7 @@ class M3UParser : public ParserBase {
   };
 
   static bool ParseMetadata(const QString &line, Metadata *metadata);
+  bool FlushChunk(SongList *songs, QList<Metadata> *metadata, const SongChunkCallback &callback, const bool collection_lookup) const;
 
 };
 
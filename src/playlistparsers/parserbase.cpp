@@ -19,11 +19,17 @@
  *
  */
 
+#include <algorithm>
+#include <utility>
+
 #include <QtGlobal>
+#include <QIODevice>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QString>
+#include <QList>
+#include <QMultiHash>
 #include <QRegularExpression>
 #include <QUrl>
 
@@ -39,7 +45,27 @@ using namespace Qt::StringLiterals;
 ParserBase::ParserBase(SharedPtr<CollectionBackendInterface> collection_backend, QObject *parent)
     : QObject(parent), collection_backend_(collection_backend) {}
 
-void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const {
+const int ParserBase::kLoadChunkSize = 500;
+
+void ParserBase::LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
+  const SongList songs = Load(device, playlist_path, dir, collection_lookup);
+  for (qint64 i = 0; i < songs.count(); i += kLoadChunkSize) {
+    if (!callback(songs.mid(i, kLoadChunkSize))) break;
+  }
+
+}
+
+SongList ParserBase::LoadAll(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
+  SongList songs;
+  LoadChunked(device, [&songs](const SongList &chunk) { songs << chunk; return true; }, playlist_path, dir, collection_lookup);
+
+  return songs;
+
+}
+
+void ParserBase::PrepareSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song) const {
 
   if (filename_or_url.isEmpty()) {
     return;
@@ -74,40 +100,116 @@ void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning
     filename = dir.absoluteFilePath(filename);
   }
 
-  const QUrl url = QUrl::fromLocalFile(filename);
+  song->set_url(QUrl::fromLocalFile(filename));
+  song->set_beginning_nanosec(beginning);
+  if (track > 0) song->set_track(track);
 
-  // Search the collection
-  if (collection_backend_ && collection_lookup) {
-    Song collection_song;
-    if (track > 0) {
-      collection_song = collection_backend_->GetSongByUrlAndTrack(url, track);
+}
+
+bool ParserBase::NeedsResolving(const Song &song) {
+
+  return !song.is_valid() && song.url().isLocalFile();
+
+}
+
+void ParserBase::ReadSongFromFile(Song *song) {
+
+  const QString filename = song->url().toLocalFile();
+
+  *song = Song(Song::Source::LocalFile);
+  const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(filename, song);
+  if (!result.success()) {
+    qLog(Error) << "Could not read file" << filename << result.error;
+  }
+
+}
+
+QList<qint64> ParserBase::ResolveSongsFromCollection(SongList *songs, const QList<qint64> &indexes, const QList<QUrl> &urls) const {
+
+  QMultiHash<QUrl, Song> collection_songs;
+  const SongList songs_found = collection_backend_->GetSongsByUrls(urls);
+  for (const Song &song : songs_found) {
+    collection_songs.insert(song.url(), song);
+  }
+
+  QList<qint64> unresolved;
+  for (qint64 i = 0; i < indexes.count(); ++i) {
+    Song &song = (*songs)[indexes.at(i)];
+    const SongList sections = collection_songs.values(urls.at(i));
+    // Match the track first, then the beginning, the same way as GetSongByUrlAndTrack() and GetSongByUrl().
+    SongList::const_iterator it = sections.constEnd();
+    if (song.track() > 0) {
+      it = std::find_if(sections.constBegin(), sections.constEnd(), [&song](const Song &section) { return section.track() == song.track(); });
+    }
+    if (it == sections.constEnd()) {
+      it = std::find_if(sections.constBegin(), sections.constEnd(), [&song](const Song &section) { return section.beginning_nanosec() == song.beginning_nanosec(); });
+    }
+    if (it == sections.constEnd()) {
+      unresolved << indexes.at(i);
     }
-    if (!collection_song.is_valid()) {
-      collection_song = collection_backend_->GetSongByUrl(url, beginning);
+    else {
+      song = *it;
     }
-    // Try canonical path
-    if (!collection_song.is_valid()) {
+  }
+
+  return unresolved;
+
+}
+
+void ParserBase::ResolveSongs(SongList *songs, const bool collection_lookup) const {
+
+  QList<qint64> pending;
+  for (qint64 i = 0; i < songs->count(); ++i) {
+    if (NeedsResolving(songs->at(i))) {
+      pending << i;
+    }
+  }
+
+  if (pending.isEmpty()) return;
+
+  // Search the collection for all the files at once, then for the canonical paths of the files not found.
+  if (collection_backend_ && collection_lookup) {
+    QList<QUrl> urls;
+    urls.reserve(pending.count());
+    for (const qint64 i : std::as_const(pending)) {
+      urls << songs->at(i).url();
+    }
+    pending = ResolveSongsFromCollection(songs, pending, urls);
+
+    QList<qint64> canonical_pending;
+    QList<QUrl> canonical_urls;
+    QList<qint64> not_found;
+    for (const qint64 i : std::as_const(pending)) {
+      const QString filename = songs->at(i).url().toLocalFile();
       const QString canonical_filepath = QFileInfo(filename).canonicalFilePath();
-      if (canonical_filepath != filename) {
-        const QUrl canonical_filepath_url = QUrl::fromLocalFile(canonical_filepath);
-        if (track > 0) {
-          collection_song = collection_backend_->GetSongByUrlAndTrack(canonical_filepath_url, track);
-        }
-        if (!collection_song.is_valid()) {
-          collection_song = collection_backend_->GetSongByUrl(canonical_filepath_url, beginning);
-        }
+      if (!canonical_filepath.isEmpty() && canonical_filepath != filename) {
+        canonical_pending << i;
+        canonical_urls << QUrl::fromLocalFile(canonical_filepath);
+      }
+      else {
+        not_found << i;
       }
     }
-    // If it was found in the collection then use it, otherwise load metadata from disk.
-    if (collection_song.is_valid()) {
-      *song = collection_song;
-      return;
+    if (!canonical_pending.isEmpty()) {
+      not_found << ResolveSongsFromCollection(songs, canonical_pending, canonical_urls);
     }
+    pending = not_found;
   }
 
-  const TagReaderClient::Result result = TagReaderClient::Instance()->ReadFileBlocking(filename, song);
-  if (!result.success()) {
-    qLog(Error) << "Could not read file" << filename << result.error;
+  // Load metadata from disk for the songs not found in the collection.
+  for (const qint64 i : std::as_const(pending)) {
+    ReadSongFromFile(&(*songs)[i]);
+  }
+
+}
+
+void ParserBase::LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const {
+
+  PrepareSong(filename_or_url, beginning, track, dir, song);
+  if (NeedsResolving(*song)) {
+    SongList songs = SongList() << *song;
+    ResolveSongs(&songs, collection_lookup);
+    *song = songs.first();
   }
 
 }
@@ -24,9 +24,12 @@
 
 #include "config.h"
 
+#include <functional>
+
 #include <QtGlobal>
 #include <QObject>
 #include <QDir>
+#include <QList>
 #include <QByteArray>
 #include <QString>
 #include <QStringList>
@@ -47,6 +50,11 @@ class ParserBase : public QObject {
  public:
   explicit ParserBase(SharedPtr<CollectionBackendInterface> collection_backend, QObject *parent = nullptr);
 
+  static const int kLoadChunkSize;
+
+  // Receives the songs of a playlist loaded with LoadChunked() in parse order. Return false to stop parsing.
+  using SongChunkCallback = std::function<bool(const SongList &songs)>;
+
   virtual QString name() const = 0;
   virtual QStringList file_extensions() const = 0;
   virtual bool load_supported() const = 0;
@@ -61,6 +69,12 @@ class ParserBase : public QObject {
   // Any playlist parser may decide to leave out some entries if it finds them incomplete or invalid.
   // This means that the final resulting SongList should be considered valid (at least from the parser's point of view).
   virtual SongList Load(QIODevice *device, const QString &playlist_path = ""_L1, const QDir &dir = QDir(), const bool collection_lookup = true) const = 0;
+
+  // Loads the playlist incrementally, passing the songs to 'callback' in chunks of at most kLoadChunkSize songs as they are parsed.
+  // Collection lookups are done once per chunk instead of once per entry.
+  // The default implementation calls Load() and splits the result, parsers that can stream should override this.
+  virtual void LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path = ""_L1, const QDir &dir = QDir(), const bool collection_lookup = true) const;
+
   virtual void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const = 0;
 
  Q_SIGNALS:
@@ -73,10 +87,24 @@ class ParserBase : public QObject {
   Song LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, const bool collection_lookup) const;
   void LoadSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song, const bool collection_lookup) const;
 
+  // Two step version of LoadSong() used for chunked loading.
+  // PrepareSong() only sets the URL, beginning and track, streams are complete after this step.
+  // ResolveSongs() then loads the metadata of all prepared local files from the collection or the files themselves.
+  void PrepareSong(const QString &filename_or_url, const qint64 beginning, const int track, const QDir &dir, Song *song) const;
+  void ResolveSongs(SongList *songs, const bool collection_lookup) const;
+
+  // Collects all chunks, used by parsers implementing Load() through LoadChunked().
+  SongList LoadAll(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const;
+
   // If the URL is a file:// URL then returns its path, absolute or relative to the directory depending on the path_type option.
   // Otherwise, returns the URL as is. This function should always be used when saving a playlist.
   static QString URLOrFilename(const QUrl &url, const QDir &dir, const PlaylistSettingsPage::PathType path_type);
 
+ private:
+  static bool NeedsResolving(const Song &song);
+  static void ReadSongFromFile(Song *song);
+  QList<qint64> ResolveSongsFromCollection(SongList *songs, const QList<qint64> &indexes, const QList<QUrl> &urls) const;
+
  private:
   SharedPtr<CollectionBackendInterface> collection_backend_;
 };
@@ -24,6 +24,7 @@
 #include <QDir>
 #include <QByteArray>
 #include <QString>
+#include <QList>
 #include <QUrl>
 #include <QSettings>
 #include <QXmlStreamReader>
@@ -46,31 +47,39 @@ XSPFParser::XSPFParser(SharedPtr<CollectionBackendInterface> collection_backend,
 
 SongList XSPFParser::Load(QIODevice *device, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
 
-  Q_UNUSED(playlist_path);
+  return LoadAll(device, playlist_path, dir, collection_lookup);
 
-  SongList songs;
+}
+
+void XSPFParser::LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path, const QDir &dir, const bool collection_lookup) const {
+
+  Q_UNUSED(playlist_path);
 
   QXmlStreamReader reader(device);
   if (!Utilities::ParseUntilElement(&reader, QStringLiteral("playlist")) || !Utilities::ParseUntilElement(&reader, QStringLiteral("trackList"))) {
-    return songs;
+    return;
   }
 
+  SongList songs;
+  QList<TrackMetadata> metadata;
   while (!reader.atEnd() && Utilities::ParseUntilElement(&reader, QStringLiteral("track"))) {
-    const Song song = ParseTrack(&reader, dir, collection_lookup);
-    if (song.is_valid()) {
-      songs << song;
+    Song song(Song::Source::LocalFile);
+    TrackMetadata track_metadata;
+    ParseTrack(&reader, dir, &song, &track_metadata);
+    songs << song;
+    metadata << track_metadata;
+    if (songs.count() >= kLoadChunkSize && !FlushChunk(&songs, &metadata, callback, collection_lookup)) {
+      return;
     }
   }
 
-  return songs;
+  FlushChunk(&songs, &metadata, callback, collection_lookup);
 
 }
 
-Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_lookup) const {
+void XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, Song *song, TrackMetadata *metadata) const {
 
-  QString title, artist, album, location, art;
-  qint64 nanosec = -1;
-  int track_num = -1;
+  QString location;
 
   while (!reader->atEnd()) {
     QXmlStreamReader::TokenType type = reader->readNext();
@@ -81,31 +90,31 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
           location = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
         }
         else if (name == "title"_L1) {
-          title = reader->readElementText();
+          metadata->title = reader->readElementText();
         }
         else if (name == "creator"_L1) {
-          artist = reader->readElementText();
+          metadata->artist = reader->readElementText();
         }
         else if (name == "album"_L1) {
-          album = reader->readElementText();
+          metadata->album = reader->readElementText();
         }
         else if (name == "image"_L1) {
-          art = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
+          metadata->art = QUrl::fromPercentEncoding(reader->readElementText().toUtf8());
         }
         else if (name == "duration"_L1) {  // in milliseconds.
           const QString duration = reader->readElementText();
           bool ok = false;
-          nanosec = duration.toInt(&ok) * kNsecPerMsec;
+          metadata->length = duration.toInt(&ok) * kNsecPerMsec;
           if (!ok) {
-            nanosec = -1;
+            metadata->length = -1;
           }
         }
         else if (name == "trackNum"_L1) {
           const QString track_num_str = reader->readElementText();
           bool ok = false;
-          track_num = track_num_str.toInt(&ok);
-          if (!ok || track_num < 1) {
-            track_num = -1;
+          metadata->track = track_num_str.toInt(&ok);
+          if (!ok || metadata->track < 1) {
+            metadata->track = -1;
           }
         }
         else if (name == "info"_L1) {
@@ -115,7 +124,7 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
       }
       case QXmlStreamReader::EndElement:{
         if (name == "track"_L1) {
-          goto return_song;
+          goto prepare_song;
         }
       }
       default:
@@ -123,20 +132,41 @@ Song XSPFParser::ParseTrack(QXmlStreamReader *reader, const QDir &dir, const boo
     }
   }
 
-return_song:
-  Song song = LoadSong(location, 0, track_num, dir, collection_lookup);
-
-  // Override metadata with what was in the playlist
-  if (song.source() != Song::Source::Collection) {
-    if (!title.isEmpty()) song.set_title(title);
-    if (!artist.isEmpty()) song.set_artist(artist);
-    if (!album.isEmpty()) song.set_album(album);
-    if (!art.isEmpty()) song.set_art_manual(QUrl(art));
-    if (nanosec > 0) song.set_length_nanosec(nanosec);
-    if (track_num > 0) song.set_track(track_num);
+prepare_song:
+  PrepareSong(location, 0, metadata->track, dir, song);
+
+}
+
+bool XSPFParser::FlushChunk(SongList *songs, QList<TrackMetadata> *metadata, const SongChunkCallback &callback, const bool collection_lookup) const {
+
+  if (songs->isEmpty()) return true;
+
+  ResolveSongs(songs, collection_lookup);
+
+  SongList valid_songs;
+  valid_songs.reserve(songs->count());
+  for (qint64 i = 0; i < songs->count(); ++i) {
+    Song song = songs->at(i);
+    if (!song.is_valid()) continue;
+    // Override metadata with what was in the playlist
+    if (song.source() != Song::Source::Collection) {
+      const TrackMetadata &track_metadata = metadata->at(i);
+      if (!track_metadata.title.isEmpty()) song.set_title(track_metadata.title);
+      if (!track_metadata.artist.isEmpty()) song.set_artist(track_metadata.artist);
+      if (!track_metadata.album.isEmpty()) song.set_album(track_metadata.album);
+      if (!track_metadata.art.isEmpty()) song.set_art_manual(QUrl(track_metadata.art));
+      if (track_metadata.length > 0) song.set_length_nanosec(track_metadata.length);
+      if (track_metadata.track > 0) song.set_track(track_metadata.track);
+    }
+    valid_songs << song;
   }
 
-  return song;
+  songs->clear();
+  metadata->clear();
+
+  if (valid_songs.isEmpty()) return true;
+
+  return callback(valid_songs);
 
 }
 
@@ -23,7 +23,9 @@
 
 #include "config.h"
 
+#include <QtGlobal>
 #include <QObject>
+#include <QList>
 #include <QByteArray>
 #include <QDir>
 #include <QString>
@@ -52,10 +54,23 @@ class XSPFParser : public XMLParser {
   bool TryMagic(const QByteArray &data) const override;
 
   SongList Load(QIODevice *device, const QString &playlist_path = ""_L1, const QDir &dir = QDir(), const bool collection_lookup = true) const override;
+  void LoadChunked(QIODevice *device, const SongChunkCallback &callback, const QString &playlist_path = ""_L1, const QDir &dir = QDir(), const bool collection_lookup = true) const override;
   void Save(const SongList &songs, QIODevice *device, const QDir &dir = QDir(), const PlaylistSettingsPage::PathType path_type = PlaylistSettingsPage::PathType::Automatic) const override;
 
  private:
-  Song ParseTrack(QXmlStreamReader *reader, const QDir &dir, const bool collection_lookup) const;
+  // Metadata from the playlist, applied to songs not found in the collection.
+  struct TrackMetadata {
+    TrackMetadata() : length(-1), track(-1) {}
+    QString title;
+    QString artist;
+    QString album;
+    QString art;
+    qint64 length;
+    int track;
+  };
+
+  void ParseTrack(QXmlStreamReader *reader, const QDir &dir, Song *song, TrackMetadata *metadata) const;
+  bool FlushChunk(SongList *songs, QList<TrackMetadata> *metadata, const SongChunkCallback &callback, const bool collection_lookup) const;
 };
 
 #endif
@@ -20,7 +20,6 @@
 #include <QtGlobal>
 #include <QObject>
 #include <QThread>
-#include <QMutexLocker>
 #include <QSqlDatabase>
 
 #include "core/shared_ptr.h"
@@ -38,7 +37,7 @@ RadioBackend::RadioBackend(SharedPtr<Database> db, QObject *parent)
 void RadioBackend::Close() {
 
   if (db_) {
-    QMutexLocker l(db_->Mutex());
+    Database::WriteLocker l(db_);
     db_->Close();
   }
 
@@ -63,7 +62,7 @@ void RadioBackend::AddChannelsAsync(const RadioChannelList &channels) {
 
 void RadioBackend::AddChannels(const RadioChannelList &channels) {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -92,7 +91,6 @@ void RadioBackend::GetChannelsAsync() {
 
 void RadioBackend::GetChannels() {
 
-  QMutexLocker l(db_->Mutex());
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
@@ -123,7 +121,7 @@ void RadioBackend::DeleteChannelsAsync() {
 
 void RadioBackend::DeleteChannels() {
 
-  QMutexLocker l(db_->Mutex());
+  Database::WriteLocker l(db_);
   QSqlDatabase db(db_->Connect());
 
   SqlQuery q(db);
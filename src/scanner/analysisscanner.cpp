@@ -0,0 +1,330 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <iostream>
+#include <utility>
+#include <algorithm>
+#include <optional>
+
+#include <QtGlobal>
+#include <QtConcurrentMap>
+#include <QThread>
+#include <QThreadPool>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QList>
+#include <QVariant>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QSqlDatabase>
+#include <QSqlError>
+
+#include "core/logging.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "core/song.h"
+#include "utilities/timeconstants.h"
+#ifdef HAVE_EBUR128
+#  include "engine/ebur128analysis.h"
+#endif
+#ifdef HAVE_SONGFINGERPRINTING
+#  include "engine/chromaprinter.h"
+#endif
+#include "analysisscanner.h"
+
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr char kConnectionName[] = "analysisscanner";
+constexpr qint64 kProgressIntervalMsec = 10000;
+constexpr double kNsecPerHour = 3600.0 * kNsecPerSec;
+}  // namespace
+
+AnalysisScanner::AnalysisScanner(const Options &options) : options_(options) {
+
+#ifndef HAVE_EBUR128
+  options_.loudness = false;
+#endif
+#ifndef HAVE_SONGFINGERPRINTING
+  options_.fingerprint = false;
+#endif
+
+  if (options_.songs_table.isEmpty()) options_.songs_table = "songs"_L1;
+  if (options_.jobs <= 0) options_.jobs = QThread::idealThreadCount();
+
+}
+
+AnalysisScanner::~AnalysisScanner() {
+
+  if (db_.isValid()) {
+    db_.close();
+    db_ = QSqlDatabase();
+    QSqlDatabase::removeDatabase(QLatin1String(kConnectionName));
+  }
+
+}
+
+int AnalysisScanner::Run() {
+
+  if (!options_.loudness && !options_.fingerprint) {
+    std::cerr << "Nothing to do, this build has neither EBU R 128 analysis nor song fingerprinting enabled.\n";
+    return 1;
+  }
+
+  if (!OpenDatabase()) return 1;
+
+  int unknown_files = 0;
+  int done_files = 0;
+  const QList<Job> jobs = CreateJobs(&unknown_files, &done_files);
+
+  std::cout << jobs.count() << " files to scan, " << done_files << " already scanned, " << unknown_files << " not in the collection." << std::endl;
+  if (jobs.isEmpty()) return 0;
+
+  QThreadPool thread_pool;
+  thread_pool.setMaxThreadCount(options_.jobs);
+
+  QElapsedTimer timer;
+  timer.start();
+  qint64 last_progress_msec = 0;
+  int scanned_files = 0;
+  int failed_files = 0;
+  qint64 audio_nanosec = 0;
+
+  const auto print_progress = [&timer, &scanned_files, &audio_nanosec, &jobs]() {
+    const double seconds = std::max(1LL, timer.elapsed()) / 1000.0;
+    std::cout << scanned_files << "/" << jobs.count() << " files, "
+              << scanned_files / seconds << " files/s, "
+              << (static_cast<double>(audio_nanosec) / kNsecPerHour) / seconds << " audio hours/s" << std::endl;
+  };
+
+  QFutureWatcher<Result> watcher;
+  QObject::connect(&watcher, &QFutureWatcher<Result>::resultReadyAt, &watcher, [&](const int index) {
+    const Result result = watcher.resultAt(index);
+    if (!StoreResult(result)) ++failed_files;
+    ++scanned_files;
+    audio_nanosec += result.audio_nanosec;
+    if (timer.elapsed() - last_progress_msec >= kProgressIntervalMsec) {
+      last_progress_msec = timer.elapsed();
+      print_progress();
+    }
+  });
+
+  QEventLoop loop;
+  QObject::connect(&watcher, &QFutureWatcher<Result>::finished, &loop, &QEventLoop::quit);
+  watcher.setFuture(QtConcurrent::mapped(&thread_pool, jobs, &AnalysisScanner::Scan));
+  loop.exec();
+
+  print_progress();
+  if (failed_files > 0) {
+    std::cerr << failed_files << " files could not be stored." << std::endl;
+  }
+
+  db_.close();
+
+  return failed_files > 0 ? 1 : 0;
+
+}
+
+bool AnalysisScanner::OpenDatabase() {
+
+  if (!QFileInfo::exists(options_.database)) {
+    std::cerr << "Database " << options_.database.toStdString() << " does not exist.\n";
+    return false;
+  }
+
+  db_ = QSqlDatabase::addDatabase(u"QSQLITE"_s, QLatin1String(kConnectionName));
+  db_.setDatabaseName(options_.database);
+  if (!db_.open()) {
+    std::cerr << "Could not open " << options_.database.toStdString() << ": " << db_.lastError().text().toStdString() << "\n";
+    return false;
+  }
+
+  {
+    SqlQuery q(db_);
+    q.prepare(u"SELECT version FROM schema_version"_s);
+    if (!q.Exec() || !q.next() || q.value(0).toInt() != Database::kSchemaVersion) {
+      std::cerr << "The database is not at schema version " << Database::kSchemaVersion << ", open it with this version of Strawberry first.\n";
+      return false;
+    }
+  }
+
+  {
+    SqlQuery q(db_);
+    q.prepare(u"SELECT name FROM sqlite_master WHERE type = 'table' AND name = ?"_s);
+    q.AddBindValue(options_.songs_table);
+    if (!q.Exec() || !q.next() || !options_.songs_table.endsWith("songs"_L1)) {
+      std::cerr << options_.songs_table.toStdString() << " is not a songs table.\n";
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+QList<AnalysisScanner::Job> AnalysisScanner::CreateJobs(int *unknown_files, int *done_files) {
+
+  QList<Job> jobs;
+
+  SqlQuery q(db_);
+  q.prepare(QStringLiteral("SELECT s.ROWID, s.beginning, s.length, s.ebur128_integrated_loudness_lufs, s.ebur128_loudness_range_lu, s.fingerprint, s.mtime, m.mtime FROM %1 AS s LEFT JOIN ebur128_analysis_misses AS m ON m.url = s.url AND m.beginning = s.beginning WHERE s.url = ? AND s.unavailable = 0").arg(options_.songs_table));
+
+  for (const QString &directory : std::as_const(options_.directories)) {
+    // Song URLs are absolute, like the collection directories.
+    QDirIterator it(QDir::cleanPath(QFileInfo(directory).absoluteFilePath()), QDir::Files | QDir::NoDotAndDotDot | QDir::Readable, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+      const QString filename = it.next();
+
+      q.AddBindUrlValue(QUrl::fromLocalFile(filename));
+      if (!q.Exec()) {
+        qLog(Error) << q.lastError() << q.LastQuery();
+        continue;
+      }
+
+      Job job;
+      job.filename = filename;
+      bool found = false;
+      while (q.next()) {
+        found = true;
+        Row row;
+        row.id = q.value(0).toInt();
+        row.beginning_nanosec = q.value(1).toLongLong();
+        row.end_nanosec = row.beginning_nanosec + q.value(2).toLongLong();
+        row.mtime = q.value(6).toLongLong();
+        // Files that gave no loudness before are only analysed again when they changed.
+        const bool loudness_missed = !q.value(7).isNull() && q.value(7).toLongLong() == row.mtime;
+        row.loudness = options_.loudness && (options_.force || ((q.value(3).isNull() || q.value(4).isNull()) && !loudness_missed));
+        if (options_.fingerprint && (options_.force || q.value(5).toString().isEmpty())) {
+          job.fingerprint = true;
+        }
+        job.rows << row;
+      }
+
+      if (!found) {
+        ++*unknown_files;
+      }
+      else if (job.fingerprint || std::any_of(job.rows.begin(), job.rows.end(), [](const Row &row) { return row.loudness; })) {
+        jobs << job;
+      }
+      else {
+        ++*done_files;
+      }
+    }
+  }
+
+  return jobs;
+
+}
+
+AnalysisScanner::Result AnalysisScanner::Scan(const Job &job) {
+
+  Result result;
+  result.filename = job.filename;
+
+#ifdef HAVE_SONGFINGERPRINTING
+  if (job.fingerprint) {
+    Chromaprinter chromaprinter(job.filename);
+    result.fingerprint = chromaprinter.CreateFingerprint();
+    // Same marker as the collection watcher, so the file isn't fingerprinted again.
+    if (result.fingerprint.isEmpty()) result.fingerprint = "NONE"_L1;
+  }
+#endif
+
+#ifdef HAVE_EBUR128
+  for (const Row &row : job.rows) {
+    if (!row.loudness) continue;
+    Song song;
+    song.set_url(QUrl::fromLocalFile(job.filename));
+    song.set_beginning_nanosec(row.beginning_nanosec);
+    song.set_end_nanosec(row.end_nanosec);
+    const std::optional<EBUR128Measures> measures = EBUR128Analysis::Compute(song);
+    if (!measures) {
+      qLog(Error) << "EBU R 128 analysis failed for" << job.filename;
+      result.loudness_misses << row;
+      continue;
+    }
+    result.rows << RowResult{ row.id, measures->loudness_lufs, measures->range_lu };
+    if (!measures->loudness_lufs || !measures->range_lu) {
+      result.loudness_misses << row;
+    }
+    result.audio_nanosec += row.end_nanosec - row.beginning_nanosec;
+  }
+#endif
+
+  return result;
+
+}
+
+bool AnalysisScanner::StoreResult(const Result &result) {
+
+  db_.transaction();
+
+  if (!result.fingerprint.isEmpty()) {
+    SqlQuery q(db_);
+    q.prepare(QStringLiteral("UPDATE %1 SET fingerprint = ? WHERE url = ?").arg(options_.songs_table));
+    q.AddBindStringValue(result.fingerprint);
+    q.AddBindUrlValue(QUrl::fromLocalFile(result.filename));
+    if (!q.Exec()) {
+      qLog(Error) << q.lastError() << q.LastQuery();
+      db_.rollback();
+      return false;
+    }
+  }
+
+  if (!result.rows.isEmpty()) {
+    SqlQuery q(db_);
+    q.prepare(QStringLiteral("UPDATE %1 SET ebur128_integrated_loudness_lufs = ?, ebur128_loudness_range_lu = ? WHERE ROWID = ?").arg(options_.songs_table));
+    for (const RowResult &row : result.rows) {
+      q.AddBindDoubleOrNullValue(row.loudness_lufs);
+      q.AddBindDoubleOrNullValue(row.range_lu);
+      q.AddBindIntValue(row.id);
+      if (!q.Exec()) {
+        qLog(Error) << q.lastError() << q.LastQuery();
+        db_.rollback();
+        return false;
+      }
+    }
+  }
+
+  if (!result.loudness_misses.isEmpty()) {
+    SqlQuery q(db_);
+    q.prepare(u"INSERT OR REPLACE INTO ebur128_analysis_misses (url, beginning, mtime) VALUES (?, ?, ?)"_s);
+    for (const Row &row : result.loudness_misses) {
+      q.AddBindUrlValue(QUrl::fromLocalFile(result.filename));
+      q.AddBindLongLongValue(row.beginning_nanosec);
+      q.AddBindLongLongValue(row.mtime);
+      if (!q.Exec()) {
+        qLog(Error) << q.lastError() << q.LastQuery();
+        db_.rollback();
+        return false;
+      }
+    }
+  }
+
+  return db_.commit();
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ANALYSISSCANNER_H
+#define ANALYSISSCANNER_H
+
+#include "config.h"
+
+#include <optional>
+
+#include <QtGlobal>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QSqlDatabase>
+
+// Fills in EBU R 128 loudness and fingerprints for the songs of a collection database without running Strawberry.
+// Files under the given directories are matched to song rows by URL, decoded in parallel on a thread pool, and the results are written
+// to the database as each file finishes. Rows that already have their values are skipped, so an interrupted scan can simply be started again.
+// Rows without a loudness result are recorded in ebur128_analysis_misses, and skipped too until the file changes.
+
+class AnalysisScanner {
+
+ public:
+  struct Options {
+    Options() : jobs(0), loudness(true), fingerprint(true), force(false) {}
+    QString database;
+    QString songs_table;
+    QStringList directories;
+    int jobs;
+    bool loudness;
+    bool fingerprint;
+    bool force;
+  };
+
+  explicit AnalysisScanner(const Options &options);
+  ~AnalysisScanner();
+
+  // Returns the process exit code.
+  int Run();
+
+  struct Row {
+    Row() : id(-1), beginning_nanosec(0), end_nanosec(0), mtime(0), loudness(false) {}
+    int id;
+    qint64 beginning_nanosec;
+    qint64 end_nanosec;
+    qint64 mtime;
+    bool loudness;
+  };
+
+  struct Job {
+    Job() : fingerprint(false) {}
+    QString filename;
+    QList<Row> rows;
+    bool fingerprint;
+  };
+
+  struct RowResult {
+    int id;
+    std::optional<double> loudness_lufs;
+    std::optional<double> range_lu;
+  };
+
+  struct Result {
+    Result() : audio_nanosec(0) {}
+    QString filename;
+    QString fingerprint;
+    QList<RowResult> rows;
+    QList<Row> loudness_misses;
+    qint64 audio_nanosec;
+  };
+
+  // The steps of Run(), except for scanning the files.
+  bool OpenDatabase();
+  QList<Job> CreateJobs(int *unknown_files, int *done_files);
+  bool StoreResult(const Result &result);
+
+ private:
+  Q_DISABLE_COPY(AnalysisScanner)
+
+  static Result Scan(const Job &job);
+
+ private:
+  Options options_;
+  QSqlDatabase db_;
+};
+
+#endif  // ANALYSISSCANNER_H
@@ -0,0 +1,86 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <QtGlobal>
+
+#include <iostream>
+
+#include <gst/gst.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QString>
+#include <QStringList>
+
+#include "core/logging.h"
+#include "analysisscanner.h"
+
+using namespace Qt::StringLiterals;
+
+int main(int argc, char **argv) {
+
+  QCoreApplication a(argc, argv);
+  QCoreApplication::setApplicationName(u"strawberry-scanner"_s);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(u"Computes EBU R 128 loudness and fingerprints for the songs of a Strawberry collection database."_s);
+  parser.addHelpOption();
+  const QCommandLineOption database_option(QStringList() << u"d"_s << u"database"_s, u"Path to strawberry.db."_s, u"file"_s);
+  const QCommandLineOption table_option(QStringList() << u"t"_s << u"table"_s, u"Songs table to update."_s, u"table"_s, u"songs"_s);
+  const QCommandLineOption jobs_option(QStringList() << u"j"_s << u"jobs"_s, u"Number of files to decode in parallel, defaults to the number of cores."_s, u"count"_s, u"0"_s);
+  const QCommandLineOption no_loudness_option(u"no-loudness"_s, u"Don't compute EBU R 128 loudness."_s);
+  const QCommandLineOption no_fingerprint_option(u"no-fingerprint"_s, u"Don't compute fingerprints."_s);
+  const QCommandLineOption force_option(u"force"_s, u"Scan files again even if they already have values."_s);
+  const QCommandLineOption verbose_option(QStringList() << u"v"_s << u"verbose"_s, u"Print debug messages."_s);
+  parser.addOption(database_option);
+  parser.addOption(table_option);
+  parser.addOption(jobs_option);
+  parser.addOption(no_loudness_option);
+  parser.addOption(no_fingerprint_option);
+  parser.addOption(force_option);
+  parser.addOption(verbose_option);
+  parser.addPositionalArgument(u"directories"_s, u"Directories of the collection to scan."_s, u"directory..."_s);
+  parser.process(a);
+
+  if (!parser.isSet(database_option) || parser.positionalArguments().isEmpty()) {
+    std::cerr << "A database and at least one directory are required, see --help.\n";
+    return 1;
+  }
+
+  logging::Init();
+  logging::SetLevels(parser.isSet(verbose_option) ? u"*:3"_s : u"*:1"_s);
+
+  gst_init(nullptr, nullptr);
+
+  AnalysisScanner::Options options;
+  options.database = parser.value(database_option);
+  options.songs_table = parser.value(table_option);
+  options.directories = parser.positionalArguments();
+  options.jobs = parser.value(jobs_option).toInt();
+  options.loudness = !parser.isSet(no_loudness_option);
+  options.fingerprint = !parser.isSet(no_fingerprint_option);
+  options.force = parser.isSet(force_option);
+
+  AnalysisScanner scanner(options);
+  return scanner.Run();
+
+}
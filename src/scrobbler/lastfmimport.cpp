@@ -51,7 +51,12 @@
 using namespace Qt::StringLiterals;
 
 namespace {
-constexpr int kRequestsDelay = 2000;
+constexpr int kRequestsDelay = 400;
+constexpr int kMaxRequestsDelay = 60000;
+constexpr int kMaxRateLimitRetries = 10;
+constexpr int kMaxRequestsInFlight = 4;
+constexpr int kTracksPerPage = 500;
+constexpr int kErrorRateLimitExceeded = 29;
 }
 
 LastFMImport::LastFMImport(SharedPtr<NetworkAccessManager> network, QObject *parent)
@@ -63,7 +68,11 @@ LastFMImport::LastFMImport(SharedPtr<NetworkAccessManager> network, QObject *par
       playcount_total_(0),
       lastplayed_total_(0),
       playcount_received_(0),
-      lastplayed_received_(0) {
+      lastplayed_received_(0),
+      recent_tracks_to_(0),
+      recent_tracks_checkpoint_(0),
+      top_tracks_checkpoint_(0),
+      rate_limit_retries_(0) {
 
   timer_flush_requests_->setInterval(kRequestsDelay);
   timer_flush_requests_->setSingleShot(false);
@@ -95,6 +104,15 @@ void LastFMImport::AbortAll() {
   top_tracks_requests_.clear();
   timer_flush_requests_->stop();
 
+  recent_tracks_to_ = 0;
+  recent_tracks_checkpoint_ = 0;
+  top_tracks_checkpoint_ = 0;
+  recent_tracks_pages_done_.clear();
+  top_tracks_pages_done_.clear();
+
+  rate_limit_retries_ = 0;
+  timer_flush_requests_->setInterval(kRequestsDelay);
+
 }
 
 void LastFMImport::ReloadSettings() {
@@ -180,6 +198,42 @@ QByteArray LastFMImport::GetReplyData(QNetworkReply *reply) {
 
 }
 
+bool LastFMImport::IsRateLimited(QNetworkReply *reply) {
+
+  if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 429) return true;
+
+  // Peek, so the data is still there for GetReplyData().
+  const QJsonDocument json_doc = QJsonDocument::fromJson(reply->peek(reply->bytesAvailable()));
+  return json_doc.isObject() && json_doc.object().contains("error"_L1) && json_doc.object()["error"_L1].toInt() == kErrorRateLimitExceeded;
+
+}
+
+// Waits twice as long before sending the next request for every throttled request in a row, the throttled request is sent again.
+bool LastFMImport::BackOff() {
+
+  if (++rate_limit_retries_ > kMaxRateLimitRetries) {
+    Error(tr("Last.fm rate limit exceeded, try again later."));
+    return false;
+  }
+
+  const int delay = std::min(kRequestsDelay << rate_limit_retries_, kMaxRequestsDelay);
+  qLog(Debug) << "Last.fm rate limit exceeded, waiting" << delay << "ms before sending the next request.";
+  timer_flush_requests_->setInterval(delay);
+  timer_flush_requests_->start();
+
+  return true;
+
+}
+
+void LastFMImport::ResetBackOff() {
+
+  if (rate_limit_retries_ == 0) return;
+
+  rate_limit_retries_ = 0;
+  timer_flush_requests_->setInterval(kRequestsDelay);
+
+}
+
 QJsonObject LastFMImport::ExtractJsonObj(const QByteArray &data) {
 
   QJsonParseError error;
@@ -223,13 +277,83 @@ void LastFMImport::ImportData(const bool lastplayed, const bool playcount) {
   lastplayed_ = lastplayed;
   playcount_ = playcount;
 
+  LoadCheckpoint();
+
+  if (recent_tracks_to_ <= 0) {
+    recent_tracks_to_ = QDateTime::currentSecsSinceEpoch();
+  }
+
+  if (recent_tracks_checkpoint_ > 0 || top_tracks_checkpoint_ > 0) {
+    qLog(Debug) << "Resuming Last.fm import from page" << recent_tracks_checkpoint_ + 1 << "of recent tracks and page" << top_tracks_checkpoint_ + 1 << "of top tracks";
+  }
+
+  Q_EMIT Started();
+
   if (lastplayed) AddGetRecentTracksRequest(0);
   if (playcount) AddGetTopTracksRequest(0);
 
 }
 
+void LastFMImport::LoadCheckpoint() {
+
+  Settings s;
+  s.beginGroup(LastFMScrobbler::kSettingsGroup);
+  const bool resume = s.contains("import_username") && s.value("import_username").toString() == username_ && s.value("import_lastplayed").toBool() == lastplayed_ && s.value("import_playcount").toBool() == playcount_;
+  if (resume) {
+    recent_tracks_to_ = s.value("import_recent_tracks_to", 0).toLongLong();
+    recent_tracks_checkpoint_ = s.value("import_recent_tracks_checkpoint", 0).toInt();
+    top_tracks_checkpoint_ = s.value("import_top_tracks_checkpoint", 0).toInt();
+  }
+  s.endGroup();
+
+  // The checkpoint is for another user or other import options, start over.
+  if (!resume) ClearCheckpoint();
+
+}
+
+void LastFMImport::SaveCheckpoint() {
+
+  Settings s;
+  s.beginGroup(LastFMScrobbler::kSettingsGroup);
+  s.setValue("import_username", username_);
+  s.setValue("import_lastplayed", lastplayed_);
+  s.setValue("import_playcount", playcount_);
+  s.setValue("import_recent_tracks_to", recent_tracks_to_);
+  s.setValue("import_recent_tracks_checkpoint", recent_tracks_checkpoint_);
+  s.setValue("import_top_tracks_checkpoint", top_tracks_checkpoint_);
+  s.endGroup();
+
+}
+
+void LastFMImport::ClearCheckpoint() {
+
+  Settings s;
+  s.beginGroup(LastFMScrobbler::kSettingsGroup);
+  s.remove("import_username");
+  s.remove("import_lastplayed");
+  s.remove("import_playcount");
+  s.remove("import_recent_tracks_to");
+  s.remove("import_recent_tracks_checkpoint");
+  s.remove("import_top_tracks_checkpoint");
+  s.endGroup();
+
+}
+
+void LastFMImport::PageDone(const int page, int *checkpoint, QSet<int> *pages_done) {
+
+  // Pages finish out of order, only move the checkpoint past pages that are all done.
+  pages_done->insert(page);
+  while (pages_done->contains(*checkpoint + 1)) {
+    pages_done->remove(*checkpoint + 1);
+    ++*checkpoint;
+  }
+
+}
+
 void LastFMImport::FlushRequests() {
 
+  if (replies_.count() >= kMaxRequestsInFlight) return;
+
   if (!recent_tracks_requests_.isEmpty()) {
     SendGetRecentTracksRequest(recent_tracks_requests_.dequeue());
     return;
@@ -258,13 +382,17 @@ void LastFMImport::SendGetRecentTracksRequest(GetRecentTracksRequest request) {
 
   ParamList params = ParamList() << Param(QStringLiteral("method"), QStringLiteral("user.getRecentTracks"));
 
+  if (recent_tracks_to_ > 0) {
+    params << Param(QStringLiteral("to"), QString::number(recent_tracks_to_));
+  }
+
   if (request.page == 0) {
     params << Param(QStringLiteral("page"), QStringLiteral("1"));
     params << Param(QStringLiteral("limit"), QStringLiteral("1"));
   }
   else {
     params << Param(QStringLiteral("page"), QString::number(request.page));
-    params << Param(QStringLiteral("limit"), QStringLiteral("500"));
+    params << Param(QStringLiteral("limit"), QString::number(kTracksPerPage));
   }
 
   QNetworkReply *reply = CreateRequest(params);
@@ -279,6 +407,12 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
+  if (IsRateLimited(reply)) {
+    if (BackOff()) recent_tracks_requests_.prepend(GetRecentTracksRequest(page));
+    return;
+  }
+  ResetBackOff();
+
   QByteArray data = GetReplyData(reply);
   if (data.isEmpty()) {
     return;
@@ -344,17 +478,22 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
   }
 
   int total = obj_attr["total"_L1].toString().toInt();
-  int pages = obj_attr["totalPages"_L1].toString().toInt();
 
   if (page == 0) {
     lastplayed_total_ = total;
+    lastplayed_received_ = std::min(total, recent_tracks_checkpoint_ * kTracksPerPage);
     UpdateTotalCheck();
-    AddGetRecentTracksRequest(1);
+    const int pages = (total + kTracksPerPage - 1) / kTracksPerPage;
+    for (int i = recent_tracks_checkpoint_ + 1; i <= pages; ++i) {
+      AddGetRecentTracksRequest(i);
+    }
   }
   else {
 
     const QJsonArray array_track = json_obj["track"_L1].toArray();
 
+    CollectionPlayStatisticsList play_statistics;
+    play_statistics.reserve(array_track.count());
     for (const QJsonValue &value_track : array_track) {
 
       ++lastplayed_received_;
@@ -388,18 +527,23 @@ void LastFMImport::GetRecentTracksRequestFinished(QNetworkReply *reply, const in
       QString title = obj_track["name"_L1].toString();
       QDateTime datetime = QDateTime::fromString(date, QStringLiteral("dd MMM yyyy, hh:mm"));
       if (datetime.isValid()) {
-        Q_EMIT UpdateLastPlayed(artist, album, title, datetime.toSecsSinceEpoch());
+        CollectionPlayStatistics statistics;
+        statistics.artist = artist;
+        statistics.album = album;
+        statistics.title = title;
+        statistics.lastplayed = datetime.toSecsSinceEpoch();
+        play_statistics << statistics;
       }
 
-      UpdateProgressCheck();
-
     }
 
-    if (page == 1) {
-      for (int i = 2; i <= pages; ++i) {
-        AddGetRecentTracksRequest(i);
-      }
+    if (!play_statistics.isEmpty()) {
+      Q_EMIT UpdatePlayStatistics(play_statistics);
     }
+    UpdateProgressCheck();
+
+    PageDone(page, &recent_tracks_checkpoint_, &recent_tracks_pages_done_);
+    SaveCheckpoint();
 
   }
 
@@ -427,7 +571,7 @@ void LastFMImport::SendGetTopTracksRequest(GetTopTracksRequest request) {
   }
   else {
     params << Param(QStringLiteral("page"), QString::number(request.page));
-    params << Param(QStringLiteral("limit"), QStringLiteral("500"));
+    params << Param(QStringLiteral("limit"), QString::number(kTracksPerPage));
   }
 
   QNetworkReply *reply = CreateRequest(params);
@@ -442,6 +586,12 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
+  if (IsRateLimited(reply)) {
+    if (BackOff()) top_tracks_requests_.prepend(GetTopTracksRequest(page));
+    return;
+  }
+  ResetBackOff();
+
   QByteArray data = GetReplyData(reply);
   if (data.isEmpty()) {
     return;
@@ -506,17 +656,22 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
     return;
   }
 
-  int pages = obj_attr["totalPages"_L1].toString().toInt();
   int total = obj_attr["total"_L1].toString().toInt();
 
   if (page == 0) {
     playcount_total_ = total;
+    playcount_received_ = std::min(total, top_tracks_checkpoint_ * kTracksPerPage);
     UpdateTotalCheck();
-    AddGetTopTracksRequest(1);
+    const int pages = (total + kTracksPerPage - 1) / kTracksPerPage;
+    for (int i = top_tracks_checkpoint_ + 1; i <= pages; ++i) {
+      AddGetTopTracksRequest(i);
+    }
   }
   else {
 
     QJsonArray array_track = json_obj["track"_L1].toArray();
+    CollectionPlayStatisticsList play_statistics;
+    play_statistics.reserve(array_track.count());
     for (QJsonArray::iterator it = array_track.begin(); it != array_track.end(); ++it) {
 
       const QJsonValue &value_track = *it;
@@ -547,16 +702,21 @@ void LastFMImport::GetTopTracksRequestFinished(QNetworkReply *reply, const int p
 
       if (playcount <= 0) continue;
 
-      Q_EMIT UpdatePlayCount(artist, title, playcount, false);
-      UpdateProgressCheck();
+      CollectionPlayStatistics statistics;
+      statistics.artist = artist;
+      statistics.title = title;
+      statistics.playcount = playcount;
+      play_statistics << statistics;
 
     }
 
-    if (page == 1) {
-      for (int i = 2; i <= pages; ++i) {
-        AddGetTopTracksRequest(i);
-      }
+    if (!play_statistics.isEmpty()) {
+      Q_EMIT UpdatePlayStatistics(play_statistics);
     }
+    UpdateProgressCheck();
+
+    PageDone(page, &top_tracks_checkpoint_, &top_tracks_pages_done_);
+    SaveCheckpoint();
 
   }
 
@@ -576,7 +736,12 @@ void LastFMImport::UpdateProgressCheck() {
 }
 
 void LastFMImport::FinishCheck() {
-  if (replies_.isEmpty() && recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) Q_EMIT Finished();
+
+  if (replies_.isEmpty() && recent_tracks_requests_.isEmpty() && top_tracks_requests_.isEmpty()) {
+    ClearCheckpoint();
+    Q_EMIT Finished();
+  }
+
 }
 
 void LastFMImport::Error(const QString &error, const QVariant &debug) {
@@ -29,9 +29,11 @@
 #include <QByteArray>
 #include <QString>
 #include <QQueue>
+#include <QSet>
 #include <QDateTime>
 
 #include "core/shared_ptr.h"
+#include "collection/collectionplaystatistics.h"
 
 class QTimer;
 class QNetworkReply;
@@ -66,6 +68,9 @@ class LastFMImport : public QObject {
   QNetworkReply *CreateRequest(const ParamList &request_params);
   QByteArray GetReplyData(QNetworkReply *reply);
   QJsonObject ExtractJsonObj(const QByteArray &data);
+  static bool IsRateLimited(QNetworkReply *reply);
+  bool BackOff();
+  void ResetBackOff();
 
   void AddGetRecentTracksRequest(const int page = 0);
   void AddGetTopTracksRequest(const int page = 0);
@@ -78,11 +83,16 @@ class LastFMImport : public QObject {
   void UpdateTotalCheck();
   void UpdateProgressCheck();
 
+  void LoadCheckpoint();
+  void SaveCheckpoint();
+  void ClearCheckpoint();
+  static void PageDone(const int page, int *checkpoint, QSet<int> *pages_done);
+
   void FinishCheck();
 
  Q_SIGNALS:
-  void UpdatePlayCount(const QString&, const QString&, const int, const bool = false);
-  void UpdateLastPlayed(const QString&, const QString&, const QString&, const qint64);
+  void Started();
+  void UpdatePlayStatistics(const CollectionPlayStatisticsList &play_statistics);
   void UpdateTotal(const int, const int);
   void UpdateProgress(const int, const int);
   void Finished();
@@ -106,7 +116,16 @@ class LastFMImport : public QObject {
   int lastplayed_received_;
   QQueue<GetRecentTracksRequest> recent_tracks_requests_;
   QQueue<GetTopTracksRequest> top_tracks_requests_;
+
+  // Pages up to the checkpoint are imported, the import continues from there if it is interrupted.
+  // Recent tracks are requested up to a fixed time, so the pages do not shift while new tracks are scrobbled.
+  qint64 recent_tracks_to_;
+  int recent_tracks_checkpoint_;
+  int top_tracks_checkpoint_;
+  QSet<int> recent_tracks_pages_done_;
+  QSet<int> top_tracks_pages_done_;
   QList<QNetworkReply*> replies_;
+  int rate_limit_retries_;
 };
 
 #endif  // LASTFMIMPORT_H
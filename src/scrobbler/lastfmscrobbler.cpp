@@ -23,6 +23,7 @@
 
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/database.h"
 
 #include "scrobblersettings.h"
 #include "lastfmscrobbler.h"
@@ -36,5 +37,5 @@ constexpr char kAuthUrl[] = "https://www.last.fm/api/auth/";
 constexpr char kCacheFile[] = "lastfmscrobbler.cache";
 }  // namespace
 
-LastFMScrobbler::LastFMScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent)
-    : ScrobblingAPI20(QLatin1String(kName), QLatin1String(kSettingsGroup), QLatin1String(kAuthUrl), QLatin1String(kApiUrl), true, QLatin1String(kCacheFile), settings, network, parent) {}
+LastFMScrobbler::LastFMScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent)
+    : ScrobblingAPI20(QLatin1String(kName), QLatin1String(kSettingsGroup), QLatin1String(kAuthUrl), QLatin1String(kApiUrl), true, QLatin1String(kCacheFile), settings, network, database, parent) {}
@@ -30,12 +30,13 @@
 
 class AudioScrobbler;
 class NetworkAccessManager;
+class Database;
 
 class LastFMScrobbler : public ScrobblingAPI20 {
   Q_OBJECT
 
  public:
-  explicit LastFMScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
+  explicit LastFMScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent = nullptr);
 
   static const char *kName;
   static const char *kSettingsGroup;
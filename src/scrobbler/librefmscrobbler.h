@@ -30,12 +30,13 @@
 
 class ScrobblerSettings;
 class NetworkAccessManager;
+class Database;
 
 class LibreFMScrobbler : public ScrobblingAPI20 {
   Q_OBJECT
 
  public:
-  explicit LibreFMScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
+  explicit LibreFMScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent = nullptr);
 
   static const char *kName;
   static const char *kSettingsGroup;
@@ -43,6 +43,7 @@
 
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/database.h"
 #include "core/song.h"
 #include "core/logging.h"
 #include "core/settings.h"
@@ -71,17 +72,18 @@ constexpr char kClientIDB64[] = "b2VBVU53cVNRZXIwZXIwOUZpcWkwUQ==";
 constexpr char kClientSecretB64[] = "Uk9GZ2hrZVEzRjNvUHlFaHFpeVdQQQ==";
 constexpr char kCacheFile[] = "listenbrainzscrobbler.cache";
 constexpr int kScrobblesPerRequest = 10;
+constexpr int kMaxRequestsInFlight = 4;
 }  // namespace
 
-ListenBrainzScrobbler::ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent)
+ListenBrainzScrobbler::ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent)
     : ScrobblerService(QLatin1String(kName), settings, parent),
       network_(network),
-      cache_(new ScrobblerCache(QLatin1String(kCacheFile), this)),
+      cache_(new ScrobblerCache(database, QLatin1String(kName), QLatin1String(kCacheFile), this)),
       server_(nullptr),
       enabled_(false),
       expires_in_(-1),
       login_time_(0),
-      submitted_(false),
+      submit_window_(kMaxRequestsInFlight),
       scrobbled_(false),
       timestamp_(0),
       submit_error_(false),
@@ -92,6 +94,7 @@ ListenBrainzScrobbler::ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settin
 
   timer_submit_.setSingleShot(true);
   QObject::connect(&timer_submit_, &QTimer::timeout, this, &ListenBrainzScrobbler::Submit);
+  QObject::connect(cache_, &ScrobblerCache::CacheLoaded, this, [this]() { StartSubmit(); });
 
   ListenBrainzScrobbler::ReloadSettings();
   LoadSession();
@@ -529,7 +532,7 @@ void ListenBrainzScrobbler::Scrobble(const Song &song) {
 
 void ListenBrainzScrobbler::StartSubmit(const bool initial) {
 
-  if (!submitted_ && cache_->Count() > 0) {
+  if (!submitted() && cache_->Count() > 0) {
     if (initial && settings_->submit_delay() <= 0 && !submit_error_) {
       if (timer_submit_.isActive()) {
         timer_submit_.stop();
@@ -551,33 +554,52 @@ void ListenBrainzScrobbler::Submit() {
 
   if (!enabled() || !authenticated() || settings_->offline()) return;
 
+  // Keep up to kMaxRequestsInFlight requests going at the same time.
+  // Scrobbles that failed as part of a batch are retried one by one, so a single bad scrobble does not hold back the rest.
+  const QList<ScrobblerCacheItemPtrList> requests = submit_window_.NextRequests(cache_->List(), kScrobblesPerRequest);
+  for (const ScrobblerCacheItemPtrList &cache_items : requests) {
+    SendScrobbles(cache_items);
+  }
+
+  if (submit_window_.paused() && !timer_submit_.isActive()) {
+    timer_submit_.setInterval(static_cast<int>(submit_window_.msec_until_ready()));
+    timer_submit_.start();
+  }
+
+}
+
+void ListenBrainzScrobbler::SendScrobbles(const ScrobblerCacheItemPtrList &cache_items) {
+
   QJsonArray array;
-  ScrobblerCacheItemPtrList cache_items_sent;
-  const ScrobblerCacheItemPtrList all_cache_items = cache_->List();
-  for (ScrobblerCacheItemPtr cache_item : all_cache_items) {
-    if (cache_item->sent) continue;
-    if (cache_item->error && cache_items_sent.count() > 0) break;
-    cache_item->sent = true;
-    cache_items_sent << cache_item;
+  for (ScrobblerCacheItemPtr cache_item : cache_items) {
     QJsonObject object_listen;
     object_listen.insert("listened_at"_L1, QJsonValue::fromVariant(cache_item->timestamp));
     object_listen.insert("track_metadata"_L1, JsonTrackMetadata(cache_item->metadata));
     array.append(QJsonValue::fromVariant(object_listen));
-    if (cache_items_sent.count() >= kScrobblesPerRequest || cache_item->error) break;
   }
 
-  if (cache_items_sent.count() <= 0) return;
-
-  submitted_ = true;
-
   QJsonObject object;
   object.insert("listen_type"_L1, "import"_L1);
   object.insert("payload"_L1, array);
   QJsonDocument doc(object);
 
+  submit_window_.Sent();
+
   QUrl url(QStringLiteral("%1/1/submit-listens").arg(QLatin1String(kApiUrl)));
   QNetworkReply *reply = CreateRequest(url, doc);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cache_items_sent]() { ScrobbleRequestFinished(reply, cache_items_sent); });
+  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cache_items]() { ScrobbleRequestFinished(reply, cache_items); });
+
+}
+
+void ListenBrainzScrobbler::ContinueSubmit() {
+
+  // Keep going right away while the server accepts scrobbles, back off to the submit timer after an error.
+  if (submit_error_) {
+    StartSubmit();
+  }
+  else {
+    Submit();
+  }
 
 }
 
@@ -588,7 +610,7 @@ void ListenBrainzScrobbler::ScrobbleRequestFinished(QNetworkReply *reply, Scrobb
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
-  submitted_ = false;
+  submit_window_.Finished(reply);
 
   QJsonObject json_obj;
   QString error_message;
@@ -606,7 +628,7 @@ void ListenBrainzScrobbler::ScrobbleRequestFinished(QNetworkReply *reply, Scrobb
   }
   else {
     submit_error_ = true;
-    if (reply_result == ReplyResult::APIError) {
+    if (reply_result == ReplyResult::APIError && !submit_window_.paused()) {
       if (cache_items.count() == 1) {
         const ScrobbleMetadata &metadata = cache_items.first()->metadata;
         Error(tr("Unable to scrobble %1 - %2 because of error: %3").arg(metadata.effective_albumartist(), metadata.title, error_message));
@@ -624,7 +646,7 @@ void ListenBrainzScrobbler::ScrobbleRequestFinished(QNetworkReply *reply, Scrobb
     }
   }
 
-  StartSubmit();
+  ContinueSubmit();
 
 }
 
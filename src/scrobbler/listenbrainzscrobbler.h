@@ -37,18 +37,20 @@
 #include "scrobblerservice.h"
 #include "scrobblercache.h"
 #include "scrobblemetadata.h"
+#include "scrobblersubmitwindow.h"
 
 class QNetworkReply;
 
 class ScrobblerSettings;
 class NetworkAccessManager;
+class Database;
 class LocalRedirectServer;
 
 class ListenBrainzScrobbler : public ScrobblerService {
   Q_OBJECT
 
  public:
-  explicit ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
+  explicit ListenBrainzScrobbler(SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent = nullptr);
   ~ListenBrainzScrobbler() override;
 
   static const char *kName;
@@ -59,7 +61,7 @@ class ListenBrainzScrobbler : public ScrobblerService {
 
   bool enabled() const override { return enabled_; }
   bool authenticated() const override { return !access_token_.isEmpty() && !user_token_.isEmpty(); }
-  bool submitted() const override { return submitted_; }
+  bool submitted() const override { return submit_window_.in_flight() > 0; }
   QString user_token() const { return user_token_; }
 
   void Authenticate();
@@ -95,6 +97,8 @@ class ListenBrainzScrobbler : public ScrobblerService {
   QNetworkReply *CreateRequest(const QUrl &url, const QJsonDocument &json_doc);
   ReplyResult GetJsonObject(QNetworkReply *reply, QJsonObject &json_obj, QString &error_description);
   QJsonObject JsonTrackMetadata(const ScrobbleMetadata &metadata) const;
+  void SendScrobbles(const ScrobblerCacheItemPtrList &cache_items);
+  void ContinueSubmit();
   void AuthError(const QString &error);
   void Error(const QString &error, const QVariant &debug = QVariant());
   void RequestAccessToken(const QUrl &redirect_url = QUrl(), const QString &code = QString());
@@ -111,7 +115,7 @@ class ListenBrainzScrobbler : public ScrobblerService {
   QString token_type_;
   QString refresh_token_;
   quint64 login_time_;
-  bool submitted_;
+  ScrobblerSubmitWindow submit_window_;
   Song song_playing_;
   bool scrobbled_;
   quint64 timestamp_;
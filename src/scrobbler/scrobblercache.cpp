@@ -21,94 +21,204 @@
 
 #include <utility>
 #include <functional>
-#include <chrono>
 #include <memory>
 
 #include <QObject>
 #include <QStandardPaths>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QString>
+#include <QStringList>
 #include <QFile>
 #include <QIODevice>
 #include <QTextStream>
-#include <QTimer>
 #include <QJsonDocument>
 #include <QJsonValue>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QSqlDatabase>
 
 #include "core/song.h"
 #include "core/logging.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "core/scopedtransaction.h"
 
 #include "scrobblercache.h"
 #include "scrobblercacheitem.h"
 
-using namespace std::chrono_literals;
 using namespace Qt::StringLiterals;
 using std::make_shared;
 
-ScrobblerCache::ScrobblerCache(const QString &filename, QObject *parent)
+namespace {
+constexpr char kColumns[] = "timestamp, state, title, album, artist, albumartist, track, grouping, length_nanosec, musicbrainz_album_artist_id, musicbrainz_artist_id, musicbrainz_original_artist_id, musicbrainz_album_id, musicbrainz_original_album_id, musicbrainz_recording_id, musicbrainz_track_id, musicbrainz_disc_id, musicbrainz_release_group_id, musicbrainz_work_id";
+constexpr char kBindings[] = ":timestamp, :state, :title, :album, :artist, :albumartist, :track, :grouping, :length_nanosec, :musicbrainz_album_artist_id, :musicbrainz_artist_id, :musicbrainz_original_artist_id, :musicbrainz_album_id, :musicbrainz_original_album_id, :musicbrainz_recording_id, :musicbrainz_track_id, :musicbrainz_disc_id, :musicbrainz_release_group_id, :musicbrainz_work_id";
+constexpr int kUpdatesPerQuery = 500;
+}  // namespace
+
+ScrobblerCache::ScrobblerCache(SharedPtr<Database> database, const QString &service, const QString &legacy_filename, QObject *parent)
     : QObject(parent),
-      timer_flush_(new QTimer(this)),
-      filename_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1Char('/') + filename),
-      loaded_(false) {
+      database_(database),
+      service_(service),
+      legacy_filename_(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1Char('/') + legacy_filename) {
 
-  ReadCache();
-  loaded_ = true;
+  // One thread, kept alive, so the writes are applied in the order they were queued and reuse the same database connection.
+  thread_pool_.setMaxThreadCount(1);
+  thread_pool_.setExpiryTimeout(-1);
 
-  timer_flush_->setSingleShot(true);
-  timer_flush_->setInterval(10min);
-  QObject::connect(timer_flush_, &QTimer::timeout, this, &ScrobblerCache::WriteCache);
+  ReadCache();
 
 }
 
 ScrobblerCache::~ScrobblerCache() {
+
+  // Close the connection of the worker thread from that thread, after the pending writes.
+  SharedPtr<Database> database = database_;
+  Run([database]() { database->Close(); });
+  thread_pool_.waitForDone();
   scrobbler_cache_.clear();
+
 }
 
 void ScrobblerCache::ReadCache() {
 
-  QFile file(filename_);
+  QFuture<ScrobblerCacheItemPtrList> future = QtConcurrent::run(&thread_pool_, &ScrobblerCache::LoadCache, this);
+  QFutureWatcher<ScrobblerCacheItemPtrList> *watcher = new QFutureWatcher<ScrobblerCacheItemPtrList>(this);
+  QObject::connect(watcher, &QFutureWatcher<ScrobblerCacheItemPtrList>::finished, this, [this, watcher]() {
+    const ScrobblerCacheItemPtrList cache_items = watcher->result();
+    watcher->deleteLater();
+    // Scrobbles added while the cache was loading were queued after the read, so they go after the stored ones.
+    scrobbler_cache_ = cache_items + scrobbler_cache_;
+    Q_EMIT CacheLoaded();
+  });
+  watcher->setFuture(future);
+
+}
+
+ScrobblerCacheItemPtrList ScrobblerCache::LoadCache() {
+
+  Compact();
+
+  ScrobblerCacheItemPtrList cache_items;
+
+  {
+    QSqlDatabase db(database_->Connect());
+
+    SqlQuery q(db);
+    q.prepare(u"SELECT ROWID, %1 FROM scrobbler_cache WHERE service = :service ORDER BY ROWID"_s.arg(QLatin1String(kColumns)));
+    q.BindStringValue(u":service"_s, service_);
+    if (!q.Exec()) {
+      database_->ReportErrors(q);
+      return cache_items;
+    }
+
+    while (q.next()) {
+      ScrobbleMetadata metadata;
+      const qint64 id = q.value(0).toLongLong();
+      const quint64 timestamp = q.value(1).toULongLong();
+      const State state = static_cast<State>(q.value(2).toInt());
+      metadata.title = q.value(3).toString();
+      metadata.album = q.value(4).toString();
+      metadata.artist = q.value(5).toString();
+      metadata.albumartist = q.value(6).toString();
+      metadata.track = q.value(7).toInt();
+      metadata.grouping = q.value(8).toString();
+      metadata.length_nanosec = q.value(9).toLongLong();
+      metadata.musicbrainz_album_artist_id = q.value(10).toString();
+      metadata.musicbrainz_artist_id = q.value(11).toString();
+      metadata.musicbrainz_original_artist_id = q.value(12).toString();
+      metadata.musicbrainz_album_id = q.value(13).toString();
+      metadata.musicbrainz_original_album_id = q.value(14).toString();
+      metadata.musicbrainz_recording_id = q.value(15).toString();
+      metadata.musicbrainz_track_id = q.value(16).toString();
+      metadata.musicbrainz_disc_id = q.value(17).toString();
+      metadata.musicbrainz_release_group_id = q.value(18).toString();
+      metadata.musicbrainz_work_id = q.value(19).toString();
+
+      ScrobblerCacheItemPtr cache_item = make_shared<ScrobblerCacheItem>(metadata, timestamp);
+      cache_item->id = id;
+      cache_item->error = state == State::Error;
+      cache_items << cache_item;
+    }
+  }
+
+  // Import the JSON cache file written by older versions once, then remove it.
+  if (QFile::exists(legacy_filename_)) {
+    const ScrobblerCacheItemPtrList legacy_cache_items = ReadLegacyCache();
+    qLog(Debug) << "Importing" << legacy_cache_items.count() << "scrobbles from" << legacy_filename_;
+    if (legacy_cache_items.isEmpty() || InsertItems(legacy_cache_items)) {
+      QFile::remove(legacy_filename_);
+    }
+    cache_items << legacy_cache_items;
+  }
+
+  return cache_items;
+
+}
+
+void ScrobblerCache::Compact() {
+
+  Database::WriteLocker l(database_);
+  QSqlDatabase db(database_->Connect());
+
+  SqlQuery q(db);
+  q.prepare(u"DELETE FROM scrobbler_cache WHERE service = :service AND state = :state"_s);
+  q.BindStringValue(u":service"_s, service_);
+  q.BindIntValue(u":state"_s, static_cast<int>(State::Submitted));
+  if (!q.Exec()) {
+    database_->ReportErrors(q);
+  }
+
+}
+
+ScrobblerCacheItemPtrList ScrobblerCache::ReadLegacyCache() const {
+
+  ScrobblerCacheItemPtrList cache_items;
+
+  QFile file(legacy_filename_);
   bool result = file.open(QIODevice::ReadOnly | QIODevice::Text);
-  if (!result) return;
+  if (!result) return cache_items;
 
   QTextStream stream(&file);
   stream.setEncoding(QStringConverter::Encoding::Utf8);
   QString data = stream.readAll();
   file.close();
 
-  if (data.isEmpty()) return;
+  if (data.isEmpty()) return cache_items;
 
   QJsonParseError error;
   QJsonDocument json_doc = QJsonDocument::fromJson(data.toUtf8(), &error);
   if (error.error != QJsonParseError::NoError) {
     qLog(Error) << "Scrobbler cache is missing JSON data.";
-    return;
+    return cache_items;
   }
   if (json_doc.isEmpty()) {
     qLog(Error) << "Scrobbler cache has empty JSON document.";
-    return;
+    return cache_items;
   }
   if (!json_doc.isObject()) {
     qLog(Error) << "Scrobbler cache JSON document is not an object.";
-    return;
+    return cache_items;
   }
   QJsonObject json_obj = json_doc.object();
   if (json_obj.isEmpty()) {
     qLog(Error) << "Scrobbler cache has empty JSON object.";
-    return;
+    return cache_items;
   }
   if (!json_obj.contains("tracks"_L1)) {
     qLog(Error) << "Scrobbler cache is missing JSON tracks.";
-    return;
+    return cache_items;
   }
   QJsonValue json_tracks = json_obj["tracks"_L1];
   if (!json_tracks.isArray()) {
     qLog(Error) << "Scrobbler cache JSON tracks is not an array.";
-    return;
+    return cache_items;
   }
   const QJsonArray json_array = json_tracks.toArray();
   if (json_array.isEmpty()) {
-    return;
+    return cache_items;
   }
 
   for (const QJsonValue &value : json_array) {
@@ -182,62 +292,112 @@ void ScrobblerCache::ReadCache() {
     }
 
     ScrobblerCacheItemPtr cache_item = make_shared<ScrobblerCacheItem>(metadata, timestamp);
-    scrobbler_cache_ << cache_item;
+    cache_items << cache_item;
 
   }
 
+  return cache_items;
+
 }
 
 void ScrobblerCache::WriteCache() {
 
-  if (!loaded_) return;
+  // Everything is written as it happens, only wait for the queued writes to finish.
+  thread_pool_.waitForDone();
+
+}
+
+void ScrobblerCache::Run(const std::function<void()> &function) {
+
+  (void)QtConcurrent::run(&thread_pool_, function);
+
+}
+
+void ScrobblerCache::BindItem(SqlQuery *q, ScrobblerCacheItemPtr cache_item) {
+
+  const ScrobbleMetadata &metadata = cache_item->metadata;
+
+  q->BindValue(u":timestamp"_s, cache_item->timestamp);
+  q->BindIntValue(u":state"_s, static_cast<int>(cache_item->error ? State::Error : State::Pending));
+  q->BindStringValue(u":title"_s, metadata.title);
+  q->BindStringValue(u":album"_s, metadata.album);
+  q->BindStringValue(u":artist"_s, metadata.artist);
+  q->BindStringValue(u":albumartist"_s, metadata.albumartist);
+  q->BindIntValue(u":track"_s, metadata.track);
+  q->BindStringValue(u":grouping"_s, metadata.grouping);
+  q->BindLongLongValue(u":length_nanosec"_s, metadata.length_nanosec);
+  q->BindStringValue(u":musicbrainz_album_artist_id"_s, metadata.musicbrainz_album_artist_id);
+  q->BindStringValue(u":musicbrainz_artist_id"_s, metadata.musicbrainz_artist_id);
+  q->BindStringValue(u":musicbrainz_original_artist_id"_s, metadata.musicbrainz_original_artist_id);
+  q->BindStringValue(u":musicbrainz_album_id"_s, metadata.musicbrainz_album_id);
+  q->BindStringValue(u":musicbrainz_original_album_id"_s, metadata.musicbrainz_original_album_id);
+  q->BindStringValue(u":musicbrainz_recording_id"_s, metadata.musicbrainz_recording_id);
+  q->BindStringValue(u":musicbrainz_track_id"_s, metadata.musicbrainz_track_id);
+  q->BindStringValue(u":musicbrainz_disc_id"_s, metadata.musicbrainz_disc_id);
+  q->BindStringValue(u":musicbrainz_release_group_id"_s, metadata.musicbrainz_release_group_id);
+  q->BindStringValue(u":musicbrainz_work_id"_s, metadata.musicbrainz_work_id);
+
+}
+
+bool ScrobblerCache::InsertItems(const ScrobblerCacheItemPtrList &cache_items) {
 
-  qLog(Debug) << "Writing scrobbler cache file" << filename_;
+  Database::WriteLocker l(database_);
+  QSqlDatabase db(database_->Connect());
 
-  if (scrobbler_cache_.isEmpty()) {
-    QFile file(filename_);
-    if (file.exists()) file.remove();
-    return;
+  ScopedTransaction transaction(&db);
+
+  SqlQuery q(db);
+  q.prepare(u"INSERT INTO scrobbler_cache (service, %1) VALUES (:service, %2)"_s.arg(QLatin1String(kColumns), QLatin1String(kBindings)));
+
+  QList<qint64> ids;
+  ids.reserve(cache_items.count());
+  for (ScrobblerCacheItemPtr cache_item : cache_items) {
+    q.BindStringValue(u":service"_s, service_);
+    BindItem(&q, cache_item);
+    if (!q.Exec()) {
+      database_->ReportErrors(q);
+      return false;
+    }
+    ids << q.lastInsertId().toLongLong();
   }
 
-  QJsonArray array;
-  for (ScrobblerCacheItemPtr cache_item : std::as_const(scrobbler_cache_)) {
-    QJsonObject object;
-    object.insert("timestamp"_L1, QJsonValue::fromVariant(cache_item->timestamp));
-    object.insert("artist"_L1, QJsonValue::fromVariant(cache_item->metadata.artist));
-    object.insert("album"_L1, QJsonValue::fromVariant(cache_item->metadata.album));
-    object.insert("title"_L1, QJsonValue::fromVariant(cache_item->metadata.title));
-    object.insert("track"_L1, QJsonValue::fromVariant(cache_item->metadata.track));
-    object.insert("albumartist"_L1, QJsonValue::fromVariant(cache_item->metadata.albumartist));
-    object.insert("grouping"_L1, QJsonValue::fromVariant(cache_item->metadata.grouping));
-    object.insert("musicbrainz_album_artist_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_album_artist_id));
-    object.insert("musicbrainz_artist_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_artist_id));
-    object.insert("musicbrainz_original_artist_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_original_artist_id));
-    object.insert("musicbrainz_album_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_album_id));
-    object.insert("musicbrainz_original_album_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_original_album_id));
-    object.insert("musicbrainz_recording_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_recording_id));
-    object.insert("musicbrainz_track_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_track_id));
-    object.insert("musicbrainz_disc_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_disc_id));
-    object.insert("musicbrainz_release_group_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_release_group_id));
-    object.insert("musicbrainz_work_id"_L1, QJsonValue::fromVariant(cache_item->metadata.musicbrainz_work_id));
-    object.insert("length_nanosec"_L1, QJsonValue::fromVariant(cache_item->metadata.length_nanosec));
-    array.append(QJsonValue::fromVariant(object));
+  transaction.Commit();
+
+  for (qint64 i = 0; i < cache_items.count(); ++i) {
+    cache_items[i]->id = ids[i];
   }
 
-  QJsonObject object;
-  object.insert("tracks"_L1, array);
-  QJsonDocument doc(object);
+  return true;
+
+}
+
+void ScrobblerCache::UpdateState(const ScrobblerCacheItemPtrList &cache_items, const State state) {
 
-  QFile file(filename_);
-  bool result = file.open(QIODevice::WriteOnly | QIODevice::Text);
-  if (!result) {
-    qLog(Error) << "Unable to open scrobbler cache file" << filename_;
-    return;
+  QStringList ids;
+  ids.reserve(cache_items.count());
+  for (ScrobblerCacheItemPtr cache_item : cache_items) {
+    if (cache_item->id != -1) {
+      ids << QString::number(cache_item->id);
+    }
+  }
+  if (ids.isEmpty()) return;
+
+  Database::WriteLocker l(database_);
+  QSqlDatabase db(database_->Connect());
+
+  ScopedTransaction transaction(&db);
+
+  for (qint64 i = 0; i < ids.count(); i += kUpdatesPerQuery) {
+    SqlQuery q(db);
+    q.prepare(u"UPDATE scrobbler_cache SET state = :state WHERE ROWID IN (%1)"_s.arg(ids.mid(i, kUpdatesPerQuery).join(u',')));
+    q.BindIntValue(u":state"_s, static_cast<int>(state));
+    if (!q.Exec()) {
+      database_->ReportErrors(q);
+      return;
+    }
   }
-  QTextStream stream(&file);
-  stream.setEncoding(QStringConverter::Encoding::Utf8);
-  stream << doc.toJson();
-  file.close();
+
+  transaction.Commit();
 
 }
 
@@ -247,9 +407,7 @@ ScrobblerCacheItemPtr ScrobblerCache::Add(const Song &song, const quint64 timest
 
   scrobbler_cache_ << cache_item;
 
-  if (loaded_ && !timer_flush_->isActive()) {
-    timer_flush_->start();
-  }
+  Run([this, cache_item]() { InsertItems(ScrobblerCacheItemPtrList() << cache_item); });
 
   return cache_item;
 
@@ -260,6 +418,9 @@ void ScrobblerCache::Remove(ScrobblerCacheItemPtr cache_item) {
   if (scrobbler_cache_.contains(cache_item)) {
     scrobbler_cache_.removeAll(cache_item);
   }
+
+  Run([this, cache_item]() { UpdateState(ScrobblerCacheItemPtrList() << cache_item, State::Submitted); });
+
 }
 
 void ScrobblerCache::ClearSent(ScrobblerCacheItemPtrList cache_items) {
@@ -276,6 +437,8 @@ void ScrobblerCache::SetError(ScrobblerCacheItemPtrList cache_items) {
     item->error = true;
   }
 
+  Run([this, cache_items]() { UpdateState(cache_items, State::Error); });
+
 }
 
 void ScrobblerCache::Flush(ScrobblerCacheItemPtrList cache_items) {
@@ -286,8 +449,6 @@ void ScrobblerCache::Flush(ScrobblerCacheItemPtrList cache_items) {
     }
   }
 
-  if (!timer_flush_->isActive()) {
-    timer_flush_->start();
-  }
+  Run([this, cache_items]() { UpdateState(cache_items, State::Submitted); });
 
 }
@@ -22,26 +22,37 @@
 
 #include "config.h"
 
-#include <memory>
+#include <functional>
 
 #include <QtGlobal>
 #include <QObject>
 #include <QList>
 #include <QString>
+#include <QThreadPool>
 
+#include "core/shared_ptr.h"
 #include "scrobblercacheitem.h"
 
-class QTimer;
 class Song;
+class Database;
+class SqlQuery;
+
+// Scrobbles are stored in the scrobbler_cache table, one row per scrobble, as soon as they are added.
+// State changes are written in batches from a single worker thread, submitted rows are removed on the next start.
+// The cache is read on the worker thread too, CacheLoaded() is emitted when the stored scrobbles are in the list.
 
 class ScrobblerCache : public QObject {
   Q_OBJECT
 
  public:
-  explicit ScrobblerCache(const QString &filename, QObject *parent);
+  explicit ScrobblerCache(SharedPtr<Database> database, const QString &service, const QString &legacy_filename, QObject *parent);
   ~ScrobblerCache() override;
 
-  void ReadCache();
+  enum class State {
+    Pending = 0,
+    Submitted = 1,
+    Error = 2
+  };
 
   ScrobblerCacheItemPtr Add(const Song &song, const quint64 timestamp);
   void Remove(ScrobblerCacheItemPtr cache_item);
@@ -54,10 +65,24 @@ class ScrobblerCache : public QObject {
  public Q_SLOTS:
   void WriteCache();
 
+ Q_SIGNALS:
+  void CacheLoaded();
+
+ private:
+  void ReadCache();
+  ScrobblerCacheItemPtrList LoadCache();
+  ScrobblerCacheItemPtrList ReadLegacyCache() const;
+  void Compact();
+  void Run(const std::function<void()> &function);
+  bool InsertItems(const ScrobblerCacheItemPtrList &cache_items);
+  void UpdateState(const ScrobblerCacheItemPtrList &cache_items, const State state);
+  static void BindItem(SqlQuery *q, ScrobblerCacheItemPtr cache_item);
+
  private:
-  QTimer *timer_flush_;
-  QString filename_;
-  bool loaded_;
+  SharedPtr<Database> database_;
+  QString service_;
+  QString legacy_filename_;
+  QThreadPool thread_pool_;
   QList<ScrobblerCacheItemPtr> scrobbler_cache_;
 };
 
@@ -25,7 +25,8 @@
 #include "scrobblemetadata.h"
 
 ScrobblerCacheItem::ScrobblerCacheItem(const ScrobbleMetadata &_metadata, const quint64 _timestamp)
-    : metadata(_metadata),
+    : id(-1),
+      metadata(_metadata),
       timestamp(_timestamp),
       sent(false),
       error(false) {}
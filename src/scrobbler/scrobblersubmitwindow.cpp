@@ -0,0 +1,151 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "config.h"
+
+#include <algorithm>
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <QString>
+#include <QDateTime>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+
+#include "core/logging.h"
+#include "scrobblersubmitwindow.h"
+
+namespace {
+constexpr qint64 kDefaultRetryAfterSec = 60;
+constexpr qint64 kMaxRetryAfterSec = 3600;
+}  // namespace
+
+ScrobblerSubmitWindow::ScrobblerSubmitWindow(const int max_in_flight)
+    : max_in_flight_(std::max(1, max_in_flight)),
+      limit_(max_in_flight_),
+      in_flight_(0) {}
+
+bool ScrobblerSubmitWindow::paused() const {
+
+  return paused_until_.isValid() && QDateTime::currentDateTimeUtc() < paused_until_;
+
+}
+
+bool ScrobblerSubmitWindow::CanSend() const {
+
+  return in_flight_ < limit_ && !paused();
+
+}
+
+qint64 ScrobblerSubmitWindow::msec_until_ready() const {
+
+  if (!paused()) return 0;
+
+  return QDateTime::currentDateTimeUtc().msecsTo(paused_until_);
+
+}
+
+QList<ScrobblerCacheItemPtrList> ScrobblerSubmitWindow::NextRequests(const ScrobblerCacheItemPtrList &cache_items, const int batch_size) const {
+
+  QList<ScrobblerCacheItemPtrList> requests;
+  if (paused()) return requests;
+
+  const int available = limit_ - in_flight_;
+  qint64 batch_index = -1;
+  for (ScrobblerCacheItemPtr cache_item : cache_items) {
+    if (cache_item->sent) continue;
+    const bool single = batch_size <= 1 || cache_item->error;
+    if (!single && batch_index != -1 && requests.at(batch_index).count() < batch_size) {
+      requests[batch_index] << cache_item;
+    }
+    else {
+      // Every new request needs room in the window, but the open batch can still take more scrobbles.
+      if (requests.count() >= available) continue;
+      requests << (ScrobblerCacheItemPtrList() << cache_item);
+      if (!single) batch_index = requests.count() - 1;
+    }
+    cache_item->sent = true;
+  }
+
+  return requests;
+
+}
+
+void ScrobblerSubmitWindow::Sent() {
+
+  ++in_flight_;
+
+}
+
+void ScrobblerSubmitWindow::Finished(QNetworkReply *reply, const bool rate_limited) {
+
+  in_flight_ = std::max(0, in_flight_ - 1);
+
+  const int http_code = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+  if (rate_limited || http_code == 429 || http_code == 503) {
+    qint64 retry_after = 0;
+    if (reply->hasRawHeader("Retry-After")) {
+      const QByteArray value = reply->rawHeader("Retry-After").trimmed();
+      bool ok = false;
+      retry_after = value.toLongLong(&ok);
+      if (!ok) {
+        const QDateTime date = QDateTime::fromString(QString::fromLatin1(value), Qt::RFC2822Date);
+        retry_after = date.isValid() ? QDateTime::currentDateTimeUtc().secsTo(date) : 0;
+      }
+    }
+    else if (reply->hasRawHeader("X-RateLimit-Reset-In")) {
+      retry_after = reply->rawHeader("X-RateLimit-Reset-In").trimmed().toLongLong();
+    }
+    RateLimited(retry_after);
+    return;
+  }
+
+  if (reply->error() == QNetworkReply::NoError && limit_ < max_in_flight_) {
+    ++limit_;
+  }
+
+  if (reply->hasRawHeader("X-RateLimit-Remaining") && reply->hasRawHeader("X-RateLimit-Reset-In")) {
+    const qint64 remaining = reply->rawHeader("X-RateLimit-Remaining").trimmed().toLongLong();
+    if (remaining <= in_flight_) {
+      PauseFor(reply->rawHeader("X-RateLimit-Reset-In").trimmed().toLongLong());
+    }
+  }
+
+}
+
+void ScrobblerSubmitWindow::RateLimited(const qint64 seconds) {
+
+  limit_ = std::max(1, limit_ / 2);
+  PauseFor(seconds > 0 ? seconds : kDefaultRetryAfterSec);
+
+}
+
+void ScrobblerSubmitWindow::PauseFor(const qint64 seconds) {
+
+  if (seconds <= 0) return;
+
+  const QDateTime paused_until = QDateTime::currentDateTimeUtc().addSecs(std::min(seconds, kMaxRetryAfterSec));
+  if (!paused_until_.isValid() || paused_until > paused_until_) {
+    paused_until_ = paused_until;
+    qLog(Debug) << "Scrobble submission paused for" << seconds << "seconds, allowing" << limit_ << "requests in flight.";
+  }
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef SCROBBLERSUBMITWINDOW_H
+#define SCROBBLERSUBMITWINDOW_H
+
+#include "config.h"
+
+#include <QtGlobal>
+#include <QList>
+#include <QDateTime>
+
+#include "scrobblercacheitem.h"
+
+class QNetworkReply;
+
+// Keeps track of the scrobble requests in flight for a service.
+// The window grows by one request for each successful reply up to the maximum, and is halved when the server asks us to slow down.
+// Rate limit headers (Retry-After, X-RateLimit-Remaining and X-RateLimit-Reset-In) pause the submission until the server is ready again.
+
+class ScrobblerSubmitWindow {
+
+ public:
+  explicit ScrobblerSubmitWindow(const int max_in_flight);
+
+  bool CanSend() const;
+  int in_flight() const { return in_flight_; }
+  int limit() const { return limit_; }
+  bool paused() const;
+  qint64 msec_until_ready() const;
+
+  // Picks the scrobbles for the requests that fit in the window and marks them as sent.
+  // Up to batch_size scrobbles go in each request, scrobbles that failed before get a request of their own.
+  QList<ScrobblerCacheItemPtrList> NextRequests(const ScrobblerCacheItemPtrList &cache_items, const int batch_size) const;
+
+  void Sent();
+  // The reply is rate limited if the HTTP status says so or if the service reported it in the reply body.
+  void Finished(QNetworkReply *reply, const bool rate_limited = false);
+  void RateLimited(const qint64 seconds = 0);
+
+ private:
+  void PauseFor(const qint64 seconds);
+
+ private:
+  int max_in_flight_;
+  int limit_;
+  int in_flight_;
+  QDateTime paused_until_;
+};
+
+#endif  // SCROBBLERSUBMITWINDOW_H
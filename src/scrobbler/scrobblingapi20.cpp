@@ -47,6 +47,7 @@
 
 #include "core/shared_ptr.h"
 #include "core/networkaccessmanager.h"
+#include "core/database.h"
 #include "core/song.h"
 #include "core/logging.h"
 #include "core/settings.h"
@@ -68,9 +69,10 @@ const char *ScrobblingAPI20::kApiKey = "211990b4c96782c05d1536e7219eb56e";
 namespace {
 constexpr char kSecret[] = "80fd738f49596e9709b1bf9319c444a8";
 constexpr int kScrobblesPerRequest = 50;
+constexpr int kMaxRequestsInFlight = 4;
 }
 
-ScrobblingAPI20::ScrobblingAPI20(const QString &name, const QString &settings_group, const QString &auth_url, const QString &api_url, const bool batch, const QString &cache_file, SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent)
+ScrobblingAPI20::ScrobblingAPI20(const QString &name, const QString &settings_group, const QString &auth_url, const QString &api_url, const bool batch, const QString &cache_file, SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent)
     : ScrobblerService(name, settings, parent),
       name_(name),
       settings_group_(settings_group),
@@ -78,18 +80,19 @@ ScrobblingAPI20::ScrobblingAPI20(const QString &name, const QString &settings_gr
       api_url_(api_url),
       batch_(batch),
       network_(network),
-      cache_(new ScrobblerCache(cache_file, this)),
+      cache_(new ScrobblerCache(database, name, cache_file, this)),
       server_(nullptr),
       enabled_(false),
       prefer_albumartist_(false),
       subscriber_(false),
-      submitted_(false),
+      submit_window_(kMaxRequestsInFlight),
       scrobbled_(false),
       timestamp_(0),
       submit_error_(false) {
 
   timer_submit_.setSingleShot(true);
   QObject::connect(&timer_submit_, &QTimer::timeout, this, &ScrobblingAPI20::Submit);
+  QObject::connect(cache_, &ScrobblerCache::CacheLoaded, this, [this]() { StartSubmit(); });
 
   ScrobblingAPI20::ReloadSettings();
   LoadSession();
@@ -180,6 +183,9 @@ ScrobblingAPI20::ReplyResult ScrobblingAPI20::GetJsonObject(QNetworkReply *reply
       reply_error_type = ReplyResult::APIError;
     }
     const ScrobbleErrorCode lastfm_error_code = static_cast<ScrobbleErrorCode>(error_code);
+    if (lastfm_error_code == ScrobbleErrorCode::RateLimitExceeded) {
+      reply_error_type = ReplyResult::RateLimited;
+    }
     if (reply->error() == QNetworkReply::AuthenticationRequiredError ||
         lastfm_error_code == ScrobbleErrorCode::InvalidSessionKey ||
         lastfm_error_code == ScrobbleErrorCode::UnauthorizedToken ||
@@ -472,7 +478,7 @@ void ScrobblingAPI20::Scrobble(const Song &song) {
 
 void ScrobblingAPI20::StartSubmit(const bool initial) {
 
-  if (!submitted_ && cache_->Count() > 0) {
+  if (!submitted() && cache_->Count() > 0) {
     if (initial && (!batch_ || settings_->submit_delay() <= 0) && !submit_error_) {
       if (timer_submit_.isActive()) {
         timer_submit_.stop();
@@ -494,19 +500,31 @@ void ScrobblingAPI20::Submit() {
 
   qLog(Debug) << name_ << "Submitting scrobbles.";
 
+  // Keep up to kMaxRequestsInFlight requests going at the same time.
+  // Scrobbles that failed as part of a batch are retried one by one, so a single bad scrobble does not hold back the rest.
+  const QList<ScrobblerCacheItemPtrList> requests = submit_window_.NextRequests(cache_->List(), batch_ ? kScrobblesPerRequest : 1);
+  for (const ScrobblerCacheItemPtrList &cache_items : requests) {
+    if (!batch_ || cache_items.first()->error) {
+      SendSingleScrobble(cache_items.first());
+    }
+    else {
+      SendScrobbles(cache_items);
+    }
+  }
+
+  if (submit_window_.paused() && !timer_submit_.isActive()) {
+    timer_submit_.setInterval(static_cast<int>(submit_window_.msec_until_ready()));
+    timer_submit_.start();
+  }
+
+}
+
+void ScrobblingAPI20::SendScrobbles(const ScrobblerCacheItemPtrList &cache_items) {
+
   ParamList params = ParamList() << Param(u"method"_s, u"track.scrobble"_s);
 
   int i = 0;
-  const ScrobblerCacheItemPtrList all_cache_items = cache_->List();
-  ScrobblerCacheItemPtrList cache_items_sent;
-  for (ScrobblerCacheItemPtr cache_item : all_cache_items) {
-    if (cache_item->sent) continue;
-    cache_item->sent = true;
-    if (!batch_) {
-      SendSingleScrobble(cache_item);
-      continue;
-    }
-    cache_items_sent << cache_item;
+  for (ScrobblerCacheItemPtr cache_item : cache_items) {
     params << Param(u"%1[%2]"_s.arg(u"artist"_s).arg(i), prefer_albumartist_ ? cache_item->metadata.effective_albumartist() : cache_item->metadata.artist);
     params << Param(u"%1[%2]"_s.arg(u"track"_s).arg(i), StripTitle(cache_item->metadata.title));
     params << Param(u"%1[%2]"_s.arg(u"timestamp"_s).arg(i), QString::number(cache_item->timestamp));
@@ -521,15 +539,24 @@ void ScrobblingAPI20::Submit() {
       params << Param(u"%1[%2]"_s.arg("trackNumber"_L1).arg(i), QString::number(cache_item->metadata.track));
     }
     ++i;
-    if (cache_items_sent.count() >= kScrobblesPerRequest) break;
   }
 
-  if (!batch_ || cache_items_sent.count() <= 0) return;
-
-  submitted_ = true;
+  submit_window_.Sent();
 
   QNetworkReply *reply = CreateRequest(params);
-  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cache_items_sent]() { ScrobbleRequestFinished(reply, cache_items_sent); });
+  QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, cache_items]() { ScrobbleRequestFinished(reply, cache_items); });
+
+}
+
+void ScrobblingAPI20::ContinueSubmit() {
+
+  // Keep going right away while the server accepts scrobbles, back off to the submit timer after an error.
+  if (submit_error_) {
+    StartSubmit();
+  }
+  else {
+    Submit();
+  }
 
 }
 
@@ -540,12 +567,16 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
   QObject::disconnect(reply, nullptr, this, nullptr);
   reply->deleteLater();
 
-  submitted_ = false;
-
   QJsonObject json_obj;
   QString error_message;
-  if (GetJsonObject(reply, json_obj, error_message) != ReplyResult::Success) {
+  const ReplyResult reply_result = GetJsonObject(reply, json_obj, error_message);
+  submit_window_.Finished(reply, reply_result == ReplyResult::RateLimited);
+  if (reply_result != ReplyResult::Success) {
     Error(error_message);
+    if (reply_result == ReplyResult::APIError && !submit_window_.paused()) {
+      // The server rejected the batch, send the scrobbles one by one to find the bad one.
+      cache_->SetError(cache_items);
+    }
     cache_->ClearSent(cache_items);
     submit_error_ = true;
     StartSubmit();
@@ -557,43 +588,43 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
 
   if (!json_obj.contains("scrobbles"_L1)) {
     Error(u"Json reply from server is missing scrobbles."_s, json_obj);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
 
   QJsonValue value_scrobbles = json_obj["scrobbles"_L1];
   if (!value_scrobbles.isObject()) {
     Error(u"Json scrobbles is not an object."_s, json_obj);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
   json_obj = value_scrobbles.toObject();
   if (json_obj.isEmpty()) {
     Error(u"Json scrobbles object is empty."_s, value_scrobbles);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
   if (!json_obj.contains("@attr"_L1) || !json_obj.contains("scrobble"_L1)) {
     Error(u"Json scrobbles object is missing values."_s, json_obj);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
 
   QJsonValue value_attr = json_obj["@attr"_L1];
   if (!value_attr.isObject()) {
     Error(u"Json scrobbles attr is not an object."_s, value_attr);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
   QJsonObject obj_attr = value_attr.toObject();
   if (obj_attr.isEmpty()) {
     Error(u"Json scrobbles attr is empty."_s, value_attr);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
   if (!obj_attr.contains("accepted"_L1) || !obj_attr.contains("ignored"_L1)) {
     Error(u"Json scrobbles attr is missing values."_s, obj_attr);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
   int accepted = obj_attr["accepted"_L1].toInt();
@@ -623,7 +654,7 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
   }
   else {
     Error(u"Json scrobbles scrobble is not an object or array."_s, value_scrobble);
-    StartSubmit();
+    ContinueSubmit();
     return;
   }
 
@@ -689,7 +720,7 @@ void ScrobblingAPI20::ScrobbleRequestFinished(QNetworkReply *reply, ScrobblerCac
 
  }
 
-  StartSubmit();
+  ContinueSubmit();
 
 }
 
@@ -712,6 +743,8 @@ void ScrobblingAPI20::SendSingleScrobble(ScrobblerCacheItemPtr item) {
     params << Param(u"trackNumber"_s, QString::number(item->metadata.track));
   }
 
+  submit_window_.Sent();
+
   QNetworkReply *reply = CreateRequest(params);
   QObject::connect(reply, &QNetworkReply::finished, this, [this, reply, item]() { SingleScrobbleRequestFinished(reply, item); });
 
@@ -726,19 +759,27 @@ void ScrobblingAPI20::SingleScrobbleRequestFinished(QNetworkReply *reply, Scrobb
 
   QJsonObject json_obj;
   QString error_message;
-  if (GetJsonObject(reply, json_obj, error_message) != ReplyResult::Success) {
+  const ReplyResult reply_result = GetJsonObject(reply, json_obj, error_message);
+  submit_window_.Finished(reply, reply_result == ReplyResult::RateLimited);
+  if (reply_result != ReplyResult::Success) {
     Error(error_message);
     cache_item->sent = false;
+    submit_error_ = true;
+    StartSubmit();
     return;
   }
 
   if (!json_obj.contains("scrobbles"_L1)) {
     Error(u"Json reply from server is missing scrobbles."_s, json_obj);
     cache_item->sent = false;
+    submit_error_ = true;
+    StartSubmit();
     return;
   }
 
   cache_->Remove(cache_item);
+  submit_error_ = false;
+  ContinueSubmit();
 
   QJsonValue value_scrobbles = json_obj["scrobbles"_L1];
   if (!value_scrobbles.isObject()) {
@@ -35,18 +35,20 @@
 #include "scrobblerservice.h"
 #include "scrobblercache.h"
 #include "scrobblercacheitem.h"
+#include "scrobblersubmitwindow.h"
 
 class QNetworkReply;
 
 class ScrobblerSettings;
 class NetworkAccessManager;
+class Database;
 class LocalRedirectServer;
 
 class ScrobblingAPI20 : public ScrobblerService {
   Q_OBJECT
 
  public:
-  explicit ScrobblingAPI20(const QString &name, const QString &settings_group, const QString &auth_url, const QString &api_url, const bool batch, const QString &cache_file, SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, QObject *parent = nullptr);
+  explicit ScrobblingAPI20(const QString &name, const QString &settings_group, const QString &auth_url, const QString &api_url, const bool batch, const QString &cache_file, SharedPtr<ScrobblerSettings> settings, SharedPtr<NetworkAccessManager> network, SharedPtr<Database> database, QObject *parent = nullptr);
   ~ScrobblingAPI20() override;
 
   static const char *kApiKey;
@@ -57,7 +59,7 @@ class ScrobblingAPI20 : public ScrobblerService {
   bool enabled() const override { return enabled_; }
   bool authenticated() const override { return !username_.isEmpty() && !session_key_.isEmpty(); }
   bool subscriber() const { return subscriber_; }
-  bool submitted() const override { return submitted_; }
+  bool submitted() const override { return submit_window_.in_flight() > 0; }
   QString username() const { return username_; }
 
   void Authenticate();
@@ -86,7 +88,8 @@ class ScrobblingAPI20 : public ScrobblerService {
   enum class ReplyResult {
     Success,
     ServerError,
-    APIError
+    APIError,
+    RateLimited
   };
 
   enum class ScrobbleErrorCode {
@@ -125,7 +128,9 @@ class ScrobblingAPI20 : public ScrobblerService {
 
   void RequestSession(const QString &token);
   void AuthError(const QString &error);
+  void SendScrobbles(const ScrobblerCacheItemPtrList &cache_items);
   void SendSingleScrobble(ScrobblerCacheItemPtr item);
+  void ContinueSubmit();
   void Error(const QString &error, const QVariant &debug = QVariant());
   static QString ErrorString(const ScrobbleErrorCode error);
   void StartSubmit(const bool initial = false) override;
@@ -149,7 +154,7 @@ class ScrobblingAPI20 : public ScrobblerService {
   QString username_;
   QString session_key_;
 
-  bool submitted_;
+  ScrobblerSubmitWindow submit_window_;
   Song song_playing_;
   bool scrobbled_;
   quint64 timestamp_;
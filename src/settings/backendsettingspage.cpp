@@ -61,6 +61,7 @@ const char *BackendSettingsPage::kSettingsGroup = "Backend";
 const qint64 BackendSettingsPage::kDefaultBufferDuration = 4000;
 const double BackendSettingsPage::kDefaultBufferLowWatermark = 0.33;
 const double BackendSettingsPage::kDefaultBufferHighWatermark = 0.99;
+const int BackendSettingsPage::kDefaultNetworkCacheSize = 128;
 
 namespace {
 constexpr char kOutputAutomaticallySelect[] = "Automatically select";
@@ -104,6 +105,7 @@ BackendSettingsPage::BackendSettingsPage(SettingsDialog *dialog, QWidget *parent
   QObject::connect(ui_->checkbox_fadeout_cross, &QCheckBox::toggled, this, &BackendSettingsPage::FadingOptionsChanged);
   QObject::connect(ui_->checkbox_fadeout_auto, &QCheckBox::toggled, this, &BackendSettingsPage::FadingOptionsChanged);
   QObject::connect(ui_->checkbox_channels, &QCheckBox::toggled, ui_->widget_channels, &QSpinBox::setEnabled);
+  QObject::connect(ui_->checkbox_network_cache, &QCheckBox::toggled, ui_->spinbox_network_cache_size, &QSpinBox::setEnabled);
   QObject::connect(ui_->button_buffer_defaults, &QPushButton::clicked, this, &BackendSettingsPage::BufferDefaults);
 
 #ifdef Q_OS_WIN32
@@ -185,6 +187,9 @@ void BackendSettingsPage::Load() {
   ui_->spinbox_bufferduration->setValue(s.value("bufferduration", kDefaultBufferDuration).toInt());
   ui_->spinbox_low_watermark->setValue(s.value("bufferlowwatermark", kDefaultBufferLowWatermark).toDouble());
   ui_->spinbox_high_watermark->setValue(s.value("bufferhighwatermark", kDefaultBufferHighWatermark).toDouble());
+  ui_->checkbox_network_cache->setChecked(s.value("network_cache", false).toBool());
+  ui_->spinbox_network_cache_size->setValue(s.value("network_cache_size", kDefaultNetworkCacheSize).toInt());
+  ui_->spinbox_network_cache_size->setEnabled(ui_->checkbox_network_cache->isChecked());
 
   ui_->radiobutton_replaygain->setChecked(s.value("rgenabled", false).toBool());
   ui_->combobox_replaygainmode->setCurrentIndex(s.value("rgmode", 0).toInt());
@@ -519,6 +524,8 @@ void BackendSettingsPage::Save() {
   s.setValue("bufferduration", ui_->spinbox_bufferduration->value());
   s.setValue("bufferlowwatermark", ui_->spinbox_low_watermark->value());
   s.setValue("bufferhighwatermark", ui_->spinbox_high_watermark->value());
+  s.setValue("network_cache", ui_->checkbox_network_cache->isChecked());
+  s.setValue("network_cache_size", ui_->spinbox_network_cache_size->value());
 
   s.setValue("rgenabled", ui_->radiobutton_replaygain->isChecked());
   s.setValue("rgmode", ui_->combobox_replaygainmode->currentIndex());
@@ -865,5 +872,7 @@ void BackendSettingsPage::BufferDefaults() {
   ui_->spinbox_bufferduration->setValue(kDefaultBufferDuration);
   ui_->spinbox_low_watermark->setValue(kDefaultBufferLowWatermark);
   ui_->spinbox_high_watermark->setValue(kDefaultBufferHighWatermark);
+  ui_->checkbox_network_cache->setChecked(false);
+  ui_->spinbox_network_cache_size->setValue(kDefaultNetworkCacheSize);
 
 }
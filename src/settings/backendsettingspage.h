@@ -47,6 +47,7 @@ class BackendSettingsPage : public SettingsPage {
   static const qint64 kDefaultBufferDuration;
   static const double kDefaultBufferLowWatermark;
   static const double kDefaultBufferHighWatermark;
+  static const int kDefaultNetworkCacheSize;
 
   void Load() override;
   void Save() override;
@@ -24,17 +24,21 @@
 #include <QDataStream>
 #include <QByteArray>
 #include <QString>
+#include <QHash>
 
 #include "playlistquerygenerator.h"
 #include "collection/collectionbackend.h"
 
-PlaylistQueryGenerator::PlaylistQueryGenerator(QObject *parent) : PlaylistGenerator(parent), dynamic_(false), current_pos_(0) {}
+PlaylistQueryGenerator::PlaylistQueryGenerator(QObject *parent) : PlaylistGenerator(parent), dynamic_(false), current_pos_(0), sampler_generation_(0), sampler_statistics_generation_(0) {}
 
 PlaylistQueryGenerator::PlaylistQueryGenerator(const QString &name, const SmartPlaylistSearch &search, const bool dynamic, QObject *parent)
     : PlaylistGenerator(parent),
       search_(search),
       dynamic_(dynamic),
-      current_pos_(0) {
+      current_pos_(0),
+      sampler_(SamplerWeight(search.sort_type_)),
+      sampler_generation_(0),
+      sampler_statistics_generation_(0) {
 
   set_name(name);
 
@@ -45,6 +49,8 @@ void PlaylistQueryGenerator::Load(const SmartPlaylistSearch &search) {
   search_ = search;
   dynamic_ = false;
   current_pos_ = 0;
+  sampler_.Clear();
+  sampler_.set_weight(SamplerWeight(search_.sort_type_));
 
 }
 
@@ -54,6 +60,9 @@ void PlaylistQueryGenerator::Load(const QByteArray &data) {
   s >> search_;
   s >> dynamic_;
 
+  sampler_.Clear();
+  sampler_.set_weight(SamplerWeight(search_.sort_type_));
+
 }
 
 QByteArray PlaylistQueryGenerator::Save() const {
@@ -77,16 +86,18 @@ PlaylistItemPtrList PlaylistQueryGenerator::Generate() {
 
 PlaylistItemPtrList PlaylistQueryGenerator::GenerateMore(const int count) {
 
+  if (search_.is_random()) {
+    return GenerateRandom(count > 0 ? count : search_.limit_);
+  }
+
   SmartPlaylistSearch search_copy = search_;
   search_copy.id_not_in_ = previous_ids_;
   if (count > 0) {
     search_copy.limit_ = count;
   }
 
-  if (search_copy.sort_type_ != SmartPlaylistSearch::SortType::Random) {
-    search_copy.first_item_ = current_pos_;
-    current_pos_ += search_copy.limit_;
-  }
+  search_copy.first_item_ = current_pos_;
+  current_pos_ += search_copy.limit_;
 
   const SongList songs = collection_backend_->SmartPlaylistsFindSongs(search_copy);
   PlaylistItemPtrList items;
@@ -103,3 +114,55 @@ PlaylistItemPtrList PlaylistQueryGenerator::GenerateMore(const int count) {
   return items;
 
 }
+
+PlaylistItemPtrList PlaylistQueryGenerator::GenerateRandom(const int count) {
+
+  // Read the generations before the query, so changes made while the query runs invalidate the candidates next time.
+  // Play statistics change all the time, so they only invalidate the candidates when the search depends on them.
+  const quint64 generation = collection_backend_->songs_generation();
+  const quint64 statistics_generation = search_.uses_statistics() ? collection_backend_->statistics_generation() : 0;
+  if (!sampler_.is_loaded() || sampler_generation_ != generation || sampler_statistics_generation_ != statistics_generation) {
+    sampler_.SetCandidates(collection_backend_->SmartPlaylistsFindCandidates(search_));
+    sampler_generation_ = generation;
+    sampler_statistics_generation_ = statistics_generation;
+  }
+
+  const QList<int> ids = sampler_.Sample(count, previous_ids_);
+  if (ids.isEmpty()) return PlaylistItemPtrList();
+
+  QHash<int, Song> songs;
+  const SongList songs_list = collection_backend_->GetSongsById(ids);
+  for (const Song &song : songs_list) {
+    songs.insert(song.id(), song);
+  }
+
+  PlaylistItemPtrList items;
+  items.reserve(ids.count());
+  for (const int id : ids) {
+    if (!songs.contains(id)) continue;
+    items << PlaylistItem::NewFromSong(songs.value(id));
+    previous_ids_ << id;
+
+    if (previous_ids_.count() > GetDynamicFuture() + GetDynamicHistory()) {
+      previous_ids_.removeFirst();
+    }
+  }
+
+  return items;
+
+}
+
+SmartPlaylistSampler::Weight PlaylistQueryGenerator::SamplerWeight(const SmartPlaylistSearch::SortType sort_type) {
+
+  switch (sort_type) {
+    case SmartPlaylistSearch::SortType::RandomByRating:
+      return SmartPlaylistSampler::Weight::Rating;
+    case SmartPlaylistSearch::SortType::RandomByPlayCount:
+      return SmartPlaylistSampler::Weight::PlayCount;
+    case SmartPlaylistSearch::SortType::RandomBySkipCount:
+      return SmartPlaylistSampler::Weight::SkipCount;
+    default:
+      return SmartPlaylistSampler::Weight::None;
+  }
+
+}
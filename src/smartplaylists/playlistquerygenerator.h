@@ -29,6 +29,7 @@
 
 #include "playlistgenerator.h"
 #include "smartplaylistsearch.h"
+#include "smartplaylistsampler.h"
 
 class PlaylistQueryGenerator : public PlaylistGenerator {
   Q_OBJECT
@@ -51,12 +52,21 @@ class PlaylistQueryGenerator : public PlaylistGenerator {
   SmartPlaylistSearch search() const { return search_; }
   int GetDynamicFuture() override { return search_.limit_; }
 
+ private:
+  PlaylistItemPtrList GenerateRandom(const int count);
+  static SmartPlaylistSampler::Weight SamplerWeight(const SmartPlaylistSearch::SortType sort_type);
+
  private:
   SmartPlaylistSearch search_;
   bool dynamic_;
 
   QList<int> previous_ids_;
   int current_pos_;
+
+  // Songs matching the search, loaded once and reloaded when the collection changes.
+  SmartPlaylistSampler sampler_;
+  quint64 sampler_generation_;
+  quint64 sampler_statistics_generation_;
 };
 
 #endif  // PLAYLISTQUERYGENERATOR_H
@@ -0,0 +1,37 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SMARTPLAYLISTCANDIDATE_H
+#define SMARTPLAYLISTCANDIDATE_H
+
+#include "config.h"
+
+#include <QList>
+
+// A song matching a smart playlist search, with the fields used to weight random draws.
+struct SmartPlaylistCandidate {
+  SmartPlaylistCandidate() : id(-1), rating(-1.0F), playcount(0), skipcount(0) {}
+  int id;
+  float rating;
+  int playcount;
+  int skipcount;
+};
+using SmartPlaylistCandidateList = QList<SmartPlaylistCandidate>;
+
+#endif  // SMARTPLAYLISTCANDIDATE_H
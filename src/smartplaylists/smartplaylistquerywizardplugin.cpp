@@ -114,6 +114,7 @@ int SmartPlaylistQueryWizardPlugin::CreatePages(QWizard *wizard, int finish_page
   QObject::connect(sort_ui_->limit_value, QOverload<int>::of(&QSpinBox::valueChanged), this, &SmartPlaylistQueryWizardPlugin::UpdateSortPreview);
   QObject::connect(sort_ui_->order, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SmartPlaylistQueryWizardPlugin::UpdateSortPreview);
   QObject::connect(sort_ui_->random, &QRadioButton::toggled, this, &SmartPlaylistQueryWizardPlugin::UpdateSortPreview);
+  QObject::connect(sort_ui_->random_weight, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SmartPlaylistQueryWizardPlugin::UpdateSortPreview);
 
   // Configure the page text
   search_page_->setTitle(tr("Search terms"));
@@ -147,8 +148,22 @@ void SmartPlaylistQueryWizardPlugin::SetGenerator(PlaylistGeneratorPtr g) {
   }
 
   // Sort order
-  if (search.sort_type_ == SmartPlaylistSearch::SortType::Random) {
+  if (search.is_random()) {
     sort_ui_->random->setChecked(true);
+    switch (search.sort_type_) {
+      case SmartPlaylistSearch::SortType::RandomByRating:
+        sort_ui_->random_weight->setCurrentIndex(1);
+        break;
+      case SmartPlaylistSearch::SortType::RandomByPlayCount:
+        sort_ui_->random_weight->setCurrentIndex(2);
+        break;
+      case SmartPlaylistSearch::SortType::RandomBySkipCount:
+        sort_ui_->random_weight->setCurrentIndex(3);
+        break;
+      default:
+        sort_ui_->random_weight->setCurrentIndex(0);
+        break;
+    }
   }
   else {
     sort_ui_->field->setChecked(true);
@@ -255,7 +270,20 @@ SmartPlaylistSearch SmartPlaylistQueryWizardPlugin::MakeSearch() const {
 
   // Sort order
   if (sort_ui_->random->isChecked()) {
-    ret.sort_type_ = SmartPlaylistSearch::SortType::Random;
+    switch (sort_ui_->random_weight->currentIndex()) {
+      case 1:
+        ret.sort_type_ = SmartPlaylistSearch::SortType::RandomByRating;
+        break;
+      case 2:
+        ret.sort_type_ = SmartPlaylistSearch::SortType::RandomByPlayCount;
+        break;
+      case 3:
+        ret.sort_type_ = SmartPlaylistSearch::SortType::RandomBySkipCount;
+        break;
+      default:
+        ret.sort_type_ = SmartPlaylistSearch::SortType::Random;
+        break;
+    }
   }
   else {
     const bool ascending = sort_ui_->order->currentIndex() == 0;
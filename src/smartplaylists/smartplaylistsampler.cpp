@@ -0,0 +1,172 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <random>
+#include <limits>
+
+#include <QList>
+#include <QHash>
+#include <QBitArray>
+
+#include "smartplaylistsampler.h"
+
+namespace {
+// Number of rejected draws per requested song before falling back to a pass over the remaining candidates.
+constexpr int kMaxRejectedDrawsPerSong = 8;
+constexpr double kUnratedWeight = 0.5;
+constexpr double kMinimumRatingWeight = 0.05;
+}  // namespace
+
+SmartPlaylistSampler::SmartPlaylistSampler(const Weight weight) : weight_(weight), loaded_(false), random_(std::random_device()()) {}
+
+void SmartPlaylistSampler::set_weight(const Weight weight) {
+
+  if (weight == weight_) return;
+
+  weight_ = weight;
+  UpdateWeights();
+
+}
+
+void SmartPlaylistSampler::SetCandidates(const CandidateList &candidates) {
+
+  candidates_ = candidates;
+
+  index_.clear();
+  index_.reserve(candidates_.count());
+  for (qint64 i = 0; i < candidates_.count(); ++i) {
+    index_.insert(candidates_[i].id, i);
+  }
+
+  UpdateWeights();
+
+  loaded_ = true;
+
+}
+
+void SmartPlaylistSampler::Clear() {
+
+  candidates_.clear();
+  index_.clear();
+  cumulative_weights_.clear();
+  loaded_ = false;
+
+}
+
+double SmartPlaylistSampler::CandidateWeight(const Candidate &candidate) const {
+
+  switch (weight_) {
+    case Weight::None:
+      return 1.0;
+    case Weight::Rating:
+      return kMinimumRatingWeight + (candidate.rating < 0.0F ? kUnratedWeight : static_cast<double>(candidate.rating));
+    case Weight::PlayCount:
+      return 1.0 + std::max(0, candidate.playcount);
+    case Weight::SkipCount:
+      return 1.0 / (1.0 + std::max(0, candidate.skipcount));
+  }
+
+  return 1.0;
+
+}
+
+void SmartPlaylistSampler::UpdateWeights() {
+
+  cumulative_weights_.clear();
+  cumulative_weights_.reserve(candidates_.count());
+
+  double total = 0.0;
+  for (const Candidate &candidate : std::as_const(candidates_)) {
+    total += CandidateWeight(candidate);
+    cumulative_weights_ << total;
+  }
+
+}
+
+QList<int> SmartPlaylistSampler::Sample(const int count, const QList<int> &exclude_ids) {
+
+  QList<int> ids;
+  if (candidates_.isEmpty() || count == 0) return ids;
+
+  QBitArray excluded(static_cast<qsizetype>(candidates_.count()));
+  for (const int id : exclude_ids) {
+    const qint64 index = index_.value(id, -1);
+    if (index != -1) excluded.setBit(static_cast<qsizetype>(index));
+  }
+  const qint64 available = candidates_.count() - excluded.count(true);
+  if (available <= 0) return ids;
+
+  // When most of the candidates are wanted anyway, a single pass over them is cheaper than drawing one by one.
+  if (count < 0 || count * 2 >= available) {
+    return SampleRemaining(count, excluded);
+  }
+
+  ids.reserve(count);
+
+  std::uniform_real_distribution<double> distribution(0.0, cumulative_weights_.constLast());
+  int rejected = 0;
+  while (ids.count() < count && rejected < count * kMaxRejectedDrawsPerSong) {
+    const double value = distribution(random_);
+    const qint64 index = std::min(static_cast<qint64>(std::upper_bound(cumulative_weights_.constBegin(), cumulative_weights_.constEnd(), value) - cumulative_weights_.constBegin()), static_cast<qint64>(candidates_.count() - 1));
+    if (excluded.testBit(static_cast<qsizetype>(index))) {
+      ++rejected;
+      continue;
+    }
+    excluded.setBit(static_cast<qsizetype>(index));
+    ids << candidates_[index].id;
+  }
+
+  if (ids.count() < count) {
+    ids << SampleRemaining(count - static_cast<int>(ids.count()), excluded);
+  }
+
+  return ids;
+
+}
+
+QList<int> SmartPlaylistSampler::SampleRemaining(const int count, QBitArray &excluded) {
+
+  // Weighted random order of the candidates that are left (Efraimidis and Spirakis): the candidates with the largest log(u) / weight win.
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  QList<std::pair<double, qint64>> keys;
+  keys.reserve(candidates_.count() - excluded.count(true));
+  for (qint64 i = 0; i < candidates_.count(); ++i) {
+    if (excluded.testBit(static_cast<qsizetype>(i))) continue;
+    const double u = std::max(distribution(random_), std::numeric_limits<double>::min());
+    keys << std::make_pair(std::log(u) / CandidateWeight(candidates_[i]), i);
+  }
+
+  const qint64 wanted = count < 0 ? keys.count() : std::min(static_cast<qint64>(count), static_cast<qint64>(keys.count()));
+  std::partial_sort(keys.begin(), keys.begin() + wanted, keys.end(), [](const std::pair<double, qint64> &a, const std::pair<double, qint64> &b) { return a.first > b.first; });
+
+  QList<int> ids;
+  ids.reserve(wanted);
+  for (qint64 i = 0; i < wanted; ++i) {
+    excluded.setBit(static_cast<qsizetype>(keys[i].second));
+    ids << candidates_[keys[i].second].id;
+  }
+
+  return ids;
+
+}
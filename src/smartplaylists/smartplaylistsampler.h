@@ -0,0 +1,78 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SMARTPLAYLISTSAMPLER_H
+#define SMARTPLAYLISTSAMPLER_H
+
+#include "config.h"
+
+#include <random>
+
+#include <QList>
+#include <QHash>
+#include <QBitArray>
+
+#include "smartplaylistcandidate.h"
+
+// Draws random song IDs from the result of a smart playlist search without going back to the database.
+// The candidates are loaded once, and each draw skips the excluded IDs using a bitmap over the candidate list.
+// Draws can be weighted by rating, play count or skip count.
+
+class SmartPlaylistSampler {
+
+ public:
+  enum class Weight {
+    None,
+    Rating,
+    PlayCount,
+    SkipCount
+  };
+
+  using Candidate = SmartPlaylistCandidate;
+  using CandidateList = SmartPlaylistCandidateList;
+
+  explicit SmartPlaylistSampler(const Weight weight = Weight::None);
+
+  Weight weight() const { return weight_; }
+  void set_weight(const Weight weight);
+
+  void SetCandidates(const CandidateList &candidates);
+  void Clear();
+
+  bool is_loaded() const { return loaded_; }
+  qint64 count() const { return candidates_.count(); }
+
+  // Returns up to count IDs not in exclude_ids, or all of them in random order if count is -1.
+  QList<int> Sample(const int count, const QList<int> &exclude_ids);
+
+ private:
+  double CandidateWeight(const Candidate &candidate) const;
+  void UpdateWeights();
+  QList<int> SampleRemaining(const int count, QBitArray &excluded);
+
+ private:
+  Weight weight_;
+  bool loaded_;
+  CandidateList candidates_;
+  QHash<int, qint64> index_;
+  QList<double> cumulative_weights_;
+  std::mt19937 random_;
+};
+
+#endif  // SMARTPLAYLISTSAMPLER_H
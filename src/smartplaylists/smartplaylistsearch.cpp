@@ -20,6 +20,8 @@
 
 #include "config.h"
 
+#include <algorithm>
+
 #include <QString>
 #include <QStringList>
 #include <QDataStream>
@@ -51,16 +53,34 @@ void SmartPlaylistSearch::Reset() {
 
 }
 
-QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
+bool SmartPlaylistSearch::is_random() const {
 
-  QString sql = QStringLiteral("SELECT %1 FROM %2").arg(Song::kRowIdColumnSpec, songs_table);
+  return sort_type_ == SortType::Random || sort_type_ == SortType::RandomByRating || sort_type_ == SortType::RandomByPlayCount || sort_type_ == SortType::RandomBySkipCount;
+
+}
+
+bool SmartPlaylistSearch::uses_statistics() const {
+
+  if (sort_type_ == SortType::RandomByRating || sort_type_ == SortType::RandomByPlayCount || sort_type_ == SortType::RandomBySkipCount) {
+    return true;
+  }
+
+  if ((sort_type_ == SortType::FieldAsc || sort_type_ == SortType::FieldDesc) && SmartPlaylistSearchTerm::IsStatisticsField(sort_field_)) {
+    return true;
+  }
+
+  return std::any_of(terms_.begin(), terms_.end(), [](const SmartPlaylistSearchTerm &term) { return SmartPlaylistSearchTerm::IsStatisticsField(term.field_); });
+
+}
+
+QStringList SmartPlaylistSearch::TermsWhereClauses(const QString &fts_table) const {
 
   // Add search terms
   QStringList where_clauses;
   QStringList term_where_clauses;
   term_where_clauses.reserve(terms_.count());
   for (const SmartPlaylistSearchTerm &term : terms_) {
-    term_where_clauses << term.ToSql();
+    term_where_clauses << term.ToSql(fts_table);
   }
 
   if (!terms_.isEmpty() && search_type_ != SearchType::All) {
@@ -68,6 +88,34 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
     where_clauses << QStringLiteral("(") + term_where_clauses.join(boolean_op) + QStringLiteral(")");
   }
 
+  return where_clauses;
+
+}
+
+QString SmartPlaylistSearch::ToCandidatesSql(const QString &songs_table, const QString &fts_table) const {
+
+  QStringList where_clauses = TermsWhereClauses(fts_table);
+  where_clauses << QStringLiteral("unavailable = 0");
+
+  return QStringLiteral("SELECT ROWID, rating, playcount, skipcount FROM %1 WHERE %2").arg(songs_table, where_clauses.join(" AND "_L1));
+
+}
+
+QString SmartPlaylistSearch::ToCountSql(const QString &songs_table, const QString &fts_table) const {
+
+  QStringList where_clauses = TermsWhereClauses(fts_table);
+  where_clauses << QStringLiteral("unavailable = 0");
+
+  return QStringLiteral("SELECT COUNT(*) FROM %1 WHERE %2").arg(songs_table, where_clauses.join(" AND "_L1));
+
+}
+
+QString SmartPlaylistSearch::ToSql(const QString &songs_table, const QString &fts_table) const {
+
+  QString sql = QStringLiteral("SELECT %1 FROM %2").arg(Song::kRowIdColumnSpec, songs_table);
+
+  QStringList where_clauses = TermsWhereClauses(fts_table);
+
   // Restrict the IDs of songs if we're making a dynamic playlist
   if (!id_not_in_.isEmpty()) {
     QString numbers;
@@ -86,7 +134,8 @@ QString SmartPlaylistSearch::ToSql(const QString &songs_table) const {
   }
 
   // Add sort by
-  if (sort_type_ == SortType::Random) {
+  if (is_random()) {
+    // The weighted random orders are only applied by the dynamic playlist sampler, previews use a plain random order.
     sql += " ORDER BY random()"_L1;
   }
   else {
@@ -25,6 +25,7 @@
 
 #include <QList>
 #include <QString>
+#include <QStringList>
 #include <QDataStream>
 
 #include "playlistgenerator.h"
@@ -46,13 +47,19 @@ class SmartPlaylistSearch {
   enum class SortType {
     Random = 0,
     FieldAsc,
-    FieldDesc
+    FieldDesc,
+    RandomByRating,
+    RandomByPlayCount,
+    RandomBySkipCount
   };
 
   explicit SmartPlaylistSearch();
   explicit SmartPlaylistSearch(const SearchType type, const TermList &terms, const SortType sort_type, const SmartPlaylistSearchTerm::Field sort_field, const int limit = PlaylistGenerator::kDefaultLimit);
 
   bool is_valid() const;
+  bool is_random() const;
+  // Whether the matching songs, their order or their random weights depend on play statistics or ratings.
+  bool uses_statistics() const;
   bool operator==(const SmartPlaylistSearch &other) const;
   bool operator!=(const SmartPlaylistSearch &other) const { return !(*this == other); }
 
@@ -67,7 +74,17 @@ class SmartPlaylistSearch {
   int first_item_;
 
   void Reset();
-  QString ToSql(const QString &songs_table) const;
+  // fts_table is the full-text index of songs_table, if it has one.
+  QString ToSql(const QString &songs_table, const QString &fts_table = QString()) const;
+
+  // Selects the ID, rating, play count and skip count of every matching song, ignoring sorting, limits and id_not_in_.
+  QString ToCandidatesSql(const QString &songs_table, const QString &fts_table = QString()) const;
+
+  // Counts the matching songs, ignoring sorting, limits and id_not_in_.
+  QString ToCountSql(const QString &songs_table, const QString &fts_table = QString()) const;
+
+ private:
+  QStringList TermsWhereClauses(const QString &fts_table) const;
 };
 
 QDataStream &operator<<(QDataStream &s, const SmartPlaylistSearch &search);
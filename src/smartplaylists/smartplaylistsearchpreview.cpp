@@ -20,30 +20,41 @@
 
 #include "config.h"
 
-#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 
+#include <QtGlobal>
 #include <QWidget>
 #include <QAbstractItemView>
+#include <QTimer>
 #include <QString>
 #include <QtConcurrentRun>
 #include <QFuture>
 #include <QFutureWatcher>
 
 #include "core/shared_ptr.h"
+#include "core/song.h"
+#include "collection/collectionbackend.h"
 
 #include "smartplaylistsearchpreview.h"
 #include "ui_smartplaylistsearchpreview.h"
 
 #include "playlist/playlist.h"
-#include "playlistquerygenerator.h"
+#include "playlist/playlistitem.h"
+#include "playlistgenerator.h"
 
 using std::make_shared;
+using namespace std::chrono_literals;
 
 SmartPlaylistSearchPreview::SmartPlaylistSearchPreview(QWidget *parent)
     : QWidget(parent),
       ui_(new Ui_SmartPlaylistSearchPreview),
       collection_backend_(nullptr),
-      model_(nullptr) {
+      model_(nullptr),
+      timer_search_(new QTimer(this)),
+      search_generation_(make_shared<std::atomic<quint64>>(0)),
+      searching_(false) {
 
   ui_->setupUi(this);
 
@@ -56,10 +67,19 @@ SmartPlaylistSearchPreview::SmartPlaylistSearchPreview(QWidget *parent)
   ui_->preview_label->setFont(bold_font);
   ui_->busy_container->hide();
 
+  timer_search_->setSingleShot(true);
+  timer_search_->setInterval(300ms);
+  QObject::connect(timer_search_, &QTimer::timeout, this, &SmartPlaylistSearchPreview::StartPendingSearch);
+
 }
 
 SmartPlaylistSearchPreview::~SmartPlaylistSearchPreview() {
+
+  // Abandon a search that is still running.
+  ++*search_generation_;
+
   delete ui_;
+
 }
 
 void SmartPlaylistSearchPreview::set_application(Application *app) {
@@ -81,14 +101,39 @@ void SmartPlaylistSearchPreview::set_collection(SharedPtr<CollectionBackend> col
 
 void SmartPlaylistSearchPreview::Update(const SmartPlaylistSearch &search) {
 
-  if (search == last_search_) {
-    // This search was the same as the last one we did
+  if (pending_search_.is_valid() ? search == pending_search_ : search == (searching_ ? running_search_ : last_search_)) {
+    // This search is already waiting, running or shown
     return;
   }
 
-  if (generator_ || isHidden()) {
-    // It's busy generating something already, or the widget isn't visible
-    pending_search_ = search;
+  // Abandon the running search, its results would be thrown away anyway
+  ++*search_generation_;
+
+  pending_search_ = search;
+  timer_search_->start();
+
+}
+
+void SmartPlaylistSearchPreview::showEvent(QShowEvent *e) {
+
+  // There might be a search waiting while we were hidden, so run it now
+  StartPendingSearch();
+
+  QWidget::showEvent(e);
+
+}
+
+void SmartPlaylistSearchPreview::StartPendingSearch() {
+
+  if (!pending_search_.is_valid() || searching_ || isHidden()) return;
+
+  const SmartPlaylistSearch search = pending_search_;
+  pending_search_ = SmartPlaylistSearch();
+
+  if (search == last_search_) {
+    // Edited back to the search that is shown
+    ui_->busy_container->hide();
+    ui_->count_label->show();
     return;
   }
 
@@ -96,64 +141,82 @@ void SmartPlaylistSearchPreview::Update(const SmartPlaylistSearch &search) {
 
 }
 
-void SmartPlaylistSearchPreview::showEvent(QShowEvent *e) {
+// Only the songs shown are loaded, the total is counted by the database.
+SmartPlaylistSearchPreview::PreviewResult SmartPlaylistSearchPreview::RunPreview(SharedPtr<CollectionBackend> collection_backend, const SmartPlaylistSearch &search, SharedPtr<std::atomic<quint64>> search_generation, const quint64 generation) {
+
+  PreviewResult result;
 
-  if (pending_search_.is_valid() && !generator_) {
-    // There was a search waiting while we were hidden, so run it now
-    RunSearch(pending_search_);
-    pending_search_ = SmartPlaylistSearch();
+  SmartPlaylistSearch preview_search = search;
+  preview_search.limit_ = search.limit_ == -1 ? PlaylistGenerator::kDefaultLimit : std::min(search.limit_, PlaylistGenerator::kDefaultLimit);
+
+  if (*search_generation != generation) return result;
+  result.songs = collection_backend->SmartPlaylistsFindSongs(preview_search);
+
+  if (result.songs.count() < preview_search.limit_) {
+    result.count = static_cast<int>(result.songs.count());
+  }
+  else {
+    if (*search_generation != generation) return result;
+    result.count = collection_backend->SmartPlaylistsCountSongs(search);
+    if (search.limit_ != -1) result.count = std::min(result.count, search.limit_);
   }
 
-  QWidget::showEvent(e);
+  result.cancelled = false;
 
-}
+  return result;
 
-namespace {
-PlaylistItemPtrList DoRunSearch(PlaylistGeneratorPtr gen) { return gen->Generate(); }
-}  // namespace
+}
 
 void SmartPlaylistSearchPreview::RunSearch(const SmartPlaylistSearch &search) {
 
-  generator_ = make_shared<PlaylistQueryGenerator>();
-  generator_->set_collection_backend(collection_backend_);
-  std::dynamic_pointer_cast<PlaylistQueryGenerator>(generator_)->Load(search);
+  searching_ = true;
+  running_search_ = search;
 
   ui_->busy_container->show();
   ui_->count_label->hide();
-  QFuture<PlaylistItemPtrList> future = QtConcurrent::run(DoRunSearch, generator_);
-  QFutureWatcher<PlaylistItemPtrList> *watcher = new QFutureWatcher<PlaylistItemPtrList>();
-  QObject::connect(watcher, &QFutureWatcher<PlaylistItemPtrList>::finished, this, &SmartPlaylistSearchPreview::SearchFinished);
+  QFuture<PreviewResult> future = QtConcurrent::run(&SmartPlaylistSearchPreview::RunPreview, collection_backend_, search, search_generation_, search_generation_->load());
+  QFutureWatcher<PreviewResult> *watcher = new QFutureWatcher<PreviewResult>();
+  QObject::connect(watcher, &QFutureWatcher<PreviewResult>::finished, this, &SmartPlaylistSearchPreview::SearchFinished);
   watcher->setFuture(future);
 
 }
 
 void SmartPlaylistSearchPreview::SearchFinished() {
 
-  QFutureWatcher<PlaylistItemPtrList> *watcher = static_cast<QFutureWatcher<PlaylistItemPtrList>*>(sender());
-  PlaylistItemPtrList all_items = watcher->result();
+  QFutureWatcher<PreviewResult> *watcher = static_cast<QFutureWatcher<PreviewResult>*>(sender());
+  const PreviewResult result = watcher->result();
   watcher->deleteLater();
 
-  last_search_ = std::dynamic_pointer_cast<PlaylistQueryGenerator>(generator_)->search();
-  generator_.reset();
+  searching_ = false;
 
-  if (pending_search_.is_valid() && pending_search_ != last_search_) {
+  if (pending_search_.is_valid()) {
     // There was another search done while we were running
-    // throw away these results and do that one now instead
-    RunSearch(pending_search_);
-    pending_search_ = SmartPlaylistSearch();
+    // throw away these results and do that one now instead, unless we are still waiting for more edits
+    if (!timer_search_->isActive()) StartPendingSearch();
+    return;
+  }
+
+  if (result.cancelled) {
+    ui_->busy_container->hide();
     return;
   }
 
-  PlaylistItemPtrList displayed_items = all_items.mid(0, PlaylistGenerator::kDefaultLimit);
+  last_search_ = running_search_;
+
+  PlaylistItemPtrList items;
+  items.reserve(result.songs.count());
+  for (const Song &song : result.songs) {
+    items << PlaylistItem::NewFromSong(song);
+  }
 
   model_->Clear();
-  model_->InsertItems(displayed_items);
+  model_->InsertItems(items);
 
-  if (displayed_items.count() < all_items.count()) {
-    ui_->count_label->setText(tr("%1 songs found (showing %2)").arg(all_items.count()).arg(displayed_items.count()));
+  if (items.count() < result.count) {
+    ui_->count_label->setText(tr("%1 songs found (showing %2)").arg(result.count).arg(items.count()));
   }
   else {
-    ui_->count_label->setText(tr("%1 songs found").arg(all_items.count()));
+    ui_->count_label->setText(tr("%1 songs found").arg(result.count));
   }
 
   ui_->busy_container->hide();
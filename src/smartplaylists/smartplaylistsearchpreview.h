@@ -23,14 +23,18 @@
 
 #include "config.h"
 
+#include <atomic>
+
+#include <QtGlobal>
 #include <QWidget>
 #include <QList>
 
 #include "core/shared_ptr.h"
+#include "core/song.h"
 
 #include "smartplaylistsearch.h"
-#include "playlistgenerator_fwd.h"
 
+class QTimer;
 class QShowEvent;
 
 class Application;
@@ -38,6 +42,9 @@ class CollectionBackend;
 class Playlist;
 class Ui_SmartPlaylistSearchPreview;
 
+// Shows the first songs of a search and how many songs it finds.
+// Searches are started after a short delay, so quick edits only run the last one, and a search is abandoned as soon as it is edited again.
+
 class SmartPlaylistSearchPreview : public QWidget {
   Q_OBJECT
 
@@ -54,9 +61,18 @@ class SmartPlaylistSearchPreview : public QWidget {
   void showEvent(QShowEvent*) override;
 
  private:
+  struct PreviewResult {
+    PreviewResult() : cancelled(true), count(0) {}
+    bool cancelled;
+    SongList songs;
+    int count;
+  };
+
+  static PreviewResult RunPreview(SharedPtr<CollectionBackend> collection_backend, const SmartPlaylistSearch &search, SharedPtr<std::atomic<quint64>> search_generation, const quint64 generation);
   void RunSearch(const SmartPlaylistSearch &search);
 
  private Q_SLOTS:
+  void StartPendingSearch();
   void SearchFinished();
 
  private:
@@ -66,9 +82,13 @@ class SmartPlaylistSearchPreview : public QWidget {
   SharedPtr<CollectionBackend> collection_backend_;
   Playlist *model_;
 
+  QTimer *timer_search_;
+  SharedPtr<std::atomic<quint64>> search_generation_;
+  bool searching_;
+
   SmartPlaylistSearch pending_search_;
+  SmartPlaylistSearch running_search_;
   SmartPlaylistSearch last_search_;
-  PlaylistGeneratorPtr generator_;
 };
 
 #endif  // SMARTPLAYLISTSEARCHPREVIEW_H
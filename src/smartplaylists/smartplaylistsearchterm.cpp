@@ -36,7 +36,7 @@ SmartPlaylistSearchTerm::SmartPlaylistSearchTerm() : field_(Field::Title), opera
 SmartPlaylistSearchTerm::SmartPlaylistSearchTerm(Field field, Operator op, const QVariant &value)
     : field_(field), operator_(op), value_(value), datetype_(DateType::Hour) {}
 
-QString SmartPlaylistSearchTerm::ToSql() const {
+QString SmartPlaylistSearchTerm::ToSql(const QString &fts_table) const {
 
   QString col = FieldColumnName(field_);
   QString date = DateName(datetype_, true);
@@ -101,18 +101,27 @@ QString SmartPlaylistSearchTerm::ToSql() const {
     value = "CAST (("_L1 + value + " + 0.05) * 10 AS INTEGER)"_L1;
   }
 
+  // The trigram index can only be used for patterns with at least 3 characters, shorter patterns scan the songs table directly.
+  const bool full_text = !fts_table.isEmpty() && IsFullTextField(field_) && value.length() >= 3;
+  const auto like = [full_text, &fts_table, &col](const QString &pattern) {
+    if (full_text) {
+      return "ROWID IN (SELECT ROWID FROM "_L1 + fts_table + " WHERE "_L1 + col + " LIKE '"_L1 + pattern + "')"_L1;
+    }
+    return col + " LIKE '"_L1 + pattern + u'\'';
+  };
+
   switch (operator_) {
     case Operator::Contains:
-      return col + " LIKE '%"_L1 + value + "%'"_L1;
+      return like(u'%' + value + u'%');
     case Operator::NotContains:
-      return col + " NOT LIKE '%"_L1 + value + "%'"_L1;
+      return "NOT "_L1 + like(u'%' + value + u'%');
     case Operator::StartsWith:
-      return col + " LIKE '"_L1 + value + "%'"_L1;
+      return like(value + u'%');
     case Operator::EndsWith:
-      return col + " LIKE '%"_L1 + value + u'\'';
+      return like(u'%' + value);
     case Operator::Equals:
       if (TypeOf(field_) == Type::Text) {
-        return col + " LIKE '"_L1 + value + u'\'';
+        return like(value);
       }
       else if (TypeOf(field_) == Type::Date || TypeOf(field_) == Type::Time || TypeOf(field_) == Type::Rating) {
         return col + " = "_L1 + value;
@@ -362,6 +371,41 @@ QString SmartPlaylistSearchTerm::FieldColumnName(const Field field) {
 
 }
 
+bool SmartPlaylistSearchTerm::IsFullTextField(const Field field) {
+
+  // The columns of the songs_fts tables.
+  switch (field) {
+    case Field::AlbumArtist:
+    case Field::Artist:
+    case Field::Album:
+    case Field::Title:
+    case Field::Genre:
+    case Field::Composer:
+    case Field::Performer:
+    case Field::Grouping:
+    case Field::Comment:
+      return true;
+    default:
+      return false;
+  }
+
+}
+
+bool SmartPlaylistSearchTerm::IsStatisticsField(const Field field) {
+
+  // Fields that change when songs are played, skipped or rated.
+  switch (field) {
+    case Field::PlayCount:
+    case Field::SkipCount:
+    case Field::LastPlayed:
+    case Field::Rating:
+      return true;
+    default:
+      return false;
+  }
+
+}
+
 QString SmartPlaylistSearchTerm::FieldName(const Field field) {
 
   switch (field) {
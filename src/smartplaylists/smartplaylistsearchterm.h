@@ -121,7 +121,8 @@ class SmartPlaylistSearchTerm {
   // For relative dates, we need a second parameter, might be useful somewhere else
   QVariant second_value_;
 
-  QString ToSql() const;
+  // Text searches on columns of the full-text index use fts_table when it is given.
+  QString ToSql(const QString &fts_table = QString()) const;
   bool is_valid() const;
   bool operator==(const SmartPlaylistSearchTerm &other) const;
   bool operator!=(const SmartPlaylistSearchTerm &other) const { return !(*this == other); }
@@ -131,6 +132,8 @@ class SmartPlaylistSearchTerm {
   static QString OperatorText(const Type type, const Operator op);
   static QString FieldName(const Field field);
   static QString FieldColumnName(const Field field);
+  static bool IsFullTextField(const Field field);
+  static bool IsStatisticsField(const Field field);
   static QString FieldSortOrderText(const Type type, const bool ascending);
   static QString DateName(const DateType datetype, const bool forQuery);
 };
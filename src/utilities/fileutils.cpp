@@ -20,6 +20,14 @@
 
 #include <QtGlobal>
 
+#ifdef Q_OS_UNIX
+#  include <unistd.h>
+#endif
+
+#ifdef Q_OS_WIN32
+#  include <windows.h>
+#endif
+
 #include <memory>
 
 #include <QByteArray>
@@ -31,6 +39,10 @@
 #include "core/logging.h"
 #include "core/scoped_ptr.h"
 
+#ifdef Q_OS_WIN32
+#  include "core/scopedwchararray.h"
+#endif
+
 #include "fileutils.h"
 
 namespace Utilities {
@@ -132,4 +144,22 @@ bool RemoveRecursive(const QString &path) {
 
 }
 
+bool LinkOrCopy(const QString &source, const QString &destination) {
+
+#if defined(Q_OS_UNIX)
+  if (::link(QFile::encodeName(source).constData(), QFile::encodeName(destination).constData()) == 0) {
+    return true;
+  }
+#elif defined(Q_OS_WIN32)
+  ScopedWCharArray source_wchar(QDir::toNativeSeparators(source));
+  ScopedWCharArray destination_wchar(QDir::toNativeSeparators(destination));
+  if (CreateHardLinkW(destination_wchar.get(), source_wchar.get(), nullptr) != 0) {
+    return true;
+  }
+#endif
+
+  return QFile::copy(source, destination);
+
+}
+
 }  // namespace Utilities
@@ -31,6 +31,8 @@ QByteArray ReadDataFromFile(const QString &filename);
 bool Copy(QIODevice *source, QIODevice *destination);
 bool CopyRecursive(const QString &source, const QString &destination);
 bool RemoveRecursive(const QString &path);
+// Creates a hard link to source, or copies it when that is not possible (different file systems for example).
+bool LinkOrCopy(const QString &source, const QString &destination);
 
 }  // namespace Utilities
 
@@ -28,8 +28,12 @@
 #include <QRect>
 #include <QSizePolicy>
 #include <QPaintEvent>
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QAction>
 
 #include "core/shared_ptr.h"
+#include "core/iconloader.h"
 #include "core/taskmanager.h"
 #include "multiloadingindicator.h"
 #include "widgets/busyindicator.h"
@@ -109,3 +113,26 @@ void MultiLoadingIndicator::paintEvent(QPaintEvent*) {
   p.drawText(text_rect, Qt::TextSingleLine | Qt::AlignLeft, fontMetrics().elidedText(text_, Qt::ElideRight, text_rect.width()));  // NOLINT(bugprone-suspicious-enum-usage)
 
 }
+
+void MultiLoadingIndicator::contextMenuEvent(QContextMenuEvent *e) {
+
+  if (!task_manager_) return;
+
+  QMenu *menu = new QMenu(this);
+  menu->setAttribute(Qt::WA_DeleteOnClose);
+
+  const QList<TaskManager::Task> tasks = task_manager_->GetTasks();
+  for (const TaskManager::Task &task : tasks) {
+    if (!task.cancellable || task.cancelled) continue;
+    const int task_id = task.id;
+    menu->addAction(IconLoader::Load(u"list-remove"_s), tr("Cancel %1").arg(task.name), this, [this, task_id]() { task_manager_->CancelTask(task_id); });
+  }
+
+  if (menu->isEmpty()) {
+    delete menu;
+    return;
+  }
+
+  menu->popup(e->globalPos());
+
+}
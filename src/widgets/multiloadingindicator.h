@@ -29,6 +29,7 @@
 #include "core/shared_ptr.h"
 
 class QPaintEvent;
+class QContextMenuEvent;
 
 class BusyIndicator;
 class TaskManager;
@@ -48,6 +49,7 @@ class MultiLoadingIndicator : public QWidget {
 
  protected:
   void paintEvent(QPaintEvent*) override;
+  void contextMenuEvent(QContextMenuEvent *e) override;
 
  private Q_SLOTS:
   void UpdateText();
@@ -0,0 +1,180 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <QMap>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+#include <QSize>
+#include <QDateTime>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "covermanager/albumcoverfetcher.h"
+#include "covermanager/coverproviderratelimiter.h"
+#include "covermanager/coversearchmisscache.h"
+#include "covermanager/deezercoverprovider.h"
+#include "mock_networkaccessmanager.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+using std::make_shared;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+constexpr qint64 kStartMSecs = 1000000;
+
+TEST(CoverProviderRateLimiterTest, AllowsBurstThenWaits) {
+
+  CoverProviderRateLimiter limiter(60, 2);
+
+  ASSERT_TRUE(limiter.CanStart(kStartMSecs));
+  limiter.Started(kStartMSecs);
+  ASSERT_TRUE(limiter.CanStart(kStartMSecs));
+  limiter.Started(kStartMSecs);
+
+  EXPECT_FALSE(limiter.CanStart(kStartMSecs));
+  EXPECT_NEAR(1000, limiter.msec_until_ready(kStartMSecs), 1);
+  EXPECT_FALSE(limiter.CanStart(kStartMSecs + 500));
+  EXPECT_TRUE(limiter.CanStart(kStartMSecs + 1001));
+
+}
+
+TEST(CoverProviderRateLimiterTest, RefillIsCappedAtBurst) {
+
+  CoverProviderRateLimiter limiter(60, 2);
+  limiter.Started(kStartMSecs);
+  limiter.Started(kStartMSecs);
+
+  // An hour later only the burst is available again.
+  const qint64 later = kStartMSecs + 3600000;
+  limiter.Started(later);
+  limiter.Started(later);
+  EXPECT_FALSE(limiter.CanStart(later));
+
+}
+
+class CoverSearchMissCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_database_.is_valid());
+    database_ = temp_database_.database();
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(CoverSearchMissCacheTest, MissesArePersisted) {
+
+  {
+    CoverSearchMissCache misses(database_);
+    misses.Load();
+    EXPECT_FALSE(misses.Contains(u"Artist"_s, u"Album"_s));
+    misses.Add(u"Artist"_s, u"Album"_s);
+    misses.Add(u"Artist"_s, u"Other album"_s);
+    EXPECT_TRUE(misses.Contains(u"Artist"_s, u"Album"_s));
+  }
+
+  CoverSearchMissCache misses(database_);
+  misses.Load();
+  EXPECT_TRUE(misses.Contains(u"artist"_s, u"ALBUM"_s));
+  EXPECT_TRUE(misses.Contains(u"Artist"_s, u"Other album"_s));
+
+  misses.Remove(u"Artist"_s, u"Album"_s);
+
+  CoverSearchMissCache misses_reloaded(database_);
+  misses_reloaded.Load();
+  EXPECT_FALSE(misses_reloaded.Contains(u"Artist"_s, u"Album"_s));
+  EXPECT_TRUE(misses_reloaded.Contains(u"Artist"_s, u"Other album"_s));
+
+}
+
+TEST_F(CoverSearchMissCacheTest, MissesExpire) {
+
+  const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+  CoverSearchMissCache misses(database_);
+  misses.Load();
+  misses.Add(u"Artist"_s, u"Album"_s, now);
+  EXPECT_TRUE(misses.Contains(u"Artist"_s, u"Album"_s, now + 60));
+  EXPECT_FALSE(misses.Contains(u"Artist"_s, u"Album"_s, now + 365LL * 24LL * 60LL * 60LL));
+
+}
+
+TEST(DeezerCoverProviderTest, ParsesAlbumSearch) {
+
+  SharedPtr<MockNetworkAccessManager> network = make_shared<MockNetworkAccessManager>();
+  const QByteArray data = R"({"data":[{"id":1,"type":"album","title":"Album","artist":{"name":"Artist"},"cover_xl":"https://example.com/xl.jpg","cover_big":"https://example.com/big.jpg"}]})";
+  MockNetworkReply *reply = network->ExpectGet(u"api.deezer.com/search/album"_s, QMap<QString, QString>{{u"output"_s, u"json"_s}, {u"limit"_s, u"10"_s}}, 200, data);
+
+  DeezerCoverProvider provider(nullptr, network);
+
+  bool finished = false;
+  CoverProviderSearchResults results;
+  QObject::connect(&provider, &CoverProvider::SearchFinished, &provider, [&finished, &results](const int id, const CoverProviderSearchResults &search_results) {
+    EXPECT_EQ(1, id);
+    finished = true;
+    results = search_results;
+  });
+
+  ASSERT_TRUE(provider.StartSearch(u"Artist"_s, u"Album"_s, QString(), 1));
+  reply->Done();
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(2, results.count());
+  for (const CoverProviderSearchResult &result : std::as_const(results)) {
+    EXPECT_EQ(u"Artist"_s, result.artist);
+    EXPECT_EQ(u"Album"_s, result.album);
+  }
+  EXPECT_EQ(QUrl(u"https://example.com/xl.jpg"_s), results[0].image_url);
+  EXPECT_EQ(QSize(1000, 1000), results[0].image_size);
+  EXPECT_EQ(0, provider.error_count());
+
+}
+
+TEST(DeezerCoverProviderTest, HttpErrorFinishesWithoutResults) {
+
+  SharedPtr<MockNetworkAccessManager> network = make_shared<MockNetworkAccessManager>();
+  MockNetworkReply *reply = network->ExpectGet(u"api.deezer.com/search/album"_s, QMap<QString, QString>(), 429, QByteArray());
+
+  DeezerCoverProvider provider(nullptr, network);
+
+  bool finished = false;
+  QObject::connect(&provider, &CoverProvider::SearchFinished, &provider, [&finished](const int, const CoverProviderSearchResults &search_results) {
+    finished = true;
+    EXPECT_TRUE(search_results.isEmpty());
+  });
+
+  ASSERT_TRUE(provider.StartSearch(u"Artist"_s, u"Album"_s, QString(), 1));
+  reply->Done();
+
+  EXPECT_TRUE(finished);
+  // The search is not mistaken for one without any covers.
+  EXPECT_EQ(1, provider.error_count());
+
+}
+
+}  // namespace
@@ -0,0 +1,236 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "config.h"
+
+#include <gtest/gtest.h>
+
+#include <QList>
+#include <QString>
+#include <QUrl>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "core/song.h"
+#include "collection/collection.h"
+#include "collection/collectionbackend.h"
+#include "scanner/analysisscanner.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+class AnalysisScannerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_database_.is_valid());
+    ASSERT_TRUE(music_dir_.isValid());
+    backend_.Init(temp_database_.database(), nullptr, Song::Source::Collection, QLatin1String(SCollection::kSongsTable), QLatin1String(SCollection::kDirsTable), QLatin1String(SCollection::kSubdirsTable));
+    filename_ = music_dir_.filePath(u"song.flac"_s);
+    QFile file(filename_);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("not audio");
+    file.close();
+    AddSong(filename_);
+  }
+
+  void AddSong(const QString &filename) {
+    Song song;
+    song.set_directory_id(1);
+    song.set_url(QUrl::fromLocalFile(filename));
+    song.set_title(u"Title"_s);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    backend_.AddOrUpdateSongs(SongList() << song);
+  }
+
+  AnalysisScanner::Options ScannerOptions(const bool loudness, const bool fingerprint) const {
+    AnalysisScanner::Options options;
+    options.database = temp_database_.FilePath(u"strawberry.db"_s);
+    options.songs_table = QLatin1String(SCollection::kSongsTable);
+    options.directories << music_dir_.path();
+    options.loudness = loudness;
+    options.fingerprint = fingerprint;
+    return options;
+  }
+
+  void SetMtime(const qint64 mtime) {
+    QSqlDatabase db(temp_database_.database()->Connect());
+    SqlQuery q(db);
+    q.prepare(u"UPDATE songs SET mtime = :mtime"_s);
+    q.BindValue(u":mtime"_s, mtime);
+    ASSERT_TRUE(q.Exec());
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  QTemporaryDir music_dir_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  CollectionBackend backend_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  QString filename_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(AnalysisScannerTest, RelativeDirectoryIsMatched) {
+
+  const QString current_path = QDir::currentPath();
+  ASSERT_TRUE(QDir::setCurrent(music_dir_.path() + u"/.."_s));
+
+  AnalysisScanner::Options options = ScannerOptions(true, true);
+  options.directories = QStringList() << QDir(music_dir_.path()).dirName();
+  AnalysisScanner scanner(options);
+  ASSERT_TRUE(scanner.OpenDatabase());
+  int unknown_files = 0;
+  int done_files = 0;
+  const QList<AnalysisScanner::Job> jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  QDir::setCurrent(current_path);
+
+  EXPECT_EQ(0, unknown_files);
+  ASSERT_EQ(1, jobs.count());
+  EXPECT_EQ(filename_, jobs.first().filename);
+
+}
+
+TEST_F(AnalysisScannerTest, UnknownFilesAreCounted) {
+
+  QFile file(music_dir_.filePath(u"other.flac"_s));
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.close();
+
+  AnalysisScanner scanner(ScannerOptions(true, true));
+  ASSERT_TRUE(scanner.OpenDatabase());
+  int unknown_files = 0;
+  int done_files = 0;
+  EXPECT_EQ(1, scanner.CreateJobs(&unknown_files, &done_files).count());
+  EXPECT_EQ(1, unknown_files);
+
+}
+
+#ifdef HAVE_EBUR128
+
+TEST_F(AnalysisScannerTest, StoredLoudnessIsSkipped) {
+
+  AnalysisScanner scanner(ScannerOptions(true, false));
+  ASSERT_TRUE(scanner.OpenDatabase());
+  int unknown_files = 0;
+  int done_files = 0;
+  QList<AnalysisScanner::Job> jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  ASSERT_EQ(1, jobs.count());
+  ASSERT_EQ(1, jobs.first().rows.count());
+  EXPECT_TRUE(jobs.first().rows.first().loudness);
+
+  AnalysisScanner::Result result;
+  result.filename = jobs.first().filename;
+  result.rows << AnalysisScanner::RowResult{ jobs.first().rows.first().id, -14.0, 5.0 };
+  ASSERT_TRUE(scanner.StoreResult(result));
+
+  jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  EXPECT_TRUE(jobs.isEmpty());
+  EXPECT_EQ(1, done_files);
+
+}
+
+TEST_F(AnalysisScannerTest, LoudnessMissIsSkippedUntilTheFileChanges) {
+
+  AnalysisScanner scanner(ScannerOptions(true, false));
+  ASSERT_TRUE(scanner.OpenDatabase());
+  int unknown_files = 0;
+  int done_files = 0;
+  QList<AnalysisScanner::Job> jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  ASSERT_EQ(1, jobs.count());
+
+  AnalysisScanner::Result result;
+  result.filename = jobs.first().filename;
+  result.loudness_misses << jobs.first().rows.first();
+  ASSERT_TRUE(scanner.StoreResult(result));
+
+  jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  EXPECT_TRUE(jobs.isEmpty());
+  EXPECT_EQ(1, done_files);
+
+  // A changed file is analysed again.
+  SetMtime(2);
+  done_files = 0;
+  jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  ASSERT_EQ(1, jobs.count());
+  EXPECT_TRUE(jobs.first().rows.first().loudness);
+  EXPECT_EQ(0, done_files);
+
+}
+
+TEST_F(AnalysisScannerTest, ForceIgnoresLoudnessMisses) {
+
+  AnalysisScanner::Options options = ScannerOptions(true, false);
+  {
+    AnalysisScanner scanner(options);
+    ASSERT_TRUE(scanner.OpenDatabase());
+    int unknown_files = 0;
+    int done_files = 0;
+    const QList<AnalysisScanner::Job> jobs = scanner.CreateJobs(&unknown_files, &done_files);
+    ASSERT_EQ(1, jobs.count());
+    AnalysisScanner::Result result;
+    result.filename = jobs.first().filename;
+    result.loudness_misses << jobs.first().rows.first();
+    ASSERT_TRUE(scanner.StoreResult(result));
+  }
+
+  options.force = true;
+  AnalysisScanner scanner(options);
+  ASSERT_TRUE(scanner.OpenDatabase());
+  int unknown_files = 0;
+  int done_files = 0;
+  EXPECT_EQ(1, scanner.CreateJobs(&unknown_files, &done_files).count());
+
+}
+
+#endif  // HAVE_EBUR128
+
+#ifdef HAVE_SONGFINGERPRINTING
+
+TEST_F(AnalysisScannerTest, FingerprintMarkerIsSkipped) {
+
+  AnalysisScanner scanner(ScannerOptions(false, true));
+  ASSERT_TRUE(scanner.OpenDatabase());
+  int unknown_files = 0;
+  int done_files = 0;
+  QList<AnalysisScanner::Job> jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  ASSERT_EQ(1, jobs.count());
+  EXPECT_TRUE(jobs.first().fingerprint);
+
+  // Files without a fingerprint get the same marker as in the collection watcher.
+  AnalysisScanner::Result result;
+  result.filename = jobs.first().filename;
+  result.fingerprint = u"NONE"_s;
+  ASSERT_TRUE(scanner.StoreResult(result));
+
+  jobs = scanner.CreateJobs(&unknown_files, &done_files);
+  EXPECT_TRUE(jobs.isEmpty());
+  EXPECT_EQ(1, done_files);
+
+}
+
+#endif  // HAVE_SONGFINGERPRINTING
+
+}  // namespace
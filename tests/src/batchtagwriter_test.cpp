@@ -0,0 +1,168 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+#include <QEventLoop>
+
+#include "core/song.h"
+#include "core/tagreaderclient.h"
+#include "core/batchtagwriter.h"
+#include "tagreadermessages.pb.h"
+
+using namespace Qt::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+class BatchTagWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    writer_.SetWriteFunction([this](const BatchTagWriter::Request &request) {
+      spb::tagreader::Message message;
+      message.set_id(static_cast<int>(replies_.count()));
+      message.mutable_write_file_request()->set_filename(request.song.url().toLocalFile().toStdString());
+      TagReaderReply *reply = new TagReaderReply(message);
+      replies_ << reply;
+      return reply;
+    });
+    QObject::connect(&writer_, &BatchTagWriter::RequestFinished, &writer_, [this](const int index, const bool success, const QString &error) {
+      finished_indexes_ << index;
+      if (!success) errors_ << error;
+    });
+    QObject::connect(&writer_, &BatchTagWriter::Finished, &writer_, [this](const bool cancelled) {
+      done_ = true;
+      cancelled_ = cancelled;
+    });
+  }
+
+  static QList<BatchTagWriter::Request> CreateRequests(const int count) {
+    QList<BatchTagWriter::Request> requests;
+    for (int i = 0; i < count; ++i) {
+      Song song(Song::Source::Collection);
+      song.Init(u"Title %1"_s.arg(i), u"Artist"_s, u"Album"_s, 100);
+      song.set_url(QUrl::fromLocalFile(u"/music/%1.flac"_s.arg(i)));
+      requests << BatchTagWriter::Request(song);
+    }
+    return requests;
+  }
+
+  // Answers the reply, and waits until the writer has handled it.
+  void Reply(TagReaderReply *reply, const bool success, const QString &error = QString()) {
+    spb::tagreader::Message message;
+    message.set_id(reply->id());
+    spb::tagreader::WriteFileResponse *response = message.mutable_write_file_response();
+    response->set_success(success);
+    if (!error.isEmpty()) response->set_error(error.toStdString());
+    const qint64 finished = finished_indexes_.count();
+    reply->SetReply(message);
+    QElapsedTimer timer;
+    timer.start();
+    while (finished_indexes_.count() == finished && timer.elapsed() < 5000) {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+    }
+  }
+
+  BatchTagWriter writer_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  QList<TagReaderReply*> replies_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  QList<int> finished_indexes_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  QStringList errors_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  bool done_ = false;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  bool cancelled_ = false;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(BatchTagWriterTest, KeepsWindowOfRequestsInFlight) {
+
+  writer_.SetMaxInFlight(3);
+  writer_.Start(CreateRequests(8));
+
+  // Only the window is sent at first, and each reply lets one more request through.
+  ASSERT_EQ(3, replies_.count());
+  EXPECT_TRUE(writer_.is_running());
+  for (int i = 0; i < 8; ++i) {
+    Reply(replies_.at(i), true);
+    EXPECT_EQ(std::min(8, i + 4), replies_.count());
+  }
+
+  EXPECT_TRUE(done_);
+  EXPECT_FALSE(cancelled_);
+  EXPECT_FALSE(writer_.is_running());
+  EXPECT_EQ(QList<int>() << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7, finished_indexes_);
+  EXPECT_TRUE(errors_.isEmpty());
+
+}
+
+TEST_F(BatchTagWriterTest, ReportsFailedWrites) {
+
+  writer_.SetMaxInFlight(2);
+  writer_.Start(CreateRequests(2));
+
+  ASSERT_EQ(2, replies_.count());
+  Reply(replies_.at(1), false, u"Read-only file"_s);
+  Reply(replies_.at(0), true);
+
+  EXPECT_TRUE(done_);
+  EXPECT_EQ(QList<int>() << 1 << 0, finished_indexes_);
+  EXPECT_EQ(QStringList() << u"Read-only file"_s, errors_);
+
+}
+
+TEST_F(BatchTagWriterTest, CancelWaitsForRequestsInFlight) {
+
+  writer_.SetMaxInFlight(2);
+  writer_.Start(CreateRequests(10));
+  ASSERT_EQ(2, replies_.count());
+
+  writer_.Cancel();
+  EXPECT_TRUE(writer_.is_cancelled());
+  EXPECT_FALSE(done_);
+
+  Reply(replies_.at(0), true);
+  EXPECT_FALSE(done_);
+  Reply(replies_.at(1), true);
+
+  // Nothing more was sent after the cancel.
+  EXPECT_EQ(2, replies_.count());
+  EXPECT_TRUE(done_);
+  EXPECT_TRUE(cancelled_);
+  EXPECT_FALSE(writer_.is_running());
+
+}
+
+TEST_F(BatchTagWriterTest, EmptyBatchFinishesImmediately) {
+
+  writer_.Start(QList<BatchTagWriter::Request>());
+
+  EXPECT_TRUE(done_);
+  EXPECT_FALSE(cancelled_);
+  EXPECT_TRUE(replies_.isEmpty());
+
+}
+
+}  // namespace
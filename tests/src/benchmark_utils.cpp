@@ -0,0 +1,154 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include <gtest/gtest.h>
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+
+#include "core/song.h"
+#include "utilities/timeconstants.h"
+#include "benchmark_utils.h"
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+constexpr int kDefaultLibrarySize = 10000;
+constexpr int kTracksPerAlbum = 10;
+constexpr int kAlbumsPerArtist = 10;
+
+constexpr const char *kWords[] = { "love", "night", "blue", "dream", "fire", "heart", "rain", "midnight", "river", "light",
+                                   "summer", "shadow", "golden", "lonely", "dance", "ocean", "winter", "electric", "silver", "road" };
+constexpr const char *kGenres[] = { "Rock", "Pop", "Jazz", "Electronic", "Classical", "Metal", "Folk", "Hip-Hop", "Blues", "Ambient" };
+constexpr const char *kComposers[] = { "Anderson", "Bach", "Carter", "Davis", "Ellington", "Foster", "Garcia", "Hughes" };
+
+QString Word(const int i) {
+  return QLatin1String(kWords[i % static_cast<int>(std::size(kWords))]);
+}
+
+}  // namespace
+
+namespace benchmark {
+
+std::vector<int> LibrarySizes() {
+
+  std::vector<int> sizes;
+  const QStringList values = qEnvironmentVariable("STRAWBERRY_BENCHMARK_SIZES").split(u',', Qt::SkipEmptyParts);
+  for (const QString &value : values) {
+    bool ok = false;
+    const int size = value.trimmed().toInt(&ok);
+    if (ok && size > 0) sizes.push_back(size);
+  }
+  if (sizes.empty()) sizes.push_back(kDefaultLibrarySize);
+
+  return sizes;
+
+}
+
+SongList GenerateSongs(const int count, const int first) {
+
+  SongList songs;
+  songs.reserve(count);
+
+  for (int i = first; i < first + count; ++i) {
+    const int album = i / kTracksPerAlbum;
+    const int artist = album / kAlbumsPerArtist;
+    const int track = (i % kTracksPerAlbum) + 1;
+
+    const QString artist_name = u"Artist "_s + QString::number(artist);
+    const QString album_name = Word(album * 3) + u' ' + Word(album * 7 + 1) + u' ' + QString::number(album);
+    const QString title = Word(i * 13 + 5) + u' ' + Word(i * 17 + 2) + u' ' + QString::number(i);
+
+    Song song(Song::Source::Collection);
+    song.Init(title, artist_name, album_name, (180 + (i % 240)) * kNsecPerSec);
+    // Every fifth album is a compilation.
+    song.set_albumartist(album % 5 == 0 ? u"Various Artists"_s : artist_name);
+    song.set_track(track);
+    song.set_disc(1 + (album % 3 == 0 && track > kTracksPerAlbum / 2 ? 1 : 0));
+    song.set_year(1960 + (album % 60));
+    song.set_genre(QLatin1String(kGenres[artist % static_cast<int>(std::size(kGenres))]));
+    song.set_composer(QLatin1String(kComposers[album % static_cast<int>(std::size(kComposers))]));
+    song.set_filetype(album % 4 == 0 ? Song::FileType::MPEG : Song::FileType::FLAC);
+    song.set_bitrate(album % 4 == 0 ? 320 : 900 + (i % 100));
+    song.set_samplerate(album % 2 == 0 ? 44100 : 48000);
+    song.set_bitdepth(album % 4 == 0 ? 0 : 16 + (album % 2) * 8);
+    song.set_playcount(static_cast<uint>(i % 50));
+    song.set_directory_id(1);
+    song.set_url(QUrl::fromLocalFile(QStringLiteral("/music/%1/%2/%3 %4.%5").arg(artist_name, album_name).arg(track, 2, 10, u'0').arg(title, album % 4 == 0 ? u"mp3"_s : u"flac"_s)));
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    songs << song;
+  }
+
+  return songs;
+
+}
+
+QStringList FilterWords() {
+
+  return QStringList() << u"midnight"_s << u"electric"_s << u"ocean"_s;
+
+}
+
+void Run(const QString &name, const std::function<void()> &function, const int repetitions, const qint64 items, const std::function<void()> &setup) {
+
+  QList<qint64> nsecs;
+  nsecs.reserve(repetitions);
+  for (int i = 0; i < repetitions; ++i) {
+    if (setup) setup();
+    QElapsedTimer timer;
+    timer.start();
+    function();
+    nsecs << timer.nsecsElapsed();
+  }
+
+  Record(name, nsecs, items);
+
+}
+
+void Record(const QString &name, QList<qint64> nsecs, const qint64 items) {
+
+  if (nsecs.isEmpty()) return;
+
+  std::sort(nsecs.begin(), nsecs.end());
+  const qint64 median = nsecs.at(nsecs.count() / 2);
+
+  const auto record_msec = [&name](const QString &key, const qint64 nsec) {
+    ::testing::Test::RecordProperty((name + u'_' + key + u"_msec"_s).toStdString(), QString::number(static_cast<double>(nsec) / kNsecPerMsec, 'f', 3).toStdString());
+  };
+  record_msec(u"min"_s, nsecs.first());
+  record_msec(u"median"_s, median);
+  record_msec(u"max"_s, nsecs.last());
+  ::testing::Test::RecordProperty((name + u"_runs"_s).toStdString(), static_cast<int>(nsecs.count()));
+  if (items > 0 && median > 0) {
+    ::testing::Test::RecordProperty((name + u"_items_per_sec"_s).toStdString(), QString::number(static_cast<double>(items) * kNsecPerSec / static_cast<double>(median), 'f', 0).toStdString());
+  }
+
+}
+
+}  // namespace benchmark
@@ -0,0 +1,59 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#include <functional>
+#include <vector>
+
+#include <QtGlobal>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "core/song.h"
+
+// Benchmarks are gtest tests that are not part of the test run, they are built by the strawberry_benchmarks target.
+// Each benchmark is run once for every library size in STRAWBERRY_BENCHMARK_SIZES (comma separated, 10000 by default),
+// and records its timings as test properties, so "--gtest_output=json:file" writes them in a machine-readable form.
+
+namespace benchmark {
+
+// The library sizes to run the benchmarks with.
+std::vector<int> LibrarySizes();
+
+// A synthetic library, the same for every run with the same count and first id.
+// Albums have 10 tracks and artists 10 albums, titles are made of common words so filters match a realistic share of songs.
+// URLs are below /music, with the directory ID 1.
+SongList GenerateSongs(const int count, const int first = 0);
+
+// A few words that are used in the titles of the generated songs, for filter benchmarks.
+QStringList FilterWords();
+
+// Runs function repetitions times, calling setup before each run without timing it, and records the times.
+void Run(const QString &name, const std::function<void()> &function, const int repetitions = 5, const qint64 items = 0, const std::function<void()> &setup = nullptr);
+
+// Records the fastest, median and slowest of the measured times as properties with the given name as prefix,
+// and the items per second of the median time if items is set.
+void Record(const QString &name, QList<qint64> nsecs, const qint64 items = 0);
+
+}  // namespace benchmark
+
+#endif  // BENCHMARK_UTILS_H
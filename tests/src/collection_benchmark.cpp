@@ -0,0 +1,261 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <QtGlobal>
+#include <QThread>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QElapsedTimer>
+#include <QMetaEnum>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QScopedPointer>
+
+#include "core/scoped_ptr.h"
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "core/songprojection.h"
+#include "core/database.h"
+#include "collection/collection.h"
+#include "collection/collectionbackend.h"
+#include "collection/collectionmodel.h"
+#include "collection/collectionfilter.h"
+#include "filterparser/filterparser.h"
+#include "filterparser/filtertree.h"
+#include "benchmark_utils.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+using std::make_unique;
+using std::make_shared;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+class CollectionBenchmark : public ::testing::TestWithParam<int> {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_database_.is_valid());
+    database_ = temp_database_.database();
+    backend_ = make_shared<CollectionBackend>();
+    backend_->Init(database_, nullptr, Song::Source::Collection, QLatin1String(SCollection::kSongsTable), QLatin1String(SCollection::kDirsTable), QLatin1String(SCollection::kSubdirsTable));
+    backend_->AddDirectory(u"/music"_s);
+    songs_ = benchmark::GenerateSongs(GetParam());
+    ::testing::Test::RecordProperty("songs", GetParam());
+  }
+
+  void TearDown() override {
+    model_.reset();
+    backend_.reset();
+  }
+
+  void CreateModel() {
+    model_ = make_unique<CollectionModel>(backend_, nullptr);
+  }
+
+  // Reloads the model with the grouping and returns the time from the start of the reload until the new tree is swapped in.
+  qint64 BuildModel(const CollectionModel::Grouping grouping) {
+    QElapsedTimer timer;
+    int resets = 0;
+    QEventLoop loop;
+    const QMetaObject::Connection connection = QObject::connect(&*model_, &CollectionModel::modelReset, &loop, [&timer, &resets, &loop]() {
+      // The first reset shows the loading indicator, the second one swaps in the tree.
+      if (++resets == 1) {
+        timer.start();
+      }
+      else {
+        loop.quit();
+      }
+    });
+    model_->SetGroupBy(grouping);
+    loop.exec();
+    QObject::disconnect(connection);
+    return timer.nsecsElapsed();
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<CollectionBackend> backend_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  ScopedPtr<CollectionModel> model_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SongList songs_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_P(CollectionBenchmark, AddOrUpdateSongs) {
+
+  benchmark::Run(u"insert"_s, [this]() { backend_->AddOrUpdateSongs(songs_); }, 3, songs_.count(), [this]() { backend_->DeleteAll(); });
+
+  // Update the songs in place, like a rescan that finds changed files.
+  SongList songs = backend_->GetAllSongs();
+  ASSERT_EQ(songs_.count(), songs.count());
+  for (Song &song : songs) {
+    song.set_mtime(2);
+  }
+  benchmark::Run(u"update"_s, [this, &songs]() { backend_->AddOrUpdateSongs(songs); }, 3, songs.count());
+
+}
+
+TEST_P(CollectionBenchmark, GetAllSongs) {
+
+  backend_->AddOrUpdateSongs(songs_);
+
+  qint64 count = 0;
+  benchmark::Run(u"all_columns"_s, [this, &count]() { count = backend_->GetAllSongs().count(); }, 5, songs_.count());
+  EXPECT_EQ(songs_.count(), count);
+
+  // Only the columns needed for matching play statistics.
+  const SongProjection projection(QStringList() << u"url"_s << u"artist"_s << u"title"_s << u"playcount"_s);
+  benchmark::Run(u"projection"_s, [this, &count, &projection]() { count = backend_->GetAllSongs(projection).count(); }, 5, songs_.count());
+  EXPECT_EQ(songs_.count(), count);
+
+}
+
+TEST_P(CollectionBenchmark, ReadDuringWrite) {
+
+  backend_->AddOrUpdateSongs(songs_);
+
+  // Add as many songs again on another thread, and read the collection while that write transaction is open.
+  const SongList new_songs = benchmark::GenerateSongs(GetParam(), GetParam());
+  QThread *thread = QThread::create([this, &new_songs]() {
+    backend_->AddOrUpdateSongs(new_songs);
+    database_->Close();
+  });
+  thread->start();
+
+  QList<qint64> nsecs;
+  while (!thread->isFinished()) {
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 count = backend_->GetAllSongs().count();
+    nsecs << timer.nsecsElapsed();
+    EXPECT_GE(count, songs_.count());
+  }
+  ASSERT_TRUE(thread->wait());
+  delete thread;
+
+  benchmark::Record(u"read"_s, nsecs, songs_.count());
+
+}
+
+TEST_P(CollectionBenchmark, SearchSongIds) {
+
+  backend_->AddOrUpdateSongs(songs_);
+  const SongList songs = backend_->GetAllSongs();
+
+  const QStringList words = benchmark::FilterWords();
+  for (const QString &word : words) {
+    qint64 fts_count = 0;
+    benchmark::Run(u"fts_"_s + word, [this, &word, &fts_count]() { fts_count = backend_->SearchSongIds(QStringList() << word).count(); }, 5, songs.count());
+
+    // The same search with the filter tree over songs that are already loaded, like the collection filter did before.
+    qint64 tree_count = 0;
+    benchmark::Run(u"filter_tree_"_s + word, [&songs, &word, &tree_count]() {
+      FilterParser parser(word);
+      QScopedPointer<FilterTree> tree(parser.parse());
+      tree_count = std::count_if(songs.begin(), songs.end(), [&tree](const Song &song) { return tree->accept(song); });
+    }, 5, songs.count());
+
+    // The filter tree also looks at columns that are not in the full-text index, so the counts can differ a little.
+    ::testing::Test::RecordProperty((u"fts_"_s + word + u"_matches"_s).toStdString(), static_cast<int>(fts_count));
+    ::testing::Test::RecordProperty((u"filter_tree_"_s + word + u"_matches"_s).toStdString(), static_cast<int>(tree_count));
+  }
+
+}
+
+TEST_P(CollectionBenchmark, ModelGrouping) {
+
+  backend_->AddOrUpdateSongs(songs_);
+  CreateModel();
+
+  const QList<CollectionModel::Grouping> groupings = QList<CollectionModel::Grouping>()
+    << CollectionModel::Grouping(CollectionModel::GroupBy::AlbumArtist, CollectionModel::GroupBy::AlbumDisc)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::Artist, CollectionModel::GroupBy::Album)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::AlbumArtist, CollectionModel::GroupBy::YearAlbumDisc)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::Genre, CollectionModel::GroupBy::AlbumArtist, CollectionModel::GroupBy::Album)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::Year, CollectionModel::GroupBy::Artist, CollectionModel::GroupBy::Album)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::Composer, CollectionModel::GroupBy::Album)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::FileType, CollectionModel::GroupBy::Format, CollectionModel::GroupBy::Artist)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::Album)
+    << CollectionModel::Grouping(CollectionModel::GroupBy::None);
+
+  const QMetaEnum group_by_enum = QMetaEnum::fromType<CollectionModel::GroupBy>();
+  for (const CollectionModel::Grouping &grouping : groupings) {
+    QString name;
+    for (int i = 0; i < 3 && grouping[i] != CollectionModel::GroupBy::None; ++i) {
+      if (!name.isEmpty()) name += u'_';
+      name += QLatin1String(group_by_enum.valueToKey(static_cast<int>(grouping[i])));
+    }
+    if (name.isEmpty()) name = u"None"_s;
+
+    QList<qint64> nsecs;
+    for (int i = 0; i < 3; ++i) {
+      nsecs << BuildModel(grouping);
+    }
+    benchmark::Record(u"build_"_s + name, nsecs, songs_.count());
+    EXPECT_EQ(songs_.count(), model_->song_nodes().count());
+  }
+
+}
+
+TEST_P(CollectionBenchmark, FilterTyping) {
+
+  backend_->AddOrUpdateSongs(songs_);
+  CreateModel();
+  BuildModel(CollectionModel::Grouping(CollectionModel::GroupBy::AlbumArtist, CollectionModel::GroupBy::AlbumDisc));
+
+  CollectionFilter *filter = model_->filter();
+
+  // Type each word a character at a time and clear the filter again, the way the search field sends it.
+  // The full-text search runs on a worker thread, so the time until the filter is applied is recorded separately from the time the event loop is blocked.
+  const QStringList words = benchmark::FilterWords();
+  for (const QString &word : words) {
+    QList<qint64> nsecs;
+    QList<qint64> blocked_nsecs;
+    for (int i = 1; i <= word.length(); ++i) {
+      QElapsedTimer timer;
+      timer.start();
+      filter->SetFilterString(word.left(i));
+      blocked_nsecs << timer.nsecsElapsed();
+      while (filter->full_text_search_pending()) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+      }
+      filter->rowCount(QModelIndex());
+      nsecs << timer.nsecsElapsed();
+    }
+    benchmark::Record(u"keystroke_"_s + word, nsecs, songs_.count());
+    benchmark::Record(u"keystroke_blocked_"_s + word, blocked_nsecs, songs_.count());
+
+    QElapsedTimer timer;
+    timer.start();
+    filter->SetFilterString(QString());
+    filter->rowCount(QModelIndex());
+    benchmark::Record(u"clear_"_s + word, QList<qint64>() << timer.nsecsElapsed());
+  }
+
+}
+
+INSTANTIATE_TEST_SUITE_P(Songs, CollectionBenchmark, ::testing::ValuesIn(benchmark::LibrarySizes()));
+
+}  // namespace
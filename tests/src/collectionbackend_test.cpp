@@ -20,6 +20,7 @@
  */
 
 #include <memory>
+#include <algorithm>
 
 #include <gtest/gtest.h>
 
@@ -31,10 +32,13 @@
 #include "core/scoped_ptr.h"
 #include "core/shared_ptr.h"
 #include "core/song.h"
+#include "core/songprojection.h"
 #include "core/database.h"
 #include "utilities/timeconstants.h"
 #include "collection/collectionbackend.h"
 #include "collection/collection.h"
+#include "smartplaylists/smartplaylistsearch.h"
+#include "smartplaylists/smartplaylistsearchterm.h"
 
 using namespace Qt::StringLiterals;
 using std::make_unique;
@@ -231,6 +235,29 @@ TEST_F(SingleSong, GetSongs) {
 
 }
 
+TEST_F(SingleSong, GetSongsProjected) {
+
+  AddDummySong();
+  if (HasFatalFailure()) return;
+
+  const SongProjection projection(QStringList() << u"artist"_s << u"url"_s);
+  EXPECT_EQ(u"ROWID, artist, url"_s, projection.column_spec());
+
+  const SongList songs = backend_->GetAllSongs(projection);
+  ASSERT_EQ(1, songs.size());
+  EXPECT_EQ(1, songs[0].id());
+  EXPECT_EQ(song_.artist(), songs[0].artist());
+  EXPECT_EQ(song_.url(), songs[0].url());
+  EXPECT_TRUE(songs[0].title().isEmpty());
+  EXPECT_TRUE(songs[0].album().isEmpty());
+
+  const SongList album_songs = backend_->GetSongsByAlbum(u"Album"_s, SongProjection(QStringList() << u"title"_s));
+  ASSERT_EQ(1, album_songs.size());
+  EXPECT_EQ(song_.title(), album_songs[0].title());
+  EXPECT_TRUE(album_songs[0].artist().isEmpty());
+
+}
+
 TEST_F(SingleSong, GetSongById) {
 
   AddDummySong();
@@ -317,6 +344,41 @@ TEST_F(SingleSong, DeleteSongs) {
 
 }
 
+TEST_F(SingleSong, SearchSongIds) {
+
+  AddDummySong();
+  if (HasFatalFailure()) return;
+
+  EXPECT_EQ(QList<int>() << 1, backend_->SearchSongIds(QStringList() << QStringLiteral("rtis")));
+  EXPECT_EQ(QList<int>() << 1, backend_->SearchSongIds(QStringList() << QStringLiteral("TITLE") << QStringLiteral("album")));
+  EXPECT_TRUE(backend_->SearchSongIds(QStringList() << QStringLiteral("title") << QStringLiteral("other")).isEmpty());
+
+  // The index follows updates and deletes of the songs table.
+  Song new_song(song_);
+  new_song.set_id(1);
+  new_song.set_title(QStringLiteral("A different title"));
+  backend_->AddOrUpdateSongs(SongList() << new_song);
+  EXPECT_EQ(QList<int>() << 1, backend_->SearchSongIds(QStringList() << QStringLiteral("differ")));
+
+  backend_->DeleteSongs(SongList() << new_song);
+  EXPECT_TRUE(backend_->SearchSongIds(QStringList() << QStringLiteral("differ")).isEmpty());
+
+}
+
+TEST_F(SingleSong, SmartPlaylistFullTextSearch) {
+
+  AddDummySong();
+  if (HasFatalFailure()) return;
+
+  const SmartPlaylistSearch contains(SmartPlaylistSearch::SearchType::And, SmartPlaylistSearch::TermList() << SmartPlaylistSearchTerm(SmartPlaylistSearchTerm::Field::Artist, SmartPlaylistSearchTerm::Operator::Contains, QStringLiteral("rtis")), SmartPlaylistSearch::SortType::FieldAsc, SmartPlaylistSearchTerm::Field::Title, -1);
+  EXPECT_TRUE(contains.ToSql(backend_->songs_table(), backend_->fts_table()).contains(backend_->fts_table()));
+  EXPECT_EQ(1, backend_->SmartPlaylistsFindSongs(contains).count());
+
+  const SmartPlaylistSearch not_contains(SmartPlaylistSearch::SearchType::And, SmartPlaylistSearch::TermList() << SmartPlaylistSearchTerm(SmartPlaylistSearchTerm::Field::Title, SmartPlaylistSearchTerm::Operator::NotContains, QStringLiteral("itl")), SmartPlaylistSearch::SortType::FieldAsc, SmartPlaylistSearchTerm::Field::Title, -1);
+  EXPECT_EQ(0, backend_->SmartPlaylistsCountSongs(not_contains));
+
+}
+
 TEST_F(SingleSong, MarkSongsUnavailable) {
 
   AddDummySong();
@@ -431,6 +493,47 @@ TEST_F(TestUrls, TestUrls) {
 
 }
 
+TEST_F(TestUrls, GetSongsByUrls) {
+
+  QStringList strings = QStringList() << QStringLiteral("file:///mnt/music/01 - Pink Floyd - Echoes.flac")
+                                      << QStringLiteral("file:///mnt/music/02 - Björn Afzelius - Det räcker nu.flac")
+                                      << QStringLiteral("file:///mnt/music/Test !#$%&'()-@^_`{}~..flac");
+
+  const QList<QUrl> urls = QUrl::fromStringList(strings);
+  SongList songs;
+  for (const QUrl &url : urls) {
+    Song song(Song::Source::Collection);
+    song.set_directory_id(1);
+    song.set_title(QStringLiteral("Test Title"));
+    song.set_url(url);
+    song.set_length_nanosec(kNsecPerSec);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    song.set_valid(true);
+    songs << song;
+  }
+
+  // A second section of the first file.
+  Song section = songs.first();
+  section.set_beginning_nanosec(kNsecPerSec);
+  songs << section;
+
+  backend_->AddOrUpdateSongs(songs);
+  if (HasFatalFailure()) return;
+
+  const SongList songs_found = backend_->GetSongsByUrls(QList<QUrl>() << urls << QUrl::fromLocalFile(QStringLiteral("/mnt/music/missing.flac")));
+  EXPECT_EQ(4, songs_found.count());
+
+  for (const QUrl &url : urls) {
+    const qint64 count = std::count_if(songs_found.begin(), songs_found.end(), [&url](const Song &song) { return song.url() == url; });
+    EXPECT_EQ(url == urls.first() ? 2 : 1, count);
+  }
+
+  EXPECT_TRUE(backend_->GetSongsByUrls(QList<QUrl>()).isEmpty());
+
+}
+
 class UpdateSongsBySongID : public CollectionBackendTest {
  protected:
   void SetUp() override {
@@ -24,6 +24,7 @@
 #include <gtest/gtest.h>
 
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QUrl>
 #include <QThread>
@@ -37,6 +38,7 @@
 #include "collection/collection.h"
 #include "collection/collectionbackend.h"
 #include "collection/collectionmodel.h"
+#include "collection/collectionitem.h"
 #include "collection/collectionfilter.h"
 
 using namespace Qt::StringLiterals;
@@ -319,4 +321,39 @@ TEST_F(CollectionModelTest, RemoveEmptyArtists) {
 
 }
 
+TEST_F(CollectionModelTest, LargeBatchSharesContainers) {
+
+  backend_->AddDirectory(QStringLiteral("/tmp"));
+  added_dir_ = true;
+
+  // Large enough for the container keys to be built in parallel.
+  SongList songs;
+  for (int i = 0; i < 1200; ++i) {
+    Song song;
+    song.Init(QStringLiteral("Title ") + QString::number(i), QStringLiteral("Artist ") + QString::number(i % 3), QStringLiteral("Album ") + QString::number(i % 4), 123);
+    song.set_directory_id(1);
+    song.set_mtime(1);
+    song.set_ctime(1);
+    song.set_filesize(1);
+    song.set_url(QUrl(QStringLiteral("file:///tmp/foo") + QString::number(i)));
+    songs << song;
+  }
+
+  QEventLoop loop;
+  QObject::connect(&*model_, &CollectionModel::rowsInserted, &loop, &QEventLoop::quit);
+  backend_->AddOrUpdateSongs(songs);
+  loop.exec();
+
+  const QList<CollectionItem*> song_nodes = model_->song_nodes();
+  ASSERT_EQ(1200, song_nodes.count());
+
+  QSet<CollectionItem*> albums;
+  for (CollectionItem *item : song_nodes) {
+    EXPECT_EQ(item->metadata.artist() + QLatin1Char('-') + item->metadata.album(), item->parent->container_key);
+    albums << item->parent;
+  }
+  EXPECT_EQ(12, albums.count());
+
+}
+
 }  // namespace
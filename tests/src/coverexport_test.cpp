@@ -0,0 +1,209 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QColor>
+#include <QTemporaryDir>
+
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "utilities/fileutils.h"
+#include "covermanager/albumcoverexport.h"
+#include "covermanager/albumcoverloaderoptions.h"
+#include "covermanager/coverexportrunnable.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+using std::make_shared;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+QByteArray ReadFile(const QString &filename) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+  return file.readAll();
+
+}
+
+// Rewrites the file in place, like AlbumCoverChoiceController::SaveCoverToFile() does.
+bool RewriteFile(const QString &filename, const QByteArray &data) {
+
+  QFile file(filename);
+  if (!file.open(QIODevice::WriteOnly)) return false;
+  return file.write(data) == data.size();
+
+}
+
+class CoverExportTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(dir_.isValid());
+    ASSERT_TRUE(QDir(dir_.path()).mkpath(u"album1"_s));
+    ASSERT_TRUE(QDir(dir_.path()).mkpath(u"album2"_s));
+    dialog_result_.export_downloaded_ = true;
+    dialog_result_.filename_ = u"cover"_s;
+    dialog_result_.overwrite_ = AlbumCoverExport::OverwriteMode::None;
+  }
+
+  QString WriteImage(const QString &filename, const QColor &color) const {
+    QImage image(16, 16, QImage::Format_RGB32);
+    image.fill(color);
+    const QString path = dir_.filePath(filename);
+    return image.save(path, "PNG") ? path : QString();
+  }
+
+  Song MakeSong(const QString &album_dir, const QString &art_manual) const {
+    Song song(Song::Source::Collection);
+    song.set_url(QUrl::fromLocalFile(dir_.filePath(album_dir + u"/track.flac"_s)));
+    if (!art_manual.isEmpty()) song.set_art_manual(QUrl::fromLocalFile(art_manual));
+    return song;
+  }
+
+  QTemporaryDir dir_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  AlbumCoverExport::DialogResult dialog_result_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(CoverExportTest, SourceKeyGroupsSongsWithTheSameCover) {
+
+  const QString cover1 = WriteImage(u"cover1.png"_s, Qt::red);
+  const QString cover2 = WriteImage(u"cover2.png"_s, Qt::blue);
+  ASSERT_FALSE(cover1.isEmpty());
+  ASSERT_FALSE(cover2.isEmpty());
+
+  const AlbumCoverLoaderOptions::Types cover_types = AlbumCoverLoaderOptions::Types() << AlbumCoverLoaderOptions::Type::Embedded << AlbumCoverLoaderOptions::Type::Manual;
+
+  const QString key1 = CoverExportRunnable::SourceKey(dialog_result_, cover_types, MakeSong(u"album1"_s, cover1));
+  EXPECT_FALSE(key1.isEmpty());
+  EXPECT_EQ(key1, CoverExportRunnable::SourceKey(dialog_result_, cover_types, MakeSong(u"album2"_s, cover1)));
+  EXPECT_NE(key1, CoverExportRunnable::SourceKey(dialog_result_, cover_types, MakeSong(u"album2"_s, cover2)));
+
+  // Embedded covers are read from each file, so they are never grouped by the key.
+  dialog_result_.export_embedded_ = true;
+  Song embedded1 = MakeSong(u"album1"_s, cover1);
+  embedded1.set_art_embedded(true);
+  Song embedded2 = MakeSong(u"album2"_s, cover1);
+  embedded2.set_art_embedded(true);
+  EXPECT_NE(CoverExportRunnable::SourceKey(dialog_result_, cover_types, embedded1), CoverExportRunnable::SourceKey(dialog_result_, cover_types, embedded2));
+
+  Song unset = MakeSong(u"album1"_s, cover1);
+  unset.set_art_unset(true);
+  EXPECT_TRUE(CoverExportRunnable::SourceKey(dialog_result_, cover_types, unset).isEmpty());
+
+}
+
+TEST(CoverExportWrittenFilesTest, KeepsTheFirstFileForEachHash) {
+
+  CoverExportWrittenFiles written_files;
+  EXPECT_TRUE(written_files.File(QByteArray("hash1")).isEmpty());
+
+  written_files.AddFile(QByteArray("hash1"), u"/music/album1/cover.jpg"_s);
+  written_files.AddFile(QByteArray("hash1"), u"/music/album2/cover.jpg"_s);
+  written_files.AddFile(QByteArray("hash2"), u"/music/album3/cover.jpg"_s);
+
+  EXPECT_EQ(u"/music/album1/cover.jpg"_s, written_files.File(QByteArray("hash1")));
+  EXPECT_EQ(u"/music/album3/cover.jpg"_s, written_files.File(QByteArray("hash2")));
+
+}
+
+TEST_F(CoverExportTest, ExportedCoversAreNotLinkedToTheSource) {
+
+  const QString source = WriteImage(u"source.png"_s, Qt::red);
+  ASSERT_FALSE(source.isEmpty());
+  const QByteArray source_data = ReadFile(source);
+
+  const SongList songs = SongList() << MakeSong(u"album1"_s, source) << MakeSong(u"album2"_s, source);
+  CoverExportRunnable runnable(dialog_result_, AlbumCoverLoaderOptions::Types() << AlbumCoverLoaderOptions::Type::Manual, songs, make_shared<CoverExportWrittenFiles>());
+  int exported = 0;
+  int skipped = 0;
+  QObject::connect(&runnable, &CoverExportRunnable::CoverExported, &runnable, [&exported]() { ++exported; });
+  QObject::connect(&runnable, &CoverExportRunnable::CoverSkipped, &runnable, [&skipped]() { ++skipped; });
+  runnable.run();
+
+  EXPECT_EQ(2, exported);
+  EXPECT_EQ(0, skipped);
+
+  const QString cover1 = dir_.filePath(u"album1/cover.png"_s);
+  const QString cover2 = dir_.filePath(u"album2/cover.png"_s);
+  EXPECT_EQ(source_data, ReadFile(cover1));
+  EXPECT_EQ(source_data, ReadFile(cover2));
+
+  // Changing the cover in Strawberry must not change the exported files.
+  ASSERT_TRUE(RewriteFile(source, QByteArray("changed")));
+  EXPECT_EQ(source_data, ReadFile(cover1));
+  EXPECT_EQ(source_data, ReadFile(cover2));
+
+#ifdef Q_OS_UNIX
+  // The other albums get a link to the first exported file.
+  ASSERT_TRUE(RewriteFile(cover1, QByteArray("changed")));
+  EXPECT_EQ(QByteArray("changed"), ReadFile(cover2));
+#endif
+
+}
+
+TEST_F(CoverExportTest, ExistingCoversAreNotOverwritten) {
+
+  const QString source = WriteImage(u"source.png"_s, Qt::red);
+  ASSERT_FALSE(source.isEmpty());
+  const QString existing = dir_.filePath(u"album1/cover.png"_s);
+  ASSERT_TRUE(RewriteFile(existing, QByteArray("existing")));
+
+  CoverExportRunnable runnable(dialog_result_, AlbumCoverLoaderOptions::Types() << AlbumCoverLoaderOptions::Type::Manual, SongList() << MakeSong(u"album1"_s, source), make_shared<CoverExportWrittenFiles>());
+  int skipped = 0;
+  QObject::connect(&runnable, &CoverExportRunnable::CoverSkipped, &runnable, [&skipped]() { ++skipped; });
+  runnable.run();
+
+  EXPECT_EQ(1, skipped);
+  EXPECT_EQ(QByteArray("existing"), ReadFile(existing));
+
+}
+
+TEST_F(CoverExportTest, LinkOrCopy) {
+
+  const QString source = dir_.filePath(u"source.txt"_s);
+  const QString destination = dir_.filePath(u"destination.txt"_s);
+  ASSERT_TRUE(RewriteFile(source, QByteArray("data")));
+
+  ASSERT_TRUE(Utilities::LinkOrCopy(source, destination));
+  EXPECT_EQ(QByteArray("data"), ReadFile(destination));
+
+  // An existing destination is left alone.
+  EXPECT_FALSE(Utilities::LinkOrCopy(source, destination));
+
+#ifdef Q_OS_UNIX
+  // Both names refer to the same file.
+  ASSERT_TRUE(RewriteFile(source, QByteArray("changed")));
+  EXPECT_EQ(QByteArray("changed"), ReadFile(destination));
+#endif
+
+}
+
+}  // namespace
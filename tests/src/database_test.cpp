@@ -0,0 +1,183 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <QElapsedTimer>
+#include <QSqlDatabase>
+#include <QVariant>
+#include <QString>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "core/sqlquery.h"
+#include "core/scopedtransaction.h"
+#include "core/song.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+class DatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_database_.is_valid());
+    database_ = temp_database_.database();
+  }
+
+  int CountPlaylists() {
+    QSqlDatabase db(database_->Connect());
+    SqlQuery q(db);
+    q.prepare(u"SELECT COUNT(*) FROM playlists"_s);
+    if (!q.Exec() || !q.next()) return -1;
+    return q.value(0).toInt();
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(DatabaseTest, JournalModeIsWal) {
+
+  QSqlDatabase db(database_->Connect());
+  SqlQuery q(db);
+  q.prepare(u"PRAGMA journal_mode"_s);
+  ASSERT_TRUE(q.Exec());
+  ASSERT_TRUE(q.next());
+  EXPECT_EQ(u"wal"_s, q.value(0).toString());
+
+}
+
+TEST_F(DatabaseTest, ReadDuringWrite) {
+
+  const int playlists = CountPlaylists();
+  ASSERT_GE(playlists, 0);
+
+  Database::WriteLocker l(database_);
+  QSqlDatabase db(database_->Connect());
+  ScopedTransaction t(&db);
+  {
+    SqlQuery q(db);
+    q.prepare(u"INSERT INTO playlists (name) VALUES ('test')"_s);
+    ASSERT_TRUE(q.Exec());
+  }
+
+  // The reader must neither wait for the write lock nor for the open transaction, and must not see the uncommitted row.
+  int playlists_read = -1;
+  qint64 read_msec = -1;
+  QThread *thread = QThread::create([this, &playlists_read, &read_msec]() {
+    QElapsedTimer timer;
+    timer.start();
+    playlists_read = CountPlaylists();
+    read_msec = timer.elapsed();
+    database_->Close();
+  });
+  thread->start();
+  ASSERT_TRUE(thread->wait(10000));
+  delete thread;
+
+  // A reader that waited for the writer would block until the 30 second busy timeout.
+  EXPECT_EQ(playlists, playlists_read);
+  EXPECT_LT(read_msec, 5000);
+
+  t.Commit();
+  EXPECT_EQ(playlists + 1, CountPlaylists());
+
+}
+
+TEST_F(DatabaseTest, WriteLockStatistics) {
+
+  const Database::LockStatistics before = database_->lock_statistics();
+
+  QThread *thread = nullptr;
+  {
+    Database::WriteLocker l(database_);
+    thread = QThread::create([this]() {
+      Database::WriteLocker l2(database_);
+    });
+    thread->start();
+    QThread::msleep(50);
+  }
+  ASSERT_TRUE(thread->wait(10000));
+  delete thread;
+
+  const Database::LockStatistics after = database_->lock_statistics();
+  EXPECT_EQ(before.locks + 2, after.locks);
+  EXPECT_EQ(before.contended + 1, after.contended);
+  EXPECT_GT(after.wait_nsec_max, 0);
+  EXPECT_GE(after.wait_nsec_total, after.wait_nsec_max);
+
+}
+
+TEST_F(DatabaseTest, SongColumnTableMatchesSchema) {
+
+  QSqlDatabase db(database_->Connect());
+  SqlQuery q(db);
+  q.prepare(u"PRAGMA table_info(songs)"_s);
+  ASSERT_TRUE(q.Exec());
+
+  int i = 0;
+  while (q.next()) {
+    ASSERT_LT(i, Song::kColumnCount);
+    const Song::ColumnInfo &column = Song::kColumnTable[i];
+    EXPECT_EQ(QString::fromLatin1(column.name), q.value(u"name"_s).toString());
+    switch (column.type) {
+      case Song::ColumnType::Text:
+        EXPECT_EQ(u"TEXT"_s, q.value(u"type"_s).toString()) << column.name;
+        break;
+      case Song::ColumnType::Integer:
+        EXPECT_EQ(u"INTEGER"_s, q.value(u"type"_s).toString()) << column.name;
+        break;
+      case Song::ColumnType::Real:
+        EXPECT_EQ(u"REAL"_s, q.value(u"type"_s).toString()) << column.name;
+        break;
+    }
+    ++i;
+  }
+  EXPECT_EQ(Song::kColumnCount, i);
+  EXPECT_EQ(Song::kColumnCount, Song::kColumns.count());
+
+}
+
+TEST_F(DatabaseTest, PositionalBindValues) {
+
+  QSqlDatabase db(database_->Connect());
+  {
+    SqlQuery q(db);
+    q.prepare(u"INSERT INTO playlists (name, last_played) VALUES (?, ?)"_s);
+    q.AddBindStringValue(QString());
+    q.AddBindIntValue(0);
+    ASSERT_TRUE(q.Exec());
+  }
+
+  SqlQuery q(db);
+  q.prepare(u"SELECT name, last_played FROM playlists WHERE ROWID = (SELECT MAX(ROWID) FROM playlists)"_s);
+  ASSERT_TRUE(q.Exec());
+  ASSERT_TRUE(q.next());
+  EXPECT_FALSE(q.value(0).isNull());
+  EXPECT_EQ(u""_s, q.value(0).toString());
+  EXPECT_EQ(-1, q.value(1).toInt());
+
+}
+
+}  // namespace
@@ -0,0 +1,106 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <QDateTime>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "lyrics/lyricscache.h"
+#include "lyrics/lyricssearchrequest.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+constexpr qint64 kDaySecs = 24LL * 60LL * 60LL;
+
+LyricsSearchRequest MakeRequest(const QString &albumartist, const QString &artist, const QString &album, const QString &title) {
+
+  LyricsSearchRequest request;
+  request.albumartist = albumartist;
+  request.artist = artist;
+  request.album = album;
+  request.title = title;
+  return request;
+
+}
+
+class LyricsCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_database_.is_valid());
+    database_ = temp_database_.database();
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(LyricsCacheTest, StoredLyricsArePersisted) {
+
+  {
+    LyricsCache cache(database_);
+    EXPECT_FALSE(cache.Lookup(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Title"_s), nullptr));
+    cache.Store(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Title"_s), u"provider"_s, u"Some lyrics"_s);
+    cache.Flush();
+  }
+
+  LyricsCache cache(database_);
+  LyricsCache::Entry entry;
+  ASSERT_TRUE(cache.Lookup(MakeRequest(QString(), u"ARTIST"_s, u"album"_s, u"title"_s), &entry));
+  EXPECT_EQ(u"provider"_s, entry.provider);
+  EXPECT_EQ(u"Some lyrics"_s, entry.lyrics);
+
+  EXPECT_FALSE(cache.Lookup(MakeRequest(QString(), u"Artist"_s, u"Other album"_s, u"Title"_s), nullptr));
+
+}
+
+TEST_F(LyricsCacheTest, AlbumArtistIsPreferred) {
+
+  EXPECT_EQ(LyricsCache::Key(MakeRequest(u"Album artist"_s, u"Artist"_s, u"Album"_s, u"Title"_s)), LyricsCache::Key(MakeRequest(u"album artist"_s, u"Other artist"_s, u"album"_s, u"title"_s)));
+  EXPECT_NE(LyricsCache::Key(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Title"_s)), LyricsCache::Key(MakeRequest(QString(), u"Other artist"_s, u"Album"_s, u"Title"_s)));
+
+}
+
+TEST_F(LyricsCacheTest, EntriesExpire) {
+
+  const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+  LyricsCache cache(database_);
+  cache.Store(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Found"_s), u"provider"_s, u"Some lyrics"_s, now);
+  cache.Store(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Not found"_s), QString(), QString(), now);
+  cache.Flush();
+
+  LyricsCache::Entry entry;
+  EXPECT_TRUE(cache.Lookup(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Not found"_s), &entry, now + kDaySecs));
+  EXPECT_TRUE(entry.lyrics.isEmpty());
+  EXPECT_FALSE(cache.Lookup(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Not found"_s), &entry, now + 7 * kDaySecs));
+
+  EXPECT_TRUE(cache.Lookup(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Found"_s), &entry, now + 7 * kDaySecs));
+  EXPECT_FALSE(cache.Lookup(MakeRequest(QString(), u"Artist"_s, u"Album"_s, u"Found"_s), &entry, now + 365 * kDaySecs));
+
+}
+
+}  // namespace
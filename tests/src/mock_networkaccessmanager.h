@@ -28,6 +28,7 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 
+#include "core/networkaccessmanager.h"
 #include "test_utils.h"
 #include "gmock/gmock.h"
 
@@ -35,6 +36,7 @@
 // Create a MockNetworkAccessManager.
 // Call ExpectGet() with appropriate expectations and the data you want back.
 // This will return a MockNetworkReply*. When you are ready for the reply to arrive, call MockNetworkReply::Done().
+// MockNetworkAccessManager is a NetworkAccessManager, so it can be given to the cover providers and other classes using one.
 
 class MockNetworkReply : public QNetworkReply {
   Q_OBJECT
@@ -60,7 +62,7 @@ class MockNetworkReply : public QNetworkReply {
 };
 
 
-class MockNetworkAccessManager : public QNetworkAccessManager {
+class MockNetworkAccessManager : public NetworkAccessManager {
   Q_OBJECT
  public:
   MockNetworkReply* ExpectGet(
@@ -0,0 +1,237 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <QtGlobal>
+#include <QFile>
+#include <QDir>
+#include <QTextStream>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QScopedPointer>
+
+#include "core/scoped_ptr.h"
+#include "core/shared_ptr.h"
+#include "core/song.h"
+#include "core/database.h"
+#include "utilities/timeconstants.h"
+#include "collection/collection.h"
+#include "collection/collectionbackend.h"
+#include "playlist/playlist.h"
+#include "playlist/playlistbackend.h"
+#include "playlist/playlistfilter.h"
+#include "playlist/playlistitem.h"
+#include "playlist/playlistsequence.h"
+#include "playlistparsers/m3uparser.h"
+#include "filterparser/filterparser.h"
+#include "filterparser/filtertree.h"
+#include "mock_settingsprovider.h"
+#include "benchmark_utils.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+using std::make_unique;
+using std::make_shared;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+class PlaylistBenchmark : public ::testing::TestWithParam<int> {
+ protected:
+  PlaylistBenchmark() : sequence_(nullptr, new DummySettingsProvider) {}
+
+  void SetUp() override {
+    songs_ = benchmark::GenerateSongs(GetParam());
+    ::testing::Test::RecordProperty("songs", GetParam());
+    CreatePlaylist();
+  }
+
+  void TearDown() override {
+    playlist_.reset();
+    collection_backend_.reset();
+  }
+
+  void CreatePlaylist() {
+    playlist_.reset();
+    playlist_ = make_unique<Playlist>(nullptr, nullptr, nullptr, 1);
+    playlist_->set_sequence(&sequence_);
+  }
+
+  // Sets up a database with the songs in the collection, and reloads them so they have their IDs.
+  void CreateCollection() {
+    ASSERT_TRUE(temp_database_.is_valid());
+    database_ = temp_database_.database();
+    collection_backend_ = make_shared<CollectionBackend>();
+    collection_backend_->Init(database_, nullptr, Song::Source::Collection, QLatin1String(SCollection::kSongsTable), QLatin1String(SCollection::kDirsTable), QLatin1String(SCollection::kSubdirsTable));
+    collection_backend_->AddDirectory(u"/music"_s);
+    collection_backend_->AddOrUpdateSongs(songs_);
+    songs_ = collection_backend_->GetAllSongs();
+    ASSERT_EQ(GetParam(), songs_.count());
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<CollectionBackend> collection_backend_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  PlaylistSequence sequence_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  ScopedPtr<Playlist> playlist_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SongList songs_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_P(PlaylistBenchmark, InsertSongs) {
+
+  benchmark::Run(u"insert"_s, [this]() { playlist_->InsertSongs(songs_); }, 3, songs_.count(), [this]() { CreatePlaylist(); });
+  EXPECT_EQ(songs_.count(), playlist_->rowCount(QModelIndex()));
+
+  // Appending to a playlist that is already full.
+  const SongList more_songs = benchmark::GenerateSongs(std::max(1, GetParam() / 10), GetParam());
+  benchmark::Run(u"append"_s, [this, &more_songs]() { playlist_->InsertSongs(more_songs); }, 3, more_songs.count());
+
+}
+
+TEST_P(PlaylistBenchmark, Sort) {
+
+  playlist_->InsertSongs(songs_);
+
+  const QList<Playlist::Column> columns = QList<Playlist::Column>() << Playlist::Column::Title << Playlist::Column::Artist << Playlist::Column::Album << Playlist::Column::Year << Playlist::Column::Length;
+  for (const Playlist::Column column : columns) {
+    const QString name = u"sort_"_s + Playlist::column_name(column).toLower().remove(u' ');
+    bool ascending = false;
+    // Alternate the order so every run has to move the items.
+    benchmark::Run(name, [this, column, &ascending]() {
+      ascending = !ascending;
+      playlist_->sort(static_cast<int>(column), ascending ? Qt::AscendingOrder : Qt::DescendingOrder);
+    }, 4, songs_.count());
+  }
+
+}
+
+TEST_P(PlaylistBenchmark, Shuffle) {
+
+  playlist_->InsertSongs(songs_);
+
+  benchmark::Run(u"shuffle"_s, [this]() { playlist_->Shuffle(); }, 5, songs_.count());
+
+  // The shuffle modes only reorder the virtual indexes.
+  sequence_.SetShuffleMode(PlaylistSequence::ShuffleMode::All);
+  benchmark::Run(u"shuffle_mode_all"_s, [this]() { playlist_->ShuffleModeChanged(PlaylistSequence::ShuffleMode::All); }, 5, songs_.count());
+  sequence_.SetShuffleMode(PlaylistSequence::ShuffleMode::Albums);
+  benchmark::Run(u"shuffle_mode_albums"_s, [this]() { playlist_->ShuffleModeChanged(PlaylistSequence::ShuffleMode::Albums); }, 5, songs_.count());
+  sequence_.SetShuffleMode(PlaylistSequence::ShuffleMode::Off);
+
+}
+
+TEST_P(PlaylistBenchmark, FilterParser) {
+
+  const QStringList filters = QStringList()
+    << u"midnight"_s
+    << u"artist:\"Artist 1\""_s
+    << u"year:>=1990 AND genre:rock"_s
+    << u"-title:love OR album:blue"_s
+    << u"(genre:jazz OR genre:blues) AND -composer:bach"_s;
+
+  for (int i = 0; i < filters.count(); ++i) {
+    const QString &filter = filters.at(i);
+    benchmark::Run(u"parse_"_s + QString::number(i), [&filter]() {
+      FilterParser parser(filter);
+      QScopedPointer<FilterTree> tree(parser.parse());
+    }, 5);
+
+    FilterParser parser(filter);
+    QScopedPointer<FilterTree> tree(parser.parse());
+    qint64 matches = 0;
+    benchmark::Run(u"accept_"_s + QString::number(i), [this, &tree, &matches]() {
+      matches = std::count_if(songs_.begin(), songs_.end(), [&tree](const Song &song) { return tree->accept(song); });
+    }, 5, songs_.count());
+    ::testing::Test::RecordProperty((u"accept_"_s + QString::number(i) + u"_matches"_s).toStdString(), static_cast<int>(matches));
+  }
+
+  // The same filters through the playlist view's proxy model.
+  playlist_->InsertSongs(songs_);
+  PlaylistFilter *proxy = playlist_->filter();
+  for (int i = 0; i < filters.count(); ++i) {
+    const QString &filter = filters.at(i);
+    benchmark::Run(u"playlist_filter_"_s + QString::number(i), [proxy, &filter]() {
+      proxy->SetFilterString(filter);
+      proxy->rowCount(QModelIndex());
+    }, 3, songs_.count(), [proxy]() { proxy->SetFilterString(QString()); });
+  }
+
+}
+
+TEST_P(PlaylistBenchmark, SavePlaylist) {
+
+  CreateCollection();
+  PlaylistBackend playlist_backend(database_);
+  const int playlist_id = playlist_backend.CreatePlaylist(u"Benchmark"_s, QString());
+  ASSERT_NE(-1, playlist_id);
+
+  PlaylistItemPtrList items;
+  items.reserve(songs_.count());
+  for (const Song &song : std::as_const(songs_)) {
+    items << PlaylistItem::NewFromSong(song);
+  }
+
+  benchmark::Run(u"save"_s, [&playlist_backend, playlist_id, &items]() { playlist_backend.SavePlaylist(playlist_id, items, -1, nullptr); }, 3, items.count());
+
+  qint64 count = 0;
+  benchmark::Run(u"load"_s, [&playlist_backend, playlist_id, &count]() { count = playlist_backend.GetPlaylistItems(playlist_id).count(); }, 3, items.count());
+  EXPECT_EQ(items.count(), count);
+
+}
+
+TEST_P(PlaylistBenchmark, LoadM3U) {
+
+  CreateCollection();
+
+  // An extended M3U with an entry for every song in the collection.
+  const QString filename = temp_database_.FilePath(u"benchmark.m3u"_s);
+  {
+    QFile file(filename);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QTextStream s(&file);
+    s << "#EXTM3U\n";
+    for (const Song &song : std::as_const(songs_)) {
+      s << "#EXTINF:" << song.length_nanosec() / kNsecPerSec << ',' << song.artist() << " - " << song.title() << '\n';
+      s << song.url().toLocalFile() << '\n';
+    }
+  }
+
+  M3UParser parser(collection_backend_);
+  qint64 count = 0;
+  benchmark::Run(u"load"_s, [&parser, &filename, &count]() {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) return;
+    const SongList songs = parser.Load(&file, filename, QDir(u"/music"_s));
+    count = std::count_if(songs.begin(), songs.end(), [](const Song &song) { return song.id() != -1; });
+  }, 3, songs_.count());
+
+  // Every entry is found in the collection, so no file is opened to read its tags.
+  EXPECT_EQ(songs_.count(), count);
+
+}
+
+INSTANTIATE_TEST_SUITE_P(Songs, PlaylistBenchmark, ::testing::ValuesIn(benchmark::LibrarySizes()));
+
+}  // namespace
@@ -126,6 +126,22 @@ TEST_F(PlaylistTest, Indexes) {
 
 }
 
+TEST_F(PlaylistTest, PeekPreviousRow) {
+
+  playlist_.InsertItems(PlaylistItemPtrList() << MakeMockItemP(QStringLiteral("One")) << MakeMockItemP(QStringLiteral("Two")) << MakeMockItemP(QStringLiteral("Three")));
+  ASSERT_EQ(3, playlist_.rowCount(QModelIndex()));
+
+  playlist_.set_current_row(0);
+  EXPECT_EQ(-1, playlist_.peek_previous_row());
+
+  playlist_.set_current_row(2);
+  EXPECT_EQ(0, playlist_.peek_previous_row());
+  // Peeking doesn't consume the played history
+  EXPECT_EQ(0, playlist_.peek_previous_row());
+  EXPECT_EQ(0, playlist_.previous_row());
+
+}
+
 TEST_F(PlaylistTest, RepeatPlaylist) {
 
   playlist_.InsertItems(PlaylistItemPtrList() << MakeMockItemP(QStringLiteral("One")) << MakeMockItemP(QStringLiteral("Two")) << MakeMockItemP(QStringLiteral("Three")));
@@ -268,6 +284,27 @@ TEST_F(PlaylistTest, InsertAfterCurrent) {
 
 }
 
+TEST_F(PlaylistTest, InsertManyAtCurrent) {
+
+  playlist_.InsertItems(PlaylistItemPtrList() << MakeMockItemP(QStringLiteral("One")) << MakeMockItemP(QStringLiteral("Two")) << MakeMockItemP(QStringLiteral("Three")));
+  ASSERT_EQ(3, playlist_.rowCount(QModelIndex()));
+
+  playlist_.set_current_row(1);
+  EXPECT_EQ(1, playlist_.current_row());
+  playlist_.InsertItems(PlaylistItemPtrList() << MakeMockItemP(QStringLiteral("Four")) << MakeMockItemP(QStringLiteral("Five")) << MakeMockItemP(QStringLiteral("Six")), 1);
+  ASSERT_EQ(6, playlist_.rowCount(QModelIndex()));
+
+  EXPECT_EQ(4, playlist_.current_row());
+  EXPECT_EQ(4, playlist_.last_played_row());
+
+  EXPECT_EQ(QStringLiteral("One"), playlist_.data(playlist_.index(0, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("Four"), playlist_.data(playlist_.index(1, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("Five"), playlist_.data(playlist_.index(2, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("Six"), playlist_.data(playlist_.index(3, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("Two"), playlist_.data(playlist_.index(4, static_cast<int>(Playlist::Column::Title))));
+
+}
+
 TEST_F(PlaylistTest, Clear) {
 
   playlist_.InsertItems(PlaylistItemPtrList() << MakeMockItemP(QStringLiteral("One")) << MakeMockItemP(QStringLiteral("Two")) << MakeMockItemP(QStringLiteral("Three")));
@@ -285,6 +322,23 @@ TEST_F(PlaylistTest, Clear) {
 
 }
 
+TEST_F(PlaylistTest, SortByTitle) {
+
+  playlist_.InsertItems(PlaylistItemPtrList() << MakeMockItemP(QStringLiteral("bravo")) << MakeMockItemP(QStringLiteral("Charlie")) << MakeMockItemP(QStringLiteral("Alpha")));
+  ASSERT_EQ(3, playlist_.rowCount(QModelIndex()));
+
+  playlist_.sort(static_cast<int>(Playlist::Column::Title), Qt::AscendingOrder);
+  EXPECT_EQ(QStringLiteral("Alpha"), playlist_.data(playlist_.index(0, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("bravo"), playlist_.data(playlist_.index(1, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("Charlie"), playlist_.data(playlist_.index(2, static_cast<int>(Playlist::Column::Title))));
+
+  playlist_.sort(static_cast<int>(Playlist::Column::Title), Qt::DescendingOrder);
+  EXPECT_EQ(QStringLiteral("Charlie"), playlist_.data(playlist_.index(0, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("bravo"), playlist_.data(playlist_.index(1, static_cast<int>(Playlist::Column::Title))));
+  EXPECT_EQ(QStringLiteral("Alpha"), playlist_.data(playlist_.index(2, static_cast<int>(Playlist::Column::Title))));
+
+}
+
 TEST_F(PlaylistTest, UndoAdd) {
 
   EXPECT_FALSE(playlist_.undo_stack()->canUndo());
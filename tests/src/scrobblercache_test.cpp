@@ -0,0 +1,156 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <QStandardPaths>
+#include <QSignalSpy>
+
+#include "core/shared_ptr.h"
+#include "core/database.h"
+#include "core/song.h"
+#include "utilities/timeconstants.h"
+#include "scrobbler/scrobblercache.h"
+#include "scrobbler/scrobblercacheitem.h"
+#include "test_utils.h"
+
+using namespace Qt::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+constexpr char kService[] = "Test";
+constexpr char kLegacyCacheFile[] = "scrobblercache_test.json";
+
+Song MakeSong(const QString &title) {
+
+  Song song(Song::Source::Collection);
+  song.Init(title, u"Artist"_s, u"Album"_s, 180 * kNsecPerSec);
+  return song;
+
+}
+
+class ScrobblerCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    QStandardPaths::setTestModeEnabled(true);
+    ASSERT_TRUE(temp_database_.is_valid());
+    database_ = temp_database_.database();
+  }
+
+  // Creates a cache and waits until it has read the stored scrobbles.
+  ScrobblerCache *CreateCache() {
+    ScrobblerCache *cache = new ScrobblerCache(database_, QLatin1String(kService), QLatin1String(kLegacyCacheFile), nullptr);
+    QSignalSpy spy(cache, &ScrobblerCache::CacheLoaded);
+    EXPECT_TRUE(spy.wait(5000));
+    return cache;
+  }
+
+  TemporaryDatabase temp_database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+  SharedPtr<Database> database_;  // NOLINT(cppcoreguidelines-non-private-member-variables-in-classes)
+};
+
+TEST_F(ScrobblerCacheTest, AddedScrobblesAreReadBack) {
+
+  {
+    ScrobblerCache *cache = CreateCache();
+    EXPECT_EQ(0, cache->Count());
+    cache->Add(MakeSong(u"Title 1"_s), 1000);
+    cache->Add(MakeSong(u"Title 2"_s), 2000);
+    cache->WriteCache();
+    delete cache;
+  }
+
+  ScrobblerCache *cache = CreateCache();
+  const ScrobblerCacheItemPtrList cache_items = cache->List();
+  ASSERT_EQ(2, cache_items.count());
+  EXPECT_EQ(u"Title 1"_s, cache_items[0]->metadata.title);
+  EXPECT_EQ(u"Artist"_s, cache_items[0]->metadata.artist);
+  EXPECT_EQ(u"Album"_s, cache_items[0]->metadata.album);
+  EXPECT_EQ(180 * kNsecPerSec, cache_items[0]->metadata.length_nanosec);
+  EXPECT_EQ(1000U, cache_items[0]->timestamp);
+  EXPECT_NE(-1, cache_items[0]->id);
+  EXPECT_FALSE(cache_items[0]->error);
+  EXPECT_EQ(u"Title 2"_s, cache_items[1]->metadata.title);
+  EXPECT_EQ(2000U, cache_items[1]->timestamp);
+  delete cache;
+
+}
+
+TEST_F(ScrobblerCacheTest, FlushedScrobblesAreRemoved) {
+
+  {
+    ScrobblerCache *cache = CreateCache();
+    ScrobblerCacheItemPtr cache_item = cache->Add(MakeSong(u"Title 1"_s), 1000);
+    cache->Add(MakeSong(u"Title 2"_s), 2000);
+    cache->Flush(ScrobblerCacheItemPtrList() << cache_item);
+    EXPECT_EQ(1, cache->Count());
+    cache->WriteCache();
+    delete cache;
+  }
+
+  ScrobblerCache *cache = CreateCache();
+  ASSERT_EQ(1, cache->Count());
+  EXPECT_EQ(u"Title 2"_s, cache->List().first()->metadata.title);
+  delete cache;
+
+}
+
+TEST_F(ScrobblerCacheTest, ErrorStateIsReadBack) {
+
+  {
+    ScrobblerCache *cache = CreateCache();
+    ScrobblerCacheItemPtr cache_item = cache->Add(MakeSong(u"Title 1"_s), 1000);
+    cache->SetError(ScrobblerCacheItemPtrList() << cache_item);
+    cache->WriteCache();
+    delete cache;
+  }
+
+  ScrobblerCache *cache = CreateCache();
+  ASSERT_EQ(1, cache->Count());
+  EXPECT_TRUE(cache->List().first()->error);
+  delete cache;
+
+}
+
+TEST_F(ScrobblerCacheTest, ScrobblesAddedWhileLoadingComeLast) {
+
+  {
+    ScrobblerCache *cache = CreateCache();
+    cache->Add(MakeSong(u"Title 1"_s), 1000);
+    cache->WriteCache();
+    delete cache;
+  }
+
+  ScrobblerCache *cache = new ScrobblerCache(database_, QLatin1String(kService), QLatin1String(kLegacyCacheFile), nullptr);
+  QSignalSpy spy(cache, &ScrobblerCache::CacheLoaded);
+  cache->Add(MakeSong(u"Title 2"_s), 2000);
+  ASSERT_TRUE(spy.wait(5000));
+
+  const ScrobblerCacheItemPtrList cache_items = cache->List();
+  ASSERT_EQ(2, cache_items.count());
+  EXPECT_EQ(u"Title 1"_s, cache_items[0]->metadata.title);
+  EXPECT_EQ(u"Title 2"_s, cache_items[1]->metadata.title);
+  delete cache;
+
+}
+
+}  // namespace
@@ -0,0 +1,253 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <QObject>
+#include <QList>
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+#include <QEventLoop>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+
+#include "core/shared_ptr.h"
+#include "scrobbler/scrobblemetadata.h"
+#include "scrobbler/scrobblercacheitem.h"
+#include "scrobbler/scrobblersubmitwindow.h"
+
+using namespace Qt::StringLiterals;
+using std::make_shared;
+
+namespace {
+
+// Local stand-in for a scrobbler API, answers every request with the same canned HTTP response.
+class StandInServer : public QTcpServer {
+ public:
+  explicit StandInServer(const QByteArray &response) : response_(response) {
+    QObject::connect(this, &QTcpServer::newConnection, this, [this]() {
+      while (hasPendingConnections()) {
+        QTcpSocket *socket = nextPendingConnection();
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket]() {
+          socket->readAll();
+          socket->write(response_);
+          socket->disconnectFromHost();
+        });
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+      }
+    });
+    listen(QHostAddress::LocalHost);
+  }
+
+  QUrl url() const { return QUrl(u"http://127.0.0.1:%1/2.0/"_s.arg(serverPort())); }
+
+ private:
+  QByteArray response_;
+};
+
+ScrobblerCacheItemPtrList CacheItems(const int count) {
+  ScrobblerCacheItemPtrList cache_items;
+  for (int i = 0; i < count; ++i) {
+    cache_items << make_shared<ScrobblerCacheItem>(ScrobbleMetadata(), static_cast<quint64>(1000 + i));
+  }
+  return cache_items;
+}
+
+QByteArray Response(const QByteArray &status, const QByteArray &headers) {
+  const QByteArray body = "{}";
+  return "HTTP/1.1 " + status + "\r\n" + headers + "Content-Type: application/json\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+}
+
+class ScrobblerSubmitWindowTest : public ::testing::Test {
+ protected:
+  void Request(StandInServer *server, ScrobblerSubmitWindow *window) {
+    window->Sent();
+    std::unique_ptr<QNetworkReply> reply(network_.post(QNetworkRequest(server->url()), QByteArray("method=track.scrobble")));
+    QEventLoop loop;
+    QObject::connect(&*reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+    window->Finished(&*reply);
+  }
+
+  QNetworkAccessManager network_;
+};
+
+}  // namespace
+
+TEST_F(ScrobblerSubmitWindowTest, LimitsRequestsInFlight) {
+
+  ScrobblerSubmitWindow window(2);
+  ASSERT_TRUE(window.CanSend());
+  window.Sent();
+  ASSERT_TRUE(window.CanSend());
+  window.Sent();
+  ASSERT_FALSE(window.CanSend());
+  ASSERT_EQ(window.in_flight(), 2);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, SuccessKeepsWindowOpen) {
+
+  StandInServer server(Response("200 OK", ""));
+  ASSERT_TRUE(server.isListening());
+
+  ScrobblerSubmitWindow window(4);
+  Request(&server, &window);
+  ASSERT_EQ(window.in_flight(), 0);
+  ASSERT_EQ(window.limit(), 4);
+  ASSERT_FALSE(window.paused());
+  ASSERT_TRUE(window.CanSend());
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, TooManyRequestsHonoursRetryAfter) {
+
+  StandInServer server(Response("429 Too Many Requests", "Retry-After: 30\r\n"));
+  ASSERT_TRUE(server.isListening());
+
+  ScrobblerSubmitWindow window(4);
+  Request(&server, &window);
+  ASSERT_EQ(window.in_flight(), 0);
+  ASSERT_EQ(window.limit(), 2);
+  ASSERT_TRUE(window.paused());
+  ASSERT_FALSE(window.CanSend());
+  ASSERT_GT(window.msec_until_ready(), 25000);
+  ASSERT_LE(window.msec_until_ready(), 30000);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, ExhaustedRateLimitPausesUntilReset) {
+
+  StandInServer server(Response("200 OK", "X-RateLimit-Remaining: 0\r\nX-RateLimit-Reset-In: 10\r\n"));
+  ASSERT_TRUE(server.isListening());
+
+  ScrobblerSubmitWindow window(4);
+  Request(&server, &window);
+  ASSERT_EQ(window.limit(), 4);
+  ASSERT_TRUE(window.paused());
+  ASSERT_GT(window.msec_until_ready(), 5000);
+  ASSERT_LE(window.msec_until_ready(), 10000);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, WindowGrowsBackAfterRateLimit) {
+
+  ScrobblerSubmitWindow window(4);
+  window.RateLimited(1);
+  ASSERT_EQ(window.limit(), 2);
+
+  StandInServer server(Response("200 OK", "X-RateLimit-Remaining: 100\r\nX-RateLimit-Reset-In: 10\r\n"));
+  ASSERT_TRUE(server.isListening());
+
+  Request(&server, &window);
+  ASSERT_EQ(window.limit(), 3);
+  Request(&server, &window);
+  ASSERT_EQ(window.limit(), 4);
+  Request(&server, &window);
+  ASSERT_EQ(window.limit(), 4);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, NextRequestsFillsWindowWithBatches) {
+
+  ScrobblerSubmitWindow window(2);
+  const ScrobblerCacheItemPtrList cache_items = CacheItems(7);
+
+  const QList<ScrobblerCacheItemPtrList> requests = window.NextRequests(cache_items, 3);
+  ASSERT_EQ(2, requests.count());
+  EXPECT_EQ(3, requests[0].count());
+  EXPECT_EQ(3, requests[1].count());
+  for (int i = 0; i < 7; ++i) {
+    EXPECT_EQ(i < 6, cache_items[i]->sent);
+  }
+
+  // Nothing more is picked until a request finishes.
+  window.Sent();
+  window.Sent();
+  EXPECT_TRUE(window.NextRequests(cache_items, 3).isEmpty());
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, NextRequestsCountsFailedScrobblesAgainstWindow) {
+
+  ScrobblerSubmitWindow window(2);
+  ScrobblerCacheItemPtrList cache_items = CacheItems(6);
+  cache_items[1]->error = true;
+  cache_items[3]->error = true;
+
+  // The first batch and the first failed scrobble fill the window, the second failed scrobble waits.
+  const QList<ScrobblerCacheItemPtrList> requests = window.NextRequests(cache_items, 10);
+  ASSERT_EQ(2, requests.count());
+  EXPECT_EQ(ScrobblerCacheItemPtrList() << cache_items[0] << cache_items[2] << cache_items[4] << cache_items[5], requests[0]);
+  EXPECT_EQ(ScrobblerCacheItemPtrList() << cache_items[1], requests[1]);
+  EXPECT_FALSE(cache_items[3]->sent);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, NextRequestsSendsOneByOneWithoutBatches) {
+
+  ScrobblerSubmitWindow window(4);
+  window.Sent();
+  const ScrobblerCacheItemPtrList cache_items = CacheItems(5);
+  cache_items[0]->sent = true;
+
+  const QList<ScrobblerCacheItemPtrList> requests = window.NextRequests(cache_items, 1);
+  ASSERT_EQ(3, requests.count());
+  for (const ScrobblerCacheItemPtrList &request : requests) {
+    EXPECT_EQ(1, request.count());
+  }
+  EXPECT_FALSE(cache_items[4]->sent);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, NextRequestsWaitsWhilePaused) {
+
+  ScrobblerSubmitWindow window(4);
+  window.RateLimited(30);
+  const ScrobblerCacheItemPtrList cache_items = CacheItems(3);
+
+  EXPECT_TRUE(window.NextRequests(cache_items, 10).isEmpty());
+  EXPECT_FALSE(cache_items[0]->sent);
+
+}
+
+TEST_F(ScrobblerSubmitWindowTest, ServiceRateLimitIsAppliedOnce) {
+
+  // A 429 reply that also carries the service's rate limit error only halves the window once.
+  StandInServer server(Response("429 Too Many Requests", "Retry-After: 30\r\n"));
+  ASSERT_TRUE(server.isListening());
+
+  ScrobblerSubmitWindow window(4);
+  window.Sent();
+  std::unique_ptr<QNetworkReply> reply(network_.post(QNetworkRequest(server.url()), QByteArray("method=track.scrobble")));
+  QEventLoop loop;
+  QObject::connect(&*reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+  loop.exec();
+  window.Finished(&*reply, true);
+  EXPECT_EQ(window.limit(), 2);
+  EXPECT_TRUE(window.paused());
+
+}
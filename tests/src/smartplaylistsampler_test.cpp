@@ -0,0 +1,119 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <QList>
+#include <QSet>
+
+#include "smartplaylists/smartplaylistsampler.h"
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+SmartPlaylistSampler::CandidateList MakeCandidates(const int count) {
+
+  SmartPlaylistSampler::CandidateList candidates;
+  for (int i = 1; i <= count; ++i) {
+    SmartPlaylistSampler::Candidate candidate;
+    candidate.id = i;
+    candidates << candidate;
+  }
+  return candidates;
+
+}
+
+TEST(SmartPlaylistSamplerTest, SamplesDistinctIdsNotExcluded) {
+
+  SmartPlaylistSampler sampler;
+  sampler.SetCandidates(MakeCandidates(1000));
+
+  const QList<int> exclude_ids = QList<int>() << 1 << 2 << 3 << 4 << 5;
+  for (int i = 0; i < 100; ++i) {
+    const QList<int> ids = sampler.Sample(20, exclude_ids);
+    ASSERT_EQ(20, ids.count());
+    const QSet<int> unique_ids(ids.begin(), ids.end());
+    EXPECT_EQ(20, unique_ids.count());
+    for (const int id : exclude_ids) {
+      EXPECT_FALSE(unique_ids.contains(id));
+    }
+  }
+
+}
+
+TEST(SmartPlaylistSamplerTest, ReturnsRemainingWhenAlmostEverythingIsExcluded) {
+
+  SmartPlaylistSampler sampler;
+  sampler.SetCandidates(MakeCandidates(10));
+
+  const QList<int> ids = sampler.Sample(5, QList<int>() << 1 << 2 << 3 << 4 << 5 << 6 << 7);
+  EXPECT_EQ(QSet<int>() << 8 << 9 << 10, QSet<int>(ids.begin(), ids.end()));
+
+  EXPECT_TRUE(sampler.Sample(5, QList<int>() << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9 << 10).isEmpty());
+
+}
+
+TEST(SmartPlaylistSamplerTest, SampleAll) {
+
+  SmartPlaylistSampler sampler;
+  sampler.SetCandidates(MakeCandidates(100));
+
+  const QList<int> ids = sampler.Sample(-1, QList<int>());
+  EXPECT_EQ(100, ids.count());
+  EXPECT_EQ(100, QSet<int>(ids.begin(), ids.end()).count());
+
+}
+
+TEST(SmartPlaylistSamplerTest, WeightedByPlayCount) {
+
+  SmartPlaylistSampler::CandidateList candidates = MakeCandidates(100);
+  candidates[0].playcount = 1000;
+
+  SmartPlaylistSampler sampler(SmartPlaylistSampler::Weight::PlayCount);
+  sampler.SetCandidates(candidates);
+
+  int hits = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (sampler.Sample(1, QList<int>()).value(0) == 1) ++hits;
+  }
+
+  // The first song carries about 90% of the total weight.
+  EXPECT_GT(hits, 70);
+
+}
+
+TEST(SmartPlaylistSamplerTest, WeightedBySkipCount) {
+
+  SmartPlaylistSampler::CandidateList candidates = MakeCandidates(2);
+  candidates[0].skipcount = 1000;
+
+  SmartPlaylistSampler sampler(SmartPlaylistSampler::Weight::SkipCount);
+  sampler.SetCandidates(candidates);
+
+  int hits = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (sampler.Sample(1, QList<int>()).value(0) == 2) ++hits;
+  }
+
+  EXPECT_GT(hits, 90);
+
+}
+
+}  // namespace
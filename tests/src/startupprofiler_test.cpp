@@ -0,0 +1,100 @@
+/*
+ * Strawberry Music Player
+ * Copyright 2024, Jonas Kvinge <jonas@jkvinge.net>
+ *
+ * Strawberry is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Strawberry is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Strawberry.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include "core/startupprofiler.h"
+
+using namespace Qt::StringLiterals;
+
+// clazy:excludeall=non-pod-global-static,returning-void-expression
+
+namespace {
+
+QJsonObject FindEvent(const QJsonArray &trace_events, const QString &name) {
+
+  for (const QJsonValue &value : trace_events) {
+    const QJsonObject trace_event = value.toObject();
+    if (trace_event["name"_L1].toString() == name) return trace_event;
+  }
+
+  return QJsonObject();
+
+}
+
+TEST(StartupProfilerTest, WritesNestedScopes) {
+
+  QTemporaryDir temp_dir;
+  ASSERT_TRUE(temp_dir.isValid());
+  const QString filename = temp_dir.filePath(u"trace.json"_s);
+
+  StartupProfiler::Start();
+  StartupProfiler::Enable(filename);
+  ASSERT_TRUE(StartupProfiler::enabled());
+
+  {
+    StartupProfiler::Scope outer("Outer");
+    {
+      StartupProfiler::Scope inner("Inner");
+    }
+    StartupProfiler::Mark("Marker");
+  }
+
+  StartupProfiler::Finish();
+  EXPECT_FALSE(StartupProfiler::enabled());
+
+  // Nothing is recorded once the trace is written.
+  {
+    StartupProfiler::Scope after("After");
+  }
+
+  QFile file(filename);
+  ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+  const QJsonArray trace_events = QJsonDocument::fromJson(file.readAll()).object()["traceEvents"_L1].toArray();
+  file.close();
+
+  const QJsonObject outer = FindEvent(trace_events, u"Outer"_s);
+  const QJsonObject inner = FindEvent(trace_events, u"Inner"_s);
+  const QJsonObject marker = FindEvent(trace_events, u"Marker"_s);
+  ASSERT_FALSE(outer.isEmpty());
+  ASSERT_FALSE(inner.isEmpty());
+  ASSERT_FALSE(marker.isEmpty());
+  EXPECT_TRUE(FindEvent(trace_events, u"After"_s).isEmpty());
+
+  EXPECT_EQ(u"X"_s, outer["ph"_L1].toString());
+  EXPECT_FALSE(outer.contains("args"_L1));
+  EXPECT_EQ(u"Outer"_s, inner["args"_L1].toObject()["parent"_L1].toString());
+  EXPECT_EQ(u"i"_s, marker["ph"_L1].toString());
+  EXPECT_EQ(u"Outer"_s, marker["args"_L1].toObject()["parent"_L1].toString());
+
+  EXPECT_GE(inner["ts"_L1].toInteger(), outer["ts"_L1].toInteger());
+  EXPECT_LE(inner["dur"_L1].toInteger(), outer["dur"_L1].toInteger());
+  EXPECT_EQ(outer["tid"_L1].toInt(), inner["tid"_L1].toInt());
+
+}
+
+}  // namespace
@@ -28,6 +28,11 @@
 #include <QString>
 #include <QUrl>
 
+#include "core/shared_ptr.h"
+#include "core/database.h"
+
+using std::make_shared;
+
 std::ostream &operator<<(std::ostream &stream, const QString &str) {
   stream << str.toStdString();
   return stream;
@@ -73,6 +78,24 @@ TemporaryResource::TemporaryResource(const QString &filename, QObject *parent) :
 
 }
 
+TemporaryDatabase::TemporaryDatabase() {
+
+  if (dir_.isValid()) {
+    database_ = make_shared<Database>(nullptr, nullptr, dir_.filePath(QStringLiteral("strawberry.db")));
+  }
+
+}
+
+TemporaryDatabase::~TemporaryDatabase() {
+
+  // Close the connection of this thread before the directory is removed.
+  if (database_) {
+    database_->Close();
+    database_.reset();
+  }
+
+}
+
 TestQObject::TestQObject(QObject *parent)
   : QObject(parent),
     invoked_(0) {
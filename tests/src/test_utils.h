@@ -26,11 +26,15 @@
 #include <QMetaType>
 #include <QModelIndex>
 #include <QTemporaryFile>
+#include <QTemporaryDir>
+
+#include "core/shared_ptr.h"
 
 class QNetworkRequest;
 class QString;
 class QUrl;
 class QVariant;
+class Database;
 
 std::ostream& operator <<(std::ostream& stream, const QString& str);
 std::ostream& operator <<(std::ostream& stream, const QVariant& var);
@@ -67,6 +71,23 @@ class TemporaryResource : public QTemporaryFile {
   explicit TemporaryResource(const QString &filename, QObject *parent = nullptr);
 };
 
+// A database file in a temporary directory, rather than an in-memory one, so the journal and locking behave like they do for users.
+class TemporaryDatabase {
+ public:
+  TemporaryDatabase();
+  ~TemporaryDatabase();
+
+  bool is_valid() const { return dir_.isValid() && database_; }
+  SharedPtr<Database> database() const { return database_; }
+  QString FilePath(const QString &filename) const { return dir_.filePath(filename); }
+
+ private:
+  Q_DISABLE_COPY(TemporaryDatabase)
+
+  QTemporaryDir dir_;
+  SharedPtr<Database> database_;
+};
+
 class TestQObject : public QObject {
   Q_OBJECT
 